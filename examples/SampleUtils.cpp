@@ -21,6 +21,7 @@
 #include "utils/BackendBinding.h"
 #include "utils/GLFWUtils.h"
 #include "utils/TerribleCommandBuffer.h"
+#include "utils/WireServerTraceLayer.h"
 
 #include <dawn/dawn_proc.h>
 #include <dawn/dawn_wsi.h>
@@ -31,6 +32,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <memory>
+#include <string>
 
 void PrintDeviceError(WGPUErrorType errorType, const char* message, void*) {
     const char* errorTypeName = "";
@@ -81,6 +84,8 @@ static wgpu::BackendType backendType = wgpu::BackendType::OpenGL;
 #endif
 
 static CmdBufType cmdBufType = CmdBufType::Terrible;
+static std::string wireTraceDir;
+static std::string wireTraceName;
 static std::unique_ptr<dawn_native::Instance> instance;
 static utils::BackendBinding* binding = nullptr;
 
@@ -88,6 +93,8 @@ static GLFWwindow* window = nullptr;
 
 static dawn_wire::WireServer* wireServer = nullptr;
 static dawn_wire::WireClient* wireClient = nullptr;
+// Owned so that the trace is closed when the sample exits.
+static std::unique_ptr<utils::WireServerTraceLayer> wireServerTraceLayer;
 static utils::TerribleCommandBuffer* c2sBuf = nullptr;
 static utils::TerribleCommandBuffer* s2cBuf = nullptr;
 
@@ -155,6 +162,13 @@ wgpu::Device CreateCppDawnDevice() {
             wireServer = new dawn_wire::WireServer(serverDesc);
             c2sBuf->SetHandler(wireServer);
 
+            if (!wireTraceDir.empty()) {
+                wireServerTraceLayer =
+                    std::make_unique<utils::WireServerTraceLayer>(wireTraceDir.c_str(), wireServer);
+                wireServerTraceLayer->BeginWireTrace(wireTraceName.c_str());
+                c2sBuf->SetHandler(wireServerTraceLayer.get());
+            }
+
             dawn_wire::WireClientDescriptor clientDesc = {};
             clientDesc.serializer = c2sBuf;
 
@@ -205,6 +219,14 @@ wgpu::TextureView CreateDefaultDepthStencilView(const wgpu::Device& device) {
 }
 
 bool InitSample(int argc, const char** argv) {
+    // Name the wire trace after the sample.
+    wireTraceName = argv[0];
+    size_t lastSeparator = wireTraceName.find_last_of("/\\");
+    if (lastSeparator != std::string::npos) {
+        wireTraceName = wireTraceName.substr(lastSeparator + 1);
+    }
+    wireTraceName += ".trace";
+
     for (int i = 1; i < argc; i++) {
         if (std::string("-b") == argv[i] || std::string("--backend") == argv[i]) {
             i++;
@@ -250,10 +272,21 @@ bool InitSample(int argc, const char** argv) {
             fprintf(stderr, "--command-buffer expects a command buffer name (none, terrible)\n");
             return false;
         }
+        if (std::string("--wire-trace-dir") == argv[i]) {
+            i++;
+            if (i < argc) {
+                wireTraceDir = argv[i];
+                continue;
+            }
+            fprintf(stderr, "--wire-trace-dir expects a directory\n");
+            return false;
+        }
         if (std::string("-h") == argv[i] || std::string("--help") == argv[i]) {
-            printf("Usage: %s [-b BACKEND] [-c COMMAND_BUFFER]\n", argv[0]);
+            printf("Usage: %s [-b BACKEND] [-c COMMAND_BUFFER] [--wire-trace-dir DIR]\n",
+                   argv[0]);
             printf("  BACKEND is one of: d3d12, metal, null, opengl, opengles, vulkan\n");
             printf("  COMMAND_BUFFER is one of: none, terrible\n");
+            printf("  DIR is where the commands sent to the wire are traced, for WireTraceReplay\n");
             return false;
         }
     }
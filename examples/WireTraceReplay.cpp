@@ -0,0 +1,317 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Replays a trace of the commands sent to a WireServer on a backend and reports the time spent
+// handling each type of command. Traces are written with --wire-trace-dir by the samples and by
+// the tests running with --use-wire. Since the commands are decoded and executed by the server as
+// they would be in the process that captured them, replaying a trace with the Null backend
+// measures the CPU cost of the frontend and of the wire for a real workload, deterministically.
+//
+// Swapchains can't be replayed because they refer to the windows of the process that captured the
+// trace: they are created as error swapchains instead. Map requests that had completed when the
+// client ticked the device or wrote to a mapping at capture time may still be pending on the
+// backend of the replay, so the replay waits for them before handling these commands.
+
+#include "dawn/dawn_proc.h"
+#include "dawn/webgpu_cpp.h"
+#include "dawn_native/DawnNative.h"
+#include "dawn_wire/Wire.h"
+#include "dawn_wire/WireServer.h"
+#include "utils/SystemUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // Drops the replies of the server, there is no client to receive them.
+    class DevNull : public dawn_wire::CommandSerializer {
+      public:
+        size_t GetMaximumAllocationSize() const override {
+            return 1024 * 1024 * 1024;
+        }
+        void* GetCmdSpace(size_t size) override {
+            if (size > buf.size()) {
+                buf.resize(size);
+            }
+            return buf.data();
+        }
+        bool Flush() override {
+            return true;
+        }
+
+      private:
+        std::vector<char> buf;
+    };
+
+    struct CommandTiming {
+        uint64_t count = 0;
+        std::chrono::duration<double> duration{0};
+    };
+
+    WGPUProcDeviceCreateSwapChain sOriginalDeviceCreateSwapChain = nullptr;
+    WGPUProcBufferMapAsync sOriginalBufferMapAsync = nullptr;
+
+    uint64_t sPendingMapRequests = 0;
+
+    struct MapRequest {
+        WGPUBufferMapCallback callback;
+        void* userdata;
+    };
+
+    WGPUSwapChain ErrorDeviceCreateSwapChain(WGPUDevice device,
+                                             WGPUSurface surface,
+                                             const WGPUSwapChainDescriptor*) {
+        WGPUSwapChainDescriptor desc = {};
+        // A 0 implementation will trigger a swapchain creation error.
+        desc.implementation = 0;
+        return sOriginalDeviceCreateSwapChain(device, surface, &desc);
+    }
+
+    // Counts the map requests whose callback wasn't called yet.
+    void TrackedBufferMapAsync(WGPUBuffer buffer,
+                               WGPUMapModeFlags mode,
+                               size_t offset,
+                               size_t size,
+                               WGPUBufferMapCallback callback,
+                               void* userdata) {
+        sPendingMapRequests++;
+        sOriginalBufferMapAsync(
+            buffer, mode, offset, size,
+            [](WGPUBufferMapAsyncStatus status, void* userdata) {
+                std::unique_ptr<MapRequest> request(static_cast<MapRequest*>(userdata));
+                sPendingMapRequests--;
+                request->callback(status, request->userdata);
+            },
+            new MapRequest{callback, userdata});
+    }
+
+    bool WaitsForMapRequests(const char* name) {
+        return std::string("DeviceTick") == name || std::string("BufferUpdateMappedData") == name;
+    }
+
+    bool ReadFile(const char* filename, std::vector<char>* data) {
+        FILE* file = fopen(filename, "rb");
+        if (!file) {
+            return false;
+        }
+
+        fseek(file, 0, SEEK_END);
+        long tellFileSize = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if (tellFileSize < 0) {
+            fclose(file);
+            return false;
+        }
+
+        size_t fileSize = static_cast<size_t>(tellFileSize);
+        data->resize(fileSize);
+        size_t bytesRead = fread(data->data(), sizeof(char), fileSize, file);
+        fclose(file);
+        return bytesRead == fileSize;
+    }
+
+    void PrintTimings(const std::map<std::string, CommandTiming>& timings) {
+        std::vector<std::pair<std::string, CommandTiming>> sortedTimings(timings.begin(),
+                                                                         timings.end());
+        std::sort(sortedTimings.begin(), sortedTimings.end(),
+                  [](const std::pair<std::string, CommandTiming>& a,
+                     const std::pair<std::string, CommandTiming>& b) {
+                      return a.second.duration > b.second.duration;
+                  });
+
+        printf("%-48s %10s %12s %12s\n", "Command", "Count", "Total (ms)", "Mean (us)");
+        for (const auto& it : sortedTimings) {
+            const CommandTiming& timing = it.second;
+            printf("%-48s %10llu %12.3f %12.3f\n", it.first.c_str(),
+                   static_cast<unsigned long long>(timing.count), timing.duration.count() * 1e3,
+                   timing.duration.count() * 1e6 / timing.count);
+        }
+    }
+
+}  // anonymous namespace
+
+int main(int argc, const char* argv[]) {
+    wgpu::BackendType backendType = wgpu::BackendType::Null;
+    const char* filename = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::string("-b") == argv[i] || std::string("--backend") == argv[i]) {
+            i++;
+            if (i < argc && std::string("d3d12") == argv[i]) {
+                backendType = wgpu::BackendType::D3D12;
+                continue;
+            }
+            if (i < argc && std::string("metal") == argv[i]) {
+                backendType = wgpu::BackendType::Metal;
+                continue;
+            }
+            if (i < argc && std::string("null") == argv[i]) {
+                backendType = wgpu::BackendType::Null;
+                continue;
+            }
+            if (i < argc && std::string("opengl") == argv[i]) {
+                backendType = wgpu::BackendType::OpenGL;
+                continue;
+            }
+            if (i < argc && std::string("opengles") == argv[i]) {
+                backendType = wgpu::BackendType::OpenGLES;
+                continue;
+            }
+            if (i < argc && std::string("vulkan") == argv[i]) {
+                backendType = wgpu::BackendType::Vulkan;
+                continue;
+            }
+            fprintf(stderr,
+                    "--backend expects a backend name (opengl, opengles, metal, d3d12, null, "
+                    "vulkan)\n");
+            return 1;
+        }
+        if (std::string("-h") == argv[i] || std::string("--help") == argv[i] ||
+            filename != nullptr) {
+            printf("Usage: %s [-b BACKEND] TRACE\n", argv[0]);
+            printf("  BACKEND is one of: d3d12, metal, null, opengl, opengles, vulkan\n");
+            printf("  TRACE is a file written with --wire-trace-dir\n");
+            return 1;
+        }
+        filename = argv[i];
+    }
+
+    if (filename == nullptr) {
+        fprintf(stderr, "Missing the trace to replay, see --help\n");
+        return 1;
+    }
+
+    std::vector<char> trace;
+    if (!ReadFile(filename, &trace)) {
+        fprintf(stderr, "Failed to read %s\n", filename);
+        return 1;
+    }
+
+    // Traces start with the index at which the fuzzers inject an error, skip it.
+    if (trace.size() < sizeof(uint64_t)) {
+        fprintf(stderr, "%s is not a wire trace\n", filename);
+        return 1;
+    }
+    const char* commands = trace.data() + sizeof(uint64_t);
+    size_t size = trace.size() - sizeof(uint64_t);
+
+    dawn_native::Instance instance;
+    instance.DiscoverDefaultAdapters();
+
+    dawn_native::Adapter backendAdapter;
+    {
+        std::vector<dawn_native::Adapter> adapters = instance.GetAdapters();
+        auto adapterIt = std::find_if(adapters.begin(), adapters.end(),
+                                      [&](const dawn_native::Adapter adapter) -> bool {
+                                          wgpu::AdapterProperties properties;
+                                          adapter.GetProperties(&properties);
+                                          return properties.backendType == backendType;
+                                      });
+        if (adapterIt == adapters.end()) {
+            fprintf(stderr, "No adapter found for the backend\n");
+            return 1;
+        }
+        backendAdapter = *adapterIt;
+    }
+
+    DawnProcTable procs = dawn_native::GetProcs();
+    sOriginalDeviceCreateSwapChain = procs.deviceCreateSwapChain;
+    procs.deviceCreateSwapChain = ErrorDeviceCreateSwapChain;
+    sOriginalBufferMapAsync = procs.bufferMapAsync;
+    procs.bufferMapAsync = TrackedBufferMapAsync;
+    dawnProcSetProcs(&procs);
+
+    wgpu::Device device = wgpu::Device::Acquire(backendAdapter.CreateDevice());
+    if (!device) {
+        fprintf(stderr, "Failed to create the device\n");
+        return 1;
+    }
+
+    DevNull devNull;
+    dawn_wire::WireServerDescriptor serverDesc = {};
+    serverDesc.procs = &procs;
+    serverDesc.serializer = &devNull;
+
+    std::unique_ptr<dawn_wire::WireServer> wireServer(new dawn_wire::WireServer(serverDesc));
+    // The device of the client is the first object it allocates.
+    wireServer->InjectDevice(device.Get(), 1, 0);
+
+    // Handle the commands one at a time to time each of them.
+    std::map<std::string, CommandTiming> timings;
+    uint64_t commandIndex = 0;
+    while (size > 0) {
+        const char* name = nullptr;
+        size_t commandSize = dawn_wire::PeekWireCommand(commands, size, &name);
+        if (commandSize == 0 || name == nullptr) {
+            fprintf(stderr, "Invalid command %llu in the trace\n",
+                    static_cast<unsigned long long>(commandIndex));
+            return 1;
+        }
+
+        if (sPendingMapRequests > 0 && WaitsForMapRequests(name)) {
+            auto start = std::chrono::steady_clock::now();
+            while (sPendingMapRequests > 0) {
+                device.Tick();
+                utils::USleep(100);
+            }
+            CommandTiming& timing = timings["(wait for map requests)"];
+            timing.duration += std::chrono::steady_clock::now() - start;
+            timing.count++;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        bool success = wireServer->HandleCommands(commands, commandSize) != nullptr;
+        CommandTiming& timing = timings[name];
+        timing.duration += std::chrono::steady_clock::now() - start;
+        timing.count++;
+
+        if (!success) {
+            fprintf(stderr, "Failed to handle command %llu (%s)\n",
+                    static_cast<unsigned long long>(commandIndex), name);
+            return 1;
+        }
+
+        commands += commandSize;
+        size -= commandSize;
+        commandIndex++;
+    }
+
+    // Wait for all the submitted work before destroying the server.
+    {
+        bool done = false;
+        auto start = std::chrono::steady_clock::now();
+        device.GetQueue().OnSubmittedWorkDone(
+            0u,
+            [](WGPUQueueWorkDoneStatus, void* userdata) { *static_cast<bool*>(userdata) = true; },
+            &done);
+        while (!done) {
+            device.Tick();
+            utils::USleep(100);
+        }
+        CommandTiming& timing = timings["(wait for submitted work)"];
+        timing.duration += std::chrono::steady_clock::now() - start;
+        timing.count++;
+    }
+
+    PrintTimings(timings);
+
+    wireServer = nullptr;
+    return 0;
+}
@@ -149,7 +149,8 @@ class RecordMember:
                  optional=False,
                  is_return_value=False,
                  default_value=None,
-                 skip_serialize=False):
+                 skip_serialize=False,
+                 wire_is_data_only=False):
         self.name = name
         self.type = typ
         self.annotation = annotation
@@ -159,6 +160,7 @@ class RecordMember:
         self.handle_type = None
         self.default_value = default_value
         self.skip_serialize = skip_serialize
+        self.wire_is_data_only = wire_is_data_only
 
     def set_handle_type(self, handle_type):
         assert self.type.dict_name == "ObjectHandle"
@@ -230,7 +232,9 @@ def linked_record_members(json_data, types):
                               optional=m.get('optional', False),
                               is_return_value=m.get('is_return_value', False),
                               default_value=m.get('default', None),
-                              skip_serialize=m.get('skip_serialize', False))
+                              skip_serialize=m.get('skip_serialize', False),
+                              wire_is_data_only=m.get('wire_is_data_only',
+                                                      False))
         handle_type = m.get('handle_type')
         if handle_type:
             member.set_handle_type(types[handle_type])
@@ -250,6 +254,13 @@ def linked_record_members(json_data, types):
             else:
                 member.length = members_by_name[m['length']]
 
+        # Data-only members are given to the command handlers without being
+        # copied out of the command buffer, so they must be arrays of bytes.
+        if member.wire_is_data_only:
+            assert member.annotation == 'const*'
+            assert member.type.name.canonical_case() == 'uint8_t'
+            assert member.length not in ('constant', 'strlen')
+
     return members
 
 
@@ -374,6 +374,16 @@ namespace {
                 const volatile {{member_transfer_type(member)}}* memberBuffer;
                 WIRE_TRY(deserializeBuffer->ReadN(memberLength, &memberBuffer));
 
+                {% if member.wire_is_data_only %}
+                    //* Data-only members are used directly from the command buffer instead of being
+                    //* copied in the allocator first. We can cast away the volatile qualifier because
+                    //* DeserializeBuffer::ReadN already validated that the range
+                    //* [memberBuffer, memberBuffer + memberLength) is valid. The handler only copies
+                    //* the bytes to their destination so if they are changed while being read, it
+                    //* only changes the data written but doesn't affect control flow.
+                    record->{{memberName}} = const_cast<const {{as_cType(member.type.name)}}*>(memberBuffer);
+                {% else %}
+
                 {{as_cType(member.type.name)}}* copiedMembers;
                 WIRE_TRY(GetSpace(allocator, memberLength, &copiedMembers));
                 {% if member.annotation == "const*const*" %}
@@ -397,6 +407,7 @@ namespace {
                 for (decltype(memberLength) i = 0; i < memberLength; ++i) {
                     {{deserialize_member(member, "memberBuffer[i]", "copiedMembers[i]")}}
                 }
+                {% endif %}
             }
         {% endfor %}
 
@@ -658,6 +669,17 @@ namespace dawn_wire {
         {% endfor %}
     }  // anonymous namespace
 
+    const char* GetWireCmdName(WireCmd command) {
+        switch (command) {
+            {% for command in cmd_records["command"] %}
+                case WireCmd::{{command.name.CamelCase()}}:
+                    return "{{command.name.CamelCase()}}";
+            {% endfor %}
+            default:
+                return nullptr;
+        }
+    }
+
     {% for command in cmd_records["command"] %}
         {{ write_command_serialization_methods(command, False) }}
     {% endfor %}
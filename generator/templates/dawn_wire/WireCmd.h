@@ -89,6 +89,9 @@ namespace dawn_wire {
         uint64_t commandSize;
     };
 
+    //* Returns the name of a command, or nullptr if it isn't a valid WireCmd.
+    const char* GetWireCmdName(WireCmd command);
+
 {% macro write_command_struct(command, is_return_command) %}
     {% set Return = "Return" if is_return_command else "" %}
     {% set Cmd = command.name.CamelCase() + "Cmd" %}
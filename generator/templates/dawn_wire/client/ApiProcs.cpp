@@ -71,7 +71,7 @@ namespace dawn_wire { namespace client {
                     self->client->SerializeCommand(cmd);
 
                     {% if method.return_type.category == "object" %}
-                        return reinterpret_cast<{{as_cType(method.return_type.name)}}>(allocation->object.get());
+                        return reinterpret_cast<{{as_cType(method.return_type.name)}}>(allocation->object);
                     {% endif %}
                 {% else %}
                     return self->{{method.name.CamelCase()}}(
@@ -78,7 +78,7 @@ namespace dawn_wire { namespace server {
                         return false;
                     }
                     if (data->deviceInfo != nullptr) {
-                        if (!UntrackDeviceChild(data->deviceInfo, objectType, objectId)) {
+                        if (!UntrackDeviceChild(&data->deviceChildLink)) {
                             return false;
                         }
                     }
@@ -93,12 +93,9 @@ namespace dawn_wire { namespace server {
                             //* are destroyed before their device. We should have a solution in
                             //* Dawn native that makes all child objects internally null if their
                             //* Device is destroyed.
-                            while (data->info->childObjectTypesAndIds.size() > 0) {
-                                ObjectType childObjectType;
-                                ObjectId childObjectId;
-                                std::tie(childObjectType, childObjectId) = UnpackObjectTypeAndId(
-                                    *data->info->childObjectTypesAndIds.begin());
-                                if (!DoDestroyObject(childObjectType, childObjectId)) {
+                            while (!data->info->children.empty()) {
+                                DeviceChildLink* child = data->info->children.head()->value();
+                                if (!DoDestroyObject(child->type, child->id)) {
                                     return false;
                                 }
                             }
@@ -65,7 +65,8 @@ namespace dawn_wire { namespace server {
                         {{name}}Data->deviceInfo = selfData->deviceInfo;
                     {% endif %}
                     if ({{name}}Data->deviceInfo != nullptr) {
-                        if (!TrackDeviceChild({{name}}Data->deviceInfo, ObjectType::{{Type}}, cmd.{{name}}.id)) {
+                        if (!TrackDeviceChild({{name}}Data->deviceInfo, ObjectType::{{Type}}, cmd.{{name}}.id,
+                                              &{{name}}Data->deviceChildLink)) {
                             return false;
                         }
                     }
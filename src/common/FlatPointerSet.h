@@ -0,0 +1,187 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMON_FLATPOINTERSET_H_
+#define COMMON_FLATPOINTERSET_H_
+
+#include "common/Assert.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// FlatPointerSet is a set of pointers stored contiguously in insertion order. Each pointer is
+// given the index at which it is stored so that values can be associated with the pointers in
+// parallel vectors, without the node allocations and the pointer-chasing of std::set or std::map.
+//
+// Small sets are searched linearly. Larger sets are indexed with an open-addressed hash table
+// using linear probing that is kept at most half full.
+template <typename T>
+class FlatPointerSet {
+  public:
+    static constexpr size_t kNotFound = ~size_t(0);
+
+    // Returns the index of |pointer| and whether it was inserted.
+    std::pair<size_t, bool> Insert(T* pointer);
+    // Returns the index of |pointer|, or kNotFound.
+    size_t Find(const T* pointer) const;
+
+    size_t Size() const;
+    bool Empty() const;
+    const std::vector<T*>& GetElements() const;
+
+    // Returns the elements in insertion order and clears the set.
+    std::vector<T*> AcquireElements();
+    void Clear();
+
+  private:
+    // Below this size, searching the elements linearly is faster than hashing the pointer.
+    static constexpr size_t kLinearSearchMaxSize = 8;
+
+    bool UsesTable() const;
+    size_t GetTableSlot(const T* pointer) const;
+    void Rehash(size_t tableSize);
+
+    std::vector<T*> mElements;
+
+    // When the table is used, each slot contains the index of an element plus one, or 0 if the
+    // slot is empty. It is rebuilt from mElements when the set grows past kLinearSearchMaxSize,
+    // so it is left stale when the set is cleared.
+    std::vector<uint32_t> mTable;
+    uint32_t mTableShift = 0;
+};
+
+template <typename T>
+constexpr size_t FlatPointerSet<T>::kNotFound;
+
+template <typename T>
+std::pair<size_t, bool> FlatPointerSet<T>::Insert(T* pointer) {
+    if (!UsesTable()) {
+        size_t index = Find(pointer);
+        if (index != kNotFound) {
+            return {index, false};
+        }
+
+        mElements.push_back(pointer);
+        if (mElements.size() > kLinearSearchMaxSize) {
+            Rehash(std::max(mTable.size(), size_t(4) * kLinearSearchMaxSize));
+        }
+        return {mElements.size() - 1, true};
+    }
+
+    const size_t mask = mTable.size() - 1;
+    for (size_t slot = GetTableSlot(pointer);; slot = (slot + 1) & mask) {
+        uint32_t entry = mTable[slot];
+        if (entry == 0) {
+            size_t index = mElements.size();
+            mElements.push_back(pointer);
+            mTable[slot] = static_cast<uint32_t>(index + 1);
+            if (2 * mElements.size() > mTable.size()) {
+                Rehash(2 * mTable.size());
+            }
+            return {index, true};
+        }
+        if (mElements[entry - 1] == pointer) {
+            return {entry - 1, false};
+        }
+    }
+}
+
+template <typename T>
+size_t FlatPointerSet<T>::Find(const T* pointer) const {
+    if (!UsesTable()) {
+        for (size_t i = 0; i < mElements.size(); ++i) {
+            if (mElements[i] == pointer) {
+                return i;
+            }
+        }
+        return kNotFound;
+    }
+
+    const size_t mask = mTable.size() - 1;
+    for (size_t slot = GetTableSlot(pointer);; slot = (slot + 1) & mask) {
+        uint32_t entry = mTable[slot];
+        if (entry == 0) {
+            return kNotFound;
+        }
+        if (mElements[entry - 1] == pointer) {
+            return entry - 1;
+        }
+    }
+}
+
+template <typename T>
+size_t FlatPointerSet<T>::Size() const {
+    return mElements.size();
+}
+
+template <typename T>
+bool FlatPointerSet<T>::Empty() const {
+    return mElements.empty();
+}
+
+template <typename T>
+const std::vector<T*>& FlatPointerSet<T>::GetElements() const {
+    return mElements;
+}
+
+template <typename T>
+std::vector<T*> FlatPointerSet<T>::AcquireElements() {
+    std::vector<T*> elements = std::move(mElements);
+    Clear();
+    return elements;
+}
+
+template <typename T>
+void FlatPointerSet<T>::Clear() {
+    mElements.clear();
+}
+
+template <typename T>
+bool FlatPointerSet<T>::UsesTable() const {
+    return mElements.size() > kLinearSearchMaxSize;
+}
+
+template <typename T>
+size_t FlatPointerSet<T>::GetTableSlot(const T* pointer) const {
+    // Fibonacci hashing: the high bits of the product depend on all the bits of the pointer, so
+    // the low bits that are the same for all the pointers because of alignment don't matter.
+    uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+    return static_cast<size_t>((hash * 0x9E3779B97F4A7C15ull) >> mTableShift);
+}
+
+template <typename T>
+void FlatPointerSet<T>::Rehash(size_t tableSize) {
+    ASSERT(tableSize >= 2 * mElements.size());
+    ASSERT((tableSize & (tableSize - 1)) == 0);
+
+    mTable.assign(tableSize, 0);
+    mTableShift = 64;
+    for (size_t size = tableSize; size > 1; size >>= 1) {
+        mTableShift--;
+    }
+
+    const size_t mask = tableSize - 1;
+    for (size_t i = 0; i < mElements.size(); ++i) {
+        size_t slot = GetTableSlot(mElements[i]);
+        while (mTable[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        mTable[slot] = static_cast<uint32_t>(i + 1);
+    }
+}
+
+#endif  // COMMON_FLATPOINTERSET_H_
@@ -20,6 +20,7 @@
 #include "common/ityp_bitset.h"
 
 #include <bitset>
+#include <cstdint>
 #include <functional>
 
 // Wrapper around std::hash to make it a templated function instead of a functor. It is marginally
@@ -61,6 +62,17 @@ void HashCombine(size_t* hash, const T& value, const Args&... args) {
     HashCombine(hash, args...);
 }
 
+// Hashes a range of bytes with 64-bit FNV-1a. The result is the same on all platforms so it can
+// be used to name data stored on disk.
+inline uint64_t HashBytes(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
 // Workaround a bug between clang++ and libstdlibc++ by defining our own hashing for bitsets.
 // When _GLIBCXX_DEBUG is enabled libstdc++ wraps containers into debug containers. For bitset this
 // means what is normally std::bitset is defined as std::__cxx1988::bitset and is replaced by the
@@ -49,6 +49,20 @@ void RefCounted::Reference() {
     mRefCount.fetch_add(kRefCountIncrement, std::memory_order_relaxed);
 }
 
+bool RefCounted::TryReference() {
+    // The relaxed ordering is enough for the same reason as in Reference(): the caller makes
+    // sure that `this` isn't freed while it calls TryReference(), for example by holding the lock
+    // of a cache that the destructor of the object needs to take.
+    uint64_t current = mRefCount.load(std::memory_order_relaxed);
+    do {
+        if ((current & ~kPayloadMask) == 0) {
+            return false;
+        }
+    } while (!mRefCount.compare_exchange_weak(current, current + kRefCountIncrement,
+                                              std::memory_order_relaxed));
+    return true;
+}
+
 void RefCounted::Release() {
     ASSERT((mRefCount & ~kPayloadMask) != 0);
 
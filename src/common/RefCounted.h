@@ -30,6 +30,11 @@ class RefCounted {
     void Reference();
     void Release();
 
+    // Adds a reference unless the object is already being deleted, which happens when an object
+    // is found through a weak pointer, for example in a cache that is only cleared by the
+    // destructor of the object. Returns true if the reference was added.
+    bool TryReference();
+
     void APIReference();
     void APIRelease();
 
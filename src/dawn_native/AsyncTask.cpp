@@ -1,65 +1,231 @@
 #include "dawn_native/AsyncTask.h"
 
+#include "common/Assert.h"
 #include "dawn_platform/DawnPlatform.h"
 
 namespace dawn_native {
 
+    AsyncTask::AsyncTask(AsyncTaskManager* taskManager,
+                         AsyncTaskFunction body,
+                         AsyncTaskFunction cancelFunction,
+                         AsyncTaskPriority priority,
+                         uint64_t serial)
+        : mTaskManager(taskManager),
+          mBody(std::move(body)),
+          mCancelFunction(std::move(cancelFunction)),
+          mPriority(priority),
+          mSerial(serial) {
+    }
+
+    bool AsyncTask::Cancel() {
+        return mTaskManager->CancelTask(this);
+    }
+
+    bool AsyncTask::RunNow() {
+        return mTaskManager->RunTaskNow(this);
+    }
+
+    void AsyncTask::Wait() {
+        mTaskManager->WaitTask(this);
+    }
+
+    bool AsyncTask::IsComplete() {
+        return mTaskManager->IsTaskComplete(this);
+    }
+
+    bool AsyncTask::IsCancelled() {
+        return mTaskManager->IsTaskCancelled(this);
+    }
+
+    AsyncTaskPriority AsyncTask::GetPriority() const {
+        return mPriority;
+    }
+
+    bool AsyncTaskManager::TaskOrder::operator()(const Ref<AsyncTask>& a,
+                                                 const Ref<AsyncTask>& b) const {
+        // std::priority_queue pops the largest element first.
+        if (a->mPriority != b->mPriority) {
+            return a->mPriority < b->mPriority;
+        }
+        return a->mSerial > b->mSerial;
+    }
+
     AsyncTaskManager::AsyncTaskManager(dawn_platform::WorkerTaskPool* workerTaskPool)
         : mWorkerTaskPool(workerTaskPool) {
     }
 
-    void AsyncTaskManager::PostTask(AsyncTask asyncTask) {
-        // If these allocations becomes expensive, we can slab-allocate tasks.
-        Ref<WaitableTask> waitableTask = AcquireRef(new WaitableTask());
-        waitableTask->taskManager = this;
-        waitableTask->asyncTask = std::move(asyncTask);
+    AsyncTaskManager::~AsyncTaskManager() {
+        // The worker threads reference the AsyncTaskManager so they must all be done with it.
+        WaitAllPendingTasks();
+    }
 
+    Ref<AsyncTask> AsyncTaskManager::PostTask(AsyncTaskFunction body,
+                                              AsyncTaskPriority priority,
+                                              AsyncTaskFunction cancelFunction) {
+        Ref<AsyncTask> task;
         {
-            // We insert new waitableTask objects into mPendingTasks in main thread (PostTask()),
-            // and we may remove waitableTask objects from mPendingTasks in either main thread
-            // (WaitAllPendingTasks()) or sub-thread (TaskCompleted), so mPendingTasks should be
-            // protected by a mutex.
-            std::lock_guard<std::mutex> lock(mPendingTasksMutex);
-            mPendingTasks.emplace(waitableTask.Get(), waitableTask);
+            // Tasks are queued from the main thread but are popped, stolen or cancelled from
+            // any thread so the queue is protected by a mutex.
+            std::lock_guard<std::mutex> lock(mMutex);
+            // If these allocations becomes expensive, we can slab-allocate tasks.
+            task = AcquireRef(new AsyncTask(this, std::move(body), std::move(cancelFunction),
+                                            priority, mNextTaskSerial++));
+            mQueuedTasks.push(task);
+            mPendingTaskCount++;
+            mOutstandingWorkerTaskCount++;
         }
 
-        // Ref the task since it is accessed inside the worker function.
-        // The worker function will acquire and release the task upon completion.
-        waitableTask->Reference();
-        waitableTask->waitableEvent =
-            mWorkerTaskPool->PostWorkerTask(DoWaitableTask, waitableTask.Get());
+        // The worker task doesn't necessarily run |task|: it runs the highest priority task still
+        // queued when it starts, if any. Completion is tracked by the AsyncTaskManager so the
+        // WaitableEvent isn't needed.
+        mWorkerTaskPool->PostWorkerTask(DoWorkerTask, this);
+
+        return task;
     }
 
-    void AsyncTaskManager::HandleTaskCompletion(WaitableTask* task) {
-        std::lock_guard<std::mutex> lock(mPendingTasksMutex);
-        auto iter = mPendingTasks.find(task);
-        if (iter != mPendingTasks.end()) {
-            mPendingTasks.erase(iter);
+    // static
+    void AsyncTaskManager::DoWorkerTask(void* taskManager) {
+        AsyncTaskManager* manager = static_cast<AsyncTaskManager*>(taskManager);
+
+        Ref<AsyncTask> task;
+        {
+            std::lock_guard<std::mutex> lock(manager->mMutex);
+            while (!manager->mQueuedTasks.empty()) {
+                Ref<AsyncTask> candidate = manager->mQueuedTasks.top();
+                manager->mQueuedTasks.pop();
+                if (candidate->mState == AsyncTask::State::Pending) {
+                    candidate->mState = AsyncTask::State::Running;
+                    task = std::move(candidate);
+                    break;
+                }
+            }
         }
+
+        if (task != nullptr) {
+            manager->RunTaskBody(task.Get());
+        }
+
+        // The notification is done with the lock held because the AsyncTaskManager may be
+        // destroyed as soon as the lock is released.
+        std::lock_guard<std::mutex> lock(manager->mMutex);
+        ASSERT(manager->mOutstandingWorkerTaskCount > 0);
+        manager->mOutstandingWorkerTaskCount--;
+        manager->mTaskCompletedCondition.notify_all();
     }
 
-    void AsyncTaskManager::WaitAllPendingTasks() {
-        std::unordered_map<WaitableTask*, Ref<WaitableTask>> allPendingTasks;
+    void AsyncTaskManager::RunTaskBody(AsyncTask* task) {
+        {
+            // Release the captured state of the body before marking the task as complete.
+            AsyncTaskFunction body = std::move(task->mBody);
+            task->mCancelFunction = nullptr;
+            body();
+        }
 
+        std::lock_guard<std::mutex> lock(mMutex);
+        ASSERT(task->mState == AsyncTask::State::Running);
+        task->mState = AsyncTask::State::Completed;
+        mPendingTaskCount--;
+        mTaskCompletedCondition.notify_all();
+    }
+
+    void AsyncTaskManager::CancelTaskBody(AsyncTask* task) {
         {
-            std::lock_guard<std::mutex> lock(mPendingTasksMutex);
-            allPendingTasks.swap(mPendingTasks);
+            AsyncTaskFunction cancelFunction = std::move(task->mCancelFunction);
+            task->mBody = nullptr;
+            if (cancelFunction) {
+                cancelFunction();
+            }
         }
 
-        for (auto& keyValue : allPendingTasks) {
-            keyValue.second->waitableEvent->Wait();
+        std::lock_guard<std::mutex> lock(mMutex);
+        ASSERT(task->mState == AsyncTask::State::Cancelling);
+        task->mState = AsyncTask::State::Cancelled;
+        mPendingTaskCount--;
+        mTaskCompletedCondition.notify_all();
+    }
+
+    bool AsyncTaskManager::CancelTask(AsyncTask* task) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (task->mState != AsyncTask::State::Pending) {
+                return false;
+            }
+            task->mState = AsyncTask::State::Cancelling;
         }
+
+        CancelTaskBody(task);
+        return true;
     }
 
-    bool AsyncTaskManager::HasPendingTasks() {
-        std::lock_guard<std::mutex> lock(mPendingTasksMutex);
-        return !mPendingTasks.empty();
+    bool AsyncTaskManager::RunTaskNow(AsyncTask* task) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            if (task->mState != AsyncTask::State::Pending) {
+                mTaskCompletedCondition.wait(lock, [task] {
+                    return task->mState == AsyncTask::State::Completed ||
+                           task->mState == AsyncTask::State::Cancelled;
+                });
+                return task->mState == AsyncTask::State::Completed;
+            }
+            // The task stays in mQueuedTasks and will be skipped by the worker thread.
+            task->mState = AsyncTask::State::Running;
+        }
+
+        RunTaskBody(task);
+        return true;
+    }
+
+    void AsyncTaskManager::WaitTask(AsyncTask* task) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mTaskCompletedCondition.wait(lock, [task] {
+            return task->mState == AsyncTask::State::Completed ||
+                   task->mState == AsyncTask::State::Cancelled;
+        });
+    }
+
+    bool AsyncTaskManager::IsTaskComplete(AsyncTask* task) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return task->mState == AsyncTask::State::Completed ||
+               task->mState == AsyncTask::State::Cancelled;
     }
 
-    void AsyncTaskManager::DoWaitableTask(void* task) {
-        Ref<WaitableTask> waitableTask = AcquireRef(static_cast<WaitableTask*>(task));
-        waitableTask->asyncTask();
-        waitableTask->taskManager->HandleTaskCompletion(waitableTask.Get());
+    bool AsyncTaskManager::IsTaskCancelled(AsyncTask* task) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return task->mState == AsyncTask::State::Cancelled;
+    }
+
+    void AsyncTaskManager::WaitAllPendingTasks() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mTaskCompletedCondition.wait(lock, [this] {
+            return mPendingTaskCount == 0 && mOutstandingWorkerTaskCount == 0;
+        });
+    }
+
+    void AsyncTaskManager::CancelAllPendingTasks() {
+        std::vector<Ref<AsyncTask>> cancelledTasks;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            while (!mQueuedTasks.empty()) {
+                Ref<AsyncTask> task = mQueuedTasks.top();
+                mQueuedTasks.pop();
+                if (task->mState == AsyncTask::State::Pending) {
+                    task->mState = AsyncTask::State::Cancelling;
+                    cancelledTasks.push_back(std::move(task));
+                }
+            }
+        }
+
+        // Call the cancellation functions in the order the tasks would have run.
+        for (Ref<AsyncTask>& task : cancelledTasks) {
+            CancelTaskBody(task.Get());
+        }
+
+        WaitAllPendingTasks();
+    }
+
+    bool AsyncTaskManager::HasPendingTasks() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mPendingTaskCount != 0;
     }
 
 }  // namespace dawn_native
@@ -15,48 +15,132 @@
 #ifndef DAWNNATIVE_ASYC_TASK_H_
 #define DAWNNATIVE_ASYC_TASK_H_
 
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
-#include <memory>
 #include <mutex>
-#include <unordered_map>
+#include <queue>
+#include <vector>
 
 #include "common/RefCounted.h"
 
 namespace dawn_platform {
-    class WaitableEvent;
     class WorkerTaskPool;
 }  // namespace dawn_platform
 
 namespace dawn_native {
 
-    // TODO(crbug.com/dawn/826): we'll add additional things to AsyncTask in the future, like
-    // Cancel() and RunNow(). Cancelling helps avoid running the task's body when we are just
-    // shutting down the device. RunNow() could be used for more advanced scenarios, for example
-    // always doing ShaderModule initial compilation asynchronously, but being able to steal the
-    // task if we need it for synchronous pipeline compilation.
-    using AsyncTask = std::function<void()>;
+    class AsyncTaskManager;
+
+    using AsyncTaskFunction = std::function<void()>;
+
+    // Tasks with a higher priority are started before the tasks with a lower priority that are
+    // still waiting for a worker thread. Tasks with the same priority start in posting order.
+    enum class AsyncTaskPriority : uint8_t {
+        Low,
+        Normal,
+        High,
+    };
+
+    // AsyncTask is the handle of a task posted to an AsyncTaskManager.
+    //  - Cancel() prevents the body of the task from running if it hasn't started yet. The
+    //    cancellation function of the task is called instead so that the owner of the task can
+    //    still report a result, for example call an API callback with a "destroyed" status.
+    //  - RunNow() steals the task and runs its body on the calling thread if it hasn't started
+    //    yet, otherwise it waits for the task to complete. This is used when the result of an
+    //    asynchronous task is needed synchronously, for example by a synchronous pipeline creation.
+    // AsyncTask must not be used after its AsyncTaskManager is destroyed.
+    class AsyncTask final : public RefCounted {
+      public:
+        // Returns true if the task was cancelled before it started.
+        bool Cancel();
+        // Returns true if the body of the task ran, false if the task was cancelled.
+        bool RunNow();
+        void Wait();
+
+        // A task is complete when its body ran or when it was cancelled.
+        bool IsComplete();
+        bool IsCancelled();
+
+        AsyncTaskPriority GetPriority() const;
+
+      private:
+        friend class AsyncTaskManager;
+
+        enum class State {
+            Pending,
+            Running,
+            Cancelling,
+            Completed,
+            Cancelled,
+        };
+
+        AsyncTask(AsyncTaskManager* taskManager,
+                  AsyncTaskFunction body,
+                  AsyncTaskFunction cancelFunction,
+                  AsyncTaskPriority priority,
+                  uint64_t serial);
+        ~AsyncTask() override = default;
+
+        AsyncTaskManager* mTaskManager;
+        AsyncTaskFunction mBody;
+        AsyncTaskFunction mCancelFunction;
+        const AsyncTaskPriority mPriority;
+        const uint64_t mSerial;
+
+        // Protected by the mutex of mTaskManager.
+        State mState = State::Pending;
+    };
 
     class AsyncTaskManager {
       public:
         explicit AsyncTaskManager(dawn_platform::WorkerTaskPool* workerTaskPool);
+        ~AsyncTaskManager();
+
+        Ref<AsyncTask> PostTask(AsyncTaskFunction body,
+                                AsyncTaskPriority priority = AsyncTaskPriority::Normal,
+                                AsyncTaskFunction cancelFunction = nullptr);
 
-        void PostTask(AsyncTask asyncTask);
+        // Waits for all the posted tasks to complete.
         void WaitAllPendingTasks();
+        // Cancels all the posted tasks that haven't started yet and waits for the others to
+        // complete.
+        void CancelAllPendingTasks();
         bool HasPendingTasks();
 
       private:
-        class WaitableTask : public RefCounted {
-          public:
-            AsyncTask asyncTask;
-            AsyncTaskManager* taskManager;
-            std::unique_ptr<dawn_platform::WaitableEvent> waitableEvent;
+        friend class AsyncTask;
+
+        struct TaskOrder {
+            bool operator()(const Ref<AsyncTask>& a, const Ref<AsyncTask>& b) const;
         };
 
-        static void DoWaitableTask(void* task);
-        void HandleTaskCompletion(WaitableTask* task);
+        static void DoWorkerTask(void* taskManager);
+
+        bool CancelTask(AsyncTask* task);
+        bool RunTaskNow(AsyncTask* task);
+        void WaitTask(AsyncTask* task);
+        bool IsTaskComplete(AsyncTask* task);
+        bool IsTaskCancelled(AsyncTask* task);
+
+        // The task must have been moved to the Running state by the caller.
+        void RunTaskBody(AsyncTask* task);
+        // The task must have been moved to the Cancelling state by the caller.
+        void CancelTaskBody(AsyncTask* task);
+
+        std::mutex mMutex;
+        std::condition_variable mTaskCompletedCondition;
+
+        // Tasks waiting for a worker thread. Tasks that are cancelled or stolen with RunNow() stay
+        // in the queue and are skipped when the worker threads pop them.
+        std::priority_queue<Ref<AsyncTask>, std::vector<Ref<AsyncTask>>, TaskOrder> mQueuedTasks;
+        uint64_t mNextTaskSerial = 0;
+        // The number of tasks that aren't complete yet.
+        uint64_t mPendingTaskCount = 0;
+        // The number of calls to DoWorkerTask() that haven't returned yet. Each posted task
+        // triggers exactly one of them.
+        uint64_t mOutstandingWorkerTaskCount = 0;
 
-        std::mutex mPendingTasksMutex;
-        std::unordered_map<WaitableTask*, Ref<WaitableTask>> mPendingTasks;
         dawn_platform::WorkerTaskPool* mWorkerTaskPool;
     };
 
@@ -255,18 +255,17 @@ namespace dawn_native {
             return DAWN_VALIDATION_ERROR("numBindings mismatch");
         }
 
-        const BindGroupLayoutBase::BindingMap& bindingMap = descriptor->layout->GetBindingMap();
-        ASSERT(bindingMap.size() <= kMaxBindingsPerPipelineLayout);
+        ASSERT(descriptor->layout->GetBindingCount() <= kMaxBindingsPerPipelineLayoutTyped);
 
         ityp::bitset<BindingIndex, kMaxBindingsPerPipelineLayout> bindingsSet;
         for (uint32_t i = 0; i < descriptor->entryCount; ++i) {
             const BindGroupEntry& entry = descriptor->entries[i];
 
-            const auto& it = bindingMap.find(BindingNumber(entry.binding));
-            if (it == bindingMap.end()) {
+            BindingIndex bindingIndex =
+                descriptor->layout->FindBindingIndexOfEntry(i, BindingNumber(entry.binding));
+            if (bindingIndex == BindGroupLayoutBase::kInvalidBindingIndex) {
                 return DAWN_VALIDATION_ERROR("setting non-existent binding");
             }
-            BindingIndex bindingIndex = it->second;
             ASSERT(bindingIndex < descriptor->layout->GetBindingCount());
 
             if (bindingsSet[bindingIndex]) {
@@ -299,7 +298,7 @@ namespace dawn_native {
         //  - Each binding must be set at most once
         //
         // We don't validate the equality because it wouldn't be possible to cover it with a test.
-        ASSERT(bindingsSet.count() == bindingMap.size());
+        ASSERT(bindingsSet.count() == static_cast<uint32_t>(descriptor->layout->GetBindingCount()));
 
         return {};
     }  // anonymous namespace
@@ -322,7 +321,7 @@ namespace dawn_native {
             const BindGroupEntry& entry = descriptor->entries[i];
 
             BindingIndex bindingIndex =
-                descriptor->layout->GetBindingIndex(BindingNumber(entry.binding));
+                descriptor->layout->FindBindingIndexOfEntry(i, BindingNumber(entry.binding));
             ASSERT(bindingIndex < mLayout->GetBindingCount());
 
             // Only a single binding type should be set, so once we found it we can skip to the
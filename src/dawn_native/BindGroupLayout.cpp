@@ -361,6 +361,8 @@ namespace dawn_native {
 
     // BindGroupLayoutBase
 
+    constexpr BindingIndex BindGroupLayoutBase::kInvalidBindingIndex;
+
     BindGroupLayoutBase::BindGroupLayoutBase(DeviceBase* device,
                                              const BindGroupLayoutDescriptor* descriptor)
         : CachedObject(device, kLabelNotImplemented),
@@ -381,11 +383,27 @@ namespace dawn_native {
             }
             IncrementBindingCounts(&mBindingCounts, binding);
 
-            const auto& it = mBindingMap.emplace(BindingNumber(binding.binding), i);
-            ASSERT(it.second);
+            mBindingMap.emplace_back(BindingNumber(binding.binding), i);
         }
         ASSERT(CheckBufferBindingsFirst({mBindingInfo.data(), GetBindingCount()}));
         ASSERT(mBindingInfo.size() <= kMaxBindingsPerPipelineLayoutTyped);
+
+        std::sort(mBindingMap.begin(), mBindingMap.end());
+        ASSERT(std::adjacent_find(mBindingMap.begin(), mBindingMap.end(),
+                                  [](const auto& a, const auto& b) {
+                                      return a.first == b.first;
+                                  }) == mBindingMap.end());
+
+        // Binding numbers are usually small and dense, index them directly when the table
+        // doesn't get larger than the other per-layout arrays.
+        if (!mBindingMap.empty() &&
+            mBindingMap.back().first < BindingNumber(kMaxBindingsPerPipelineLayout)) {
+            mBindingIndexTable = ityp::vector<BindingNumber, BindingIndex>(
+                mBindingMap.back().first + BindingNumber(1), kInvalidBindingIndex);
+            for (const auto& it : mBindingMap) {
+                mBindingIndexTable[it.first] = it.second;
+            }
+        }
     }
 
     BindGroupLayoutBase::BindGroupLayoutBase(DeviceBase* device, ObjectBase::ErrorTag tag)
@@ -410,20 +428,45 @@ namespace dawn_native {
     }
 
     bool BindGroupLayoutBase::HasBinding(BindingNumber bindingNumber) const {
-        return mBindingMap.count(bindingNumber) != 0;
+        return FindBindingIndex(bindingNumber) != kInvalidBindingIndex;
     }
 
     BindingIndex BindGroupLayoutBase::GetBindingIndex(BindingNumber bindingNumber) const {
         ASSERT(!IsError());
-        const auto& it = mBindingMap.find(bindingNumber);
-        ASSERT(it != mBindingMap.end());
+        BindingIndex bindingIndex = FindBindingIndex(bindingNumber);
+        ASSERT(bindingIndex != kInvalidBindingIndex);
+        return bindingIndex;
+    }
+
+    BindingIndex BindGroupLayoutBase::FindBindingIndex(BindingNumber bindingNumber) const {
+        if (!mBindingIndexTable.empty()) {
+            if (bindingNumber >= mBindingIndexTable.size()) {
+                return kInvalidBindingIndex;
+            }
+            return mBindingIndexTable[bindingNumber];
+        }
+
+        auto it = std::lower_bound(
+            mBindingMap.begin(), mBindingMap.end(), bindingNumber,
+            [](const auto& entry, BindingNumber number) { return entry.first < number; });
+        if (it == mBindingMap.end() || it->first != bindingNumber) {
+            return kInvalidBindingIndex;
+        }
         return it->second;
     }
 
+    BindingIndex BindGroupLayoutBase::FindBindingIndexOfEntry(uint32_t entryIndex,
+                                                              BindingNumber bindingNumber) const {
+        if (entryIndex < mBindingMap.size() && mBindingMap[entryIndex].first == bindingNumber) {
+            return mBindingMap[entryIndex].second;
+        }
+        return FindBindingIndex(bindingNumber);
+    }
+
     size_t BindGroupLayoutBase::ComputeContentHash() {
         ObjectContentHasher recorder;
-        // std::map is sorted by key, so two BGLs constructed in different orders
-        // will still record the same.
+        // The binding map is sorted by BindingNumber, so two BGLs constructed in different
+        // orders will still record the same.
         for (const auto& it : mBindingMap) {
             recorder.Record(it.first, it.second);
 
@@ -28,7 +28,8 @@
 #include "dawn_native/dawn_platform.h"
 
 #include <bitset>
-#include <map>
+#include <utility>
+#include <vector>
 
 namespace dawn_native {
 
@@ -46,8 +47,12 @@ namespace dawn_native {
 
         static BindGroupLayoutBase* MakeError(DeviceBase* device);
 
-        // A map from the BindingNumber to its packed BindingIndex.
-        using BindingMap = std::map<BindingNumber, BindingIndex>;
+        // A map from the BindingNumber to its packed BindingIndex, sorted by BindingNumber.
+        using BindingMap = std::vector<std::pair<BindingNumber, BindingIndex>>;
+
+        // Returned by FindBindingIndex when the layout doesn't have the binding.
+        static constexpr BindingIndex kInvalidBindingIndex =
+            BindingIndex(std::numeric_limits<uint32_t>::max());
 
         const BindingInfo& GetBindingInfo(BindingIndex bindingIndex) const {
             ASSERT(!IsError());
@@ -57,6 +62,13 @@ namespace dawn_native {
         const BindingMap& GetBindingMap() const;
         bool HasBinding(BindingNumber bindingNumber) const;
         BindingIndex GetBindingIndex(BindingNumber bindingNumber) const;
+        // Like GetBindingIndex, but returns kInvalidBindingIndex if there is no such binding.
+        BindingIndex FindBindingIndex(BindingNumber bindingNumber) const;
+        // Like FindBindingIndex for the entry |entryIndex| of a BindGroupDescriptor. The entries
+        // are usually sorted by BindingNumber so the binding at the same position in the binding
+        // map is checked first.
+        BindingIndex FindBindingIndexOfEntry(uint32_t entryIndex,
+                                             BindingNumber bindingNumber) const;
 
         // Functions necessary for the unordered_set<BGLBase*>-based cache.
         size_t ComputeContentHash() override;
@@ -115,6 +127,11 @@ namespace dawn_native {
 
         // Map from BindGroupLayoutEntry.binding to packed indices.
         BindingMap mBindingMap;
+
+        // The BindingIndex of each BindingNumber, or kInvalidBindingIndex, so that bindings are
+        // found in constant time. It is only used when the largest BindingNumber is small enough
+        // for the table to stay compact, otherwise the bindings are searched in mBindingMap.
+        ityp::vector<BindingNumber, BindingIndex> mBindingIndexTable;
     };
 
 }  // namespace dawn_native
@@ -23,6 +23,112 @@
 
 namespace dawn_native {
 
+    // CommandBlockPool
+
+    constexpr size_t CommandBlockPool::kMinPooledBlockSize;
+    constexpr size_t CommandBlockPool::kMaxPooledBlockSize;
+
+    CommandBlockPool::~CommandBlockPool() {
+        for (SizeClass& sizeClass : mSizeClasses) {
+            ASSERT(sizeClass.inUseCount == 0);
+            for (uint8_t* block : sizeClass.freeBlocks) {
+                free(block);
+            }
+        }
+    }
+
+    uint8_t* CommandBlockPool::AllocateBlock(size_t minimumSize, size_t* blockSize) {
+        if (minimumSize > kMaxPooledBlockSize) {
+            uint8_t* block = static_cast<uint8_t*>(malloc(minimumSize));
+            if (DAWN_UNLIKELY(block == nullptr)) {
+                return nullptr;
+            }
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStats.systemAllocations++;
+            *blockSize = minimumSize;
+            return block;
+        }
+
+        uint32_t sizeClassIndex =
+            Log2Ceil(static_cast<uint64_t>(std::max(minimumSize, kMinPooledBlockSize))) -
+            ConstexprLog2(kMinPooledBlockSize);
+        *blockSize = kMinPooledBlockSize << sizeClassIndex;
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            SizeClass& sizeClass = mSizeClasses[sizeClassIndex];
+            sizeClass.inUseCount++;
+            sizeClass.highWaterMark = std::max(sizeClass.highWaterMark, sizeClass.inUseCount);
+
+            if (!sizeClass.freeBlocks.empty()) {
+                uint8_t* block = sizeClass.freeBlocks.back();
+                sizeClass.freeBlocks.pop_back();
+                mStats.recycledAllocations++;
+                mStats.cachedBlocks--;
+                mStats.cachedBytes -= *blockSize;
+                return block;
+            }
+            mStats.systemAllocations++;
+        }
+
+        // Allocate outside of the lock since it can be slow.
+        uint8_t* block = static_cast<uint8_t*>(malloc(*blockSize));
+        if (DAWN_UNLIKELY(block == nullptr)) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mSizeClasses[sizeClassIndex].inUseCount--;
+            mStats.systemAllocations--;
+        }
+        return block;
+    }
+
+    void CommandBlockPool::FreeBlocks(const CommandBlocks& blocks) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (const BlockDef& block : blocks) {
+            if (block.size > kMaxPooledBlockSize) {
+                free(block.block);
+                mStats.systemFrees++;
+                continue;
+            }
+
+            ASSERT(IsPowerOfTwo(block.size) && block.size >= kMinPooledBlockSize);
+            SizeClass& sizeClass =
+                mSizeClasses[Log2(static_cast<uint64_t>(block.size)) -
+                             ConstexprLog2(kMinPooledBlockSize)];
+            ASSERT(sizeClass.inUseCount > 0);
+            sizeClass.inUseCount--;
+            sizeClass.freeBlocks.push_back(block.block);
+            mStats.cachedBlocks++;
+            mStats.cachedBytes += block.size;
+        }
+    }
+
+    void CommandBlockPool::Trim() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (size_t i = 0; i < kSizeClassCount; ++i) {
+            SizeClass& sizeClass = mSizeClasses[i];
+            size_t blockSize = kMinPooledBlockSize << i;
+
+            // Keep the blocks that would have been needed to reach the high-water mark.
+            size_t keptBlockCount = sizeClass.highWaterMark - sizeClass.inUseCount;
+            while (sizeClass.freeBlocks.size() > keptBlockCount) {
+                free(sizeClass.freeBlocks.back());
+                sizeClass.freeBlocks.pop_back();
+                mStats.systemFrees++;
+                mStats.cachedBlocks--;
+                mStats.cachedBytes -= blockSize;
+            }
+            sizeClass.highWaterMark = sizeClass.inUseCount;
+        }
+    }
+
+    CommandBlockPoolStats CommandBlockPool::GetStats() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mStats;
+    }
+
+    // CommandIterator
+
     // TODO(cwallez@chromium.org): figure out a way to have more type safety for the iterator
 
     CommandIterator::CommandIterator() {
@@ -36,6 +142,7 @@ namespace dawn_native {
     CommandIterator::CommandIterator(CommandIterator&& other) {
         if (!other.IsEmpty()) {
             mBlocks = std::move(other.mBlocks);
+            mBlockPool = std::move(other.mBlockPool);
             other.Reset();
         }
         Reset();
@@ -44,19 +151,21 @@ namespace dawn_native {
     CommandIterator& CommandIterator::operator=(CommandIterator&& other) {
         ASSERT(IsEmpty());
         mBlocks = std::move(other.mBlocks);
+        mBlockPool = std::move(other.mBlockPool);
         other.Reset();
         Reset();
         return *this;
     }
 
     CommandIterator::CommandIterator(CommandAllocator&& allocator)
-        : mBlocks(allocator.AcquireBlocks()) {
+        : mBlocks(allocator.AcquireBlocks()), mBlockPool(allocator.mBlockPool) {
         Reset();
     }
 
     CommandIterator& CommandIterator::operator=(CommandAllocator&& allocator) {
         ASSERT(IsEmpty());
         mBlocks = allocator.AcquireBlocks();
+        mBlockPool = allocator.mBlockPool;
         Reset();
         return *this;
     }
@@ -92,8 +201,12 @@ namespace dawn_native {
             return;
         }
 
-        for (auto& block : mBlocks) {
-            free(block.block);
+        if (mBlockPool != nullptr) {
+            mBlockPool->FreeBlocks(mBlocks);
+        } else {
+            for (auto& block : mBlocks) {
+                free(block.block);
+            }
         }
         mBlocks.clear();
         Reset();
@@ -114,8 +227,11 @@ namespace dawn_native {
     //  - Better block allocation, maybe have Dawn API to say command buffer is going to have size
     //    close to another
 
-    CommandAllocator::CommandAllocator()
-        : mCurrentPtr(reinterpret_cast<uint8_t*>(&mDummyEnum[0])),
+    // CommandAllocator
+
+    CommandAllocator::CommandAllocator(CommandBlockPool* blockPool)
+        : mBlockPool(blockPool),
+          mCurrentPtr(reinterpret_cast<uint8_t*>(&mDummyEnum[0])),
           mEndPtr(reinterpret_cast<uint8_t*>(&mDummyEnum[1])) {
     }
 
@@ -162,14 +278,21 @@ namespace dawn_native {
         mLastAllocationSize =
             std::max(minimumSize, std::min(mLastAllocationSize * 2, size_t(16384)));
 
-        uint8_t* block = static_cast<uint8_t*>(malloc(mLastAllocationSize));
+        uint8_t* block;
+        size_t blockSize;
+        if (mBlockPool != nullptr) {
+            block = mBlockPool->AllocateBlock(mLastAllocationSize, &blockSize);
+        } else {
+            block = static_cast<uint8_t*>(malloc(mLastAllocationSize));
+            blockSize = mLastAllocationSize;
+        }
         if (DAWN_UNLIKELY(block == nullptr)) {
             return false;
         }
 
-        mBlocks.push_back({mLastAllocationSize, block});
+        mBlocks.push_back({blockSize, block});
         mCurrentPtr = AlignPtr(block, alignof(uint32_t));
-        mEndPtr = block + mLastAllocationSize;
+        mEndPtr = block + blockSize;
         return true;
     }
 
@@ -18,9 +18,13 @@
 #include "common/Assert.h"
 #include "common/Math.h"
 #include "common/NonCopyable.h"
+#include "common/RefCounted.h"
+#include "dawn_native/DawnNative.h"
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
 #include <vector>
 
 namespace dawn_native {
@@ -60,6 +64,46 @@ namespace dawn_native {
     };
     using CommandBlocks = std::vector<BlockDef>;
 
+    // CommandBlockPool recycles the blocks of the commands once they are destroyed, so that
+    // encoding many small command buffers doesn't allocate and free blocks with the system
+    // allocator each time. There is one pool per device shared by all the threads that encode or
+    // destroy commands, so it is protected by a mutex. It is refcounted because the commands can
+    // outlive the device.
+    //
+    // Blocks are pooled in power-of-two size classes, larger blocks are allocated and freed
+    // directly. Trim() frees the blocks that weren't needed since the previous call to Trim():
+    // each size class keeps only enough blocks to reach the high-water mark of its blocks in use
+    // since then.
+    class CommandBlockPool : public RefCounted {
+      public:
+        static constexpr size_t kMinPooledBlockSize = 4096;
+        static constexpr size_t kMaxPooledBlockSize = 16384;
+
+        // Returns a block of at least |minimumSize| bytes and stores its size in |blockSize|, or
+        // nullptr if the allocation failed.
+        uint8_t* AllocateBlock(size_t minimumSize, size_t* blockSize);
+        void FreeBlocks(const CommandBlocks& blocks);
+
+        void Trim();
+        CommandBlockPoolStats GetStats();
+
+      private:
+        ~CommandBlockPool() override;
+
+        static constexpr size_t kSizeClassCount =
+            ConstexprLog2(kMaxPooledBlockSize) - ConstexprLog2(kMinPooledBlockSize) + 1;
+
+        struct SizeClass {
+            std::vector<uint8_t*> freeBlocks;
+            size_t inUseCount = 0;
+            size_t highWaterMark = 0;
+        };
+
+        std::mutex mMutex;
+        std::array<SizeClass, kSizeClassCount> mSizeClasses;
+        CommandBlockPoolStats mStats;
+    };
+
     namespace detail {
         constexpr uint32_t kEndOfBlock = std::numeric_limits<uint32_t>::max();
         constexpr uint32_t kAdditionalData = std::numeric_limits<uint32_t>::max() - 1;
@@ -138,6 +182,8 @@ namespace dawn_native {
         }
 
         CommandBlocks mBlocks;
+        // The pool the blocks are returned to, if they were allocated from one.
+        Ref<CommandBlockPool> mBlockPool;
         uint8_t* mCurrentPtr = nullptr;
         size_t mCurrentBlock = 0;
         // Used to avoid a special case for empty iterators.
@@ -146,7 +192,8 @@ namespace dawn_native {
 
     class CommandAllocator : public NonCopyable {
       public:
-        CommandAllocator();
+        // The blocks are allocated from |blockPool| if it isn't null.
+        explicit CommandAllocator(CommandBlockPool* blockPool = nullptr);
         ~CommandAllocator();
 
         template <typename T, typename E>
@@ -238,6 +285,7 @@ namespace dawn_native {
         bool GetNewBlock(size_t minimumSize);
 
         CommandBlocks mBlocks;
+        Ref<CommandBlockPool> mBlockPool;
         size_t mLastAllocationSize = 2048;
 
         // Pointers to the current range of allocation in the block. Guaranteed to allow for at
@@ -0,0 +1,138 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_CONTENTLESSOBJECTCACHE_H_
+#define DAWNNATIVE_CONTENTLESSOBJECTCACHE_H_
+
+#include "common/Assert.h"
+#include "common/NonCopyable.h"
+#include "common/RefCounted.h"
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+
+namespace dawn_native {
+
+    // ContentLessObjectCache is a thread-safe cache of objects, looked up by the value of the
+    // objects instead of their pointer using the HashFunc and EqualityFunc of |Blueprint|.
+    // The cache doesn't hold references to the objects: they remove themselves from the cache
+    // with Erase() in their destructor.
+    //
+    // The cache is split in shards selected with the content hash so that lookups and insertions
+    // of different objects from different threads rarely contend on the same lock. Because the
+    // objects aren't referenced by the cache, a lookup can race with the last Release() of an
+    // object. Such objects are skipped using RefCounted::TryReference() and are replaced on
+    // insertion, which is why Erase() only removes the exact object passed to it.
+    //
+    // |Blueprint| is the type the lookups are done with. It defaults to |Object| but can be a base
+    // class of |Object| that isn't refcounted, like AttachmentStateBlueprint.
+    template <typename Object, typename Blueprint = Object, size_t kShardCount = 16>
+    class ContentLessObjectCache : public NonCopyable {
+      public:
+        ContentLessObjectCache() = default;
+        ~ContentLessObjectCache() {
+            ASSERT(Empty());
+        }
+
+        // Returns a reference to the live cached object equal to |blueprint|, or nullptr.
+        Ref<Object> Find(Blueprint* blueprint) {
+            Shard& shard = GetShard(blueprint);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            auto iter = shard.objects.find(blueprint);
+            if (iter == shard.objects.end()) {
+                return nullptr;
+            }
+            Object* object = static_cast<Object*>(*iter);
+            if (!object->TryReference()) {
+                return nullptr;
+            }
+            return AcquireRef(object);
+        }
+
+        // Inserts |object| in the cache unless a live object equal to it is already cached.
+        // Returns the cached object, and whether it is |object|.
+        std::pair<Ref<Object>, bool> Insert(Object* object) {
+            Shard& shard = GetShard(object);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            auto insertion = shard.objects.insert(object);
+            if (insertion.second) {
+                return {object, true};
+            }
+
+            Object* existing = static_cast<Object*>(*insertion.first);
+            ASSERT(existing != object);
+            if (existing->TryReference()) {
+                return {AcquireRef(existing), false};
+            }
+
+            // The existing object is being deleted and will call Erase() soon. Replace it so that
+            // lookups don't miss until then.
+            shard.objects.erase(insertion.first);
+            shard.objects.insert(object);
+            return {object, true};
+        }
+
+        // Removes |object| from the cache. Returns false if |object| isn't in the cache, which
+        // happens when it was replaced by Insert() while it was being deleted, or when it lost an
+        // insertion race against an equal object.
+        bool Erase(Object* object) {
+            Shard& shard = GetShard(object);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            auto iter = shard.objects.find(object);
+            if (iter == shard.objects.end() || *iter != object) {
+                return false;
+            }
+            shard.objects.erase(iter);
+            return true;
+        }
+
+        bool Empty() {
+            for (Shard& shard : mShards) {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                if (!shard.objects.empty()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+      private:
+        struct Shard {
+            std::mutex mutex;
+            std::unordered_set<Blueprint*,
+                               typename Blueprint::HashFunc,
+                               typename Blueprint::EqualityFunc>
+                objects;
+        };
+
+        Shard& GetShard(const Blueprint* blueprint) {
+            // The low bits of the hash also select the bucket inside the shard so mix in the high
+            // bits to keep the shards and their buckets evenly used.
+            size_t hash = typename Blueprint::HashFunc()(blueprint);
+            hash ^= hash >> (sizeof(size_t) * 4);
+            return mShards[hash % kShardCount];
+        }
+
+        std::array<Shard, kShardCount> mShards;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_CONTENTLESSOBJECTCACHE_H_
@@ -107,7 +107,8 @@ namespace dawn_native {
         size_t blueprintHash,
         WGPUCreateComputePipelineAsyncCallback callback,
         void* userdata)
-        : mComputePipeline(nonInitializedComputePipeline),
+        : mDevice(nonInitializedComputePipeline->GetDevice()),
+          mComputePipeline(nonInitializedComputePipeline),
           mBlueprintHash(blueprintHash),
           mCallback(callback),
           mUserdata(userdata),
@@ -137,22 +138,65 @@ namespace dawn_native {
         }
 
         mComputeShaderModule = nullptr;
-        mComputePipeline->GetDevice()->AddComputePipelineAsyncCallbackTask(
-            mComputePipeline, errorMessage, mCallback, mUserdata, mBlueprintHash);
-    }
-
-    void CreateComputePipelineAsyncTask::RunAsync(
-        std::unique_ptr<CreateComputePipelineAsyncTask> task) {
-        DeviceBase* device = task->mComputePipeline->GetDevice();
-
-        // Using "taskPtr = std::move(task)" causes compilation error while it should be supported
-        // since C++14:
-        // https://docs.microsoft.com/en-us/cpp/cpp/lambda-expressions-in-cpp?view=msvc-160
-        auto asyncTask = [taskPtr = task.release()] {
-            std::unique_ptr<CreateComputePipelineAsyncTask> innnerTaskPtr(taskPtr);
-            innnerTaskPtr->Run();
-        };
-        device->GetAsyncTaskManager()->PostTask(std::move(asyncTask));
+        ReportResult(errorMessage);
+    }
+
+    void CreateComputePipelineAsyncTask::ReportCancellation() {
+        // The callback tasks are handled as a shutdown or a device loss by the device.
+        mComputePipeline = nullptr;
+        mComputeShaderModule = nullptr;
+        ReportResult("Pipeline creation cancelled");
+    }
+
+    void CreateComputePipelineAsyncTask::ReportResult(const std::string& errorMessage) {
+        std::vector<JoinedCallback> joinedCallbacks;
+        {
+            std::lock_guard<std::mutex> lock(mJoinedCallbacksMutex);
+            mIsResultReported = true;
+            joinedCallbacks.swap(mJoinedCallbacks);
+        }
+
+        mDevice->AddComputePipelineAsyncCallbackTask(mComputePipeline, errorMessage, mCallback,
+                                                     mUserdata, mBlueprintHash);
+        for (const JoinedCallback& joined : joinedCallbacks) {
+            mDevice->AddComputePipelineAsyncCallbackTask(mComputePipeline, errorMessage,
+                                                         joined.callback, joined.userdata,
+                                                         mBlueprintHash);
+        }
+    }
+
+    bool CreateComputePipelineAsyncTask::AddJoinedCallback(
+        WGPUCreateComputePipelineAsyncCallback callback,
+        void* userdata) {
+        std::lock_guard<std::mutex> lock(mJoinedCallbacksMutex);
+        if (mIsResultReported) {
+            return false;
+        }
+        mJoinedCallbacks.push_back({callback, userdata});
+        return true;
+    }
+
+    ComputePipelineBase* CreateComputePipelineAsyncTask::GetComputePipeline() const {
+        return mComputePipeline.Get();
+    }
+
+    Ref<AsyncTask> CreateComputePipelineAsyncTask::RunAsync(
+        std::unique_ptr<CreateComputePipelineAsyncTask> task,
+        AsyncTaskPriority priority) {
+        DeviceBase* device = task->mDevice;
+        Ref<ComputePipelineBase> pipeline = task->mComputePipeline;
+        size_t blueprintHash = task->mBlueprintHash;
+
+        // The task is shared with the pending creation record of the device, which reads the
+        // result after stealing the task.
+        std::shared_ptr<CreateComputePipelineAsyncTask> sharedTask = std::move(task);
+        Ref<AsyncTask> asyncTask = device->GetAsyncTaskManager()->PostTask(
+            [sharedTask] { sharedTask->Run(); }, priority,
+            [sharedTask] { sharedTask->ReportCancellation(); });
+
+        device->TrackPendingComputePipelineCreation(std::move(pipeline), blueprintHash,
+                                                    std::move(sharedTask), asyncTask);
+        return asyncTask;
     }
 
 }  // namespace dawn_native
@@ -17,9 +17,14 @@
 
 #include "common/RefCounted.h"
 #include "dawn/webgpu.h"
+#include "dawn_native/AsyncTask.h"
 #include "dawn_native/CallbackTaskManager.h"
 #include "dawn_native/Error.h"
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace dawn_native {
 
     class ComputePipelineBase;
@@ -83,10 +88,26 @@ namespace dawn_native {
 
         virtual ~CreateComputePipelineAsyncTask() = default;
         void Run();
+        // Called instead of Run() when the task is cancelled before it starts, for example when
+        // the device is destroyed. The callback is then called with the status of the device.
+        void ReportCancellation();
+
+        // Returns the initialized pipeline after Run() completed, or nullptr if it failed or was
+        // cancelled.
+        ComputePipelineBase* GetComputePipeline() const;
+
+        // Makes the task also report its result to |callback|, for asynchronous creations of the
+        // same pipeline requested while this one is in flight. Returns false if the task already
+        // reported its result, in which case |callback| won't be called.
+        bool AddJoinedCallback(WGPUCreateComputePipelineAsyncCallback callback, void* userdata);
 
-        static void RunAsync(std::unique_ptr<CreateComputePipelineAsyncTask> task);
+        // Posts the task to the AsyncTaskManager of the device and records it as a pending
+        // creation so that a synchronous creation of the same pipeline can steal it.
+        static Ref<AsyncTask> RunAsync(std::unique_ptr<CreateComputePipelineAsyncTask> task,
+                                       AsyncTaskPriority priority = AsyncTaskPriority::Normal);
 
       protected:
+        DeviceBase* mDevice;
         Ref<ComputePipelineBase> mComputePipeline;
         size_t mBlueprintHash;
         WGPUCreateComputePipelineAsyncCallback mCallback;
@@ -96,6 +117,20 @@ namespace dawn_native {
         Ref<PipelineLayoutBase> mLayout;
         std::string mEntryPoint;
         Ref<ShaderModuleBase> mComputeShaderModule;
+
+      private:
+        struct JoinedCallback {
+            WGPUCreateComputePipelineAsyncCallback callback;
+            void* userdata;
+        };
+
+        void ReportResult(const std::string& errorMessage);
+
+        // Callbacks are joined from the device thread while the task may be running on a worker
+        // thread.
+        std::mutex mJoinedCallbacksMutex;
+        std::vector<JoinedCallback> mJoinedCallbacks;
+        bool mIsResultReported = false;
     };
 
 }  // namespace dawn_native
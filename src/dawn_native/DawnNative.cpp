@@ -15,8 +15,11 @@
 #include "dawn_native/DawnNative.h"
 
 #include "dawn_native/Buffer.h"
+#include "dawn_native/CommandAllocator.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/DynamicUploader.h"
 #include "dawn_native/Instance.h"
+#include "dawn_native/PersistentCache.h"
 #include "dawn_native/Texture.h"
 #include "dawn_platform/DawnPlatform.h"
 
@@ -192,6 +195,26 @@ namespace dawn_native {
         return deviceBase->GetDeprecationWarningCountForTesting();
     }
 
+    PipelineCreationStats GetPipelineCreationStats(WGPUDevice device) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        return deviceBase->GetPipelineCreationStats();
+    }
+
+    CommandBlockPoolStats GetCommandBlockPoolStats(WGPUDevice device) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        return deviceBase->GetCommandBlockPool()->GetStats();
+    }
+
+    PersistentCacheStats GetPersistentCacheStats(WGPUDevice device) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        return deviceBase->GetPersistentCache()->GetStats();
+    }
+
+    DynamicUploaderStats GetDynamicUploaderStats(WGPUDevice device) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        return deviceBase->GetDynamicUploader()->GetStats();
+    }
+
     bool IsTextureSubresourceInitialized(WGPUTexture cTexture,
                                          uint32_t baseMipLevel,
                                          uint32_t levelCount,
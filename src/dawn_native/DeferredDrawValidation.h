@@ -0,0 +1,132 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_DEFERREDDRAWVALIDATION_H_
+#define DAWNNATIVE_DEFERREDDRAWVALIDATION_H_
+
+#include "dawn_native/Error.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace dawn_native {
+
+    // Records the Draw and DrawIndexed calls made with the same pass state (pipeline, bind
+    // groups, vertex and index buffers) so that they can be validated once, before the state
+    // changes, instead of at each call.
+    //
+    // The validation of a draw depends either only on the state, or on a value of the draw being
+    // over a limit given by the state (the end of the vertex, instance or index range) or not
+    // being zero (the first instance and the base vertex, for the toggles that disallow them). So
+    // the first invalid draw is always one of the first draw, the first indexed draw, the first
+    // draw with a non-zero first instance or base vertex, or a draw that increases the maximum
+    // end of a range. Only these candidates are kept, and validating them in order with the
+    // regular per-draw validation returns the same error as validating all the draws would.
+    class DeferredDrawValidation {
+      public:
+        struct Draw {
+            bool indexed;
+            uint32_t count;  // The vertex count, or the index count for indexed draws.
+            uint32_t instanceCount;
+            uint32_t first;  // The first vertex, or the first index for indexed draws.
+            int32_t baseVertex;
+            uint32_t firstInstance;
+        };
+
+        void RecordDraw(uint32_t vertexCount,
+                        uint32_t instanceCount,
+                        uint32_t firstVertex,
+                        uint32_t firstInstance) {
+            uint64_t vertexEnd = uint64_t(firstVertex) + vertexCount;
+            uint64_t instanceEnd = uint64_t(firstInstance) + instanceCount;
+
+            bool isCandidate = mCandidates.empty() || vertexEnd > mMaxVertexEnd ||
+                               instanceEnd > mMaxInstanceEnd ||
+                               (firstInstance != 0 && !mHasNonZeroFirstInstance);
+            if (isCandidate) {
+                mCandidates.push_back(
+                    {false, vertexCount, instanceCount, firstVertex, 0, firstInstance});
+                mMaxVertexEnd = std::max(mMaxVertexEnd, vertexEnd);
+                mMaxInstanceEnd = std::max(mMaxInstanceEnd, instanceEnd);
+                mHasNonZeroFirstInstance |= firstInstance != 0;
+            }
+        }
+
+        void RecordDrawIndexed(uint32_t indexCount,
+                               uint32_t instanceCount,
+                               uint32_t firstIndex,
+                               int32_t baseVertex,
+                               uint32_t firstInstance) {
+            uint64_t indexEnd = uint64_t(firstIndex) + indexCount;
+            uint64_t instanceEnd = uint64_t(firstInstance) + instanceCount;
+
+            bool isCandidate = !mHasIndexedDraw || indexEnd > mMaxIndexEnd ||
+                               instanceEnd > mMaxInstanceEnd ||
+                               (firstInstance != 0 && !mHasNonZeroFirstInstance) ||
+                               (baseVertex != 0 && !mHasNonZeroBaseVertex);
+            if (isCandidate) {
+                mCandidates.push_back(
+                    {true, indexCount, instanceCount, firstIndex, baseVertex, firstInstance});
+                mHasIndexedDraw = true;
+                mMaxIndexEnd = std::max(mMaxIndexEnd, indexEnd);
+                mMaxInstanceEnd = std::max(mMaxInstanceEnd, instanceEnd);
+                mHasNonZeroFirstInstance |= firstInstance != 0;
+                mHasNonZeroBaseVertex |= baseVertex != 0;
+            }
+        }
+
+        bool HasPendingDraws() const {
+            return !mCandidates.empty();
+        }
+
+        // Validates the recorded draws with |validateDraw|, which must be called with the state
+        // they were recorded with, and starts recording a new set of draws.
+        template <typename ValidateDrawFn>
+        MaybeError Validate(ValidateDrawFn&& validateDraw) {
+            for (const Draw& draw : mCandidates) {
+                MaybeError error = validateDraw(draw);
+                if (error.IsError()) {
+                    Reset();
+                    return error;
+                }
+            }
+            Reset();
+            return {};
+        }
+
+        // Drops the recorded draws without validating them.
+        void Reset() {
+            mCandidates.clear();
+            mMaxVertexEnd = 0;
+            mMaxInstanceEnd = 0;
+            mMaxIndexEnd = 0;
+            mHasIndexedDraw = false;
+            mHasNonZeroFirstInstance = false;
+            mHasNonZeroBaseVertex = false;
+        }
+
+      private:
+        std::vector<Draw> mCandidates;
+        uint64_t mMaxVertexEnd = 0;
+        uint64_t mMaxInstanceEnd = 0;
+        uint64_t mMaxIndexEnd = 0;
+        bool mHasIndexedDraw = false;
+        bool mHasNonZeroFirstInstance = false;
+        bool mHasNonZeroBaseVertex = false;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_DEFERREDDRAWVALIDATION_H_
@@ -21,10 +21,12 @@
 #include "dawn_native/BindGroup.h"
 #include "dawn_native/BindGroupLayout.h"
 #include "dawn_native/Buffer.h"
+#include "dawn_native/CommandAllocator.h"
 #include "dawn_native/CommandBuffer.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/CompilationMessages.h"
 #include "dawn_native/ComputePipeline.h"
+#include "dawn_native/ContentLessObjectCache.h"
 #include "dawn_native/CreatePipelineAsyncTask.h"
 #include "dawn_native/DynamicUploader.h"
 #include "dawn_native/ErrorData.h"
@@ -46,30 +48,17 @@
 #include "dawn_native/ValidationUtils_autogen.h"
 #include "dawn_platform/DawnPlatform.h"
 
+#include <unordered_map>
 #include <unordered_set>
 
 namespace dawn_native {
 
     // DeviceBase sub-structures
 
-    // The caches are unordered_sets of pointers with special hash and compare functions
-    // to compare the value of the objects, instead of the pointers.
-    template <typename Object>
-    using ContentLessObjectCache =
-        std::unordered_set<Object*, typename Object::HashFunc, typename Object::EqualityFunc>;
-
+    // The caches are sharded and thread-safe so that they can be used from the worker threads
+    // that create objects asynchronously.
     struct DeviceBase::Caches {
-        ~Caches() {
-            ASSERT(attachmentStates.empty());
-            ASSERT(bindGroupLayouts.empty());
-            ASSERT(computePipelines.empty());
-            ASSERT(pipelineLayouts.empty());
-            ASSERT(renderPipelines.empty());
-            ASSERT(samplers.empty());
-            ASSERT(shaderModules.empty());
-        }
-
-        ContentLessObjectCache<AttachmentStateBlueprint> attachmentStates;
+        ContentLessObjectCache<AttachmentState, AttachmentStateBlueprint> attachmentStates;
         ContentLessObjectCache<BindGroupLayoutBase> bindGroupLayouts;
         ContentLessObjectCache<ComputePipelineBase> computePipelines;
         ContentLessObjectCache<PipelineLayoutBase> pipelineLayouts;
@@ -78,6 +67,18 @@ namespace dawn_native {
         ContentLessObjectCache<ShaderModuleBase> shaderModules;
     };
 
+    struct DeviceBase::PendingComputePipelineCreation {
+        // The non-initialized pipeline, used to compare with blueprints.
+        Ref<ComputePipelineBase> pipeline;
+        std::shared_ptr<CreateComputePipelineAsyncTask> createTask;
+        Ref<AsyncTask> asyncTask;
+    };
+
+    struct DeviceBase::PendingPipelineCreations {
+        // Keyed by blueprint hash. Entries with the same hash are compared by content.
+        std::unordered_multimap<size_t, PendingComputePipelineCreation> computePipelines;
+    };
+
     struct DeviceBase::DeprecationWarnings {
         std::unordered_set<std::string> emitted;
         size_t count = 0;
@@ -173,9 +174,11 @@ namespace dawn_native {
 #endif  // DAWN_ENABLE_ASSERTS
 
         mCaches = std::make_unique<DeviceBase::Caches>();
+        mPendingPipelineCreations = std::make_unique<DeviceBase::PendingPipelineCreations>();
         mErrorScopeStack = std::make_unique<ErrorScopeStack>();
         mDynamicUploader = std::make_unique<DynamicUploader>(this);
         mCallbackTaskManager = std::make_unique<CallbackTaskManager>();
+        mCommandBlockPool = AcquireRef(new CommandBlockPool());
         mDeprecationWarnings = std::make_unique<DeprecationWarnings>();
         mInternalPipelineStore = std::make_unique<InternalPipelineStore>();
         mPersistentCache = std::make_unique<PersistentCache>(this);
@@ -196,9 +199,11 @@ namespace dawn_native {
     void DeviceBase::ShutDownBase() {
         // Skip handling device facilities if they haven't even been created (or failed doing so)
         if (mState != State::BeingCreated) {
-            // Call all the callbacks immediately as the device is about to shut down.
-            // TODO(crbug.com/dawn/826): Cancel the tasks that are in flight if possible.
-            mAsyncTaskManager->WaitAllPendingTasks();
+            // Call all the callbacks immediately as the device is about to shut down. The tasks
+            // that haven't started are cancelled, their callbacks are called with the shutdown
+            // status like the ones of the tasks that completed.
+            mAsyncTaskManager->CancelAllPendingTasks();
+            mPendingPipelineCreations->computePipelines.clear();
             auto callbackTasks = mCallbackTaskManager->AcquireCallbackTasks();
             for (std::unique_ptr<CallbackTask>& callbackTask : callbackTasks) {
                 callbackTask->HandleShutDown();
@@ -249,6 +254,7 @@ namespace dawn_native {
         mDynamicUploader = nullptr;
         mCallbackTaskManager = nullptr;
         mAsyncTaskManager = nullptr;
+        mPendingPipelineCreations = nullptr;
         mPersistentCache = nullptr;
 
         mEmptyBindGroupLayout = nullptr;
@@ -300,8 +306,8 @@ namespace dawn_native {
 
             mQueue->HandleDeviceLoss();
 
-            // TODO(crbug.com/dawn/826): Cancel the tasks that are in flight if possible.
-            mAsyncTaskManager->WaitAllPendingTasks();
+            mAsyncTaskManager->CancelAllPendingTasks();
+            mPendingPipelineCreations->computePipelines.clear();
             auto callbackTasks = mCallbackTaskManager->AcquireCallbackTasks();
             for (std::unique_ptr<CallbackTask>& callbackTask : callbackTasks) {
                 callbackTask->HandleDeviceLoss();
@@ -526,15 +532,12 @@ namespace dawn_native {
         const size_t blueprintHash = blueprint.ComputeContentHash();
         blueprint.SetContentHash(blueprintHash);
 
-        Ref<BindGroupLayoutBase> result;
-        auto iter = mCaches->bindGroupLayouts.find(&blueprint);
-        if (iter != mCaches->bindGroupLayouts.end()) {
-            result = *iter;
-        } else {
+        Ref<BindGroupLayoutBase> result = mCaches->bindGroupLayouts.Find(&blueprint);
+        if (result == nullptr) {
             DAWN_TRY_ASSIGN(result, CreateBindGroupLayoutImpl(descriptor));
             result->SetIsCachedReference();
             result->SetContentHash(blueprintHash);
-            mCaches->bindGroupLayouts.insert(result.Get());
+            result = mCaches->bindGroupLayouts.Insert(result.Get()).first;
         }
 
         return std::move(result);
@@ -542,8 +545,7 @@ namespace dawn_native {
 
     void DeviceBase::UncacheBindGroupLayout(BindGroupLayoutBase* obj) {
         ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->bindGroupLayouts.erase(obj);
-        ASSERT(removedCount == 1);
+        mCaches->bindGroupLayouts.Erase(obj);
     }
 
     // Private function used at initialization
@@ -567,11 +569,7 @@ namespace dawn_native {
         const size_t blueprintHash = blueprint.ComputeContentHash();
         blueprint.SetContentHash(blueprintHash);
 
-        Ref<ComputePipelineBase> result;
-        auto iter = mCaches->computePipelines.find(&blueprint);
-        if (iter != mCaches->computePipelines.end()) {
-            result = *iter;
-        }
+        Ref<ComputePipelineBase> result = mCaches->computePipelines.Find(&blueprint);
 
         return std::make_pair(result, blueprintHash);
     }
@@ -583,11 +581,7 @@ namespace dawn_native {
         const size_t blueprintHash = blueprint.ComputeContentHash();
         blueprint.SetContentHash(blueprintHash);
 
-        Ref<RenderPipelineBase> result;
-        auto iter = mCaches->renderPipelines.find(&blueprint);
-        if (iter != mCaches->renderPipelines.end()) {
-            result = *iter;
-        }
+        Ref<RenderPipelineBase> result = mCaches->renderPipelines.Find(&blueprint);
 
         return std::make_pair(result, blueprintHash);
     }
@@ -595,33 +589,127 @@ namespace dawn_native {
     Ref<ComputePipelineBase> DeviceBase::AddOrGetCachedComputePipeline(
         Ref<ComputePipelineBase> computePipeline,
         size_t blueprintHash) {
+        // The pipeline may already have been cached when a synchronous creation joined its
+        // asynchronous creation.
+        if (computePipeline->IsCachedReference()) {
+            return computePipeline;
+        }
         computePipeline->SetContentHash(blueprintHash);
-        auto insertion = mCaches->computePipelines.insert(computePipeline.Get());
+        auto insertion = mCaches->computePipelines.Insert(computePipeline.Get());
         if (insertion.second) {
             computePipeline->SetIsCachedReference();
-            return computePipeline;
-        } else {
-            return *(insertion.first);
         }
+        return std::move(insertion.first);
     }
 
     Ref<RenderPipelineBase> DeviceBase::AddOrGetCachedRenderPipeline(
         Ref<RenderPipelineBase> renderPipeline,
         size_t blueprintHash) {
         renderPipeline->SetContentHash(blueprintHash);
-        auto insertion = mCaches->renderPipelines.insert(renderPipeline.Get());
+        auto insertion = mCaches->renderPipelines.Insert(renderPipeline.Get());
         if (insertion.second) {
             renderPipeline->SetIsCachedReference();
-            return renderPipeline;
-        } else {
-            return *(insertion.first);
+        }
+        return std::move(insertion.first);
+    }
+
+    void DeviceBase::TrackPendingComputePipelineCreation(
+        Ref<ComputePipelineBase> pipeline,
+        size_t blueprintHash,
+        std::shared_ptr<CreateComputePipelineAsyncTask> createTask,
+        Ref<AsyncTask> asyncTask) {
+        mPendingPipelineCreations->computePipelines.emplace(
+            blueprintHash, PendingComputePipelineCreation{std::move(pipeline),
+                                                          std::move(createTask),
+                                                          std::move(asyncTask)});
+    }
+
+    DeviceBase::PendingComputePipelineCreation* DeviceBase::FindPendingComputePipelineCreation(
+        const ComputePipelineDescriptor* descriptor,
+        size_t blueprintHash) {
+        auto range = mPendingPipelineCreations->computePipelines.equal_range(blueprintHash);
+        if (range.first == range.second) {
+            return nullptr;
+        }
+
+        ComputePipelineBase blueprint(this, descriptor);
+        for (auto iter = range.first; iter != range.second; ++iter) {
+            if (ComputePipelineBase::EqualityFunc()(&blueprint, iter->second.pipeline.Get())) {
+                return &iter->second;
+            }
+        }
+        return nullptr;
+    }
+
+    Ref<ComputePipelineBase> DeviceBase::JoinPendingComputePipelineCreation(
+        const ComputePipelineDescriptor* descriptor,
+        size_t blueprintHash) {
+        PendingComputePipelineCreation* creation =
+            FindPendingComputePipelineCreation(descriptor, blueprintHash);
+        if (creation == nullptr) {
+            return nullptr;
+        }
+
+        // Run the task on this thread if it hasn't started yet, otherwise wait for it.
+        if (!creation->asyncTask->RunNow()) {
+            return nullptr;
+        }
+        // On failure, let the caller compile the pipeline again to produce the error.
+        ComputePipelineBase* result = creation->createTask->GetComputePipeline();
+        if (result == nullptr) {
+            return nullptr;
+        }
+        return AddOrGetCachedComputePipeline(result, blueprintHash);
+    }
+
+    bool DeviceBase::JoinPendingComputePipelineCreationAsync(
+        const ComputePipelineDescriptor* descriptor,
+        size_t blueprintHash,
+        WGPUCreateComputePipelineAsyncCallback callback,
+        void* userdata) {
+        PendingComputePipelineCreation* creation =
+            FindPendingComputePipelineCreation(descriptor, blueprintHash);
+        if (creation == nullptr) {
+            return false;
+        }
+
+        if (creation->createTask->AddJoinedCallback(callback, userdata)) {
+            return true;
+        }
+
+        // The task already reported its result but its callback tasks may not have been flushed
+        // yet. Use the result directly like for a cache hit if the creation succeeded.
+        creation->asyncTask->Wait();
+        if (creation->asyncTask->IsCancelled()) {
+            return false;
+        }
+        ComputePipelineBase* result = creation->createTask->GetComputePipeline();
+        if (result == nullptr) {
+            return false;
+        }
+        Ref<ComputePipelineBase> cachedPipeline =
+            AddOrGetCachedComputePipeline(result, blueprintHash);
+        callback(WGPUCreatePipelineAsyncStatus_Success,
+                 reinterpret_cast<WGPUComputePipeline>(cachedPipeline.Detach()), "", userdata);
+        return true;
+    }
+
+    void DeviceBase::RemoveCompletedPendingPipelineCreations() {
+        // Completed creations have already queued their callback task, which caches the pipeline
+        // or reports the error, so they don't need to be joined anymore.
+        auto& computePipelines = mPendingPipelineCreations->computePipelines;
+        for (auto iter = computePipelines.begin(); iter != computePipelines.end();) {
+            if (iter->second.asyncTask->IsComplete()) {
+                iter = computePipelines.erase(iter);
+            } else {
+                ++iter;
+            }
         }
     }
 
     void DeviceBase::UncacheComputePipeline(ComputePipelineBase* obj) {
         ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->computePipelines.erase(obj);
-        ASSERT(removedCount == 1);
+        mCaches->computePipelines.Erase(obj);
     }
 
     ResultOrError<Ref<PipelineLayoutBase>> DeviceBase::GetOrCreatePipelineLayout(
@@ -631,15 +719,12 @@ namespace dawn_native {
         const size_t blueprintHash = blueprint.ComputeContentHash();
         blueprint.SetContentHash(blueprintHash);
 
-        Ref<PipelineLayoutBase> result;
-        auto iter = mCaches->pipelineLayouts.find(&blueprint);
-        if (iter != mCaches->pipelineLayouts.end()) {
-            result = *iter;
-        } else {
+        Ref<PipelineLayoutBase> result = mCaches->pipelineLayouts.Find(&blueprint);
+        if (result == nullptr) {
             DAWN_TRY_ASSIGN(result, CreatePipelineLayoutImpl(descriptor));
             result->SetIsCachedReference();
             result->SetContentHash(blueprintHash);
-            mCaches->pipelineLayouts.insert(result.Get());
+            result = mCaches->pipelineLayouts.Insert(result.Get()).first;
         }
 
         return std::move(result);
@@ -647,14 +732,12 @@ namespace dawn_native {
 
     void DeviceBase::UncachePipelineLayout(PipelineLayoutBase* obj) {
         ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->pipelineLayouts.erase(obj);
-        ASSERT(removedCount == 1);
+        mCaches->pipelineLayouts.Erase(obj);
     }
 
     void DeviceBase::UncacheRenderPipeline(RenderPipelineBase* obj) {
         ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->renderPipelines.erase(obj);
-        ASSERT(removedCount == 1);
+        mCaches->renderPipelines.Erase(obj);
     }
 
     ResultOrError<Ref<SamplerBase>> DeviceBase::GetOrCreateSampler(
@@ -664,15 +747,12 @@ namespace dawn_native {
         const size_t blueprintHash = blueprint.ComputeContentHash();
         blueprint.SetContentHash(blueprintHash);
 
-        Ref<SamplerBase> result;
-        auto iter = mCaches->samplers.find(&blueprint);
-        if (iter != mCaches->samplers.end()) {
-            result = *iter;
-        } else {
+        Ref<SamplerBase> result = mCaches->samplers.Find(&blueprint);
+        if (result == nullptr) {
             DAWN_TRY_ASSIGN(result, CreateSamplerImpl(descriptor));
             result->SetIsCachedReference();
             result->SetContentHash(blueprintHash);
-            mCaches->samplers.insert(result.Get());
+            result = mCaches->samplers.Insert(result.Get()).first;
         }
 
         return std::move(result);
@@ -680,8 +760,7 @@ namespace dawn_native {
 
     void DeviceBase::UncacheSampler(SamplerBase* obj) {
         ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->samplers.erase(obj);
-        ASSERT(removedCount == 1);
+        mCaches->samplers.Erase(obj);
     }
 
     ResultOrError<Ref<ShaderModuleBase>> DeviceBase::GetOrCreateShaderModule(
@@ -695,11 +774,8 @@ namespace dawn_native {
         const size_t blueprintHash = blueprint.ComputeContentHash();
         blueprint.SetContentHash(blueprintHash);
 
-        Ref<ShaderModuleBase> result;
-        auto iter = mCaches->shaderModules.find(&blueprint);
-        if (iter != mCaches->shaderModules.end()) {
-            result = *iter;
-        } else {
+        Ref<ShaderModuleBase> result = mCaches->shaderModules.Find(&blueprint);
+        if (result == nullptr) {
             if (!parseResult->HasParsedShader()) {
                 // We skip the parse on creation if validation isn't enabled which let's us quickly
                 // lookup in the cache without validating and parsing. We need the parsed module
@@ -712,7 +788,7 @@ namespace dawn_native {
             DAWN_TRY_ASSIGN(result, CreateShaderModuleImpl(descriptor, parseResult));
             result->SetIsCachedReference();
             result->SetContentHash(blueprintHash);
-            mCaches->shaderModules.insert(result.Get());
+            result = mCaches->shaderModules.Insert(result.Get()).first;
         }
 
         return std::move(result);
@@ -720,22 +796,20 @@ namespace dawn_native {
 
     void DeviceBase::UncacheShaderModule(ShaderModuleBase* obj) {
         ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->shaderModules.erase(obj);
-        ASSERT(removedCount == 1);
+        mCaches->shaderModules.Erase(obj);
     }
 
     Ref<AttachmentState> DeviceBase::GetOrCreateAttachmentState(
         AttachmentStateBlueprint* blueprint) {
-        auto iter = mCaches->attachmentStates.find(blueprint);
-        if (iter != mCaches->attachmentStates.end()) {
-            return static_cast<AttachmentState*>(*iter);
+        Ref<AttachmentState> result = mCaches->attachmentStates.Find(blueprint);
+        if (result != nullptr) {
+            return result;
         }
 
         Ref<AttachmentState> attachmentState = AcquireRef(new AttachmentState(this, *blueprint));
         attachmentState->SetIsCachedReference();
         attachmentState->SetContentHash(attachmentState->ComputeContentHash());
-        mCaches->attachmentStates.insert(attachmentState.Get());
-        return attachmentState;
+        return mCaches->attachmentStates.Insert(attachmentState.Get()).first;
     }
 
     Ref<AttachmentState> DeviceBase::GetOrCreateAttachmentState(
@@ -758,8 +832,7 @@ namespace dawn_native {
 
     void DeviceBase::UncacheAttachmentState(AttachmentState* obj) {
         ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->attachmentStates.erase(obj);
-        ASSERT(removedCount == 1);
+        mCaches->attachmentStates.Erase(obj);
     }
 
     // Object creation API methods
@@ -940,6 +1013,10 @@ namespace dawn_native {
         // We have to check callback tasks in every Tick because it is not related to any global
         // serials.
         FlushCallbackTaskQueue();
+        RemoveCompletedPendingPipelineCreations();
+
+        // Release the command blocks that weren't needed since the last Tick.
+        mCommandBlockPool->Trim();
 
         return {};
     }
@@ -995,6 +1072,10 @@ namespace dawn_native {
         ++mLazyClearCountForTesting;
     }
 
+    PipelineCreationStats DeviceBase::GetPipelineCreationStats() const {
+        return mPipelineCreationStats;
+    }
+
     size_t DeviceBase::GetDeprecationWarningCountForTesting() {
         return mDeprecationWarnings->count;
     }
@@ -1093,12 +1174,22 @@ namespace dawn_native {
 
         auto pipelineAndBlueprintFromCache = GetCachedComputePipeline(&appliedDescriptor);
         if (pipelineAndBlueprintFromCache.first.Get() != nullptr) {
+            mPipelineCreationStats.cacheHits++;
             return std::move(pipelineAndBlueprintFromCache.first);
         }
+        size_t blueprintHash = pipelineAndBlueprintFromCache.second;
+
+        // Reuse the result of an asynchronous creation of the same pipeline if there is one.
+        Ref<ComputePipelineBase> pendingResult =
+            JoinPendingComputePipelineCreation(&appliedDescriptor, blueprintHash);
+        if (pendingResult != nullptr) {
+            mPipelineCreationStats.pendingCreationJoins++;
+            return std::move(pendingResult);
+        }
 
+        mPipelineCreationStats.cacheMisses++;
         Ref<ComputePipelineBase> backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateComputePipelineImpl(&appliedDescriptor));
-        size_t blueprintHash = pipelineAndBlueprintFromCache.second;
         return AddOrGetCachedComputePipeline(backendObj, blueprintHash);
     }
 
@@ -1120,15 +1211,22 @@ namespace dawn_native {
 
         // Call the callback directly when we can get a cached compute pipeline object.
         auto pipelineAndBlueprintFromCache = GetCachedComputePipeline(&appliedDescriptor);
+        const size_t blueprintHash = pipelineAndBlueprintFromCache.second;
         if (pipelineAndBlueprintFromCache.first.Get() != nullptr) {
+            mPipelineCreationStats.cacheHits++;
             Ref<ComputePipelineBase> result = std::move(pipelineAndBlueprintFromCache.first);
             callback(WGPUCreatePipelineAsyncStatus_Success,
                      reinterpret_cast<WGPUComputePipeline>(result.Detach()), "", userdata);
+        } else if (JoinPendingComputePipelineCreationAsync(&appliedDescriptor, blueprintHash,
+                                                           callback, userdata)) {
+            // The same pipeline is already being created asynchronously, the callback will be
+            // called with its result instead of compiling the pipeline again.
+            mPipelineCreationStats.pendingCreationJoins++;
         } else {
             // Otherwise we will create the pipeline object in CreateComputePipelineAsyncImpl(),
             // where the pipeline object may be created asynchronously and the result will be saved
             // to mCreatePipelineAsyncTracker.
-            const size_t blueprintHash = pipelineAndBlueprintFromCache.second;
+            mPipelineCreationStats.cacheMisses++;
             CreateComputePipelineAsyncImpl(&appliedDescriptor, blueprintHash, callback, userdata);
         }
 
@@ -1275,9 +1373,11 @@ namespace dawn_native {
 
         auto pipelineAndBlueprintFromCache = GetCachedRenderPipeline(&appliedDescriptor);
         if (pipelineAndBlueprintFromCache.first.Get() != nullptr) {
+            mPipelineCreationStats.cacheHits++;
             return std::move(pipelineAndBlueprintFromCache.first);
         }
 
+        mPipelineCreationStats.cacheMisses++;
         Ref<RenderPipelineBase> backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateRenderPipelineImpl(&appliedDescriptor));
         size_t blueprintHash = pipelineAndBlueprintFromCache.second;
@@ -1302,10 +1402,14 @@ namespace dawn_native {
         // Call the callback directly when we can get a cached render pipeline object.
         auto pipelineAndBlueprintFromCache = GetCachedRenderPipeline(&appliedDescriptor);
         if (pipelineAndBlueprintFromCache.first.Get() != nullptr) {
+            mPipelineCreationStats.cacheHits++;
             Ref<RenderPipelineBase> result = std::move(pipelineAndBlueprintFromCache.first);
             callback(WGPUCreatePipelineAsyncStatus_Success,
                      reinterpret_cast<WGPURenderPipeline>(result.Detach()), "", userdata);
         } else {
+            // Render pipelines are created synchronously by all the backends so there is never
+            // a pending creation to join: an identical request will hit the cache.
+            mPipelineCreationStats.cacheMisses++;
             // Otherwise we will create the pipeline object in CreateRenderPipelineAsyncImpl(),
             // where the pipeline object may be created asynchronously and the result will be saved
             // to mCreatePipelineAsyncTracker.
@@ -1471,6 +1575,10 @@ namespace dawn_native {
         return mCallbackTaskManager.get();
     }
 
+    CommandBlockPool* DeviceBase::GetCommandBlockPool() const {
+        return mCommandBlockPool.Get();
+    }
+
     dawn_platform::WorkerTaskPool* DeviceBase::GetWorkerTaskPool() const {
         return mWorkerTaskPool.get();
     }
@@ -1500,8 +1608,9 @@ namespace dawn_native {
 
             void Finish() final {
                 // TODO(jiawei.shao@intel.com): call AddOrGetCachedComputePipeline() asynchronously
-                // in CreateComputePipelineAsyncTaskImpl::Run() when the front-end pipeline cache is
-                // thread-safe.
+                // in CreateComputePipelineAsyncTaskImpl::Run() now that the front-end pipeline cache
+                // is thread-safe. This requires pipelines that lose the insertion race to still be
+                // released on the device thread.
                 if (mPipeline.Get() != nullptr) {
                     mPipeline = mPipeline->GetDevice()->AddOrGetCachedComputePipeline(
                         mPipeline, mBlueprintHash);
@@ -26,6 +26,7 @@
 #include "dawn_native/DawnNative.h"
 #include "dawn_native/dawn_platform.h"
 
+#include <memory>
 #include <utility>
 
 namespace dawn_platform {
@@ -34,11 +35,14 @@ namespace dawn_platform {
 
 namespace dawn_native {
     class AdapterBase;
+    class AsyncTask;
     class AsyncTaskManager;
     class AttachmentState;
     class AttachmentStateBlueprint;
     class BindGroupLayoutBase;
     class CallbackTaskManager;
+    class CommandBlockPool;
+    class CreateComputePipelineAsyncTask;
     class DynamicUploader;
     class ErrorScopeStack;
     class ExternalTextureBase;
@@ -264,6 +268,7 @@ namespace dawn_native {
         size_t GetLazyClearCountForTesting();
         void IncrementLazyClearCountForTesting();
         size_t GetDeprecationWarningCountForTesting();
+        PipelineCreationStats GetPipelineCreationStats() const;
         void EmitDeprecationWarning(const char* warning);
         void EmitLog(const char* message);
         void EmitLog(WGPULoggingType loggingType, const char* message);
@@ -290,6 +295,7 @@ namespace dawn_native {
 
         AsyncTaskManager* GetAsyncTaskManager() const;
         CallbackTaskManager* GetCallbackTaskManager() const;
+        CommandBlockPool* GetCommandBlockPool() const;
         dawn_platform::WorkerTaskPool* GetWorkerTaskPool() const;
 
         void AddComputePipelineAsyncCallbackTask(Ref<ComputePipelineBase> pipeline,
@@ -298,6 +304,14 @@ namespace dawn_native {
                                                  void* userdata,
                                                  size_t blueprintHash);
 
+        // Records an asynchronous compute pipeline creation that is in flight so that a
+        // synchronous creation of the same pipeline joins it instead of compiling it again.
+        void TrackPendingComputePipelineCreation(
+            Ref<ComputePipelineBase> pipeline,
+            size_t blueprintHash,
+            std::shared_ptr<CreateComputePipelineAsyncTask> createTask,
+            Ref<AsyncTask> asyncTask);
+
       protected:
         void SetToggle(Toggle toggle, bool isEnabled);
         void ForceSetToggle(Toggle toggle, bool isEnabled);
@@ -363,6 +377,19 @@ namespace dawn_native {
             size_t blueprintHash);
         Ref<RenderPipelineBase> AddOrGetCachedRenderPipeline(Ref<RenderPipelineBase> renderPipeline,
                                                              size_t blueprintHash);
+        struct PendingComputePipelineCreation;
+        PendingComputePipelineCreation* FindPendingComputePipelineCreation(
+            const ComputePipelineDescriptor* descriptor,
+            size_t blueprintHash);
+        Ref<ComputePipelineBase> JoinPendingComputePipelineCreation(
+            const ComputePipelineDescriptor* descriptor,
+            size_t blueprintHash);
+        bool JoinPendingComputePipelineCreationAsync(
+            const ComputePipelineDescriptor* descriptor,
+            size_t blueprintHash,
+            WGPUCreateComputePipelineAsyncCallback callback,
+            void* userdata);
+        void RemoveCompletedPendingPipelineCreations();
         virtual void CreateComputePipelineAsyncImpl(const ComputePipelineDescriptor* descriptor,
                                                     size_t blueprintHash,
                                                     WGPUCreateComputePipelineAsyncCallback callback,
@@ -433,12 +460,20 @@ namespace dawn_native {
         struct Caches;
         std::unique_ptr<Caches> mCaches;
 
+        // The asynchronous pipeline creations that may still be in flight.
+        struct PendingPipelineCreations;
+        std::unique_ptr<PendingPipelineCreations> mPendingPipelineCreations;
+
         Ref<BindGroupLayoutBase> mEmptyBindGroupLayout;
 
         std::unique_ptr<DynamicUploader> mDynamicUploader;
         std::unique_ptr<AsyncTaskManager> mAsyncTaskManager;
         Ref<QueueBase> mQueue;
 
+        // Refcounted because the command buffers return their blocks to the pool when they are
+        // destroyed, which can happen after the device is destroyed.
+        Ref<CommandBlockPool> mCommandBlockPool;
+
         struct DeprecationWarnings;
         std::unique_ptr<DeprecationWarnings> mDeprecationWarnings;
 
@@ -449,6 +484,7 @@ namespace dawn_native {
         TogglesSet mEnabledToggles;
         TogglesSet mOverridenToggles;
         size_t mLazyClearCountForTesting = 0;
+        PipelineCreationStats mPipelineCreationStats;
 
         ExtensionsSet mEnabledExtensions;
 
@@ -16,11 +16,17 @@
 #include "common/Math.h"
 #include "dawn_native/Device.h"
 
+#include <algorithm>
+
 namespace dawn_native {
 
+    constexpr uint64_t DynamicUploader::kMinRingBufferSize;
+    constexpr uint64_t DynamicUploader::kMaxRingBufferSize;
+    constexpr uint64_t DynamicUploader::kIdleTicksBeforeTrim;
+
     DynamicUploader::DynamicUploader(DeviceBase* device) : mDevice(device) {
         mRingBuffers.emplace_back(
-            std::unique_ptr<RingBuffer>(new RingBuffer{nullptr, {kRingBufferSize}}));
+            std::unique_ptr<RingBuffer>(new RingBuffer{nullptr, {kMinRingBufferSize}, 0}));
     }
 
     void DynamicUploader::ReleaseStagingBuffer(std::unique_ptr<StagingBufferBase> stagingBuffer) {
@@ -28,19 +34,48 @@ namespace dawn_native {
                                         mDevice->GetPendingCommandSerial());
     }
 
+    // static
+    uint64_t DynamicUploader::GetSizeClass(uint64_t allocationSize) {
+        ASSERT(allocationSize > kMaxRingBufferSize);
+        return Align(allocationSize, NextPowerOfTwo(allocationSize) / 8);
+    }
+
+    ResultOrError<UploadHandle> DynamicUploader::AllocateLarge(uint64_t allocationSize,
+                                                               ExecutionSerial serial) {
+        uint64_t sizeClass = GetSizeClass(allocationSize);
+        mStats.largeAllocations++;
+
+        // Reuse the most recently used free staging buffer of the size class, if any.
+        std::unique_ptr<StagingBufferBase> stagingBuffer;
+        auto it = mFreeStagingBuffers.find(sizeClass);
+        if (it != mFreeStagingBuffers.end()) {
+            ASSERT(!it->second.empty());
+            stagingBuffer = std::move(it->second.back().mStagingBuffer);
+            it->second.pop_back();
+            if (it->second.empty()) {
+                mFreeStagingBuffers.erase(it);
+            }
+            mFreeStagingBufferBytes -= sizeClass;
+            mStats.largeAllocationReuses++;
+        } else {
+            DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateStagingBuffer(sizeClass));
+            mStats.stagingBufferCreations++;
+        }
+
+        UploadHandle uploadHandle;
+        uploadHandle.mappedBuffer = static_cast<uint8_t*>(stagingBuffer->GetMappedPointer());
+        uploadHandle.stagingBuffer = stagingBuffer.get();
+
+        mInFlightStagingBufferBytes += sizeClass;
+        mInFlightStagingBuffers.Enqueue(std::move(stagingBuffer), serial);
+        return uploadHandle;
+    }
+
     ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocationSize,
                                                                   ExecutionSerial serial) {
         // Disable further sub-allocation should the request be too large.
-        if (allocationSize > kRingBufferSize) {
-            std::unique_ptr<StagingBufferBase> stagingBuffer;
-            DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateStagingBuffer(allocationSize));
-
-            UploadHandle uploadHandle;
-            uploadHandle.mappedBuffer = static_cast<uint8_t*>(stagingBuffer->GetMappedPointer());
-            uploadHandle.stagingBuffer = stagingBuffer.get();
-
-            ReleaseStagingBuffer(std::move(stagingBuffer));
-            return uploadHandle;
+        if (allocationSize > kMaxRingBufferSize) {
+            return AllocateLarge(allocationSize, serial);
         }
 
         // Note: Validation ensures size is already aligned.
@@ -63,17 +98,27 @@ namespace dawn_native {
             startOffset = targetRingBuffer->mAllocator.Allocate(allocationSize, serial);
         }
 
-        // Upon failure, append a newly created ring buffer to fulfill the
-        // request.
+        // Upon failure, append a newly created ring buffer to fulfill the request. It is twice
+        // as large as the largest ring buffer so that the ring buffers quickly reach the size
+        // needed by the uploads of a frame.
         if (startOffset == RingBufferAllocator::kInvalidOffset) {
+            uint64_t largestSize = 0;
+            for (const auto& ringBuffer : mRingBuffers) {
+                largestSize = std::max(largestSize, ringBuffer->mAllocator.GetSize());
+            }
+            uint64_t ringBufferSize =
+                std::max({kMinRingBufferSize, NextPowerOfTwo(allocationSize), 2 * largestSize});
+            ringBufferSize = std::min(ringBufferSize, kMaxRingBufferSize);
+
             mRingBuffers.emplace_back(
-                std::unique_ptr<RingBuffer>(new RingBuffer{nullptr, {kRingBufferSize}}));
+                std::unique_ptr<RingBuffer>(new RingBuffer{nullptr, {ringBufferSize}, mTick}));
 
             targetRingBuffer = mRingBuffers.back().get();
             startOffset = targetRingBuffer->mAllocator.Allocate(allocationSize, serial);
         }
 
         ASSERT(startOffset != RingBufferAllocator::kInvalidOffset);
+        targetRingBuffer->mLastUsedTick = mTick;
 
         // Allocate the staging buffer backing the ringbuffer.
         // Note: the first ringbuffer will be lazily created.
@@ -82,6 +127,7 @@ namespace dawn_native {
             DAWN_TRY_ASSIGN(stagingBuffer,
                             mDevice->CreateStagingBuffer(targetRingBuffer->mAllocator.GetSize()));
             targetRingBuffer->mStagingBuffer = std::move(stagingBuffer);
+            mStats.stagingBufferCreations++;
         }
 
         ASSERT(targetRingBuffer->mStagingBuffer != nullptr);
@@ -96,17 +142,60 @@ namespace dawn_native {
     }
 
     void DynamicUploader::Deallocate(ExecutionSerial lastCompletedSerial) {
+        mTick++;
+
         // Reclaim memory within the ring buffers by ticking (or removing requests no longer
-        // in-flight).
-        for (size_t i = 0; i < mRingBuffers.size(); ++i) {
-            mRingBuffers[i]->mAllocator.Deallocate(lastCompletedSerial);
-
-            // Never erase the last buffer as to prevent re-creating smaller buffers
-            // again. The last buffer is the largest.
-            if (mRingBuffers[i]->mAllocator.Empty() && i < mRingBuffers.size() - 1) {
-                mRingBuffers.erase(mRingBuffers.begin() + i);
+        // in-flight). Empty ring buffers are kept so that the uploads of the next frames don't
+        // create them again, unless they stayed unused for kIdleTicksBeforeTrim ticks.
+        for (auto& ringBuffer : mRingBuffers) {
+            ringBuffer->mAllocator.Deallocate(lastCompletedSerial);
+        }
+        auto IsIdle = [&](const std::unique_ptr<RingBuffer>& ringBuffer) {
+            if (!ringBuffer->mAllocator.Empty() ||
+                mTick - ringBuffer->mLastUsedTick <= kIdleTicksBeforeTrim) {
+                return false;
+            }
+            if (ringBuffer->mStagingBuffer != nullptr) {
+                mStats.trimmedBytes += ringBuffer->mAllocator.GetSize();
             }
+            return true;
+        };
+        mRingBuffers.erase(std::remove_if(mRingBuffers.begin(), mRingBuffers.end(), IsIdle),
+                           mRingBuffers.end());
+        if (mRingBuffers.empty()) {
+            mRingBuffers.emplace_back(
+                std::unique_ptr<RingBuffer>(new RingBuffer{nullptr, {kMinRingBufferSize}, mTick}));
         }
+
+        // Return the staging buffers of the completed large allocations to the pool, then free
+        // the ones that stayed unused for too long.
+        for (std::unique_ptr<StagingBufferBase>& stagingBuffer :
+             mInFlightStagingBuffers.IterateUpTo(lastCompletedSerial)) {
+            uint64_t size = stagingBuffer->GetSize();
+            mInFlightStagingBufferBytes -= size;
+            mFreeStagingBufferBytes += size;
+            mFreeStagingBuffers[size].push_back({std::move(stagingBuffer), mTick});
+        }
+        mInFlightStagingBuffers.ClearUpTo(lastCompletedSerial);
+
+        for (auto it = mFreeStagingBuffers.begin(); it != mFreeStagingBuffers.end();) {
+            // The buffers of a size class are ordered from the least to the most recently used.
+            std::vector<PooledStagingBuffer>& buffers = it->second;
+            auto firstUsed = std::find_if(buffers.begin(), buffers.end(), [&](const auto& pooled) {
+                return mTick - pooled.mLastUsedTick <= kIdleTicksBeforeTrim;
+            });
+            uint64_t trimmedBytes = static_cast<uint64_t>(firstUsed - buffers.begin()) * it->first;
+            mFreeStagingBufferBytes -= trimmedBytes;
+            mStats.trimmedBytes += trimmedBytes;
+            buffers.erase(buffers.begin(), firstUsed);
+
+            if (buffers.empty()) {
+                it = mFreeStagingBuffers.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
         mReleasedStagingBuffers.ClearUpTo(lastCompletedSerial);
     }
 
@@ -124,6 +213,29 @@ namespace dawn_native {
         uploadHandle.mappedBuffer =
             static_cast<uint8_t*>(uploadHandle.mappedBuffer) + additionalOffset;
         uploadHandle.startOffset += additionalOffset;
+
+        mStats.peakBytesInFlight = std::max(mStats.peakBytesInFlight, GetBytesInFlight());
         return uploadHandle;
     }
+
+    uint64_t DynamicUploader::GetBytesInFlight() const {
+        uint64_t bytesInFlight = mInFlightStagingBufferBytes;
+        for (const auto& ringBuffer : mRingBuffers) {
+            bytesInFlight += ringBuffer->mAllocator.GetUsedSize();
+        }
+        return bytesInFlight;
+    }
+
+    DynamicUploaderStats DynamicUploader::GetStats() const {
+        DynamicUploaderStats stats = mStats;
+        stats.bytesInFlight = GetBytesInFlight();
+        stats.ringBufferCount = mRingBuffers.size();
+        stats.stagingBufferBytes = mInFlightStagingBufferBytes + mFreeStagingBufferBytes;
+        for (const auto& ringBuffer : mRingBuffers) {
+            if (ringBuffer->mStagingBuffer != nullptr) {
+                stats.stagingBufferBytes += ringBuffer->mAllocator.GetSize();
+            }
+        }
+        return stats;
+    }
 }  // namespace dawn_native
@@ -15,13 +15,23 @@
 #ifndef DAWNNATIVE_DYNAMICUPLOADER_H_
 #define DAWNNATIVE_DYNAMICUPLOADER_H_
 
+#include "dawn_native/DawnNative.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/IntegerTypes.h"
 #include "dawn_native/RingBufferAllocator.h"
 #include "dawn_native/StagingBuffer.h"
 
+#include <map>
+#include <vector>
+
 // DynamicUploader is the front-end implementation used to manage multiple ring buffers for upload
 // usage.
+//
+// The ring buffers grow geometrically with the demand: when no ring buffer has room for an
+// allocation, a new one at least twice as large as the largest one is created, up to
+// kMaxRingBufferSize. Allocations larger than that use dedicated staging buffers that are
+// pooled by size class and reused once the GPU is done with them. The ring buffers and pooled
+// staging buffers that stay unused for kIdleTicksBeforeTrim ticks are freed.
 namespace dawn_native {
 
     struct UploadHandle {
@@ -32,6 +42,10 @@ namespace dawn_native {
 
     class DynamicUploader {
       public:
+        static constexpr uint64_t kMinRingBufferSize = 4 * 1024 * 1024;
+        static constexpr uint64_t kMaxRingBufferSize = 64 * 1024 * 1024;
+        static constexpr uint64_t kIdleTicksBeforeTrim = 64;
+
         DynamicUploader(DeviceBase* device);
         ~DynamicUploader() = default;
 
@@ -46,19 +60,41 @@ namespace dawn_native {
                                              uint64_t offsetAlignment);
         void Deallocate(ExecutionSerial lastCompletedSerial);
 
-      private:
-        static constexpr uint64_t kRingBufferSize = 4 * 1024 * 1024;
+        DynamicUploaderStats GetStats() const;
 
+      private:
         struct RingBuffer {
             std::unique_ptr<StagingBufferBase> mStagingBuffer;
             RingBufferAllocator mAllocator;
+            uint64_t mLastUsedTick;
+        };
+
+        struct PooledStagingBuffer {
+            std::unique_ptr<StagingBufferBase> mStagingBuffer;
+            uint64_t mLastUsedTick;
         };
 
         ResultOrError<UploadHandle> AllocateInternal(uint64_t allocationSize,
                                                      ExecutionSerial serial);
+        ResultOrError<UploadHandle> AllocateLarge(uint64_t allocationSize,
+                                                  ExecutionSerial serial);
+        uint64_t GetBytesInFlight() const;
+
+        // The rounded up size of the staging buffers of large allocations, so that allocations of
+        // similar sizes share staging buffers while wasting at most a quarter of their size.
+        static uint64_t GetSizeClass(uint64_t allocationSize);
 
         std::vector<std::unique_ptr<RingBuffer>> mRingBuffers;
         SerialQueue<ExecutionSerial, std::unique_ptr<StagingBufferBase>> mReleasedStagingBuffers;
+
+        // The staging buffers of large allocations, in flight or free to reuse, keyed by size.
+        SerialQueue<ExecutionSerial, std::unique_ptr<StagingBufferBase>> mInFlightStagingBuffers;
+        std::map<uint64_t, std::vector<PooledStagingBuffer>> mFreeStagingBuffers;
+        uint64_t mInFlightStagingBufferBytes = 0;
+        uint64_t mFreeStagingBufferBytes = 0;
+
+        uint64_t mTick = 0;
+        DynamicUploaderStats mStats;
         DeviceBase* mDevice;
     };
 }  // namespace dawn_native
@@ -20,11 +20,15 @@
 #include "dawn_native/Device.h"
 #include "dawn_native/ErrorData.h"
 #include "dawn_native/RenderBundleEncoder.h"
+#include "dawn_native/RenderEncoderBase.h"
 
 namespace dawn_native {
 
     EncodingContext::EncodingContext(DeviceBase* device, const ObjectBase* initialEncoder)
-        : mDevice(device), mTopLevelEncoder(initialEncoder), mCurrentEncoder(initialEncoder) {
+        : mDevice(device),
+          mTopLevelEncoder(initialEncoder),
+          mCurrentEncoder(initialEncoder),
+          mAllocator(device->GetCommandBlockPool()) {
     }
 
     EncodingContext::~EncodingContext() {
@@ -59,6 +63,9 @@ namespace dawn_native {
             ASSERT(error->GetType() == InternalErrorType::Validation);
             // If the encoding context is not finished, errors are deferred until
             // Finish() is called.
+            if (mError == nullptr) {
+                ValidateDeferredDraws();
+            }
             if (mError == nullptr) {
                 mError = std::move(error);
             }
@@ -67,6 +74,21 @@ namespace dawn_native {
         }
     }
 
+    void EncodingContext::SetDeferredDrawValidationEncoder(RenderEncoderBase* encoder) {
+        ASSERT(encoder == nullptr || mDeferredDrawValidationEncoder == nullptr);
+        mDeferredDrawValidationEncoder = encoder;
+    }
+
+    void EncodingContext::ValidateDeferredDraws() {
+        ASSERT(mError == nullptr);
+        if (mDeferredDrawValidationEncoder != nullptr) {
+            MaybeError maybeError = mDeferredDrawValidationEncoder->ValidateDeferredDraws();
+            if (maybeError.IsError()) {
+                mError = maybeError.AcquireError();
+            }
+        }
+    }
+
     void EncodingContext::EnterPass(const ObjectBase* passEncoder) {
         // Assert we're at the top level.
         ASSERT(mCurrentEncoder == mTopLevelEncoder);
@@ -124,6 +146,16 @@ namespace dawn_native {
         // Even if finish validation fails, it is now invalid to call any encoding commands,
         // so we clear the encoders. Note: mTopLevelEncoder == nullptr is used as a flag for
         // if Finish() has been called.
+        // The pending draws of an encoder that wasn't ended are dropped so that they aren't
+        // validated after Finish() when the encoder is released.
+        if (mError == nullptr) {
+            ValidateDeferredDraws();
+        }
+        if (mDeferredDrawValidationEncoder != nullptr) {
+            mDeferredDrawValidationEncoder->DetachDeferredDrawValidation();
+        }
+        ASSERT(mDeferredDrawValidationEncoder == nullptr);
+
         mCurrentEncoder = nullptr;
         mTopLevelEncoder = nullptr;
 
@@ -27,6 +27,7 @@ namespace dawn_native {
 
     class DeviceBase;
     class ObjectBase;
+    class RenderEncoderBase;
 
     // Base class for allocating/iterating commands.
     // It performs error tracking as well as encoding state for render/compute passes.
@@ -72,6 +73,11 @@ namespace dawn_native {
             return !ConsumedError(encodeFunction(&mAllocator));
         }
 
+        // Sets the encoder whose draws are validated lazily. Its pending draws are validated
+        // before any other error is handled so that the error of the first invalid command is
+        // the one that is kept. Can be set to nullptr.
+        void SetDeferredDrawValidationEncoder(RenderEncoderBase* encoder);
+
         // Functions to set current encoder state
         void EnterPass(const ObjectBase* passEncoder);
         void ExitPass(const ObjectBase* passEncoder, RenderPassResourceUsage usages);
@@ -86,6 +92,7 @@ namespace dawn_native {
       private:
         bool IsFinished() const;
         void MoveToIterator();
+        void ValidateDeferredDraws();
 
         DeviceBase* mDevice;
 
@@ -98,6 +105,7 @@ namespace dawn_native {
         // The current encoder changes with Enter/ExitPass which should be called by
         // CommandEncoder::Begin/EndPass.
         const ObjectBase* mCurrentEncoder;
+        RenderEncoderBase* mDeferredDrawValidationEncoder = nullptr;
 
         RenderPassUsages mRenderPassUsages;
         bool mWereRenderPassUsagesAcquired = false;
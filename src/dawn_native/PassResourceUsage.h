@@ -37,7 +37,8 @@ namespace dawn_native {
 
     // Which resources are used by a synchronization scope and how they are used. The command
     // buffer validation pre-computes this information so that backends with explicit barriers
-    // don't have to re-compute it.
+    // don't have to re-compute it. The resources are in the order they are first used in the
+    // synchronization scope.
     struct SyncScopeResourceUsage {
         std::vector<BufferBase*> buffers;
         std::vector<wgpu::BufferUsage> bufferUsages;
@@ -63,10 +64,11 @@ namespace dawn_native {
 
         std::vector<SyncScopeResourceUsage> dispatchUsages;
 
-        // All the resources referenced by this compute pass for validation in Queue::Submit.
-        std::set<BufferBase*> referencedBuffers;
-        std::set<TextureBase*> referencedTextures;
-        std::set<ExternalTextureBase*> referencedExternalTextures;
+        // All the resources referenced by this compute pass for validation in Queue::Submit,
+        // without duplicates.
+        std::vector<BufferBase*> referencedBuffers;
+        std::vector<TextureBase*> referencedTextures;
+        std::vector<ExternalTextureBase*> referencedExternalTextures;
     };
 
     // Contains all the resource usage data for a render pass.
@@ -80,6 +82,19 @@ namespace dawn_native {
         std::vector<std::vector<bool>> queryAvailabilities;
     };
 
+    // A summary of the texture usage of a render bundle that is computed when the bundle is
+    // created, so that ExecuteBundles can merge the usage of most textures without merging their
+    // SubresourceStorages.
+    struct RenderBundleUsageSummary {
+        // The textures that have the same usage in all their subresources, which is the case of
+        // the textures that are only sampled, with that usage.
+        std::vector<TextureBase*> wholeTextures;
+        std::vector<wgpu::TextureUsage> wholeTextureUsages;
+
+        // The indices in RenderPassResourceUsage::textures of the other textures.
+        std::vector<size_t> partialTextureIndices;
+    };
+
     using RenderPassUsages = std::vector<RenderPassResourceUsage>;
     using ComputePassUsages = std::vector<ComputePassResourceUsage>;
 
@@ -20,6 +20,7 @@
 #include "dawn_native/ExternalTexture.h"
 #include "dawn_native/Format.h"
 #include "dawn_native/QuerySet.h"
+#include "dawn_native/RenderBundle.h"
 #include "dawn_native/Texture.h"
 
 #include <utility>
@@ -27,22 +28,28 @@
 namespace dawn_native {
 
     void SyncScopeUsageTracker::BufferUsedAs(BufferBase* buffer, wgpu::BufferUsage usage) {
-        // std::map's operator[] will create the key and return 0 if the key didn't exist
-        // before.
-        mBufferUsages[buffer] |= usage;
+        auto insertion = mBuffers.Insert(buffer);
+        if (insertion.second) {
+            mBufferUsages.push_back(usage);
+        } else {
+            mBufferUsages[insertion.first] |= usage;
+        }
+    }
+
+    TextureSubresourceUsage& SyncScopeUsageTracker::GetTextureUsage(TextureBase* texture) {
+        auto insertion = mTextures.Insert(texture);
+        if (insertion.second) {
+            mTextureUsages.emplace_back(texture->GetFormat().aspects, texture->GetArrayLayers(),
+                                        texture->GetNumMipLevels(), wgpu::TextureUsage::None);
+        }
+        return mTextureUsages[insertion.first];
     }
 
     void SyncScopeUsageTracker::TextureViewUsedAs(TextureViewBase* view, wgpu::TextureUsage usage) {
         TextureBase* texture = view->GetTexture();
         const SubresourceRange& range = view->GetSubresourceRange();
 
-        // Get or create a new TextureSubresourceUsage for that texture (initially filled with
-        // wgpu::TextureUsage::None)
-        auto it = mTextureUsages.emplace(
-            std::piecewise_construct, std::forward_as_tuple(texture),
-            std::forward_as_tuple(texture->GetFormat().aspects, texture->GetArrayLayers(),
-                                  texture->GetNumMipLevels(), wgpu::TextureUsage::None));
-        TextureSubresourceUsage& textureUsage = it.first->second;
+        TextureSubresourceUsage& textureUsage = GetTextureUsage(texture);
 
         textureUsage.Update(range,
                             [usage](const SubresourceRange&, wgpu::TextureUsage* storedUsage) {
@@ -60,23 +67,37 @@ namespace dawn_native {
                             });
     }
 
-    void SyncScopeUsageTracker::AddRenderBundleTextureUsage(
-        TextureBase* texture,
-        const TextureSubresourceUsage& textureUsage) {
-        // Get or create a new TextureSubresourceUsage for that texture (initially filled with
-        // wgpu::TextureUsage::None)
-        auto it = mTextureUsages.emplace(
-            std::piecewise_construct, std::forward_as_tuple(texture),
-            std::forward_as_tuple(texture->GetFormat().aspects, texture->GetArrayLayers(),
-                                  texture->GetNumMipLevels(), wgpu::TextureUsage::None));
-        TextureSubresourceUsage* passTextureUsage = &it.first->second;
-
-        passTextureUsage->Merge(
-            textureUsage, [](const SubresourceRange&, wgpu::TextureUsage* storedUsage,
-                             const wgpu::TextureUsage& addedUsage) {
-                ASSERT((addedUsage & wgpu::TextureUsage::RenderAttachment) == 0);
-                *storedUsage |= addedUsage;
-            });
+    void SyncScopeUsageTracker::AddRenderBundleUsage(const RenderPassResourceUsage& usage,
+                                                     const RenderBundleUsageSummary& summary) {
+        for (size_t i = 0; i < usage.buffers.size(); ++i) {
+            BufferUsedAs(usage.buffers[i], usage.bufferUsages[i]);
+        }
+
+        // The usage of whole textures is added with a single update of the pass usage, that
+        // stays compressed if it was.
+        for (size_t i = 0; i < summary.wholeTextures.size(); ++i) {
+            TextureBase* texture = summary.wholeTextures[i];
+            wgpu::TextureUsage addedUsage = summary.wholeTextureUsages[i];
+            ASSERT((addedUsage & wgpu::TextureUsage::RenderAttachment) == 0);
+
+            GetTextureUsage(texture).Update(
+                texture->GetAllSubresources(),
+                [addedUsage](const SubresourceRange&, wgpu::TextureUsage* storedUsage) {
+                    *storedUsage |= addedUsage;
+                });
+        }
+
+        for (size_t index : summary.partialTextureIndices) {
+            TextureSubresourceUsage* passTextureUsage = &GetTextureUsage(usage.textures[index]);
+
+            passTextureUsage->Merge(
+                usage.textureUsages[index],
+                [](const SubresourceRange&, wgpu::TextureUsage* storedUsage,
+                   const wgpu::TextureUsage& addedUsage) {
+                    ASSERT((addedUsage & wgpu::TextureUsage::RenderAttachment) == 0);
+                    *storedUsage |= addedUsage;
+                });
+        }
     }
 
     void SyncScopeUsageTracker::AddBindGroup(BindGroupBase* group) {
@@ -139,7 +160,7 @@ namespace dawn_native {
                     ASSERT(textureViews[1].Get() == nullptr);
                     ASSERT(textureViews[2].Get() == nullptr);
 
-                    mExternalTextureUsages.insert(externalTexture);
+                    mExternalTextures.Insert(externalTexture);
                     TextureViewUsedAs(textureViews[0].Get(), wgpu::TextureUsage::TextureBinding);
                     break;
                 }
@@ -152,28 +173,15 @@ namespace dawn_native {
 
     SyncScopeResourceUsage SyncScopeUsageTracker::AcquireSyncScopeUsage() {
         SyncScopeResourceUsage result;
-        result.buffers.reserve(mBufferUsages.size());
-        result.bufferUsages.reserve(mBufferUsages.size());
-        result.textures.reserve(mTextureUsages.size());
-        result.textureUsages.reserve(mTextureUsages.size());
-
-        for (auto& it : mBufferUsages) {
-            result.buffers.push_back(it.first);
-            result.bufferUsages.push_back(it.second);
-        }
-
-        for (auto& it : mTextureUsages) {
-            result.textures.push_back(it.first);
-            result.textureUsages.push_back(std::move(it.second));
-        }
 
-        for (auto& it : mExternalTextureUsages) {
-            result.externalTextures.push_back(it);
-        }
+        result.buffers = mBuffers.AcquireElements();
+        result.bufferUsages = std::move(mBufferUsages);
+        result.textures = mTextures.AcquireElements();
+        result.textureUsages = std::move(mTextureUsages);
+        result.externalTextures = mExternalTextures.AcquireElements();
 
         mBufferUsages.clear();
         mTextureUsages.clear();
-        mExternalTextureUsages.clear();
 
         return result;
     }
@@ -183,7 +191,7 @@ namespace dawn_native {
     }
 
     void ComputePassResourceUsageTracker::AddReferencedBuffer(BufferBase* buffer) {
-        mUsage.referencedBuffers.insert(buffer);
+        mReferencedBuffers.Insert(buffer);
     }
 
     void ComputePassResourceUsageTracker::AddResourcesReferencedByBindGroup(BindGroupBase* group) {
@@ -192,13 +200,12 @@ namespace dawn_native {
 
             switch (bindingInfo.bindingType) {
                 case BindingInfoType::Buffer: {
-                    mUsage.referencedBuffers.insert(group->GetBindingAsBufferBinding(index).buffer);
+                    mReferencedBuffers.Insert(group->GetBindingAsBufferBinding(index).buffer);
                     break;
                 }
 
                 case BindingInfoType::Texture: {
-                    mUsage.referencedTextures.insert(
-                        group->GetBindingAsTextureView(index)->GetTexture());
+                    mReferencedTextures.Insert(group->GetBindingAsTextureView(index)->GetTexture());
                     break;
                 }
 
@@ -213,8 +220,8 @@ namespace dawn_native {
                     ASSERT(textureViews[1].Get() == nullptr);
                     ASSERT(textureViews[2].Get() == nullptr);
 
-                    mUsage.referencedExternalTextures.insert(externalTexture);
-                    mUsage.referencedTextures.insert(textureViews[0].Get()->GetTexture());
+                    mReferencedExternalTextures.Insert(externalTexture);
+                    mReferencedTextures.Insert(textureViews[0].Get()->GetTexture());
                     break;
                 }
 
@@ -226,9 +233,18 @@ namespace dawn_native {
     }
 
     ComputePassResourceUsage ComputePassResourceUsageTracker::AcquireResourceUsage() {
+        mUsage.referencedBuffers = mReferencedBuffers.AcquireElements();
+        mUsage.referencedTextures = mReferencedTextures.AcquireElements();
+        mUsage.referencedExternalTextures = mReferencedExternalTextures.AcquireElements();
         return std::move(mUsage);
     }
 
+    void RenderPassResourceUsageTracker::AddRenderBundle(RenderBundleBase* bundle) {
+        if (mRenderBundles.Insert(bundle).second) {
+            AddRenderBundleUsage(bundle->GetResourceUsage(), bundle->GetUsageSummary());
+        }
+    }
+
     RenderPassResourceUsage RenderPassResourceUsageTracker::AcquireResourceUsage() {
         RenderPassResourceUsage result;
         *static_cast<SyncScopeResourceUsage*>(&result) = AcquireSyncScopeUsage();
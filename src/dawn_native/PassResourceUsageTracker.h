@@ -15,11 +15,13 @@
 #ifndef DAWNNATIVE_PASSRESOURCEUSAGETRACKER_H_
 #define DAWNNATIVE_PASSRESOURCEUSAGETRACKER_H_
 
+#include "common/FlatPointerSet.h"
 #include "dawn_native/PassResourceUsage.h"
 
 #include "dawn_native/dawn_platform.h"
 
 #include <map>
+#include <vector>
 
 namespace dawn_native {
 
@@ -27,17 +29,21 @@ namespace dawn_native {
     class BufferBase;
     class ExternalTextureBase;
     class QuerySetBase;
+    class RenderBundleBase;
     class TextureBase;
 
     using QueryAvailabilityMap = std::map<QuerySetBase*, std::vector<bool>>;
 
-    // Helper class to build SyncScopeResourceUsages
+    // Helper class to build SyncScopeResourceUsages. The resources are tracked in flat tables
+    // instead of tree-based maps because they are looked up for every SetBindGroup and draw, and
+    // are output in the order they were first used.
     class SyncScopeUsageTracker {
       public:
         void BufferUsedAs(BufferBase* buffer, wgpu::BufferUsage usage);
         void TextureViewUsedAs(TextureViewBase* texture, wgpu::TextureUsage usage);
-        void AddRenderBundleTextureUsage(TextureBase* texture,
-                                         const TextureSubresourceUsage& textureUsage);
+        // Merges the usage of a render bundle, that has the |summary| of its texture usage.
+        void AddRenderBundleUsage(const RenderPassResourceUsage& usage,
+                                  const RenderBundleUsageSummary& summary);
 
         // Walks the bind groups and tracks all its resources.
         void AddBindGroup(BindGroupBase* group);
@@ -46,9 +52,16 @@ namespace dawn_native {
         SyncScopeResourceUsage AcquireSyncScopeUsage();
 
       private:
-        std::map<BufferBase*, wgpu::BufferUsage> mBufferUsages;
-        std::map<TextureBase*, TextureSubresourceUsage> mTextureUsages;
-        std::set<ExternalTextureBase*> mExternalTextureUsages;
+        // Gets or creates the TextureSubresourceUsage for that texture (initially filled with
+        // wgpu::TextureUsage::None).
+        TextureSubresourceUsage& GetTextureUsage(TextureBase* texture);
+
+        // The usages are stored at the index of their resource in the FlatPointerSet.
+        FlatPointerSet<BufferBase> mBuffers;
+        std::vector<wgpu::BufferUsage> mBufferUsages;
+        FlatPointerSet<TextureBase> mTextures;
+        std::vector<TextureSubresourceUsage> mTextureUsages;
+        FlatPointerSet<ExternalTextureBase> mExternalTextures;
     };
 
     // Helper class to build ComputePassResourceUsages
@@ -62,6 +75,9 @@ namespace dawn_native {
 
       private:
         ComputePassResourceUsage mUsage;
+        FlatPointerSet<BufferBase> mReferencedBuffers;
+        FlatPointerSet<TextureBase> mReferencedTextures;
+        FlatPointerSet<ExternalTextureBase> mReferencedExternalTextures;
     };
 
     // Helper class to build RenderPassResourceUsages
@@ -70,6 +86,10 @@ namespace dawn_native {
         void TrackQueryAvailability(QuerySetBase* querySet, uint32_t queryIndex);
         const QueryAvailabilityMap& GetQueryAvailabilityMap() const;
 
+        // Merges the usage of |bundle|, unless it was already executed in this pass: merging the
+        // same usage again wouldn't change the usage of the pass.
+        void AddRenderBundle(RenderBundleBase* bundle);
+
         RenderPassResourceUsage AcquireResourceUsage();
 
       private:
@@ -79,6 +99,8 @@ namespace dawn_native {
 
         // Tracks queries used in the render pass to validate that they aren't written twice.
         QueryAvailabilityMap mQueryAvailabilities;
+
+        FlatPointerSet<RenderBundleBase> mRenderBundles;
     };
 
 }  // namespace dawn_native
@@ -15,53 +15,174 @@
 #include "dawn_native/PersistentCache.h"
 
 #include "common/Assert.h"
+#include "common/HashUtils.h"
 #include "dawn_native/Device.h"
 #include "dawn_platform/DawnPlatform.h"
 
+#include <cstring>
+
 namespace dawn_native {
 
+    namespace {
+
+        dawn_platform::CachingInterface* GetPlatformCache(DeviceBase* device) {
+            // TODO(dawn:549): Create a fingerprint of concatenated version strings (ex. Tint
+            // commit hash, Dawn commit hash). This will be used by the client so it may know when
+            // to discard previously cached Dawn objects should this fingerprint change.
+            dawn_platform::Platform* platform = device->GetPlatform();
+            if (platform != nullptr) {
+                return platform->GetCachingInterface(/*fingerprint*/ nullptr,
+                                                     /*fingerprintSize*/ 0);
+            }
+            return nullptr;
+        }
+
+        size_t HashKey(const PersistentCacheKey& key) {
+            return static_cast<size_t>(HashBytes(key.data(), key.size()));
+        }
+
+        size_t GetEntryByteSize(const PersistentCacheKey& key, size_t blobSize) {
+            return key.size() + blobSize;
+        }
+
+    }  // anonymous namespace
+
+    constexpr size_t PersistentCache::kDefaultMemoryBudget;
+    constexpr size_t PersistentCache::kShardCount;
+
     PersistentCache::PersistentCache(DeviceBase* device)
-        : mDevice(device), mCache(GetPlatformCache()) {
+        : PersistentCache(device, GetPlatformCache(device), kDefaultMemoryBudget) {
+    }
+
+    PersistentCache::PersistentCache(DeviceBase* device,
+                                     dawn_platform::CachingInterface* platformCache,
+                                     size_t memoryBudget)
+        : mDevice(device), mCache(platformCache), mShardMemoryBudget(memoryBudget / kShardCount) {
     }
 
     ScopedCachedBlob PersistentCache::LoadData(const PersistentCacheKey& key) {
         ScopedCachedBlob blob = {};
+        const size_t hash = HashKey(key);
+
+        Blob memoryBlob = LoadFromMemory(key, hash);
+        if (memoryBlob != nullptr) {
+            mMemoryHits++;
+            blob.bufferSize = memoryBlob->size();
+            blob.buffer.reset(new uint8_t[blob.bufferSize]);
+            memcpy(blob.buffer.get(), memoryBlob->data(), blob.bufferSize);
+            return blob;
+        }
+
         if (mCache == nullptr) {
+            mMisses++;
             return blob;
         }
-        std::lock_guard<std::mutex> lock(mMutex);
-        blob.bufferSize = mCache->LoadData(reinterpret_cast<WGPUDevice>(mDevice), key.data(),
-                                           key.size(), nullptr, 0);
-        if (blob.bufferSize > 0) {
-            blob.buffer.reset(new uint8_t[blob.bufferSize]);
-            const size_t bufferSize =
-                mCache->LoadData(reinterpret_cast<WGPUDevice>(mDevice), key.data(), key.size(),
-                                 blob.buffer.get(), blob.bufferSize);
-            ASSERT(bufferSize == blob.bufferSize);
+
+        {
+            std::lock_guard<std::mutex> lock(mPlatformMutex);
+            blob.bufferSize = mCache->LoadData(reinterpret_cast<WGPUDevice>(mDevice), key.data(),
+                                               key.size(), nullptr, 0);
+            if (blob.bufferSize > 0) {
+                blob.buffer.reset(new uint8_t[blob.bufferSize]);
+                const size_t bufferSize =
+                    mCache->LoadData(reinterpret_cast<WGPUDevice>(mDevice), key.data(),
+                                     key.size(), blob.buffer.get(), blob.bufferSize);
+                ASSERT(bufferSize == blob.bufferSize);
+            }
+        }
+
+        if (blob.bufferSize == 0) {
+            mMisses++;
             return blob;
         }
+
+        // Keep the blob in memory so that the next loads don't go to the platform cache.
+        mPlatformHits++;
+        StoreInMemory(key, hash,
+                      std::make_shared<const std::vector<uint8_t>>(
+                          blob.buffer.get(), blob.buffer.get() + blob.bufferSize));
         return blob;
     }
 
     void PersistentCache::StoreData(const PersistentCacheKey& key, const void* value, size_t size) {
+        ASSERT(value != nullptr);
+        ASSERT(size > 0);
+        mStores++;
+
+        const uint8_t* bytes = static_cast<const uint8_t*>(value);
+        StoreInMemory(key, HashKey(key),
+                      std::make_shared<const std::vector<uint8_t>>(bytes, bytes + size));
+
         if (mCache == nullptr) {
             return;
         }
-        ASSERT(value != nullptr);
-        ASSERT(size > 0);
-        std::lock_guard<std::mutex> lock(mMutex);
+        std::lock_guard<std::mutex> lock(mPlatformMutex);
         mCache->StoreData(reinterpret_cast<WGPUDevice>(mDevice), key.data(), key.size(), value,
                           size);
     }
 
-    dawn_platform::CachingInterface* PersistentCache::GetPlatformCache() {
-        // TODO(dawn:549): Create a fingerprint of concatenated version strings (ex. Tint commit
-        // hash, Dawn commit hash). This will be used by the client so it may know when to discard
-        // previously cached Dawn objects should this fingerprint change.
-        dawn_platform::Platform* platform = mDevice->GetPlatform();
-        if (platform != nullptr) {
-            return platform->GetCachingInterface(/*fingerprint*/ nullptr, /*fingerprintSize*/ 0);
+    PersistentCache::Blob PersistentCache::LoadFromMemory(const PersistentCacheKey& key,
+                                                          size_t hash) {
+        Shard& shard = mShards[hash % kShardCount];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.entriesByHash.find(hash);
+        // The full key is compared in case two keys have the same hash.
+        if (it == shard.entriesByHash.end() || it->second->key != key) {
+            return nullptr;
         }
-        return nullptr;
+
+        // Move the entry to the front of the LRU list.
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        return it->second->blob;
+    }
+
+    void PersistentCache::StoreInMemory(const PersistentCacheKey& key, size_t hash, Blob blob) {
+        const size_t entrySize = GetEntryByteSize(key, blob->size());
+        if (entrySize > mShardMemoryBudget) {
+            return;
+        }
+
+        Shard& shard = mShards[hash % kShardCount];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        // Replace the entry with the same hash, if any. It is either the same key being stored
+        // again or a hash collision in which case the most recent key wins.
+        auto it = shard.entriesByHash.find(hash);
+        if (it != shard.entriesByHash.end()) {
+            size_t replacedSize = GetEntryByteSize(it->second->key, it->second->blob->size());
+            shard.bytes -= replacedSize;
+            mMemoryBytes -= replacedSize;
+            shard.entries.erase(it->second);
+            shard.entriesByHash.erase(it);
+        }
+
+        // Evict the least recently used entries until the new entry fits in the budget.
+        while (shard.bytes + entrySize > mShardMemoryBudget) {
+            ASSERT(!shard.entries.empty());
+            const Entry& evicted = shard.entries.back();
+            size_t evictedSize = GetEntryByteSize(evicted.key, evicted.blob->size());
+            shard.bytes -= evictedSize;
+            mMemoryBytes -= evictedSize;
+            mEvictions++;
+            shard.entriesByHash.erase(evicted.hash);
+            shard.entries.pop_back();
+        }
+
+        shard.entries.push_front({key, hash, std::move(blob)});
+        shard.entriesByHash[hash] = shard.entries.begin();
+        shard.bytes += entrySize;
+        mMemoryBytes += entrySize;
+    }
+
+    PersistentCacheStats PersistentCache::GetStats() const {
+        PersistentCacheStats stats;
+        stats.memoryHits = mMemoryHits.load();
+        stats.platformHits = mPlatformHits.load();
+        stats.misses = mMisses.load();
+        stats.stores = mStores.load();
+        stats.evictions = mEvictions.load();
+        stats.memoryBytes = mMemoryBytes.load();
+        return stats;
     }
 }  // namespace dawn_native
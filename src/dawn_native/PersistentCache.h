@@ -17,7 +17,14 @@
 
 #include "dawn_native/Error.h"
 
+#include "dawn_native/DawnNative.h"
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace dawn_platform {
@@ -35,15 +42,27 @@ namespace dawn_native {
 
     class DeviceBase;
 
-    enum class PersistentKeyType { Shader };
+    // The kind of blob a key refers to. It is the first element serialized in the keys so that
+    // blobs of different kinds never share a key.
+    enum class PersistentKeyType { Shader, ComputePipeline, RenderPipeline, PipelineLayout };
 
     // This class should always be thread-safe as it is used in Create*PipelineAsync() where it is
     // called asynchronously.
-    // The thread-safety of any access to mCache (the function LoadData() and StoreData()) is
-    // protected by mMutex.
+    //
+    // The blobs are looked up in an in-memory LRU tier before the platform cache. The in-memory
+    // tier is split in shards indexed by a hash of the key, each with its own mutex and an equal
+    // part of the byte budget, so that concurrent lookups of different keys rarely contend. The
+    // platform cache isn't required to be thread-safe so the accesses to mCache (the calls to
+    // LoadData() and StoreData() on it) are protected by mPlatformMutex.
     class PersistentCache {
       public:
+        static constexpr size_t kDefaultMemoryBudget = 16 * 1024 * 1024;
+
         PersistentCache(DeviceBase* device);
+        // Used in tests to use a specific platform cache, which may be null, and memory budget.
+        PersistentCache(DeviceBase* device,
+                        dawn_platform::CachingInterface* platformCache,
+                        size_t memoryBudget);
 
         // Combines load/store operations into a single call.
         // If the load was successful, a non-empty blob is returned to the caller.
@@ -75,17 +94,48 @@ namespace dawn_native {
             return std::move(blob);
         }
 
+        PersistentCacheStats GetStats() const;
+
       private:
+        using Blob = std::shared_ptr<const std::vector<uint8_t>>;
+
+        struct Entry {
+            PersistentCacheKey key;
+            size_t hash;
+            Blob blob;
+        };
+
+        struct Shard {
+            std::mutex mutex;
+            // The most recently used entries are at the front.
+            std::list<Entry> entries;
+            std::unordered_map<size_t, std::list<Entry>::iterator> entriesByHash;
+            size_t bytes = 0;
+        };
+
+        static constexpr size_t kShardCount = 16;
+
         // PersistentCache impl
         ScopedCachedBlob LoadData(const PersistentCacheKey& key);
         void StoreData(const PersistentCacheKey& key, const void* value, size_t size);
 
-        dawn_platform::CachingInterface* GetPlatformCache();
+        Blob LoadFromMemory(const PersistentCacheKey& key, size_t hash);
+        void StoreInMemory(const PersistentCacheKey& key, size_t hash, Blob blob);
 
         DeviceBase* mDevice = nullptr;
 
-        std::mutex mMutex;
+        std::mutex mPlatformMutex;
         dawn_platform::CachingInterface* mCache = nullptr;
+
+        const size_t mShardMemoryBudget;
+        std::array<Shard, kShardCount> mShards;
+
+        std::atomic<uint64_t> mMemoryHits{0};
+        std::atomic<uint64_t> mPlatformHits{0};
+        std::atomic<uint64_t> mMisses{0};
+        std::atomic<uint64_t> mStores{0};
+        std::atomic<uint64_t> mEvictions{0};
+        std::atomic<uint64_t> mMemoryBytes{0};
     };
 }  // namespace dawn_native
 
@@ -28,6 +28,7 @@
 #include "dawn_native/RenderPassEncoder.h"
 #include "dawn_native/RenderPipeline.h"
 #include "dawn_native/Texture.h"
+#include "dawn_native/TextureDataCopy.h"
 #include "dawn_platform/DawnPlatform.h"
 #include "dawn_platform/tracing/TraceEvent.h"
 
@@ -37,41 +38,6 @@ namespace dawn_native {
 
     namespace {
 
-        void CopyTextureData(uint8_t* dstPointer,
-                             const uint8_t* srcPointer,
-                             uint32_t depth,
-                             uint32_t rowsPerImage,
-                             uint64_t imageAdditionalStride,
-                             uint32_t actualBytesPerRow,
-                             uint32_t dstBytesPerRow,
-                             uint32_t srcBytesPerRow) {
-            bool copyWholeLayer =
-                actualBytesPerRow == dstBytesPerRow && dstBytesPerRow == srcBytesPerRow;
-            bool copyWholeData = copyWholeLayer && imageAdditionalStride == 0;
-
-            if (!copyWholeLayer) {  // copy row by row
-                for (uint32_t d = 0; d < depth; ++d) {
-                    for (uint32_t h = 0; h < rowsPerImage; ++h) {
-                        memcpy(dstPointer, srcPointer, actualBytesPerRow);
-                        dstPointer += dstBytesPerRow;
-                        srcPointer += srcBytesPerRow;
-                    }
-                    srcPointer += imageAdditionalStride;
-                }
-            } else {
-                uint64_t layerSize = uint64_t(rowsPerImage) * actualBytesPerRow;
-                if (!copyWholeData) {  // copy layer by layer
-                    for (uint32_t d = 0; d < depth; ++d) {
-                        memcpy(dstPointer, srcPointer, layerSize);
-                        dstPointer += layerSize;
-                        srcPointer += layerSize + imageAdditionalStride;
-                    }
-                } else {  // do a single copy
-                    memcpy(dstPointer, srcPointer, layerSize * depth);
-                }
-            }
-        }
-
         ResultOrError<UploadHandle> UploadTextureDataAligningBytesPerRowAndOffset(
             DeviceBase* device,
             const void* data,
@@ -117,7 +83,8 @@ namespace dawn_native {
 
             CopyTextureData(dstPointer, srcPointer, writeSizePixel.depthOrArrayLayers,
                             alignedRowsPerImage, imageAdditionalStride, alignedBytesPerRow,
-                            optimallyAlignedBytesPerRow, dataLayout.bytesPerRow);
+                            optimallyAlignedBytesPerRow, dataLayout.bytesPerRow,
+                            device->GetWorkerTaskPool());
 
             return uploadHandle;
         }
@@ -29,6 +29,27 @@ namespace dawn_native {
           mCommands(encoder->AcquireCommands()),
           mAttachmentState(std::move(attachmentState)),
           mResourceUsage(std::move(resourceUsage)) {
+        for (size_t i = 0; i < mResourceUsage.textures.size(); ++i) {
+            bool hasSingleUsage = true;
+            bool isFirstRange = true;
+            wgpu::TextureUsage firstUsage = wgpu::TextureUsage::None;
+            mResourceUsage.textureUsages[i].Iterate(
+                [&](const SubresourceRange&, const wgpu::TextureUsage& usage) {
+                    if (isFirstRange) {
+                        firstUsage = usage;
+                        isFirstRange = false;
+                    } else if (usage != firstUsage) {
+                        hasSingleUsage = false;
+                    }
+                });
+
+            if (hasSingleUsage) {
+                mUsageSummary.wholeTextures.push_back(mResourceUsage.textures[i]);
+                mUsageSummary.wholeTextureUsages.push_back(firstUsage);
+            } else {
+                mUsageSummary.partialTextureIndices.push_back(i);
+            }
+        }
     }
 
     RenderBundleBase::~RenderBundleBase() {
@@ -58,4 +79,9 @@ namespace dawn_native {
         return mResourceUsage;
     }
 
+    const RenderBundleUsageSummary& RenderBundleBase::GetUsageSummary() const {
+        ASSERT(!IsError());
+        return mUsageSummary;
+    }
+
 }  // namespace dawn_native
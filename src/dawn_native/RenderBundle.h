@@ -44,6 +44,7 @@ namespace dawn_native {
 
         const AttachmentState* GetAttachmentState() const;
         const RenderPassResourceUsage& GetResourceUsage() const;
+        const RenderBundleUsageSummary& GetUsageSummary() const;
 
       protected:
         ~RenderBundleBase() override;
@@ -54,6 +55,7 @@ namespace dawn_native {
         CommandIterator mCommands;
         Ref<AttachmentState> mAttachmentState;
         RenderPassResourceUsage mResourceUsage;
+        RenderBundleUsageSummary mUsageSummary;
     };
 
 }  // namespace dawn_native
@@ -56,22 +56,106 @@ namespace dawn_native {
         return std::move(mAttachmentState);
     }
 
+    void RenderEncoderBase::EnableDeferredDrawValidation() {
+        ASSERT(!IsError());
+        if (!IsValidationEnabled() ||
+            !GetDevice()->IsToggleEnabled(Toggle::DeferDrawValidation)) {
+            return;
+        }
+        mDeferDrawValidation = true;
+        mEncodingContext->SetDeferredDrawValidationEncoder(this);
+    }
+
+    void RenderEncoderBase::DisableDeferredDrawValidation() {
+        if (!mDeferDrawValidation) {
+            return;
+        }
+        mEncodingContext->ConsumedError(ValidateDeferredDraws());
+        mEncodingContext->SetDeferredDrawValidationEncoder(nullptr);
+        mDeferDrawValidation = false;
+    }
+
+    void RenderEncoderBase::DetachDeferredDrawValidation() {
+        if (!mDeferDrawValidation) {
+            return;
+        }
+        mDeferredDraws.Reset();
+        mEncodingContext->SetDeferredDrawValidationEncoder(nullptr);
+        mDeferDrawValidation = false;
+    }
+
+    MaybeError RenderEncoderBase::ValidateDeferredDraws() {
+        if (!mDeferredDraws.HasPendingDraws()) {
+            return {};
+        }
+        return mDeferredDraws.Validate(
+            [&](const DeferredDrawValidation::Draw& draw) -> MaybeError {
+                if (draw.indexed) {
+                    return ValidateDrawIndexed(draw.count, draw.instanceCount, draw.first,
+                                               draw.baseVertex, draw.firstInstance);
+                }
+                return ValidateDraw(draw.count, draw.instanceCount, draw.first,
+                                    draw.firstInstance);
+            });
+    }
+
+    void RenderEncoderBase::ValidateDeferredDrawsBeforeStateChange() {
+        if (mDeferDrawValidation) {
+            mEncodingContext->ConsumedError(ValidateDeferredDraws());
+        }
+    }
+
+    MaybeError RenderEncoderBase::ValidateDraw(uint32_t vertexCount,
+                                               uint32_t instanceCount,
+                                               uint32_t firstVertex,
+                                               uint32_t firstInstance) {
+        DAWN_TRY(mCommandBufferState.ValidateCanDraw());
+
+        if (mDisableBaseInstance && firstInstance != 0) {
+            return DAWN_VALIDATION_ERROR("Non-zero first instance not supported");
+        }
+
+        DAWN_TRY(
+            mCommandBufferState.ValidateBufferInRangeForVertexBuffer(vertexCount, firstVertex));
+        DAWN_TRY(mCommandBufferState.ValidateBufferInRangeForInstanceBuffer(instanceCount,
+                                                                            firstInstance));
+        return {};
+    }
+
+    MaybeError RenderEncoderBase::ValidateDrawIndexed(uint32_t indexCount,
+                                                      uint32_t instanceCount,
+                                                      uint32_t firstIndex,
+                                                      int32_t baseVertex,
+                                                      uint32_t firstInstance) {
+        DAWN_TRY(mCommandBufferState.ValidateCanDrawIndexed());
+
+        if (mDisableBaseInstance && firstInstance != 0) {
+            return DAWN_VALIDATION_ERROR("Non-zero first instance not supported");
+        }
+        if (mDisableBaseVertex && baseVertex != 0) {
+            return DAWN_VALIDATION_ERROR("Non-zero base vertex not supported");
+        }
+
+        DAWN_TRY(mCommandBufferState.ValidateIndexBufferInRange(indexCount, firstIndex));
+
+        // Although we don't know actual vertex access range in CPU, we still call the
+        // ValidateBufferInRangeForVertexBuffer in order to deal with those vertex step mode
+        // vertex buffer with an array stride of zero.
+        DAWN_TRY(mCommandBufferState.ValidateBufferInRangeForVertexBuffer(0, 0));
+        DAWN_TRY(mCommandBufferState.ValidateBufferInRangeForInstanceBuffer(instanceCount,
+                                                                            firstInstance));
+        return {};
+    }
+
     void RenderEncoderBase::APIDraw(uint32_t vertexCount,
                                     uint32_t instanceCount,
                                     uint32_t firstVertex,
                                     uint32_t firstInstance) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
-            if (IsValidationEnabled()) {
-                DAWN_TRY(mCommandBufferState.ValidateCanDraw());
-
-                if (mDisableBaseInstance && firstInstance != 0) {
-                    return DAWN_VALIDATION_ERROR("Non-zero first instance not supported");
-                }
-
-                DAWN_TRY(mCommandBufferState.ValidateBufferInRangeForVertexBuffer(vertexCount,
-                                                                                  firstVertex));
-                DAWN_TRY(mCommandBufferState.ValidateBufferInRangeForInstanceBuffer(instanceCount,
-                                                                                    firstInstance));
+            if (mDeferDrawValidation) {
+                mDeferredDraws.RecordDraw(vertexCount, instanceCount, firstVertex, firstInstance);
+            } else if (IsValidationEnabled()) {
+                DAWN_TRY(ValidateDraw(vertexCount, instanceCount, firstVertex, firstInstance));
             }
 
             DrawCmd* draw = allocator->Allocate<DrawCmd>(Command::Draw);
@@ -90,24 +174,12 @@ namespace dawn_native {
                                            int32_t baseVertex,
                                            uint32_t firstInstance) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
-            if (IsValidationEnabled()) {
-                DAWN_TRY(mCommandBufferState.ValidateCanDrawIndexed());
-
-                if (mDisableBaseInstance && firstInstance != 0) {
-                    return DAWN_VALIDATION_ERROR("Non-zero first instance not supported");
-                }
-                if (mDisableBaseVertex && baseVertex != 0) {
-                    return DAWN_VALIDATION_ERROR("Non-zero base vertex not supported");
-                }
-
-                DAWN_TRY(mCommandBufferState.ValidateIndexBufferInRange(indexCount, firstIndex));
-
-                // Although we don't know actual vertex access range in CPU, we still call the
-                // ValidateBufferInRangeForVertexBuffer in order to deal with those vertex step mode
-                // vertex buffer with an array stride of zero.
-                DAWN_TRY(mCommandBufferState.ValidateBufferInRangeForVertexBuffer(0, 0));
-                DAWN_TRY(mCommandBufferState.ValidateBufferInRangeForInstanceBuffer(instanceCount,
-                                                                                    firstInstance));
+            if (mDeferDrawValidation) {
+                mDeferredDraws.RecordDrawIndexed(indexCount, instanceCount, firstIndex, baseVertex,
+                                                 firstInstance);
+            } else if (IsValidationEnabled()) {
+                DAWN_TRY(ValidateDrawIndexed(indexCount, instanceCount, firstIndex, baseVertex,
+                                             firstInstance));
             }
 
             DrawIndexedCmd* draw = allocator->Allocate<DrawIndexedCmd>(Command::DrawIndexed);
@@ -189,6 +261,8 @@ namespace dawn_native {
 
     void RenderEncoderBase::APISetPipeline(RenderPipelineBase* pipeline) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            ValidateDeferredDrawsBeforeStateChange();
+
             if (IsValidationEnabled()) {
                 DAWN_TRY(GetDevice()->ValidateObject(pipeline));
 
@@ -214,6 +288,8 @@ namespace dawn_native {
                                               uint64_t offset,
                                               uint64_t size) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            ValidateDeferredDrawsBeforeStateChange();
+
             if (IsValidationEnabled()) {
                 DAWN_TRY(GetDevice()->ValidateObject(buffer));
                 DAWN_TRY(ValidateCanUseAs(buffer, wgpu::BufferUsage::Index));
@@ -267,6 +343,8 @@ namespace dawn_native {
                                                uint64_t offset,
                                                uint64_t size) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            ValidateDeferredDrawsBeforeStateChange();
+
             if (IsValidationEnabled()) {
                 DAWN_TRY(GetDevice()->ValidateObject(buffer));
                 DAWN_TRY(ValidateCanUseAs(buffer, wgpu::BufferUsage::Vertex));
@@ -318,6 +396,8 @@ namespace dawn_native {
                                             uint32_t dynamicOffsetCount,
                                             const uint32_t* dynamicOffsets) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            ValidateDeferredDrawsBeforeStateChange();
+
             BindGroupIndex groupIndex(groupIndexIn);
 
             if (IsValidationEnabled()) {
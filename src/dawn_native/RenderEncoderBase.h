@@ -17,6 +17,7 @@
 
 #include "dawn_native/AttachmentState.h"
 #include "dawn_native/CommandBufferStateTracker.h"
+#include "dawn_native/DeferredDrawValidation.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/PassResourceUsageTracker.h"
 #include "dawn_native/ProgrammablePassEncoder.h"
@@ -58,17 +59,46 @@ namespace dawn_native {
         const AttachmentState* GetAttachmentState() const;
         Ref<AttachmentState> AcquireAttachmentState();
 
+        // Validates the Draw and DrawIndexed calls recorded since the last state change when
+        // their validation is deferred.
+        MaybeError ValidateDeferredDraws();
+
+        // Stops deferring the validation of draws and drops the pending draws without validating
+        // them. Called when the encoding context stops accepting commands from this encoder.
+        void DetachDeferredDrawValidation();
+
       protected:
         // Construct an "error" render encoder base.
         RenderEncoderBase(DeviceBase* device, EncodingContext* encodingContext, ErrorTag errorTag);
 
+        // With the DeferDrawValidation toggle, Draw and DrawIndexed are recorded without being
+        // validated and are validated together before the next state change. The encoding context
+        // also validates them before handling any other error so that the same error is produced.
+        // Disabling the deferred validation validates the pending draws.
+        void EnableDeferredDrawValidation();
+        void DisableDeferredDrawValidation();
+        void ValidateDeferredDrawsBeforeStateChange();
+
         CommandBufferStateTracker mCommandBufferState;
         RenderPassResourceUsageTracker mUsageTracker;
 
       private:
+        MaybeError ValidateDraw(uint32_t vertexCount,
+                                uint32_t instanceCount,
+                                uint32_t firstVertex,
+                                uint32_t firstInstance);
+        MaybeError ValidateDrawIndexed(uint32_t indexCount,
+                                       uint32_t instanceCount,
+                                       uint32_t firstIndex,
+                                       int32_t baseVertex,
+                                       uint32_t firstInstance);
+
         Ref<AttachmentState> mAttachmentState;
         const bool mDisableBaseVertex;
         const bool mDisableBaseInstance;
+
+        bool mDeferDrawValidation = false;
+        DeferredDrawValidation mDeferredDraws;
     };
 
 }  // namespace dawn_native
@@ -62,6 +62,7 @@ namespace dawn_native {
           mRenderTargetHeight(renderTargetHeight),
           mOcclusionQuerySet(occlusionQuerySet) {
         mUsageTracker = std::move(usageTracker);
+        EnableDeferredDrawValidation();
     }
 
     RenderPassEncoder::RenderPassEncoder(DeviceBase* device,
@@ -71,6 +72,13 @@ namespace dawn_native {
         : RenderEncoderBase(device, encodingContext, errorTag), mCommandEncoder(commandEncoder) {
     }
 
+    RenderPassEncoder::~RenderPassEncoder() {
+        // The pass may be released without being ended, stop the encoding context from
+        // referencing it. Its pending draws are dropped: a pass that isn't ended can't produce a
+        // valid command buffer, and the encoding context may already be finished.
+        DetachDeferredDrawValidation();
+    }
+
     RenderPassEncoder* RenderPassEncoder::MakeError(DeviceBase* device,
                                                     CommandEncoder* commandEncoder,
                                                     EncodingContext* encodingContext) {
@@ -89,6 +97,8 @@ namespace dawn_native {
     }
 
     void RenderPassEncoder::APIEndPass() {
+        DisableDeferredDrawValidation();
+
         if (mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
                 if (IsValidationEnabled()) {
                     DAWN_TRY(ValidateProgrammableEncoderEnd());
@@ -199,6 +209,8 @@ namespace dawn_native {
     void RenderPassEncoder::APIExecuteBundles(uint32_t count,
                                               RenderBundleBase* const* renderBundles) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            ValidateDeferredDrawsBeforeStateChange();
+
             if (IsValidationEnabled()) {
                 for (uint32_t i = 0; i < count; ++i) {
                     DAWN_TRY(GetDevice()->ValidateObject(renderBundles[i]));
@@ -220,16 +232,7 @@ namespace dawn_native {
             Ref<RenderBundleBase>* bundles = allocator->AllocateData<Ref<RenderBundleBase>>(count);
             for (uint32_t i = 0; i < count; ++i) {
                 bundles[i] = renderBundles[i];
-
-                const RenderPassResourceUsage& usages = bundles[i]->GetResourceUsage();
-                for (uint32_t i = 0; i < usages.buffers.size(); ++i) {
-                    mUsageTracker.BufferUsedAs(usages.buffers[i], usages.bufferUsages[i]);
-                }
-
-                for (uint32_t i = 0; i < usages.textures.size(); ++i) {
-                    mUsageTracker.AddRenderBundleTextureUsage(usages.textures[i],
-                                                              usages.textureUsages[i]);
-                }
+                mUsageTracker.AddRenderBundle(renderBundles[i]);
             }
 
             return {};
@@ -37,6 +37,8 @@ namespace dawn_native {
                                             CommandEncoder* commandEncoder,
                                             EncodingContext* encodingContext);
 
+        ~RenderPassEncoder() override;
+
         void APIEndPass();
 
         void APISetStencilReference(uint32_t reference);
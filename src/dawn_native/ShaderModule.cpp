@@ -464,20 +464,17 @@ namespace dawn_native {
                                                             BindGroupIndex group,
                                                             const EntryPointMetadata& entryPoint,
                                                             const BindGroupLayoutBase* layout) {
-            const BindGroupLayoutBase::BindingMap& layoutBindings = layout->GetBindingMap();
-
             // Iterate over all bindings used by this group in the shader, and find the
             // corresponding binding in the BindGroupLayout, if it exists.
             for (const auto& it : entryPoint.bindings[group]) {
                 BindingNumber bindingNumber = it.first;
                 const ShaderBindingInfo& shaderInfo = it.second;
 
-                const auto& bindingIt = layoutBindings.find(bindingNumber);
-                if (bindingIt == layoutBindings.end()) {
+                BindingIndex bindingIndex = layout->FindBindingIndex(bindingNumber);
+                if (bindingIndex == BindGroupLayoutBase::kInvalidBindingIndex) {
                     return DAWN_VALIDATION_ERROR("Missing bind group layout entry for " +
                                                  GetShaderDeclarationString(group, bindingNumber));
                 }
-                BindingIndex bindingIndex(bindingIt->second);
                 const BindingInfo& layoutInfo = layout->GetBindingInfo(bindingIndex);
 
                 if (layoutInfo.bindingType != shaderInfo.bindingType) {
@@ -132,6 +132,11 @@ namespace dawn_native {
         template <typename F>
         void Iterate(F&& iterateFunc) const;
 
+        // Same as Iterate except that iterateFunc is only called with ranges that in aggregate
+        // form `range`. The storage isn't decompressed so the ranges are as large as possible.
+        template <typename F>
+        void Iterate(const SubresourceRange& range, F&& iterateFunc) const;
+
         // Given an updateFunc that's a function or function-like objet that can be called with
         // arguments of type (const SubresourceRange& range, T* data) and returns void,
         // calls it with ranges that in aggregate form `range` and pass for each of the
@@ -383,6 +388,43 @@ namespace dawn_native {
         }
     }
 
+    template <typename T>
+    template <typename F>
+    void SubresourceStorage<T>::Iterate(const SubresourceRange& range, F&& iterateFunc) const {
+        ASSERT(range.baseArrayLayer + range.layerCount <= mArrayLayerCount);
+        ASSERT(range.baseMipLevel + range.levelCount <= mMipLevelCount);
+
+        for (Aspect aspect : IterateEnumMask(range.aspects)) {
+            uint32_t aspectIndex = GetAspectIndex(aspect);
+
+            // Fastest path, call iterateFunc on the part of the range in the aspect at once.
+            if (mAspectCompressed[aspectIndex]) {
+                SubresourceRange aspectRange = range;
+                aspectRange.aspects = aspect;
+                iterateFunc(aspectRange, DataInline(aspectIndex));
+                continue;
+            }
+
+            uint32_t layerEnd = range.baseArrayLayer + range.layerCount;
+            for (uint32_t layer = range.baseArrayLayer; layer < layerEnd; layer++) {
+                // Fast path, call iterateFunc on the part of the range in the layer at once.
+                if (LayerCompressed(aspectIndex, layer)) {
+                    SubresourceRange layerRange(aspect, {layer, 1},
+                                                {range.baseMipLevel, range.levelCount});
+                    iterateFunc(layerRange, Data(aspectIndex, layer));
+                    continue;
+                }
+
+                // Slow path, call iterateFunc for each mip level.
+                uint32_t levelEnd = range.baseMipLevel + range.levelCount;
+                for (uint32_t level = range.baseMipLevel; level < levelEnd; level++) {
+                    SubresourceRange levelRange = SubresourceRange::MakeSingle(aspect, layer, level);
+                    iterateFunc(levelRange, Data(aspectIndex, layer, level));
+                }
+            }
+        }
+    }
+
     template <typename T>
     const T& SubresourceStorage<T>::Get(Aspect aspect,
                                         uint32_t arrayLayer,
@@ -441,11 +441,11 @@ namespace dawn_native {
           mSampleCount(descriptor->sampleCount),
           mUsage(descriptor->usage),
           mInternalUsage(mUsage),
-          mState(state) {
-        uint32_t subresourceCount =
-            mMipLevelCount * GetArrayLayers() * GetAspectCount(mFormat.aspects);
-        mIsSubresourceContentInitializedAtIndex = std::vector<bool>(subresourceCount, false);
-
+          mState(state),
+          mIsSubresourceContentInitialized(mFormat.aspects,
+                                           GetArrayLayers(),
+                                           mMipLevelCount,
+                                           false) {
         const DawnTextureInternalUsageDescriptor* internalUsageDesc = nullptr;
         FindInChain(descriptor->nextInChain, &internalUsageDesc);
         if (internalUsageDesc != nullptr) {
@@ -462,7 +462,10 @@ namespace dawn_native {
     static Format kUnusedFormat;
 
     TextureBase::TextureBase(DeviceBase* device, ObjectBase::ErrorTag tag)
-        : ObjectBase(device, tag), mFormat(kUnusedFormat) {
+        : ObjectBase(device, tag),
+          mFormat(kUnusedFormat),
+          // Error textures don't track their content, use an empty storage.
+          mIsSubresourceContentInitialized(Aspect::Color, 0, 0) {
     }
 
     // static
@@ -520,7 +523,7 @@ namespace dawn_native {
     }
     uint32_t TextureBase::GetSubresourceCount() const {
         ASSERT(!IsError());
-        return static_cast<uint32_t>(mIsSubresourceContentInitializedAtIndex.size());
+        return mMipLevelCount * GetArrayLayers() * GetAspectCount(mFormat.aspects);
     }
     wgpu::TextureUsage TextureBase::GetUsage() const {
         ASSERT(!IsError());
@@ -551,36 +554,21 @@ namespace dawn_native {
 
     bool TextureBase::IsSubresourceContentInitialized(const SubresourceRange& range) const {
         ASSERT(!IsError());
-        for (Aspect aspect : IterateEnumMask(range.aspects)) {
-            for (uint32_t arrayLayer = range.baseArrayLayer;
-                 arrayLayer < range.baseArrayLayer + range.layerCount; ++arrayLayer) {
-                for (uint32_t mipLevel = range.baseMipLevel;
-                     mipLevel < range.baseMipLevel + range.levelCount; ++mipLevel) {
-                    uint32_t subresourceIndex = GetSubresourceIndex(mipLevel, arrayLayer, aspect);
-                    ASSERT(subresourceIndex < mIsSubresourceContentInitializedAtIndex.size());
-                    if (!mIsSubresourceContentInitializedAtIndex[subresourceIndex]) {
-                        return false;
-                    }
-                }
-            }
-        }
-        return true;
+        bool isInitialized = true;
+        mIsSubresourceContentInitialized.Iterate(
+            range, [&](const SubresourceRange&, bool isRangeInitialized) {
+                isInitialized &= isRangeInitialized;
+            });
+        return isInitialized;
     }
 
     void TextureBase::SetIsSubresourceContentInitialized(bool isInitialized,
                                                          const SubresourceRange& range) {
         ASSERT(!IsError());
-        for (Aspect aspect : IterateEnumMask(range.aspects)) {
-            for (uint32_t arrayLayer = range.baseArrayLayer;
-                 arrayLayer < range.baseArrayLayer + range.layerCount; ++arrayLayer) {
-                for (uint32_t mipLevel = range.baseMipLevel;
-                     mipLevel < range.baseMipLevel + range.levelCount; ++mipLevel) {
-                    uint32_t subresourceIndex = GetSubresourceIndex(mipLevel, arrayLayer, aspect);
-                    ASSERT(subresourceIndex < mIsSubresourceContentInitializedAtIndex.size());
-                    mIsSubresourceContentInitializedAtIndex[subresourceIndex] = isInitialized;
-                }
-            }
-        }
+        mIsSubresourceContentInitialized.Update(
+            range, [&](const SubresourceRange&, bool* isRangeInitialized) {
+                *isRangeInitialized = isInitialized;
+            });
     }
 
     MaybeError TextureBase::ValidateCanUseInSubmitNow() const {
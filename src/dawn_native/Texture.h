@@ -21,6 +21,7 @@
 #include "dawn_native/Forward.h"
 #include "dawn_native/ObjectBase.h"
 #include "dawn_native/Subresource.h"
+#include "dawn_native/SubresourceStorage.h"
 
 #include "dawn_native/dawn_platform.h"
 
@@ -109,8 +110,9 @@ namespace dawn_native {
         wgpu::TextureUsage mInternalUsage = wgpu::TextureUsage::None;
         TextureState mState;
 
-        // TODO(crbug.com/dawn/845): Use a more optimized data structure to save space
-        std::vector<bool> mIsSubresourceContentInitializedAtIndex;
+        // Compressed per aspect and per layer so that the common cases of textures fully
+        // initialized, or initialized layer by layer, are tracked without per-subresource data.
+        SubresourceStorage<bool> mIsSubresourceContentInitialized;
     };
 
     class TextureViewBase : public ObjectBase {
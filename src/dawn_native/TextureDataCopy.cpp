@@ -0,0 +1,194 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/TextureDataCopy.h"
+
+#include "common/Assert.h"
+#include "dawn_platform/DawnPlatform.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace dawn_native {
+
+    namespace {
+
+        // Copies smaller than this are always done on the calling thread.
+        constexpr uint64_t kMinParallelCopySize = 16 * 1024 * 1024;
+        // The minimum amount of data copied by each thread of a parallel copy.
+        constexpr uint64_t kMinBytesPerCopyTask = 4 * 1024 * 1024;
+        // The maximum number of threads, including the calling thread, used by a copy.
+        constexpr uint64_t kMaxCopyTaskCount = 4;
+
+        struct CopyParams {
+            uint8_t* dstPointer;
+            const uint8_t* srcPointer;
+            uint32_t rowsPerImage;
+            uint64_t srcBytesPerImage;
+            uint32_t actualBytesPerRow;
+            uint32_t dstBytesPerRow;
+            uint32_t srcBytesPerRow;
+        };
+
+        // The size of the copies is known at compile time so they are inlined as a few vector
+        // loads and stores instead of calls to memcpy.
+        template <uint32_t kRowSize>
+        void CopyFixedSizeRows(uint8_t* dst,
+                               const uint8_t* src,
+                               uint32_t rowCount,
+                               uint32_t dstBytesPerRow,
+                               uint32_t srcBytesPerRow) {
+            for (uint32_t row = 0; row < rowCount; ++row) {
+                memcpy(dst, src, kRowSize);
+                dst += dstBytesPerRow;
+                src += srcBytesPerRow;
+            }
+        }
+
+        void CopyRows(uint8_t* dst,
+                      const uint8_t* src,
+                      uint32_t rowCount,
+                      uint32_t actualBytesPerRow,
+                      uint32_t dstBytesPerRow,
+                      uint32_t srcBytesPerRow) {
+            if (actualBytesPerRow == dstBytesPerRow && actualBytesPerRow == srcBytesPerRow) {
+                memcpy(dst, src, uint64_t(rowCount) * actualBytesPerRow);
+                return;
+            }
+
+            switch (actualBytesPerRow) {
+                case 4:
+                    CopyFixedSizeRows<4>(dst, src, rowCount, dstBytesPerRow, srcBytesPerRow);
+                    break;
+                case 8:
+                    CopyFixedSizeRows<8>(dst, src, rowCount, dstBytesPerRow, srcBytesPerRow);
+                    break;
+                case 16:
+                    CopyFixedSizeRows<16>(dst, src, rowCount, dstBytesPerRow, srcBytesPerRow);
+                    break;
+                case 32:
+                    CopyFixedSizeRows<32>(dst, src, rowCount, dstBytesPerRow, srcBytesPerRow);
+                    break;
+                case 64:
+                    CopyFixedSizeRows<64>(dst, src, rowCount, dstBytesPerRow, srcBytesPerRow);
+                    break;
+                case 128:
+                    CopyFixedSizeRows<128>(dst, src, rowCount, dstBytesPerRow, srcBytesPerRow);
+                    break;
+                default:
+                    for (uint32_t row = 0; row < rowCount; ++row) {
+                        memcpy(dst, src, actualBytesPerRow);
+                        dst += dstBytesPerRow;
+                        src += srcBytesPerRow;
+                    }
+                    break;
+            }
+        }
+
+        // Copies the rows [firstRow, firstRow + rowCount) where the rows of all the images are
+        // numbered consecutively.
+        void CopyRowRange(const CopyParams& params, uint64_t firstRow, uint64_t rowCount) {
+            uint64_t row = firstRow;
+            uint64_t rowEnd = firstRow + rowCount;
+            while (row < rowEnd) {
+                uint64_t image = row / params.rowsPerImage;
+                uint32_t rowInImage = static_cast<uint32_t>(row % params.rowsPerImage);
+                uint32_t copiedRowCount = static_cast<uint32_t>(
+                    std::min<uint64_t>(rowEnd - row, params.rowsPerImage - rowInImage));
+
+                CopyRows(params.dstPointer + row * params.dstBytesPerRow,
+                         params.srcPointer + image * params.srcBytesPerImage +
+                             uint64_t(rowInImage) * params.srcBytesPerRow,
+                         copiedRowCount, params.actualBytesPerRow, params.dstBytesPerRow,
+                         params.srcBytesPerRow);
+                row += copiedRowCount;
+            }
+        }
+
+        struct CopyTask {
+            const CopyParams* params;
+            uint64_t firstRow;
+            uint64_t rowCount;
+        };
+
+        void DoCopyTask(void* userdata) {
+            const CopyTask* task = static_cast<const CopyTask*>(userdata);
+            CopyRowRange(*task->params, task->firstRow, task->rowCount);
+        }
+
+    }  // anonymous namespace
+
+    void CopyTextureData(uint8_t* dstPointer,
+                         const uint8_t* srcPointer,
+                         uint32_t depth,
+                         uint32_t rowsPerImage,
+                         uint64_t imageAdditionalStride,
+                         uint32_t actualBytesPerRow,
+                         uint32_t dstBytesPerRow,
+                         uint32_t srcBytesPerRow,
+                         dawn_platform::WorkerTaskPool* workerTaskPool) {
+        ASSERT(actualBytesPerRow <= dstBytesPerRow && actualBytesPerRow <= srcBytesPerRow);
+        if (depth == 0 || rowsPerImage == 0 || actualBytesPerRow == 0) {
+            return;
+        }
+
+        CopyParams params;
+        params.dstPointer = dstPointer;
+        params.srcPointer = srcPointer;
+        params.actualBytesPerRow = actualBytesPerRow;
+        params.dstBytesPerRow = dstBytesPerRow;
+        params.srcBytesPerRow = srcBytesPerRow;
+        uint64_t rowCount = uint64_t(depth) * rowsPerImage;
+        if (imageAdditionalStride == 0) {
+            // The rows of all the images are evenly spaced so they can be copied as one image.
+            params.rowsPerImage = static_cast<uint32_t>(
+                std::min<uint64_t>(rowCount, std::numeric_limits<uint32_t>::max()));
+        } else {
+            params.rowsPerImage = rowsPerImage;
+        }
+        params.srcBytesPerImage =
+            uint64_t(params.rowsPerImage) * srcBytesPerRow + imageAdditionalStride;
+
+        uint64_t copySize = rowCount * actualBytesPerRow;
+        if (workerTaskPool == nullptr || copySize < kMinParallelCopySize) {
+            CopyRowRange(params, 0, rowCount);
+            return;
+        }
+
+        // Split the rows between the calling thread, which copies the first range, and tasks
+        // posted on the worker pool, then wait for the tasks to complete.
+        uint64_t taskCount = std::min(kMaxCopyTaskCount, copySize / kMinBytesPerCopyTask);
+        uint64_t rowsPerTask = (rowCount + taskCount - 1) / taskCount;
+
+        std::vector<CopyTask> tasks;
+        tasks.reserve(taskCount);
+        for (uint64_t firstRow = 0; firstRow < rowCount; firstRow += rowsPerTask) {
+            tasks.push_back({&params, firstRow, std::min(rowsPerTask, rowCount - firstRow)});
+        }
+
+        std::vector<std::unique_ptr<dawn_platform::WaitableEvent>> events;
+        events.reserve(tasks.size() - 1);
+        for (size_t i = 1; i < tasks.size(); ++i) {
+            events.push_back(workerTaskPool->PostWorkerTask(DoCopyTask, &tasks[i]));
+        }
+        DoCopyTask(&tasks[0]);
+        for (const std::unique_ptr<dawn_platform::WaitableEvent>& event : events) {
+            event->Wait();
+        }
+    }
+
+}  // namespace dawn_native
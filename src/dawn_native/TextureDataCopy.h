@@ -0,0 +1,46 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_TEXTUREDATACOPY_H_
+#define DAWNNATIVE_TEXTUREDATACOPY_H_
+
+#include <cstdint>
+
+namespace dawn_platform {
+    class WorkerTaskPool;
+}  // namespace dawn_platform
+
+namespace dawn_native {
+
+    // Copies |depth| images of |rowsPerImage| rows of |actualBytesPerRow| bytes of texture data
+    // from |srcPointer| to |dstPointer|. The rows are |srcBytesPerRow| and |dstBytesPerRow| apart
+    // and the source images are additionally separated by |imageAdditionalStride| bytes while the
+    // destination images are tightly packed.
+    //
+    // Contiguous data is copied at once and small rows are copied with fixed-size copies. When a
+    // |workerTaskPool| is given, the rows of very large copies are split between it and the
+    // calling thread. The copy is complete when the function returns.
+    void CopyTextureData(uint8_t* dstPointer,
+                         const uint8_t* srcPointer,
+                         uint32_t depth,
+                         uint32_t rowsPerImage,
+                         uint64_t imageAdditionalStride,
+                         uint32_t actualBytesPerRow,
+                         uint32_t dstBytesPerRow,
+                         uint32_t srcBytesPerRow,
+                         dawn_platform::WorkerTaskPool* workerTaskPool = nullptr);
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_TEXTUREDATACOPY_H_
@@ -217,6 +217,12 @@ namespace dawn_native {
               "Enables calls to SetLabel to be forwarded to backend-specific APIs that label "
               "objects.",
               "https://crbug.com/dawn/840"}},
+            {Toggle::DeferDrawValidation,
+             {"defer_draw_validation",
+              "Validates the draws of a render pass once before each change of the pipeline, bind "
+              "groups or vertex and index buffers instead of at each draw. The same errors are "
+              "produced but the validation of the draws using the same state is shared.",
+              "https://bugs.chromium.org/p/dawn/issues/list?q=defer_draw_validation"}},
             // Dummy comment to separate the }} so it is clearer what to copy-paste to add a toggle.
         }};
     }  // anonymous namespace
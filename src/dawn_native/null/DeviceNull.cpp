@@ -16,6 +16,7 @@
 
 #include "dawn_native/BackendConnection.h"
 #include "dawn_native/Commands.h"
+#include "dawn_native/EnumMaskIterator.h"
 #include "dawn_native/ErrorData.h"
 #include "dawn_native/Instance.h"
 #include "dawn_native/Surface.h"
@@ -65,6 +66,98 @@ namespace dawn_native { namespace null {
         return new Backend(instance);
     }
 
+    namespace {
+
+        // Copies |imageCount| images of |rowCount| rows of |bytesPerRow| bytes. Contiguous images
+        // and rows are copied with a single memcpy so that the copy runs at memory bandwidth for
+        // tightly packed data.
+        void CopyImages(uint8_t* dst,
+                        uint64_t dstBytesPerRow,
+                        uint64_t dstBytesPerImage,
+                        const uint8_t* src,
+                        uint64_t srcBytesPerRow,
+                        uint64_t srcBytesPerImage,
+                        uint64_t bytesPerRow,
+                        uint32_t rowCount,
+                        uint32_t imageCount) {
+            bool rowsArePacked = dstBytesPerRow == bytesPerRow && srcBytesPerRow == bytesPerRow;
+            uint64_t bytesPerImage = bytesPerRow * rowCount;
+
+            if (rowsArePacked && dstBytesPerImage == bytesPerImage &&
+                srcBytesPerImage == bytesPerImage) {
+                memcpy(dst, src, bytesPerImage * imageCount);
+                return;
+            }
+
+            for (uint32_t image = 0; image < imageCount; ++image) {
+                uint8_t* dstImage = dst + image * dstBytesPerImage;
+                const uint8_t* srcImage = src + image * srcBytesPerImage;
+                if (rowsArePacked) {
+                    memcpy(dstImage, srcImage, bytesPerImage);
+                    continue;
+                }
+                for (uint32_t row = 0; row < rowCount; ++row) {
+                    memcpy(dstImage + row * dstBytesPerRow, srcImage + row * srcBytesPerRow,
+                           bytesPerRow);
+                }
+            }
+        }
+
+        // Copies between a texture and linear data described by a TextureDataLayout.
+        enum class TextureCopyDirection { LinearToTexture, TextureToLinear };
+        MaybeError CopyBetweenTextureAndLinearData(TextureCopyDirection direction,
+                                                   uint8_t* linearData,
+                                                   const TextureDataLayout& layout,
+                                                   const TextureCopy& textureCopy,
+                                                   const Extent3D& copySize) {
+            Texture* texture = ToBackend(textureCopy.texture.Get());
+            const TexelBlockInfo& blockInfo =
+                texture->GetFormat().GetAspectInfo(textureCopy.aspect).block;
+
+            Texture::DataLayout textureLayout;
+            DAWN_TRY_ASSIGN(textureLayout,
+                            texture->GetDataLayout(textureCopy.aspect, textureCopy.mipLevel,
+                                                   textureCopy.origin));
+
+            uint32_t rowCount = copySize.height / blockInfo.height;
+            uint64_t bytesPerRow = uint64_t(copySize.width / blockInfo.width) * blockInfo.byteSize;
+            uint64_t linearBytesPerImage = uint64_t(layout.bytesPerRow) * layout.rowsPerImage;
+            uint8_t* linear = linearData + layout.offset;
+
+            if (direction == TextureCopyDirection::LinearToTexture) {
+                CopyImages(textureLayout.data, textureLayout.bytesPerRow,
+                           textureLayout.bytesPerImage, linear, layout.bytesPerRow,
+                           linearBytesPerImage, bytesPerRow, rowCount,
+                           copySize.depthOrArrayLayers);
+            } else {
+                CopyImages(linear, layout.bytesPerRow, linearBytesPerImage, textureLayout.data,
+                           textureLayout.bytesPerRow, textureLayout.bytesPerImage, bytesPerRow,
+                           rowCount, copySize.depthOrArrayLayers);
+            }
+            return {};
+        }
+
+        TextureDataLayout ToTextureDataLayout(const BufferCopy& bufferCopy) {
+            TextureDataLayout layout;
+            layout.offset = bufferCopy.offset;
+            layout.bytesPerRow = bufferCopy.bytesPerRow;
+            layout.rowsPerImage = bufferCopy.rowsPerImage;
+            return layout;
+        }
+
+        // Marks the subresources written by a copy as initialized, clearing them first if the
+        // copy doesn't overwrite them completely.
+        MaybeError PrepareTextureCopyDestination(const TextureCopy& dst, const Extent3D& copySize) {
+            SubresourceRange range = GetSubresourcesAffectedByCopy(dst, copySize);
+            if (IsCompleteSubresourceCopiedTo(dst.texture.Get(), copySize, dst.mipLevel)) {
+                dst.texture->SetIsSubresourceContentInitialized(true, range);
+                return {};
+            }
+            return ToBackend(dst.texture)->EnsureSubresourceContentInitialized(range);
+        }
+
+    }  // anonymous namespace
+
     struct CopyFromStagingToBufferOperation : PendingOperation {
         virtual void Execute() {
             destination->CopyFromStaging(staging, sourceOffset, destinationOffset, size);
@@ -202,7 +295,12 @@ namespace dawn_native { namespace null {
                                                 const TextureDataLayout& src,
                                                 TextureCopy* dst,
                                                 const Extent3D& copySizePixels) {
-        return {};
+        // The queue operations are ordered with the submits, which are executed immediately, so
+        // the texture can be written immediately as well.
+        DAWN_TRY(PrepareTextureCopyDestination(*dst, copySizePixels));
+        uint8_t* stagingData = static_cast<uint8_t*>(source->GetMappedPointer());
+        return CopyBetweenTextureAndLinearData(TextureCopyDirection::LinearToTexture, stagingData,
+                                               src, *dst, copySizePixels);
     }
 
     MaybeError Device::IncrementMemoryUsage(uint64_t bytes) {
@@ -266,7 +364,9 @@ namespace dawn_native { namespace null {
 
     Buffer::Buffer(Device* device, const BufferDescriptor* descriptor)
         : BufferBase(device, descriptor) {
-        mBackingData = std::unique_ptr<uint8_t[]>(new uint8_t[GetSize()]);
+        // Zero-initialized so that the contents read back from the Null backend are
+        // deterministic, like lazily cleared buffers on the other backends.
+        mBackingData = std::unique_ptr<uint8_t[]>(new uint8_t[GetSize()]());
         mAllocatedSize = GetSize();
     }
 
@@ -299,6 +399,10 @@ namespace dawn_native { namespace null {
         memcpy(mBackingData.get() + bufferOffset, data, size);
     }
 
+    uint8_t* Buffer::GetBackingData() {
+        return mBackingData.get();
+    }
+
     MaybeError Buffer::MapAsyncImpl(wgpu::MapMode mode, size_t offset, size_t size) {
         return {};
     }
@@ -319,6 +423,100 @@ namespace dawn_native { namespace null {
         : CommandBufferBase(encoder, descriptor) {
     }
 
+    MaybeError CommandBuffer::Execute() {
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            switch (type) {
+                case Command::CopyBufferToBuffer: {
+                    CopyBufferToBufferCmd* copy = mCommands.NextCommand<CopyBufferToBufferCmd>();
+                    if (copy->size == 0) {
+                        break;
+                    }
+
+                    Buffer* srcBuffer = ToBackend(copy->source.Get());
+                    Buffer* dstBuffer = ToBackend(copy->destination.Get());
+                    // Buffers can't be copied to themselves so the ranges don't overlap.
+                    memcpy(dstBuffer->GetBackingData() + copy->destinationOffset,
+                           srcBuffer->GetBackingData() + copy->sourceOffset, copy->size);
+                    break;
+                }
+
+                case Command::CopyBufferToTexture: {
+                    CopyBufferToTextureCmd* copy = mCommands.NextCommand<CopyBufferToTextureCmd>();
+                    if (copy->copySize.width == 0 || copy->copySize.height == 0 ||
+                        copy->copySize.depthOrArrayLayers == 0) {
+                        break;
+                    }
+
+                    DAWN_TRY(PrepareTextureCopyDestination(copy->destination, copy->copySize));
+                    DAWN_TRY(CopyBetweenTextureAndLinearData(
+                        TextureCopyDirection::LinearToTexture,
+                        ToBackend(copy->source.buffer)->GetBackingData(),
+                        ToTextureDataLayout(copy->source), copy->destination, copy->copySize));
+                    break;
+                }
+
+                case Command::CopyTextureToBuffer: {
+                    CopyTextureToBufferCmd* copy = mCommands.NextCommand<CopyTextureToBufferCmd>();
+                    if (copy->copySize.width == 0 || copy->copySize.height == 0 ||
+                        copy->copySize.depthOrArrayLayers == 0) {
+                        break;
+                    }
+
+                    DAWN_TRY(ToBackend(copy->source.texture)
+                                 ->EnsureSubresourceContentInitialized(
+                                     GetSubresourcesAffectedByCopy(copy->source, copy->copySize)));
+                    DAWN_TRY(CopyBetweenTextureAndLinearData(
+                        TextureCopyDirection::TextureToLinear,
+                        ToBackend(copy->destination.buffer)->GetBackingData(),
+                        ToTextureDataLayout(copy->destination), copy->source, copy->copySize));
+                    break;
+                }
+
+                case Command::CopyTextureToTexture: {
+                    CopyTextureToTextureCmd* copy =
+                        mCommands.NextCommand<CopyTextureToTextureCmd>();
+                    if (copy->copySize.width == 0 || copy->copySize.height == 0 ||
+                        copy->copySize.depthOrArrayLayers == 0) {
+                        break;
+                    }
+
+                    Texture* srcTexture = ToBackend(copy->source.texture.Get());
+                    DAWN_TRY(srcTexture->EnsureSubresourceContentInitialized(
+                        GetSubresourcesAffectedByCopy(copy->source, copy->copySize)));
+                    DAWN_TRY(PrepareTextureCopyDestination(copy->destination, copy->copySize));
+
+                    Texture::DataLayout srcLayout;
+                    DAWN_TRY_ASSIGN(srcLayout, srcTexture->GetDataLayout(copy->source.aspect,
+                                                                         copy->source.mipLevel,
+                                                                         copy->source.origin));
+                    Texture::DataLayout dstLayout;
+                    DAWN_TRY_ASSIGN(dstLayout, ToBackend(copy->destination.texture)
+                                                   ->GetDataLayout(copy->destination.aspect,
+                                                                   copy->destination.mipLevel,
+                                                                   copy->destination.origin));
+
+                    // Both textures have the same format and sample count, and the copied
+                    // subresources don't overlap.
+                    const TexelBlockInfo& blockInfo =
+                        srcTexture->GetFormat().GetAspectInfo(copy->source.aspect).block;
+                    uint64_t bytesPerRow = uint64_t(copy->copySize.width / blockInfo.width) *
+                                           blockInfo.byteSize * srcTexture->GetSampleCount();
+                    CopyImages(dstLayout.data, dstLayout.bytesPerRow, dstLayout.bytesPerImage,
+                               srcLayout.data, srcLayout.bytesPerRow, srcLayout.bytesPerImage,
+                               bytesPerRow, copy->copySize.height / blockInfo.height,
+                               copy->copySize.depthOrArrayLayers);
+                    break;
+                }
+
+                default:
+                    SkipCommand(&mCommands, type);
+                    break;
+            }
+        }
+        return {};
+    }
+
     // QuerySet
 
     QuerySet::QuerySet(Device* device, const QuerySetDescriptor* descriptor)
@@ -340,13 +538,18 @@ namespace dawn_native { namespace null {
     Queue::~Queue() {
     }
 
-    MaybeError Queue::SubmitImpl(uint32_t, CommandBufferBase* const*) {
+    MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) {
         Device* device = ToBackend(GetDevice());
 
         // The Vulkan, D3D12 and Metal implementation all tick the device here,
         // for testing purposes we should also tick in the null implementation.
         DAWN_TRY(device->Tick());
 
+        // The pending operations were executed by the Tick so the commands see their results.
+        for (uint32_t i = 0; i < commandCount; ++i) {
+            DAWN_TRY(ToBackend(commands[i])->Execute());
+        }
+
         return device->SubmitPendingOperations();
     }
 
@@ -394,8 +597,8 @@ namespace dawn_native { namespace null {
     ResultOrError<TextureViewBase*> SwapChain::GetCurrentTextureViewImpl() {
         TextureDescriptor textureDesc = GetSwapChainBaseTextureDescriptor(this);
         // TODO(dawn:723): change to not use AcquireRef for reentrant object creation.
-        mTexture = AcquireRef(
-            new Texture(GetDevice(), &textureDesc, TextureBase::TextureState::OwnedInternal));
+        mTexture = AcquireRef(new Texture(ToBackend(GetDevice()), &textureDesc,
+                                          TextureBase::TextureState::OwnedInternal));
         // TODO(dawn:723): change to not use AcquireRef for reentrant object creation.
         return mTexture->APICreateView();
     }
@@ -407,6 +610,103 @@ namespace dawn_native { namespace null {
         }
     }
 
+    // Texture
+
+    Texture::Texture(Device* device, const TextureDescriptor* descriptor, TextureState state)
+        : TextureBase(device, descriptor, state) {
+    }
+
+    Texture::~Texture() {
+        DestroyInternal();
+    }
+
+    void Texture::DestroyImpl() {
+        if (mBackingData != nullptr) {
+            mBackingData = nullptr;
+            ToBackend(GetDevice())->DecrementMemoryUsage(mBackingDataSize);
+        }
+    }
+
+    ResultOrError<Texture::DataLayout> Texture::GetDataLayout(Aspect aspect,
+                                                              uint32_t mipLevel,
+                                                              const Origin3D& origin) {
+        ASSERT(HasOneBit(aspect));
+        ASSERT(mipLevel < GetNumMipLevels());
+        const TexelBlockInfo& blockInfo = GetFormat().GetAspectInfo(aspect).block;
+
+        if (mBackingData == nullptr) {
+            ASSERT(GetTextureState() != TextureState::Destroyed);
+
+            mLevelOffsets.resize(GetAspectCount(GetFormat().aspects) * GetNumMipLevels());
+            uint64_t size = 0;
+            for (Aspect levelAspect : IterateEnumMask(GetFormat().aspects)) {
+                for (uint32_t level = 0; level < GetNumMipLevels(); ++level) {
+                    const TexelBlockInfo& levelBlockInfo =
+                        GetFormat().GetAspectInfo(levelAspect).block;
+                    Extent3D levelSize = GetMipLevelPhysicalSize(level);
+                    uint32_t imageCount = GetDimension() == wgpu::TextureDimension::e3D
+                                              ? levelSize.depthOrArrayLayers
+                                              : GetArrayLayers();
+
+                    mLevelOffsets[GetAspectIndex(levelAspect) * GetNumMipLevels() + level] = size;
+                    size += uint64_t(levelSize.width / levelBlockInfo.width) *
+                            levelBlockInfo.byteSize * GetSampleCount() *
+                            (levelSize.height / levelBlockInfo.height) * imageCount;
+                }
+            }
+
+            DAWN_TRY(ToBackend(GetDevice())->IncrementMemoryUsage(size));
+            mBackingDataSize = size;
+            mBackingData = std::unique_ptr<uint8_t[]>(new uint8_t[size]());
+        }
+
+        Extent3D levelSize = GetMipLevelPhysicalSize(mipLevel);
+        DataLayout layout;
+        layout.bytesPerRow =
+            uint64_t(levelSize.width / blockInfo.width) * blockInfo.byteSize * GetSampleCount();
+        layout.bytesPerImage = layout.bytesPerRow * (levelSize.height / blockInfo.height);
+        layout.data = mBackingData.get() +
+                      mLevelOffsets[GetAspectIndex(aspect) * GetNumMipLevels() + mipLevel] +
+                      origin.z * layout.bytesPerImage +
+                      (origin.y / blockInfo.height) * layout.bytesPerRow +
+                      uint64_t(origin.x / blockInfo.width) * blockInfo.byteSize * GetSampleCount();
+        return layout;
+    }
+
+    MaybeError Texture::EnsureSubresourceContentInitialized(const SubresourceRange& range) {
+        if (!GetDevice()->IsToggleEnabled(Toggle::LazyClearResourceOnFirstUse)) {
+            return {};
+        }
+
+        for (Aspect aspect : IterateEnumMask(range.aspects)) {
+            for (uint32_t level = range.baseMipLevel;
+                 level < range.baseMipLevel + range.levelCount; ++level) {
+                for (uint32_t layer = range.baseArrayLayer;
+                     layer < range.baseArrayLayer + range.layerCount; ++layer) {
+                    SubresourceRange subresource =
+                        SubresourceRange::SingleMipAndLayer(level, layer, aspect);
+                    if (IsSubresourceContentInitialized(subresource)) {
+                        continue;
+                    }
+
+                    // The depth slices of a 3D texture are a single subresource.
+                    Origin3D origin;
+                    origin.z = layer;
+                    DataLayout layout;
+                    DAWN_TRY_ASSIGN(layout, GetDataLayout(aspect, level, origin));
+                    uint32_t imageCount = GetDimension() == wgpu::TextureDimension::e3D
+                                              ? GetMipLevelPhysicalSize(level).depthOrArrayLayers
+                                              : 1;
+                    memset(layout.data, 0, layout.bytesPerImage * imageCount);
+
+                    SetIsSubresourceContentInitialized(true, subresource);
+                    GetDevice()->IncrementLazyClearCountForTesting();
+                }
+            }
+        }
+        return {};
+    }
+
     // ShaderModule
 
     MaybeError ShaderModule::Initialize(ShaderModuleParseResult* parseResult) {
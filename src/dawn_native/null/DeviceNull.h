@@ -52,7 +52,7 @@ namespace dawn_native { namespace null {
     using Sampler = SamplerBase;
     class ShaderModule;
     class SwapChain;
-    using Texture = TextureBase;
+    class Texture;
     using TextureView = TextureViewBase;
 
     struct NullBackendTraits {
@@ -210,6 +210,8 @@ namespace dawn_native { namespace null {
 
         void DoWriteBuffer(uint64_t bufferOffset, const void* data, size_t size);
 
+        uint8_t* GetBackingData();
+
       private:
         ~Buffer() override;
         MaybeError MapAsyncImpl(wgpu::MapMode mode, size_t offset, size_t size) override;
@@ -225,6 +227,10 @@ namespace dawn_native { namespace null {
     class CommandBuffer final : public CommandBufferBase {
       public:
         CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor);
+
+        // Executes the copy commands on the CPU backing stores of the buffers and textures. The
+        // other commands are skipped.
+        MaybeError Execute();
     };
 
     class QuerySet final : public QuerySetBase {
@@ -250,6 +256,39 @@ namespace dawn_native { namespace null {
                                    size_t size) override;
     };
 
+    class Texture final : public TextureBase {
+      public:
+        Texture(Device* device, const TextureDescriptor* descriptor, TextureState state);
+
+        // The texel blocks of a subresource are stored in tightly packed rows, and the array
+        // layers or depth slices of a mip level are tightly packed images.
+        struct DataLayout {
+            // The first byte of the texel block at the requested origin.
+            uint8_t* data;
+            uint64_t bytesPerRow;
+            uint64_t bytesPerImage;
+        };
+
+        // Returns where the texel blocks of |aspect| at |origin| in |mipLevel| are stored. The
+        // backing store is allocated on first use so that textures that are never copied to or
+        // from don't use memory.
+        ResultOrError<DataLayout> GetDataLayout(Aspect aspect,
+                                                uint32_t mipLevel,
+                                                const Origin3D& origin);
+
+        MaybeError EnsureSubresourceContentInitialized(const SubresourceRange& range);
+
+      private:
+        ~Texture() override;
+        void DestroyImpl() override;
+
+        // The offsets of each mip level of each aspect in mBackingData, indexed by
+        // GetAspectIndex(aspect) * GetNumMipLevels() + mipLevel.
+        std::vector<uint64_t> mLevelOffsets;
+        uint64_t mBackingDataSize = 0;
+        std::unique_ptr<uint8_t[]> mBackingData;
+    };
+
     class ShaderModule final : public ShaderModuleBase {
       public:
         using ShaderModuleBase::ShaderModuleBase;
@@ -21,12 +21,11 @@
 namespace dawn_native { namespace opengl {
 
     MaybeError ValidateGLBindGroupDescriptor(const BindGroupDescriptor* descriptor) {
-        const BindGroupLayoutBase::BindingMap& bindingMap = descriptor->layout->GetBindingMap();
         for (uint32_t i = 0; i < descriptor->entryCount; ++i) {
             const BindGroupEntry& entry = descriptor->entries[i];
 
-            const auto& it = bindingMap.find(BindingNumber(entry.binding));
-            BindingIndex bindingIndex = it->second;
+            BindingIndex bindingIndex =
+                descriptor->layout->FindBindingIndexOfEntry(i, BindingNumber(entry.binding));
             ASSERT(bindingIndex < descriptor->layout->GetBindingCount());
 
             const BindingInfo& bindingInfo = descriptor->layout->GetBindingInfo(bindingIndex);
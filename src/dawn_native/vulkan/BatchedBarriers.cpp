@@ -0,0 +1,101 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/vulkan/BatchedBarriers.h"
+
+#include "common/Assert.h"
+#include "dawn_native/vulkan/VulkanFunctions.h"
+
+namespace dawn_native { namespace vulkan {
+
+    namespace {
+
+        bool RangesOverlap(const SubresourceRange& a, const SubresourceRange& b) {
+            return (a.aspects & b.aspects) != Aspect::None &&
+                   a.baseMipLevel < b.baseMipLevel + b.levelCount &&
+                   b.baseMipLevel < a.baseMipLevel + a.levelCount &&
+                   a.baseArrayLayer < b.baseArrayLayer + b.layerCount &&
+                   b.baseArrayLayer < a.baseArrayLayer + a.layerCount;
+        }
+
+    }  // anonymous namespace
+
+    // BatchedBarriers
+
+    bool BatchedBarriers::IsEmpty() const {
+        return bufferBarriers.empty() && imageBarriers.empty();
+    }
+
+    void BatchedBarriers::Record(const VulkanFunctions& fn, VkCommandBuffer commands) {
+        if (!IsEmpty()) {
+            ASSERT(srcStages != 0 && dstStages != 0);
+            fn.CmdPipelineBarrier(commands, srcStages, dstStages, 0, 0, nullptr,
+                                  bufferBarriers.size(), bufferBarriers.data(),
+                                  imageBarriers.size(), imageBarriers.data());
+        }
+
+        bufferBarriers.clear();
+        imageBarriers.clear();
+        srcStages = 0;
+        dstStages = 0;
+    }
+
+    // TransferBatchTracker
+
+    bool TransferBatchTracker::CanUseBuffer(VkBuffer buffer, bool isWrite) const {
+        auto it = mBufferWrites.find(buffer.GetHandle());
+        if (it == mBufferWrites.end()) {
+            return true;
+        }
+        return !isWrite && !it->second;
+    }
+
+    bool TransferBatchTracker::CanUseTexture(VkImage image,
+                                             const SubresourceRange& range,
+                                             bool isWrite) const {
+        auto it = mTextureUses.find(image.GetHandle());
+        if (it == mTextureUses.end()) {
+            return true;
+        }
+
+        for (const TextureUse& use : it->second) {
+            if ((isWrite || use.isWrite) && RangesOverlap(range, use.range)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void TransferBatchTracker::UseBuffer(VkBuffer buffer, bool isWrite) {
+        ASSERT(CanUseBuffer(buffer, isWrite));
+        mBufferWrites[buffer.GetHandle()] |= isWrite;
+    }
+
+    void TransferBatchTracker::UseTexture(VkImage image,
+                                          const SubresourceRange& range,
+                                          bool isWrite) {
+        ASSERT(CanUseTexture(image, range, isWrite));
+        mTextureUses[image.GetHandle()].push_back({range, isWrite});
+    }
+
+    bool TransferBatchTracker::IsEmpty() const {
+        return mBufferWrites.empty() && mTextureUses.empty();
+    }
+
+    void TransferBatchTracker::Reset() {
+        mBufferWrites.clear();
+        mTextureUses.clear();
+    }
+
+}}  // namespace dawn_native::vulkan
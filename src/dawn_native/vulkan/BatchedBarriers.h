@@ -0,0 +1,72 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_BATCHEDBARRIERS_H_
+#define DAWNNATIVE_VULKAN_BATCHEDBARRIERS_H_
+
+#include "common/vulkan_platform.h"
+#include "dawn_native/Subresource.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace dawn_native { namespace vulkan {
+
+    struct VulkanFunctions;
+
+    // The barriers of several resources, gathered so that they are recorded with a single
+    // vkCmdPipelineBarrier.
+    struct BatchedBarriers {
+        bool IsEmpty() const;
+
+        // Records the barriers, if any, and clears them.
+        void Record(const VulkanFunctions& fn, VkCommandBuffer commands);
+
+        std::vector<VkBufferMemoryBarrier> bufferBarriers;
+        std::vector<VkImageMemoryBarrier> imageBarriers;
+        VkPipelineStageFlags srcStages = 0;
+        VkPipelineStageFlags dstStages = 0;
+    };
+
+    // Tracks the resources used by a batch of consecutive transfer commands whose barriers are
+    // all recorded before the first command of the batch. A command can only join the batch if
+    // it doesn't need a barrier after the commands already in it: it must not write a resource
+    // that they use, or use a resource that they write.
+    class TransferBatchTracker {
+      public:
+        bool CanUseBuffer(VkBuffer buffer, bool isWrite) const;
+        // For depth-stencil textures, whose aspects are transitioned together, |range| must
+        // contain both aspects.
+        bool CanUseTexture(VkImage image, const SubresourceRange& range, bool isWrite) const;
+
+        void UseBuffer(VkBuffer buffer, bool isWrite);
+        void UseTexture(VkImage image, const SubresourceRange& range, bool isWrite);
+
+        bool IsEmpty() const;
+        void Reset();
+
+      private:
+        struct TextureUse {
+            SubresourceRange range;
+            bool isWrite;
+        };
+
+        // Whether each buffer is written by the batch.
+        std::unordered_map<::VkBuffer, bool> mBufferWrites;
+        std::unordered_map<::VkImage, std::vector<TextureUse>> mTextureUses;
+    };
+
+}}  // namespace dawn_native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_BATCHEDBARRIERS_H_
@@ -18,6 +18,7 @@
 #include "common/ityp_vector.h"
 #include "dawn_native/vulkan/BindGroupVk.h"
 #include "dawn_native/vulkan/DescriptorSetAllocator.h"
+#include "dawn_native/vulkan/DescriptorSetUpdater.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/VulkanError.h"
@@ -119,8 +120,11 @@ namespace dawn_native { namespace vulkan {
                                     device->GetVkDevice(), &createInfo, nullptr, &*mHandle),
                                 "CreateDescriptorSetLayout"));
 
-        // Compute the size of descriptor pools used for this layout.
+        // Compute the size of descriptor pools used for this layout, and the type of the
+        // descriptor of each binding for the updates of the descriptor sets.
         std::map<VkDescriptorType, uint32_t> descriptorCountPerType;
+        std::vector<VkDescriptorType> descriptorTypes;
+        descriptorTypes.reserve(static_cast<uint32_t>(GetBindingCount()));
 
         for (BindingIndex bindingIndex{0}; bindingIndex < GetBindingCount(); ++bindingIndex) {
             // TODO(dawn:728) In the future, special handling will be needed for external textures
@@ -129,8 +133,16 @@ namespace dawn_native { namespace vulkan {
 
             // map::operator[] will return 0 if the key doesn't exist.
             descriptorCountPerType[vulkanType]++;
+            descriptorTypes.push_back(vulkanType);
         }
 
+        bool useUpdateTemplate =
+            device->GetDeviceInfo().HasExt(DeviceExt::DescriptorUpdateTemplate);
+        DAWN_TRY_ASSIGN(mDescriptorSetUpdater,
+                        DescriptorSetUpdater::Create(&device->fn, device->GetVkDevice(), mHandle,
+                                                     std::move(descriptorTypes),
+                                                     useUpdateTemplate));
+
         // TODO(enga): Consider deduping allocators for layouts with the same descriptor type
         // counts.
         mDescriptorSetAllocator =
@@ -163,6 +175,10 @@ namespace dawn_native { namespace vulkan {
         return mHandle;
     }
 
+    const DescriptorSetUpdater* BindGroupLayout::GetDescriptorSetUpdater() const {
+        return mDescriptorSetUpdater.get();
+    }
+
     ResultOrError<Ref<BindGroup>> BindGroupLayout::AllocateBindGroup(
         Device* device,
         const BindGroupDescriptor* descriptor) {
@@ -27,6 +27,7 @@ namespace dawn_native { namespace vulkan {
     class BindGroup;
     struct DescriptorSetAllocation;
     class DescriptorSetAllocator;
+    class DescriptorSetUpdater;
     class Device;
 
     VkDescriptorType VulkanDescriptorType(const BindingInfo& bindingInfo);
@@ -52,6 +53,7 @@ namespace dawn_native { namespace vulkan {
         BindGroupLayout(DeviceBase* device, const BindGroupLayoutDescriptor* descriptor);
 
         VkDescriptorSetLayout GetHandle() const;
+        const DescriptorSetUpdater* GetDescriptorSetUpdater() const;
 
         ResultOrError<Ref<BindGroup>> AllocateBindGroup(Device* device,
                                                         const BindGroupDescriptor* descriptor);
@@ -67,6 +69,7 @@ namespace dawn_native { namespace vulkan {
 
         SlabAllocator<BindGroup> mBindGroupAllocator;
         std::unique_ptr<DescriptorSetAllocator> mDescriptorSetAllocator;
+        std::unique_ptr<DescriptorSetUpdater> mDescriptorSetUpdater;
     };
 
 }}  // namespace dawn_native::vulkan
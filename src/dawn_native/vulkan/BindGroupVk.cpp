@@ -19,6 +19,7 @@
 #include "dawn_native/ExternalTexture.h"
 #include "dawn_native/vulkan/BindGroupLayoutVk.h"
 #include "dawn_native/vulkan/BufferVk.h"
+#include "dawn_native/vulkan/DescriptorSetUpdater.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/SamplerVk.h"
@@ -38,95 +39,60 @@ namespace dawn_native { namespace vulkan {
                          DescriptorSetAllocation descriptorSetAllocation)
         : BindGroupBase(this, device, descriptor),
           mDescriptorSetAllocation(descriptorSetAllocation) {
-        // Now do a write of a single descriptor set with all possible chained data allocated on the
-        // stack.
+        // Gather the descriptors of all the bindings in a packed array, with data allocated on
+        // the stack, and write them with the updater precomputed by the layout.
         const uint32_t bindingCount = static_cast<uint32_t>((GetLayout()->GetBindingCount()));
-        ityp::stack_vec<uint32_t, VkWriteDescriptorSet, kMaxOptimalBindingsPerGroup> writes(
+        ityp::stack_vec<uint32_t, DescriptorInfo, kMaxOptimalBindingsPerGroup> descriptors(
             bindingCount);
-        ityp::stack_vec<uint32_t, VkDescriptorBufferInfo, kMaxOptimalBindingsPerGroup>
-            writeBufferInfo(bindingCount);
-        ityp::stack_vec<uint32_t, VkDescriptorImageInfo, kMaxOptimalBindingsPerGroup>
-            writeImageInfo(bindingCount);
-
-        uint32_t numWrites = 0;
-        for (const auto& it : GetLayout()->GetBindingMap()) {
-            BindingIndex bindingIndex = it.second;
-            const BindingInfo& bindingInfo = GetLayout()->GetBindingInfo(bindingIndex);
 
-            auto& write = writes[numWrites];
-            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            write.pNext = nullptr;
-            write.dstSet = GetHandle();
-            write.dstBinding = static_cast<uint32_t>(bindingIndex);
-            write.dstArrayElement = 0;
-            write.descriptorCount = 1;
-            write.descriptorType = VulkanDescriptorType(bindingInfo);
+        for (BindingIndex bindingIndex{0}; bindingIndex < GetLayout()->GetBindingCount();
+             ++bindingIndex) {
+            const BindingInfo& bindingInfo = GetLayout()->GetBindingInfo(bindingIndex);
+            DescriptorInfo& descriptor = descriptors[static_cast<uint32_t>(bindingIndex)];
 
             switch (bindingInfo.bindingType) {
                 case BindingInfoType::Buffer: {
                     BufferBinding binding = GetBindingAsBufferBinding(bindingIndex);
 
-                    VkBuffer handle = ToBackend(binding.buffer)->GetHandle();
-                    if (handle == VK_NULL_HANDLE) {
-                        // The Buffer was destroyed. Skip this descriptor write since it would be
-                        // a Vulkan Validation Layers error. This bind group won't be used as it
-                        // is an error to submit a command buffer that references destroyed
-                        // resources.
-                        continue;
-                    }
-                    writeBufferInfo[numWrites].buffer = handle;
-                    writeBufferInfo[numWrites].offset = binding.offset;
-                    writeBufferInfo[numWrites].range = binding.size;
-                    write.pBufferInfo = &writeBufferInfo[numWrites];
+                    // The handle is VK_NULL_HANDLE if the Buffer was destroyed, in which case
+                    // the updater skips this descriptor.
+                    descriptor.buffer.buffer = ToBackend(binding.buffer)->GetHandle();
+                    descriptor.buffer.offset = binding.offset;
+                    descriptor.buffer.range = binding.size;
                     break;
                 }
 
                 case BindingInfoType::Sampler: {
                     Sampler* sampler = ToBackend(GetBindingAsSampler(bindingIndex));
-                    writeImageInfo[numWrites].sampler = sampler->GetHandle();
-                    write.pImageInfo = &writeImageInfo[numWrites];
+                    descriptor.image.sampler = sampler->GetHandle();
+                    descriptor.image.imageView = VK_NULL_HANDLE;
+                    descriptor.image.imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
                     break;
                 }
 
                 case BindingInfoType::Texture: {
                     TextureView* view = ToBackend(GetBindingAsTextureView(bindingIndex));
 
-                    VkImageView handle = view->GetHandle();
-                    if (handle == VK_NULL_HANDLE) {
-                        // The Texture was destroyed before the TextureView was created.
-                        // Skip this descriptor write since it would be
-                        // a Vulkan Validation Layers error. This bind group won't be used as it
-                        // is an error to submit a command buffer that references destroyed
-                        // resources.
-                        continue;
-                    }
-                    writeImageInfo[numWrites].imageView = handle;
+                    // The handle is VK_NULL_HANDLE if the Texture was destroyed before the
+                    // TextureView was created, in which case the updater skips this descriptor.
+                    descriptor.image.sampler = VK_NULL_HANDLE;
+                    descriptor.image.imageView = view->GetHandle();
 
                     // The layout may be GENERAL here because of interactions between the Sampled
                     // and ReadOnlyStorage usages. See the logic in VulkanImageLayout.
-                    writeImageInfo[numWrites].imageLayout = VulkanImageLayout(
+                    descriptor.image.imageLayout = VulkanImageLayout(
                         ToBackend(view->GetTexture()), wgpu::TextureUsage::TextureBinding);
-
-                    write.pImageInfo = &writeImageInfo[numWrites];
                     break;
                 }
 
                 case BindingInfoType::StorageTexture: {
                     TextureView* view = ToBackend(GetBindingAsTextureView(bindingIndex));
 
-                    VkImageView handle = view->GetHandle();
-                    if (handle == VK_NULL_HANDLE) {
-                        // The Texture was destroyed before the TextureView was created.
-                        // Skip this descriptor write since it would be
-                        // a Vulkan Validation Layers error. This bind group won't be used as it
-                        // is an error to submit a command buffer that references destroyed
-                        // resources.
-                        continue;
-                    }
-                    writeImageInfo[numWrites].imageView = handle;
-                    writeImageInfo[numWrites].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-
-                    write.pImageInfo = &writeImageInfo[numWrites];
+                    // The handle is VK_NULL_HANDLE if the Texture was destroyed before the
+                    // TextureView was created, in which case the updater skips this descriptor.
+                    descriptor.image.sampler = VK_NULL_HANDLE;
+                    descriptor.image.imageView = view->GetHandle();
+                    descriptor.image.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
                     break;
                 }
 
@@ -141,21 +107,16 @@ namespace dawn_native { namespace vulkan {
 
                     TextureView* view = ToBackend(textureViews[0].Get());
 
-                    writeImageInfo[numWrites].imageView = view->GetHandle();
-                    writeImageInfo[numWrites].imageLayout = VulkanImageLayout(
+                    descriptor.image.sampler = VK_NULL_HANDLE;
+                    descriptor.image.imageView = view->GetHandle();
+                    descriptor.image.imageLayout = VulkanImageLayout(
                         ToBackend(view->GetTexture()), wgpu::TextureUsage::TextureBinding);
-
-                    write.pImageInfo = &writeImageInfo[numWrites];
                     break;
                 }
             }
-
-            numWrites++;
         }
 
-        // TODO(crbug.com/dawn/855): Batch these updates
-        device->fn.UpdateDescriptorSets(device->GetVkDevice(), numWrites, writes.data(), 0,
-                                        nullptr);
+        ToBackend(GetLayout())->GetDescriptorSetUpdater()->Update(GetHandle(), descriptors.data());
     }
 
     BindGroup::~BindGroup() {
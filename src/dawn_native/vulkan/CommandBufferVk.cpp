@@ -20,12 +20,14 @@
 #include "dawn_native/Commands.h"
 #include "dawn_native/EnumMaskIterator.h"
 #include "dawn_native/RenderBundle.h"
+#include "dawn_native/vulkan/BatchedBarriers.h"
 #include "dawn_native/vulkan/BindGroupVk.h"
 #include "dawn_native/vulkan/BufferVk.h"
 #include "dawn_native/vulkan/CommandRecordingContext.h"
 #include "dawn_native/vulkan/ComputePipelineVk.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/FramebufferCache.h"
 #include "dawn_native/vulkan/PipelineLayoutVk.h"
 #include "dawn_native/vulkan/QuerySetVk.h"
 #include "dawn_native/vulkan/RenderPassCache.h"
@@ -61,6 +63,18 @@ namespace dawn_native { namespace vulkan {
                    imageExtentSrc.depthOrArrayLayers == imageExtentDst.depthOrArrayLayers;
         }
 
+        bool IsTransferCommand(Command type) {
+            switch (type) {
+                case Command::CopyBufferToBuffer:
+                case Command::CopyBufferToTexture:
+                case Command::CopyTextureToBuffer:
+                case Command::CopyTextureToTexture:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
         VkImageCopy ComputeImageCopyRegion(const TextureCopy& srcCopy,
                                            const TextureCopy& dstCopy,
                                            const Extent3D& copySize,
@@ -151,10 +165,7 @@ namespace dawn_native { namespace vulkan {
         void TransitionAndClearForSyncScope(Device* device,
                                             CommandRecordingContext* recordingContext,
                                             const SyncScopeResourceUsage& scope) {
-            std::vector<VkBufferMemoryBarrier> bufferBarriers;
-            std::vector<VkImageMemoryBarrier> imageBarriers;
-            VkPipelineStageFlags srcStages = 0;
-            VkPipelineStageFlags dstStages = 0;
+            BatchedBarriers barriers;
 
             for (size_t i = 0; i < scope.buffers.size(); ++i) {
                 Buffer* buffer = ToBackend(scope.buffers[i]);
@@ -162,8 +173,9 @@ namespace dawn_native { namespace vulkan {
 
                 VkBufferMemoryBarrier bufferBarrier;
                 if (buffer->TransitionUsageAndGetResourceBarrier(
-                        scope.bufferUsages[i], &bufferBarrier, &srcStages, &dstStages)) {
-                    bufferBarriers.push_back(bufferBarrier);
+                        scope.bufferUsages[i], &bufferBarrier, &barriers.srcStages,
+                        &barriers.dstStages)) {
+                    barriers.bufferBarriers.push_back(bufferBarrier);
                 }
             }
 
@@ -180,15 +192,11 @@ namespace dawn_native { namespace vulkan {
                         }
                     });
                 texture->TransitionUsageForPass(recordingContext, scope.textureUsages[i],
-                                                &imageBarriers, &srcStages, &dstStages);
+                                                &barriers.imageBarriers, &barriers.srcStages,
+                                                &barriers.dstStages);
             }
 
-            if (bufferBarriers.size() || imageBarriers.size()) {
-                device->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages,
-                                              0, 0, nullptr, bufferBarriers.size(),
-                                              bufferBarriers.data(), imageBarriers.size(),
-                                              imageBarriers.data());
-            }
+            barriers.Record(device->fn, recordingContext->commandBuffer);
         }
 
         MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
@@ -224,21 +232,21 @@ namespace dawn_native { namespace vulkan {
                 DAWN_TRY_ASSIGN(renderPassVK, device->GetRenderPassCache()->GetRenderPass(query));
             }
 
-            // Create a framebuffer that will be used once for the render pass and gather the clear
-            // values for the attachments at the same time.
+            // Query a framebuffer from the cache and gather the clear values for the attachments at
+            // the same time.
             std::array<VkClearValue, kMaxColorAttachments + 1> clearValues;
             VkFramebuffer framebuffer = VK_NULL_HANDLE;
             uint32_t attachmentCount = 0;
             {
-                // Fill in the attachment info that will be chained in the framebuffer create info.
-                std::array<VkImageView, kMaxColorAttachments * 2 + 1> attachments;
+                FramebufferCacheQuery query;
+                query.SetRenderPass(renderPassVK, renderPass->width, renderPass->height);
 
                 for (ColorAttachmentIndex i :
                      IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
                     auto& attachmentInfo = renderPass->colorAttachments[i];
                     TextureView* view = ToBackend(attachmentInfo.view.Get());
 
-                    attachments[attachmentCount] = view->GetHandle();
+                    query.AddAttachment(view->GetHandle());
 
                     switch (view->GetFormat().GetAspectInfo(Aspect::Color).baseType) {
                         case wgpu::TextureComponentType::Float: {
@@ -277,7 +285,7 @@ namespace dawn_native { namespace vulkan {
                     auto& attachmentInfo = renderPass->depthStencilAttachment;
                     TextureView* view = ToBackend(attachmentInfo.view.Get());
 
-                    attachments[attachmentCount] = view->GetHandle();
+                    query.AddAttachment(view->GetHandle());
 
                     clearValues[attachmentCount].depthStencil.depth = attachmentInfo.clearDepth;
                     clearValues[attachmentCount].depthStencil.stencil = attachmentInfo.clearStencil;
@@ -291,32 +299,13 @@ namespace dawn_native { namespace vulkan {
                         TextureView* view =
                             ToBackend(renderPass->colorAttachments[i].resolveTarget.Get());
 
-                        attachments[attachmentCount] = view->GetHandle();
+                        query.AddAttachment(view->GetHandle());
 
                         attachmentCount++;
                     }
                 }
 
-                // Chain attachments and create the framebuffer
-                VkFramebufferCreateInfo createInfo;
-                createInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-                createInfo.pNext = nullptr;
-                createInfo.flags = 0;
-                createInfo.renderPass = renderPassVK;
-                createInfo.attachmentCount = attachmentCount;
-                createInfo.pAttachments = AsVkArray(attachments.data());
-                createInfo.width = renderPass->width;
-                createInfo.height = renderPass->height;
-                createInfo.layers = 1;
-
-                DAWN_TRY(
-                    CheckVkSuccess(device->fn.CreateFramebuffer(device->GetVkDevice(), &createInfo,
-                                                                nullptr, &*framebuffer),
-                                   "CreateFramebuffer"));
-
-                // We don't reuse VkFramebuffers so mark the framebuffer for deletion as soon as the
-                // commands currently being recorded are finished.
-                device->GetFencedDeleter()->DeleteWhenUnused(framebuffer);
+                DAWN_TRY_ASSIGN(framebuffer, device->GetFramebufferCache()->GetFramebuffer(query));
             }
 
             VkRenderPassBeginInfo beginInfo;
@@ -490,153 +479,190 @@ namespace dawn_native { namespace vulkan {
         recordingContext->tempBuffers.emplace_back(tempBuffer);
     }
 
-    MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingContext) {
-        Device* device = ToBackend(GetDevice());
-        VkCommandBuffer commands = recordingContext->commandBuffer;
-
-        // Records the necessary barriers for the resource usage pre-computed by the frontend.
-        // And resets the used query sets which are rewritten on the render pass.
-        auto PrepareResourcesForRenderPass = [](Device* device,
-                                                CommandRecordingContext* recordingContext,
-                                                const RenderPassResourceUsage& usages) {
-            TransitionAndClearForSyncScope(device, recordingContext, usages);
-
-            // Reset all query set used on current render pass together before beginning render pass
-            // because the reset command must be called outside render pass
-            for (size_t i = 0; i < usages.querySets.size(); ++i) {
-                ResetUsedQuerySetsOnRenderPass(device, recordingContext->commandBuffer,
-                                               usages.querySets[i], usages.queryAvailabilities[i]);
-            }
+    // A transfer command gathered by RecordTransfers, with the resources that it uses.
+    struct TransferCommand {
+        // A buffer or a range of a texture used by the transfer.
+        struct ResourceUse {
+            Buffer* buffer = nullptr;
+            Texture* texture = nullptr;
+            SubresourceRange range;
+            bool isWrite = false;
         };
 
-        size_t nextComputePassNumber = 0;
-        size_t nextRenderPassNumber = 0;
-
         Command type;
-        while (mCommands.NextCommandId(&type)) {
-            switch (type) {
-                case Command::CopyBufferToBuffer: {
-                    CopyBufferToBufferCmd* copy = mCommands.NextCommand<CopyBufferToBufferCmd>();
-                    if (copy->size == 0) {
-                        // Skip no-op copies.
-                        break;
-                    }
-
-                    Buffer* srcBuffer = ToBackend(copy->source.Get());
-                    Buffer* dstBuffer = ToBackend(copy->destination.Get());
+        union {
+            CopyBufferToBufferCmd* bufferToBuffer;
+            CopyBufferToTextureCmd* bufferToTexture;
+            CopyTextureToBufferCmd* textureToBuffer;
+            CopyTextureToTextureCmd* textureToTexture;
+        };
+        std::array<ResourceUse, 2> uses;  // The source, then the destination.
+    };
 
-                    srcBuffer->EnsureDataInitialized(recordingContext);
-                    dstBuffer->EnsureDataInitializedAsDestination(
-                        recordingContext, copy->destinationOffset, copy->size);
+    namespace {
 
-                    srcBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
-                    dstBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
+        TransferCommand::ResourceUse BufferUse(BufferBase* buffer, bool isWrite) {
+            TransferCommand::ResourceUse use;
+            use.buffer = ToBackend(buffer);
+            use.isWrite = isWrite;
+            return use;
+        }
 
-                    VkBufferCopy region;
-                    region.srcOffset = copy->sourceOffset;
-                    region.dstOffset = copy->destinationOffset;
-                    region.size = copy->size;
+        TransferCommand::ResourceUse TextureUse(const TextureCopy& copy,
+                                                const Extent3D& copySize,
+                                                bool isWrite) {
+            TransferCommand::ResourceUse use;
+            use.texture = ToBackend(copy.texture.Get());
+            use.range = GetSubresourcesAffectedByCopy(copy, copySize);
+            use.isWrite = isWrite;
+            return use;
+        }
 
-                    VkBuffer srcHandle = srcBuffer->GetHandle();
-                    VkBuffer dstHandle = dstBuffer->GetHandle();
-                    device->fn.CmdCopyBuffer(commands, srcHandle, dstHandle, 1, &region);
-                    break;
+        // Reads the transfer command of type |type|. Returns false for no-op copies, which
+        // aren't recorded.
+        bool NextTransferCommand(CommandIterator* commands,
+                                 Command type,
+                                 TransferCommand* transfer) {
+            transfer->type = type;
+            switch (type) {
+                case Command::CopyBufferToBuffer: {
+                    CopyBufferToBufferCmd* copy = commands->NextCommand<CopyBufferToBufferCmd>();
+                    transfer->bufferToBuffer = copy;
+                    transfer->uses = {BufferUse(copy->source.Get(), false),
+                                      BufferUse(copy->destination.Get(), true)};
+                    return copy->size != 0;
                 }
 
                 case Command::CopyBufferToTexture: {
-                    CopyBufferToTextureCmd* copy = mCommands.NextCommand<CopyBufferToTextureCmd>();
+                    CopyBufferToTextureCmd* copy = commands->NextCommand<CopyBufferToTextureCmd>();
+                    transfer->bufferToTexture = copy;
                     if (copy->copySize.width == 0 || copy->copySize.height == 0 ||
                         copy->copySize.depthOrArrayLayers == 0) {
-                        // Skip no-op copies.
-                        continue;
+                        return false;
                     }
-                    auto& src = copy->source;
-                    auto& dst = copy->destination;
+                    ASSERT(copy->destination.texture->GetDimension() !=
+                           wgpu::TextureDimension::e1D);
+                    transfer->uses = {BufferUse(copy->source.buffer.Get(), false),
+                                      TextureUse(copy->destination, copy->copySize, true)};
+                    return true;
+                }
 
-                    ToBackend(src.buffer)->EnsureDataInitialized(recordingContext);
+                case Command::CopyTextureToBuffer: {
+                    CopyTextureToBufferCmd* copy = commands->NextCommand<CopyTextureToBufferCmd>();
+                    transfer->textureToBuffer = copy;
+                    if (copy->copySize.width == 0 || copy->copySize.height == 0 ||
+                        copy->copySize.depthOrArrayLayers == 0) {
+                        return false;
+                    }
+                    ASSERT(copy->source.texture->GetDimension() != wgpu::TextureDimension::e1D);
+                    transfer->uses = {TextureUse(copy->source, copy->copySize, false),
+                                      BufferUse(copy->destination.buffer.Get(), true)};
+                    return true;
+                }
 
-                    VkBufferImageCopy region =
-                        ComputeBufferImageCopyRegion(src, dst, copy->copySize);
-                    VkImageSubresourceLayers subresource = region.imageSubresource;
+                case Command::CopyTextureToTexture: {
+                    CopyTextureToTextureCmd* copy =
+                        commands->NextCommand<CopyTextureToTextureCmd>();
+                    transfer->textureToTexture = copy;
+                    if (copy->copySize.width == 0 || copy->copySize.height == 0 ||
+                        copy->copySize.depthOrArrayLayers == 0) {
+                        return false;
+                    }
+                    transfer->uses = {TextureUse(copy->source, copy->copySize, false),
+                                      TextureUse(copy->destination, copy->copySize, true)};
+                    return true;
+                }
+
+                default:
+                    UNREACHABLE();
+            }
+        }
+
+        // The range of the texture tracked by the TransferBatchTracker for |use|: the depth and
+        // stencil aspects are transitioned together so they can't be used separately in a batch.
+        SubresourceRange GetTrackedRange(const TransferCommand::ResourceUse& use) {
+            SubresourceRange range = use.range;
+            if (use.texture->GetFormat().aspects == (Aspect::Depth | Aspect::Stencil)) {
+                range.aspects = Aspect::Depth | Aspect::Stencil;
+            }
+            return range;
+        }
+
+        bool CanAddToBatch(const TransferBatchTracker& tracker, const TransferCommand& transfer) {
+            for (const TransferCommand::ResourceUse& use : transfer.uses) {
+                bool canUse =
+                    use.buffer != nullptr
+                        ? tracker.CanUseBuffer(use.buffer->GetHandle(), use.isWrite)
+                        : tracker.CanUseTexture(use.texture->GetHandle(), GetTrackedRange(use),
+                                                use.isWrite);
+                if (!canUse) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void AddToBatch(TransferBatchTracker* tracker, const TransferCommand& transfer) {
+            for (const TransferCommand::ResourceUse& use : transfer.uses) {
+                if (use.buffer != nullptr) {
+                    tracker->UseBuffer(use.buffer->GetHandle(), use.isWrite);
+                } else {
+                    tracker->UseTexture(use.texture->GetHandle(), GetTrackedRange(use),
+                                        use.isWrite);
+                }
+            }
+        }
+
+        // Lazily initializes the resources of a transfer, or marks the subresources that it
+        // overwrites completely as initialized.
+        void InitializeTransferResources(CommandRecordingContext* recordingContext,
+                                         const TransferCommand& transfer) {
+            switch (transfer.type) {
+                case Command::CopyBufferToBuffer: {
+                    CopyBufferToBufferCmd* copy = transfer.bufferToBuffer;
+                    ToBackend(copy->source)->EnsureDataInitialized(recordingContext);
+                    ToBackend(copy->destination)
+                        ->EnsureDataInitializedAsDestination(
+                            recordingContext, copy->destinationOffset, copy->size);
+                    break;
+                }
 
-                    ASSERT(dst.texture->GetDimension() != wgpu::TextureDimension::e1D);
-                    SubresourceRange range =
-                        GetSubresourcesAffectedByCopy(copy->destination, copy->copySize);
+                case Command::CopyBufferToTexture: {
+                    CopyBufferToTextureCmd* copy = transfer.bufferToTexture;
+                    TextureCopy& dst = copy->destination;
+                    const SubresourceRange& range = transfer.uses[1].range;
 
+                    ToBackend(copy->source.buffer)->EnsureDataInitialized(recordingContext);
                     if (IsCompleteSubresourceCopiedTo(dst.texture.Get(), copy->copySize,
-                                                      subresource.mipLevel)) {
+                                                      dst.mipLevel)) {
                         // Since texture has been overwritten, it has been "initialized"
                         dst.texture->SetIsSubresourceContentInitialized(true, range);
                     } else {
                         ToBackend(dst.texture)
                             ->EnsureSubresourceContentInitialized(recordingContext, range);
                     }
-                    ToBackend(src.buffer)
-                        ->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
-                    ToBackend(dst.texture)
-                        ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopyDst, range);
-                    VkBuffer srcBuffer = ToBackend(src.buffer)->GetHandle();
-                    VkImage dstImage = ToBackend(dst.texture)->GetHandle();
-
-                    // Dawn guarantees dstImage be in the TRANSFER_DST_OPTIMAL layout after the
-                    // copy command.
-                    device->fn.CmdCopyBufferToImage(commands, srcBuffer, dstImage,
-                                                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
-                                                    &region);
                     break;
                 }
 
                 case Command::CopyTextureToBuffer: {
-                    CopyTextureToBufferCmd* copy = mCommands.NextCommand<CopyTextureToBufferCmd>();
-                    if (copy->copySize.width == 0 || copy->copySize.height == 0 ||
-                        copy->copySize.depthOrArrayLayers == 0) {
-                        // Skip no-op copies.
-                        continue;
-                    }
-                    auto& src = copy->source;
-                    auto& dst = copy->destination;
-
-                    ToBackend(dst.buffer)
+                    CopyTextureToBufferCmd* copy = transfer.textureToBuffer;
+                    ToBackend(copy->destination.buffer)
                         ->EnsureDataInitializedAsDestination(recordingContext, copy);
-
-                    VkBufferImageCopy region =
-                        ComputeBufferImageCopyRegion(dst, src, copy->copySize);
-
-                    ASSERT(src.texture->GetDimension() != wgpu::TextureDimension::e1D);
-                    SubresourceRange range =
-                        GetSubresourcesAffectedByCopy(copy->source, copy->copySize);
-
-                    ToBackend(src.texture)
-                        ->EnsureSubresourceContentInitialized(recordingContext, range);
-
-                    ToBackend(src.texture)
-                        ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopySrc, range);
-                    ToBackend(dst.buffer)
-                        ->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
-
-                    VkImage srcImage = ToBackend(src.texture)->GetHandle();
-                    VkBuffer dstBuffer = ToBackend(dst.buffer)->GetHandle();
-                    // The Dawn CopySrc usage is always mapped to GENERAL
-                    device->fn.CmdCopyImageToBuffer(commands, srcImage, VK_IMAGE_LAYOUT_GENERAL,
-                                                    dstBuffer, 1, &region);
+                    ToBackend(copy->source.texture)
+                        ->EnsureSubresourceContentInitialized(recordingContext,
+                                                              transfer.uses[0].range);
                     break;
                 }
 
                 case Command::CopyTextureToTexture: {
-                    CopyTextureToTextureCmd* copy =
-                        mCommands.NextCommand<CopyTextureToTextureCmd>();
-                    if (copy->copySize.width == 0 || copy->copySize.height == 0 ||
-                        copy->copySize.depthOrArrayLayers == 0) {
-                        // Skip no-op copies.
-                        continue;
-                    }
+                    CopyTextureToTextureCmd* copy = transfer.textureToTexture;
                     TextureCopy& src = copy->source;
                     TextureCopy& dst = copy->destination;
-                    SubresourceRange srcRange = GetSubresourcesAffectedByCopy(src, copy->copySize);
-                    SubresourceRange dstRange = GetSubresourcesAffectedByCopy(dst, copy->copySize);
+                    const SubresourceRange& dstRange = transfer.uses[1].range;
 
                     ToBackend(src.texture)
-                        ->EnsureSubresourceContentInitialized(recordingContext, srcRange);
+                        ->EnsureSubresourceContentInitialized(recordingContext,
+                                                              transfer.uses[0].range);
                     if (IsCompleteSubresourceCopiedTo(dst.texture.Get(), copy->copySize,
                                                       dst.mipLevel)) {
                         // Since destination texture has been overwritten, it has been "initialized"
@@ -654,14 +680,147 @@ namespace dawn_native { namespace vulkan {
                         ASSERT(!IsRangeOverlapped(src.origin.z, dst.origin.z,
                                                   copy->copySize.depthOrArrayLayers));
                     }
+                    break;
+                }
 
-                    // TODO after Yunchao's CL
-                    ToBackend(src.texture)
-                        ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopySrc,
-                                             srcRange);
-                    ToBackend(dst.texture)
-                        ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopyDst,
-                                             dstRange);
+                default:
+                    UNREACHABLE();
+            }
+        }
+
+        // Transitions the resources of a transfer to CopySrc or CopyDst and adds the barriers
+        // needed to |barriers|.
+        void TransitionTransferResources(CommandRecordingContext* recordingContext,
+                                         const TransferCommand& transfer,
+                                         BatchedBarriers* barriers) {
+            for (const TransferCommand::ResourceUse& use : transfer.uses) {
+                if (use.buffer != nullptr) {
+                    wgpu::BufferUsage usage =
+                        use.isWrite ? wgpu::BufferUsage::CopyDst : wgpu::BufferUsage::CopySrc;
+                    VkBufferMemoryBarrier barrier;
+                    if (use.buffer->TransitionUsageAndGetResourceBarrier(
+                            usage, &barrier, &barriers->srcStages, &barriers->dstStages)) {
+                        barriers->bufferBarriers.push_back(barrier);
+                    }
+                } else {
+                    wgpu::TextureUsage usage =
+                        use.isWrite ? wgpu::TextureUsage::CopyDst : wgpu::TextureUsage::CopySrc;
+                    use.texture->TransitionUsageAndCollectBarriers(
+                        recordingContext, usage, use.range, &barriers->imageBarriers,
+                        &barriers->srcStages, &barriers->dstStages);
+                }
+            }
+        }
+
+    }  // anonymous namespace
+
+    bool CommandBuffer::RecordTransfers(CommandRecordingContext* recordingContext,
+                                        Command* type) {
+        // Gather the consecutive transfer commands so that the barriers they need can be computed
+        // before they are recorded.
+        std::vector<TransferCommand> transfers;
+        bool hasCommand = true;
+        while (hasCommand && IsTransferCommand(*type)) {
+            TransferCommand transfer;
+            if (NextTransferCommand(&mCommands, *type, &transfer)) {
+                transfers.push_back(transfer);
+            }
+            hasCommand = mCommands.NextCommandId(type);
+        }
+
+        // Split the transfers in batches of commands that don't depend on each other, and record
+        // each batch after a single pipeline barrier, like the barriers of passes.
+        TransferBatchTracker tracker;
+        size_t batchStart = 0;
+        for (size_t i = 0; i < transfers.size(); ++i) {
+            if (!CanAddToBatch(tracker, transfers[i])) {
+                RecordTransferBatch(recordingContext, &transfers[batchStart], i - batchStart);
+                tracker.Reset();
+                batchStart = i;
+            }
+            AddToBatch(&tracker, transfers[i]);
+        }
+        if (batchStart < transfers.size()) {
+            RecordTransferBatch(recordingContext, &transfers[batchStart],
+                                transfers.size() - batchStart);
+        }
+
+        return hasCommand;
+    }
+
+    void CommandBuffer::RecordTransferBatch(CommandRecordingContext* recordingContext,
+                                            const TransferCommand* transfers,
+                                            size_t count) {
+        Device* device = ToBackend(GetDevice());
+        VkCommandBuffer commands = recordingContext->commandBuffer;
+
+        // The lazy initializations record their own commands and barriers, so they are done
+        // before the barriers of the batch are computed.
+        for (size_t i = 0; i < count; ++i) {
+            InitializeTransferResources(recordingContext, transfers[i]);
+        }
+
+        BatchedBarriers barriers;
+        for (size_t i = 0; i < count; ++i) {
+            TransitionTransferResources(recordingContext, transfers[i], &barriers);
+        }
+        barriers.Record(device->fn, commands);
+
+        for (size_t i = 0; i < count; ++i) {
+            const TransferCommand& transfer = transfers[i];
+            switch (transfer.type) {
+                case Command::CopyBufferToBuffer: {
+                    CopyBufferToBufferCmd* copy = transfer.bufferToBuffer;
+
+                    VkBufferCopy region;
+                    region.srcOffset = copy->sourceOffset;
+                    region.dstOffset = copy->destinationOffset;
+                    region.size = copy->size;
+
+                    VkBuffer srcHandle = ToBackend(copy->source)->GetHandle();
+                    VkBuffer dstHandle = ToBackend(copy->destination)->GetHandle();
+                    device->fn.CmdCopyBuffer(commands, srcHandle, dstHandle, 1, &region);
+                    break;
+                }
+
+                case Command::CopyBufferToTexture: {
+                    CopyBufferToTextureCmd* copy = transfer.bufferToTexture;
+                    auto& src = copy->source;
+                    auto& dst = copy->destination;
+
+                    VkBufferImageCopy region =
+                        ComputeBufferImageCopyRegion(src, dst, copy->copySize);
+                    VkBuffer srcBuffer = ToBackend(src.buffer)->GetHandle();
+                    VkImage dstImage = ToBackend(dst.texture)->GetHandle();
+
+                    // Dawn guarantees dstImage be in the TRANSFER_DST_OPTIMAL layout after the
+                    // copy command.
+                    device->fn.CmdCopyBufferToImage(commands, srcBuffer, dstImage,
+                                                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
+                                                    &region);
+                    break;
+                }
+
+                case Command::CopyTextureToBuffer: {
+                    CopyTextureToBufferCmd* copy = transfer.textureToBuffer;
+                    auto& src = copy->source;
+                    auto& dst = copy->destination;
+
+                    VkBufferImageCopy region =
+                        ComputeBufferImageCopyRegion(dst, src, copy->copySize);
+                    VkImage srcImage = ToBackend(src.texture)->GetHandle();
+                    VkBuffer dstBuffer = ToBackend(dst.buffer)->GetHandle();
+
+                    // The Dawn CopySrc usage is always mapped to GENERAL
+                    device->fn.CmdCopyImageToBuffer(commands, srcImage, VK_IMAGE_LAYOUT_GENERAL,
+                                                    dstBuffer, 1, &region);
+                    break;
+                }
+
+                case Command::CopyTextureToTexture: {
+                    CopyTextureToTextureCmd* copy = transfer.textureToTexture;
+                    TextureCopy& src = copy->source;
+                    TextureCopy& dst = copy->destination;
 
                     // In some situations we cannot do texture-to-texture copies with vkCmdCopyImage
                     // because as Vulkan SPEC always validates image copies with the virtual size of
@@ -703,6 +862,45 @@ namespace dawn_native { namespace vulkan {
                     break;
                 }
 
+                default:
+                    UNREACHABLE();
+            }
+        }
+    }
+
+    MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingContext) {
+        Device* device = ToBackend(GetDevice());
+        VkCommandBuffer commands = recordingContext->commandBuffer;
+
+        // Records the necessary barriers for the resource usage pre-computed by the frontend.
+        // And resets the used query sets which are rewritten on the render pass.
+        auto PrepareResourcesForRenderPass = [](Device* device,
+                                                CommandRecordingContext* recordingContext,
+                                                const RenderPassResourceUsage& usages) {
+            TransitionAndClearForSyncScope(device, recordingContext, usages);
+
+            // Reset all query set used on current render pass together before beginning render pass
+            // because the reset command must be called outside render pass
+            for (size_t i = 0; i < usages.querySets.size(); ++i) {
+                ResetUsedQuerySetsOnRenderPass(device, recordingContext->commandBuffer,
+                                               usages.querySets[i], usages.queryAvailabilities[i]);
+            }
+        };
+
+        size_t nextComputePassNumber = 0;
+        size_t nextRenderPassNumber = 0;
+
+        Command type;
+        bool hasCommand = mCommands.NextCommandId(&type);
+        while (hasCommand) {
+            if (IsTransferCommand(type)) {
+                // Records the consecutive transfer commands and reads the id of the command after
+                // them.
+                hasCommand = RecordTransfers(recordingContext, &type);
+                continue;
+            }
+
+            switch (type) {
                 case Command::BeginRenderPass: {
                     BeginRenderPassCmd* cmd = mCommands.NextCommand<BeginRenderPassCmd>();
 
@@ -825,6 +1023,8 @@ namespace dawn_native { namespace vulkan {
                 default:
                     break;
             }
+
+            hasCommand = mCommands.NextCommandId(&type);
         }
 
         return {};
@@ -21,6 +21,7 @@
 #include "common/vulkan_platform.h"
 
 namespace dawn_native {
+    enum class Command;
     struct BeginRenderPassCmd;
     struct TextureCopy;
 }  // namespace dawn_native
@@ -29,6 +30,7 @@ namespace dawn_native { namespace vulkan {
 
     struct CommandRecordingContext;
     class Device;
+    struct TransferCommand;
 
     class CommandBuffer final : public CommandBufferBase {
       public:
@@ -44,6 +46,12 @@ namespace dawn_native { namespace vulkan {
                                      const ComputePassResourceUsage& resourceUsages);
         MaybeError RecordRenderPass(CommandRecordingContext* recordingContext,
                                     BeginRenderPassCmd* renderPass);
+        // Records the transfer command of type `type` and the ones following it. Returns whether
+        // there is a command after them, and its type in `type`.
+        bool RecordTransfers(CommandRecordingContext* recordingContext, Command* type);
+        void RecordTransferBatch(CommandRecordingContext* recordingContext,
+                                 const TransferCommand* transfers,
+                                 size_t count);
         void RecordCopyImageWithTemporaryBuffer(CommandRecordingContext* recordingContext,
                                                 const TextureCopy& srcCopy,
                                                 const TextureCopy& dstCopy,
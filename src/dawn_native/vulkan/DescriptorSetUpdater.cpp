@@ -0,0 +1,177 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/vulkan/DescriptorSetUpdater.h"
+
+#include "common/Assert.h"
+#include "dawn_native/vulkan/VulkanError.h"
+#include "dawn_native/vulkan/VulkanFunctions.h"
+
+namespace dawn_native { namespace vulkan {
+
+    namespace {
+
+        bool IsBufferDescriptorType(VkDescriptorType type) {
+            switch (type) {
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+    }  // anonymous namespace
+
+    // static
+    ResultOrError<std::unique_ptr<DescriptorSetUpdater>> DescriptorSetUpdater::Create(
+        const VulkanFunctions* fn,
+        VkDevice device,
+        VkDescriptorSetLayout layout,
+        std::vector<VkDescriptorType> descriptorTypes,
+        bool useUpdateTemplate) {
+        std::unique_ptr<DescriptorSetUpdater> updater(
+            new DescriptorSetUpdater(fn, device, std::move(descriptorTypes)));
+
+        // Templates must have at least one entry, but there is nothing to update in empty sets.
+        if (useUpdateTemplate && !updater->mDescriptorTypes.empty()) {
+            DAWN_TRY(updater->InitializeUpdateTemplate(layout));
+        }
+        return std::move(updater);
+    }
+
+    DescriptorSetUpdater::DescriptorSetUpdater(const VulkanFunctions* fn,
+                                               VkDevice device,
+                                               std::vector<VkDescriptorType> descriptorTypes)
+        : mFn(fn), mDevice(device), mDescriptorTypes(std::move(descriptorTypes)) {
+    }
+
+    DescriptorSetUpdater::~DescriptorSetUpdater() {
+        // Update templates aren't used by execution on the GPU so they can be destroyed
+        // immediately.
+        if (mUpdateTemplate != VK_NULL_HANDLE) {
+            mFn->DestroyDescriptorUpdateTemplate(mDevice, mUpdateTemplate, nullptr);
+            mUpdateTemplate = VK_NULL_HANDLE;
+        }
+    }
+
+    MaybeError DescriptorSetUpdater::InitializeUpdateTemplate(VkDescriptorSetLayout layout) {
+        // One entry per binding, reading the DescriptorInfo at the index of the binding. The
+        // VkDescriptorBufferInfo or VkDescriptorImageInfo is read depending on the type.
+        std::vector<VkDescriptorUpdateTemplateEntry> entries(mDescriptorTypes.size());
+        for (uint32_t binding = 0; binding < mDescriptorTypes.size(); ++binding) {
+            VkDescriptorUpdateTemplateEntry& entry = entries[binding];
+            entry.dstBinding = binding;
+            entry.dstArrayElement = 0;
+            entry.descriptorCount = 1;
+            entry.descriptorType = mDescriptorTypes[binding];
+            entry.offset = binding * sizeof(DescriptorInfo);
+            entry.stride = sizeof(DescriptorInfo);
+        }
+
+        VkDescriptorUpdateTemplateCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+        createInfo.pDescriptorUpdateEntries = entries.data();
+        createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+        createInfo.descriptorSetLayout = layout;
+        // The following members are ignored for VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET.
+        createInfo.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        createInfo.pipelineLayout = VK_NULL_HANDLE;
+        createInfo.set = 0;
+
+        return CheckVkSuccess(
+            mFn->CreateDescriptorUpdateTemplate(mDevice, &createInfo, nullptr, &*mUpdateTemplate),
+            "CreateDescriptorUpdateTemplate");
+    }
+
+    void DescriptorSetUpdater::Update(VkDescriptorSet set,
+                                      const DescriptorInfo* descriptors) const {
+        if (mDescriptorTypes.empty()) {
+            return;
+        }
+
+        if (mUpdateTemplate != VK_NULL_HANDLE) {
+            bool allValid = true;
+            for (uint32_t binding = 0; binding < mDescriptorTypes.size(); ++binding) {
+                allValid = allValid && IsDescriptorValid(binding, descriptors[binding]);
+            }
+
+            if (allValid) {
+                mFn->UpdateDescriptorSetWithTemplate(mDevice, set, mUpdateTemplate, descriptors);
+                return;
+            }
+        }
+
+        UpdateWithWrites(set, descriptors);
+    }
+
+    VkDescriptorUpdateTemplate DescriptorSetUpdater::GetUpdateTemplate() const {
+        return mUpdateTemplate;
+    }
+
+    bool DescriptorSetUpdater::IsDescriptorValid(uint32_t binding,
+                                                 const DescriptorInfo& descriptor) const {
+        VkDescriptorType type = mDescriptorTypes[binding];
+        if (IsBufferDescriptorType(type)) {
+            return descriptor.buffer.buffer != VK_NULL_HANDLE;
+        }
+        if (type == VK_DESCRIPTOR_TYPE_SAMPLER) {
+            return descriptor.image.sampler != VK_NULL_HANDLE;
+        }
+        return descriptor.image.imageView != VK_NULL_HANDLE;
+    }
+
+    void DescriptorSetUpdater::UpdateWithWrites(VkDescriptorSet set,
+                                                const DescriptorInfo* descriptors) const {
+        std::vector<VkWriteDescriptorSet> writes;
+        writes.reserve(mDescriptorTypes.size());
+
+        for (uint32_t binding = 0; binding < mDescriptorTypes.size(); ++binding) {
+            if (!IsDescriptorValid(binding, descriptors[binding])) {
+                // The resource was destroyed. Skip this descriptor write since it would be a
+                // Vulkan Validation Layers error. This bind group won't be used as it is an error
+                // to submit a command buffer that references destroyed resources.
+                continue;
+            }
+
+            VkWriteDescriptorSet write;
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.pNext = nullptr;
+            write.dstSet = set;
+            write.dstBinding = binding;
+            write.dstArrayElement = 0;
+            write.descriptorCount = 1;
+            write.descriptorType = mDescriptorTypes[binding];
+            write.pImageInfo = nullptr;
+            write.pBufferInfo = nullptr;
+            write.pTexelBufferView = nullptr;
+            if (IsBufferDescriptorType(write.descriptorType)) {
+                write.pBufferInfo = &descriptors[binding].buffer;
+            } else {
+                write.pImageInfo = &descriptors[binding].image;
+            }
+
+            writes.push_back(write);
+        }
+
+        mFn->UpdateDescriptorSets(mDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0,
+                                  nullptr);
+    }
+
+}}  // namespace dawn_native::vulkan
@@ -0,0 +1,76 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_DESCRIPTORSETUPDATER_H_
+#define DAWNNATIVE_VULKAN_DESCRIPTORSETUPDATER_H_
+
+#include "common/vulkan_platform.h"
+#include "dawn_native/Error.h"
+
+#include <memory>
+#include <vector>
+
+namespace dawn_native { namespace vulkan {
+
+    struct VulkanFunctions;
+
+    // The data written to the descriptor of a binding. Which member is used depends on the
+    // descriptor type of the binding.
+    union DescriptorInfo {
+        VkDescriptorBufferInfo buffer;
+        VkDescriptorImageInfo image;
+    };
+
+    // Writes the descriptors of the descriptor sets of a VkDescriptorSetLayout whose binding N is a
+    // single descriptor of type descriptorTypes[N]. The descriptors are given as a packed array of
+    // DescriptorInfo, one per binding.
+    //
+    // When VK_KHR_descriptor_update_template is available, a VkDescriptorUpdateTemplate reading
+    // that array is created once so that updating a set is a single call that doesn't need to
+    // build a VkWriteDescriptorSet per binding. Otherwise vkUpdateDescriptorSets is used.
+    class DescriptorSetUpdater {
+      public:
+        static ResultOrError<std::unique_ptr<DescriptorSetUpdater>> Create(
+            const VulkanFunctions* fn,
+            VkDevice device,
+            VkDescriptorSetLayout layout,
+            std::vector<VkDescriptorType> descriptorTypes,
+            bool useUpdateTemplate);
+        ~DescriptorSetUpdater();
+
+        // Descriptors of resources with a VK_NULL_HANDLE (because they were destroyed) are skipped
+        // since writing them would be a validation error. The set is then updated without the
+        // template.
+        void Update(VkDescriptorSet set, const DescriptorInfo* descriptors) const;
+
+        VkDescriptorUpdateTemplate GetUpdateTemplate() const;
+
+      private:
+        DescriptorSetUpdater(const VulkanFunctions* fn,
+                             VkDevice device,
+                             std::vector<VkDescriptorType> descriptorTypes);
+        MaybeError InitializeUpdateTemplate(VkDescriptorSetLayout layout);
+
+        bool IsDescriptorValid(uint32_t binding, const DescriptorInfo& descriptor) const;
+        void UpdateWithWrites(VkDescriptorSet set, const DescriptorInfo* descriptors) const;
+
+        const VulkanFunctions* mFn;
+        VkDevice mDevice;
+        std::vector<VkDescriptorType> mDescriptorTypes;
+        VkDescriptorUpdateTemplate mUpdateTemplate = VK_NULL_HANDLE;
+    };
+
+}}  // namespace dawn_native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_DESCRIPTORSETUPDATER_H_
@@ -28,6 +28,7 @@
 #include "dawn_native/vulkan/CommandBufferVk.h"
 #include "dawn_native/vulkan/ComputePipelineVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/FramebufferCache.h"
 #include "dawn_native/vulkan/PipelineLayoutVk.h"
 #include "dawn_native/vulkan/QuerySetVk.h"
 #include "dawn_native/vulkan/QueueVk.h"
@@ -85,6 +86,9 @@ namespace dawn_native { namespace vulkan {
         }
 
         mRenderPassCache = std::make_unique<RenderPassCache>(this);
+        mFramebufferCache = std::make_unique<FramebufferCache>(
+            &fn, mVkDevice,
+            [this](VkFramebuffer framebuffer) { mDeleter->DeleteWhenUnused(framebuffer); });
         mResourceMemoryAllocator = std::make_unique<ResourceMemoryAllocator>(this);
 
         mExternalMemoryService = std::make_unique<external_memory::Service>(this);
@@ -220,6 +224,10 @@ namespace dawn_native { namespace vulkan {
         return mRenderPassCache.get();
     }
 
+    FramebufferCache* Device::GetFramebufferCache() const {
+        return mFramebufferCache.get();
+    }
+
     ResourceMemoryAllocator* Device::GetResourceMemoryAllocator() const {
         return mResourceMemoryAllocator.get();
     }
@@ -977,8 +985,10 @@ namespace dawn_native { namespace vulkan {
         // Allow recycled memory to be deleted.
         mResourceMemoryAllocator->DestroyPool();
 
-        // The VkRenderPasses in the cache can be destroyed immediately since all commands referring
-        // to them are guaranteed to be finished executing.
+        // The VkFramebuffers and VkRenderPasses in the caches can be destroyed immediately since
+        // all commands referring to them are guaranteed to be finished executing. The framebuffers
+        // reference the render passes so they are destroyed first.
+        mFramebufferCache = nullptr;
         mRenderPassCache = nullptr;
 
         // We need handle deleting all child objects by calling Tick() again with a large serial to
@@ -37,6 +37,7 @@ namespace dawn_native { namespace vulkan {
     class BindGroupLayout;
     class BufferUploader;
     class FencedDeleter;
+    class FramebufferCache;
     class RenderPassCache;
     class ResourceMemoryAllocator;
 
@@ -59,6 +60,7 @@ namespace dawn_native { namespace vulkan {
 
         FencedDeleter* GetFencedDeleter() const;
         RenderPassCache* GetRenderPassCache() const;
+        FramebufferCache* GetFramebufferCache() const;
         ResourceMemoryAllocator* GetResourceMemoryAllocator() const;
 
         CommandRecordingContext* GetPendingRecordingContext();
@@ -165,6 +167,7 @@ namespace dawn_native { namespace vulkan {
         std::unique_ptr<FencedDeleter> mDeleter;
         std::unique_ptr<ResourceMemoryAllocator> mResourceMemoryAllocator;
         std::unique_ptr<RenderPassCache> mRenderPassCache;
+        std::unique_ptr<FramebufferCache> mFramebufferCache;
 
         std::unique_ptr<external_memory::Service> mExternalMemoryService;
         std::unique_ptr<external_semaphore::Service> mExternalSemaphoreService;
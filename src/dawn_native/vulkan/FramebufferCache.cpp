@@ -0,0 +1,179 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/vulkan/FramebufferCache.h"
+
+#include "common/Assert.h"
+#include "common/HashUtils.h"
+#include "dawn_native/vulkan/VulkanError.h"
+#include "dawn_native/vulkan/VulkanFunctions.h"
+
+#include <algorithm>
+
+namespace dawn_native { namespace vulkan {
+
+    // FramebufferCacheQuery
+
+    void FramebufferCacheQuery::SetRenderPass(VkRenderPass renderPass,
+                                              uint32_t width,
+                                              uint32_t height) {
+        this->renderPass = renderPass;
+        this->width = width;
+        this->height = height;
+    }
+
+    void FramebufferCacheQuery::AddAttachment(VkImageView view) {
+        ASSERT(attachmentCount < kMaxFramebufferAttachments);
+        attachments[attachmentCount] = view;
+        attachmentCount++;
+    }
+
+    // FramebufferCache
+
+    FramebufferCache::FramebufferCache(const VulkanFunctions* fn,
+                                       VkDevice device,
+                                       DeleteWhenUnusedFn deleteWhenUnused)
+        : mFn(fn), mDevice(device), mDeleteWhenUnused(std::move(deleteWhenUnused)) {
+    }
+
+    FramebufferCache::~FramebufferCache() {
+        for (auto it : mCache) {
+            mFn->DestroyFramebuffer(mDevice, it.second, nullptr);
+        }
+        mCache.clear();
+        mQueriesByView.clear();
+    }
+
+    ResultOrError<VkFramebuffer> FramebufferCache::GetFramebuffer(
+        const FramebufferCacheQuery& query) {
+        auto it = mCache.find(query);
+        if (it != mCache.end()) {
+            mStats.hits++;
+            return VkFramebuffer(it->second);
+        }
+
+        VkFramebuffer framebuffer;
+        DAWN_TRY_ASSIGN(framebuffer, CreateFramebufferForQuery(query));
+        mStats.misses++;
+
+        it = mCache.emplace(query, framebuffer).first;
+        const FramebufferCacheQuery* key = &it->first;
+        for (uint32_t i = 0; i < key->attachmentCount; ++i) {
+            // Record the key once per view even if the view is used by several attachments.
+            std::vector<const FramebufferCacheQuery*>& queries =
+                mQueriesByView[key->attachments[i].GetHandle()];
+            if (queries.empty() || queries.back() != key) {
+                queries.push_back(key);
+            }
+        }
+
+        return framebuffer;
+    }
+
+    void FramebufferCache::OnImageViewDestroyed(VkImageView view) {
+        auto it = mQueriesByView.find(view.GetHandle());
+        if (it == mQueriesByView.end()) {
+            return;
+        }
+
+        // Remove the list of |view| first so that Evict doesn't modify it while it is iterated.
+        std::vector<const FramebufferCacheQuery*> queries = std::move(it->second);
+        mQueriesByView.erase(it);
+
+        for (const FramebufferCacheQuery* query : queries) {
+            Evict(*query);
+        }
+    }
+
+    size_t FramebufferCache::GetFramebufferCount() const {
+        return mCache.size();
+    }
+
+    const FramebufferCacheStats& FramebufferCache::GetStats() const {
+        return mStats;
+    }
+
+    ResultOrError<VkFramebuffer> FramebufferCache::CreateFramebufferForQuery(
+        const FramebufferCacheQuery& query) const {
+        VkFramebufferCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.renderPass = query.renderPass;
+        createInfo.attachmentCount = query.attachmentCount;
+        createInfo.pAttachments = AsVkArray(query.attachments.data());
+        createInfo.width = query.width;
+        createInfo.height = query.height;
+        createInfo.layers = 1;
+
+        VkFramebuffer framebuffer;
+        DAWN_TRY(
+            CheckVkSuccess(mFn->CreateFramebuffer(mDevice, &createInfo, nullptr, &*framebuffer),
+                           "CreateFramebuffer"));
+        return framebuffer;
+    }
+
+    void FramebufferCache::Evict(const FramebufferCacheQuery& query) {
+        auto cacheIt = mCache.find(query);
+        ASSERT(cacheIt != mCache.end() && &cacheIt->first == &query);
+
+        for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+            auto viewIt = mQueriesByView.find(query.attachments[i].GetHandle());
+            if (viewIt == mQueriesByView.end()) {
+                // The list of the view being destroyed was already removed.
+                continue;
+            }
+
+            std::vector<const FramebufferCacheQuery*>& queries = viewIt->second;
+            queries.erase(std::remove(queries.begin(), queries.end(), &query), queries.end());
+            if (queries.empty()) {
+                mQueriesByView.erase(viewIt);
+            }
+        }
+
+        mDeleteWhenUnused(cacheIt->second);
+        mStats.evictions++;
+
+        // This frees |query|.
+        mCache.erase(cacheIt);
+    }
+
+    size_t FramebufferCache::CacheFuncs::operator()(const FramebufferCacheQuery& query) const {
+        size_t hash = Hash(query.renderPass.GetHandle());
+
+        HashCombine(&hash, query.width, query.height, query.attachmentCount);
+        for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+            HashCombine(&hash, query.attachments[i].GetHandle());
+        }
+
+        return hash;
+    }
+
+    bool FramebufferCache::CacheFuncs::operator()(const FramebufferCacheQuery& a,
+                                                  const FramebufferCacheQuery& b) const {
+        if (a.renderPass != b.renderPass || a.width != b.width || a.height != b.height ||
+            a.attachmentCount != b.attachmentCount) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < a.attachmentCount; ++i) {
+            if (a.attachments[i] != b.attachments[i]) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+}}  // namespace dawn_native::vulkan
@@ -0,0 +1,113 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_FRAMEBUFFERCACHE_H_
+#define DAWNNATIVE_VULKAN_FRAMEBUFFERCACHE_H_
+
+#include "common/Constants.h"
+#include "common/vulkan_platform.h"
+#include "dawn_native/Error.h"
+
+#include <array>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace dawn_native { namespace vulkan {
+
+    struct VulkanFunctions;
+
+    // The color attachments, the depth-stencil attachment and the resolve targets.
+    static constexpr uint32_t kMaxFramebufferAttachments = kMaxColorAttachments * 2 + 1;
+
+    // This is a key to query the FramebufferCache. The attachments must be added in the
+    // "color-depthstencil-resolve" order used by the RenderPassCache.
+    struct FramebufferCacheQuery {
+        void SetRenderPass(VkRenderPass renderPass, uint32_t width, uint32_t height);
+        void AddAttachment(VkImageView view);
+
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        uint32_t width = 0;
+        uint32_t height = 0;
+
+        uint32_t attachmentCount = 0;
+        std::array<VkImageView, kMaxFramebufferAttachments> attachments;
+    };
+
+    struct FramebufferCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    // Caches VkFramebuffers so that render passes drawing to the same attachments every frame
+    // don't create and delete a framebuffer each time. A framebuffer stays in the cache until one
+    // of its attachments is destroyed. The VkRenderPasses don't need to be tracked because the
+    // RenderPassCache keeps them alive for the lifetime of the device.
+    class FramebufferCache {
+      public:
+        // Called with the framebuffers evicted from the cache, which can still be used by
+        // commands that haven't finished executing.
+        using DeleteWhenUnusedFn = std::function<void(VkFramebuffer)>;
+
+        FramebufferCache(const VulkanFunctions* fn,
+                         VkDevice device,
+                         DeleteWhenUnusedFn deleteWhenUnused);
+        // The framebuffers still in the cache are destroyed immediately, so all the commands
+        // using them must be finished executing.
+        ~FramebufferCache();
+
+        ResultOrError<VkFramebuffer> GetFramebuffer(const FramebufferCacheQuery& query);
+
+        // Evicts the framebuffers that use |view| as an attachment. Must be called before the
+        // VkImageView is deleted.
+        void OnImageViewDestroyed(VkImageView view);
+
+        size_t GetFramebufferCount() const;
+        const FramebufferCacheStats& GetStats() const;
+
+      private:
+        // Does the actual VkFramebuffer creation on a cache miss.
+        ResultOrError<VkFramebuffer> CreateFramebufferForQuery(
+            const FramebufferCacheQuery& query) const;
+
+        // Removes the entry of |query| from the cache and from the lists of its attachments.
+        // |query| must be the key stored in the cache, it is invalid after the call.
+        void Evict(const FramebufferCacheQuery& query);
+
+        // Implements the functors necessary for to use FramebufferCacheQueries as unordered_map
+        // keys.
+        struct CacheFuncs {
+            size_t operator()(const FramebufferCacheQuery& query) const;
+            bool operator()(const FramebufferCacheQuery& a, const FramebufferCacheQuery& b) const;
+        };
+        using Cache =
+            std::unordered_map<FramebufferCacheQuery, VkFramebuffer, CacheFuncs, CacheFuncs>;
+
+        const VulkanFunctions* mFn = nullptr;
+        VkDevice mDevice = VK_NULL_HANDLE;
+        DeleteWhenUnusedFn mDeleteWhenUnused;
+        Cache mCache;
+
+        // For each image view used by a cached framebuffer, the keys of the cache that contain
+        // it. The keys point inside the nodes of mCache which are stable when it is rehashed.
+        std::unordered_map<::VkImageView, std::vector<const FramebufferCacheQuery*>>
+            mQueriesByView;
+
+        FramebufferCacheStats mStats;
+    };
+
+}}  // namespace dawn_native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_FRAMEBUFFERCACHE_H_
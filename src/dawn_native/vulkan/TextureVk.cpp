@@ -25,6 +25,7 @@
 #include "dawn_native/vulkan/CommandRecordingContext.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/FramebufferCache.h"
 #include "dawn_native/vulkan/ResourceHeapVk.h"
 #include "dawn_native/vulkan/ResourceMemoryAllocatorVk.h"
 #include "dawn_native/vulkan/StagingBufferVk.h"
@@ -977,11 +978,8 @@ namespace dawn_native { namespace vulkan {
         VkPipelineStageFlags srcStages = 0;
         VkPipelineStageFlags dstStages = 0;
 
-        TransitionUsageAndGetResourceBarrier(usage, range, &barriers, &srcStages, &dstStages);
-
-        if (mExternalState != ExternalState::InternalOnly) {
-            TweakTransitionForExternalUsage(recordingContext, &barriers, 0);
-        }
+        TransitionUsageAndCollectBarriers(recordingContext, usage, range, &barriers, &srcStages,
+                                          &dstStages);
 
         if (!barriers.empty()) {
             ASSERT(srcStages != 0 && dstStages != 0);
@@ -991,6 +989,23 @@ namespace dawn_native { namespace vulkan {
         }
     }
 
+    void Texture::TransitionUsageAndCollectBarriers(
+        CommandRecordingContext* recordingContext,
+        wgpu::TextureUsage usage,
+        const SubresourceRange& range,
+        std::vector<VkImageMemoryBarrier>* imageBarriers,
+        VkPipelineStageFlags* srcStages,
+        VkPipelineStageFlags* dstStages) {
+        size_t transitionBarrierStart = imageBarriers->size();
+
+        TransitionUsageAndGetResourceBarrier(usage, range, imageBarriers, srcStages, dstStages);
+
+        if (mExternalState != ExternalState::InternalOnly) {
+            TweakTransitionForExternalUsage(recordingContext, imageBarriers,
+                                            transitionBarrierStart);
+        }
+    }
+
     void Texture::TransitionUsageAndGetResourceBarrier(
         wgpu::TextureUsage usage,
         const SubresourceRange& range,
@@ -1250,6 +1265,7 @@ namespace dawn_native { namespace vulkan {
         Device* device = ToBackend(GetTexture()->GetDevice());
 
         if (mHandle != VK_NULL_HANDLE) {
+            device->GetFramebufferCache()->OnImageViewDestroyed(mHandle);
             device->GetFencedDeleter()->DeleteWhenUnused(mHandle);
             mHandle = VK_NULL_HANDLE;
         }
@@ -70,6 +70,14 @@ namespace dawn_native { namespace vulkan {
         void TransitionUsageNow(CommandRecordingContext* recordingContext,
                                 wgpu::TextureUsage usage,
                                 const SubresourceRange& range);
+        // Like TransitionUsageNow but adds the barriers to `imageBarriers` so that they can be
+        // recorded together with the barriers of other resources.
+        void TransitionUsageAndCollectBarriers(CommandRecordingContext* recordingContext,
+                                               wgpu::TextureUsage usage,
+                                               const SubresourceRange& range,
+                                               std::vector<VkImageMemoryBarrier>* imageBarriers,
+                                               VkPipelineStageFlags* srcStages,
+                                               VkPipelineStageFlags* dstStages);
         void TransitionUsageForPass(CommandRecordingContext* recordingContext,
                                     const TextureSubresourceUsage& textureUsages,
                                     std::vector<VkImageMemoryBarrier>* imageBarriers,
@@ -131,6 +131,8 @@ namespace dawn_native { namespace vulkan {
         //
         {DeviceExt::BindMemory2, "VK_KHR_bind_memory2", VulkanVersion_1_1},
         {DeviceExt::Maintenance1, "VK_KHR_maintenance1", VulkanVersion_1_1},
+        {DeviceExt::DescriptorUpdateTemplate, "VK_KHR_descriptor_update_template",
+         VulkanVersion_1_1},
         {DeviceExt::StorageBufferStorageClass, "VK_KHR_storage_buffer_storage_class",
          VulkanVersion_1_1},
         {DeviceExt::GetPhysicalDeviceProperties2, "VK_KHR_get_physical_device_properties2",
@@ -198,6 +200,7 @@ namespace dawn_native { namespace vulkan {
                 case DeviceExt::BindMemory2:
                 case DeviceExt::GetMemoryRequirements2:
                 case DeviceExt::Maintenance1:
+                case DeviceExt::DescriptorUpdateTemplate:
                 case DeviceExt::ImageFormatList:
                 case DeviceExt::StorageBufferStorageClass:
                     hasDependencies = true;
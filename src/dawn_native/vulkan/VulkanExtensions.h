@@ -74,6 +74,7 @@ namespace dawn_native { namespace vulkan {
         // Promoted to 1.1
         BindMemory2,
         Maintenance1,
+        DescriptorUpdateTemplate,
         StorageBufferStorageClass,
         GetPhysicalDeviceProperties2,
         GetMemoryRequirements2,
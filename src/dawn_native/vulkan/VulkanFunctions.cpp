@@ -160,14 +160,17 @@ namespace dawn_native { namespace vulkan {
         return {};
     }
 
-#define GET_DEVICE_PROC(name)                                                           \
-    do {                                                                                \
-        name = reinterpret_cast<decltype(name)>(GetDeviceProcAddr(device, "vk" #name)); \
-        if (name == nullptr) {                                                          \
-            return DAWN_INTERNAL_ERROR(std::string("Couldn't get proc vk") + #name);    \
-        }                                                                               \
+#define GET_DEVICE_PROC_BASE(name, procName)                                                \
+    do {                                                                                    \
+        name = reinterpret_cast<decltype(name)>(GetDeviceProcAddr(device, "vk" #procName)); \
+        if (name == nullptr) {                                                              \
+            return DAWN_INTERNAL_ERROR(std::string("Couldn't get proc vk") + #procName);    \
+        }                                                                                   \
     } while (0)
 
+#define GET_DEVICE_PROC(name) GET_DEVICE_PROC_BASE(name, name)
+#define GET_DEVICE_PROC_VENDOR(name, vendor) GET_DEVICE_PROC_BASE(name, name##vendor)
+
     MaybeError VulkanFunctions::LoadDeviceProcs(VkDevice device,
                                                 const VulkanDeviceInfo& deviceInfo) {
         GET_DEVICE_PROC(AllocateCommandBuffers);
@@ -290,6 +293,18 @@ namespace dawn_native { namespace vulkan {
         GET_DEVICE_PROC(UpdateDescriptorSets);
         GET_DEVICE_PROC(WaitForFences);
 
+        // Vulkan 1.1 is not required to report promoted extensions from 1.0 and is not required to
+        // support the vendor entrypoint in GetProcAddress.
+        if (deviceInfo.properties.apiVersion >= VK_MAKE_VERSION(1, 1, 0)) {
+            GET_DEVICE_PROC(CreateDescriptorUpdateTemplate);
+            GET_DEVICE_PROC(DestroyDescriptorUpdateTemplate);
+            GET_DEVICE_PROC(UpdateDescriptorSetWithTemplate);
+        } else if (deviceInfo.HasExt(DeviceExt::DescriptorUpdateTemplate)) {
+            GET_DEVICE_PROC_VENDOR(CreateDescriptorUpdateTemplate, KHR);
+            GET_DEVICE_PROC_VENDOR(DestroyDescriptorUpdateTemplate, KHR);
+            GET_DEVICE_PROC_VENDOR(UpdateDescriptorSetWithTemplate, KHR);
+        }
+
         if (deviceInfo.HasExt(DeviceExt::ExternalMemoryFD)) {
             GET_DEVICE_PROC(GetMemoryFdKHR);
             GET_DEVICE_PROC(GetMemoryFdPropertiesKHR);
@@ -0,0 +1,113 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_platform/FileCachingInterface.h"
+
+#include "common/Assert.h"
+#include "common/HashUtils.h"
+#include "common/SystemUtils.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace dawn_platform {
+
+    namespace {
+
+        // The header of the entry files.
+        struct EntryHeader {
+            uint64_t keySize;
+            uint64_t valueSize;
+        };
+
+    }  // anonymous namespace
+
+    FileCachingInterface::FileCachingInterface(std::string directory)
+        : mDirectory(std::move(directory)) {
+    }
+
+    FileCachingInterface::~FileCachingInterface() = default;
+
+    size_t FileCachingInterface::LoadData(const WGPUDevice device,
+                                          const void* key,
+                                          size_t keySize,
+                                          void* valueOut,
+                                          size_t valueSize) {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        std::ifstream file(GetEntryPath(key, keySize), std::ios::binary);
+        EntryHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            header.keySize != keySize) {
+            return 0;
+        }
+
+        std::vector<char> storedKey(keySize);
+        if (!file.read(storedKey.data(), keySize) || memcmp(storedKey.data(), key, keySize) != 0) {
+            return 0;
+        }
+
+        if (valueOut != nullptr && valueSize >= header.valueSize) {
+            if (!file.read(static_cast<char*>(valueOut), header.valueSize)) {
+                return 0;
+            }
+        }
+        return static_cast<size_t>(header.valueSize);
+    }
+
+    void FileCachingInterface::StoreData(const WGPUDevice device,
+                                         const void* key,
+                                         size_t keySize,
+                                         const void* value,
+                                         size_t valueSize) {
+        ASSERT(value != nullptr && valueSize > 0);
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        const std::string path = GetEntryPath(key, keySize);
+        const std::string temporaryPath = path + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            EntryHeader header = {keySize, valueSize};
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(static_cast<const char*>(key), keySize);
+            file.write(static_cast<const char*>(value), valueSize);
+            if (!file) {
+                file.close();
+                std::remove(temporaryPath.c_str());
+                return;
+            }
+        }
+
+        // std::rename doesn't replace existing files on all platforms.
+        std::remove(path.c_str());
+        if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            std::remove(temporaryPath.c_str());
+        }
+    }
+
+    void FileCachingInterface::DeleteData(const void* key, size_t keySize) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::remove(GetEntryPath(key, keySize).c_str());
+    }
+
+    std::string FileCachingInterface::GetEntryPath(const void* key, size_t keySize) const {
+        char name[17];
+        snprintf(name, sizeof(name), "%016llx",
+                 static_cast<unsigned long long>(HashBytes(key, keySize)));
+        return mDirectory + GetPathSeparator() + name;
+    }
+
+}  // namespace dawn_platform
@@ -0,0 +1,60 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNPLATFORM_FILECACHINGINTERFACE_H_
+#define DAWNPLATFORM_FILECACHINGINTERFACE_H_
+
+#include "dawn_platform/DawnPlatform.h"
+
+#include <mutex>
+#include <string>
+
+namespace dawn_platform {
+
+    // A reference implementation of the CachingInterface that stores each entry in a file of a
+    // directory. The files are named after a hash of the key, and contain the key followed by the
+    // value so that keys with the same hash are told apart. Entries are written to a temporary
+    // file first so that a partially written entry is never loaded.
+    // It is exported so that the tests can use it as a persistent cache.
+    class DAWN_PLATFORM_EXPORT FileCachingInterface : public CachingInterface {
+      public:
+        // |directory| must exist and be writable.
+        explicit FileCachingInterface(std::string directory);
+        ~FileCachingInterface() override;
+
+        size_t LoadData(const WGPUDevice device,
+                        const void* key,
+                        size_t keySize,
+                        void* valueOut,
+                        size_t valueSize) override;
+
+        void StoreData(const WGPUDevice device,
+                       const void* key,
+                       size_t keySize,
+                       const void* value,
+                       size_t valueSize) override;
+
+        // Removes the entry of |key|, if any.
+        void DeleteData(const void* key, size_t keySize);
+
+      private:
+        std::string GetEntryPath(const void* key, size_t keySize) const;
+
+        const std::string mDirectory;
+        std::mutex mMutex;
+    };
+
+}  // namespace dawn_platform
+
+#endif  // DAWNPLATFORM_FILECACHINGINTERFACE_H_
@@ -14,19 +14,18 @@
 
 #include "dawn_platform/WorkerThread.h"
 
-#include <condition_variable>
-#include <functional>
-#include <thread>
+#include <algorithm>
 
 #include "common/Assert.h"
 
-namespace {
+namespace dawn_platform {
 
-    class AsyncWaitableEventImpl {
+    // The shared state between the WaitableEvent returned to the caller of PostWorkerTask() and
+    // the worker thread running the task. It is referenced once by each of them and goes back to
+    // its AsyncWaitableEventPool when both are done with it so that the mutex and condition
+    // variable can be reused by later tasks.
+    class AsyncWaitableEventState : public NonCopyable {
       public:
-        AsyncWaitableEventImpl() : mIsComplete(false) {
-        }
-
         void Wait() {
             std::unique_lock<std::mutex> lock(mMutex);
             mCondition.wait(lock, [this] { return mIsComplete; });
@@ -45,53 +44,250 @@ namespace {
             mCondition.notify_all();
         }
 
+        void Initialize(Ref<AsyncWaitableEventPool> pool) {
+            mIsComplete = false;
+            mRefCount.store(2, std::memory_order_relaxed);
+            mPool = std::move(pool);
+        }
+
+        void Release();
+
       private:
         std::mutex mMutex;
         std::condition_variable mCondition;
-        bool mIsComplete;
+        bool mIsComplete = false;
+
+        std::atomic<uint32_t> mRefCount{0};
+        Ref<AsyncWaitableEventPool> mPool;
+    };
+
+    // A free-list of AsyncWaitableEventState. It is ref-counted because the events handed out
+    // to the callers of PostWorkerTask() may outlive the AsyncWorkerThreadPool itself.
+    class AsyncWaitableEventPool : public RefCounted {
+      public:
+        AsyncWaitableEventState* Acquire() {
+            AsyncWaitableEventState* state = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (!mFreeStates.empty()) {
+                    state = mFreeStates.back();
+                    mFreeStates.pop_back();
+                }
+            }
+            if (state == nullptr) {
+                state = new AsyncWaitableEventState();
+            }
+            state->Initialize(this);
+            return state;
+        }
+
+        void Recycle(AsyncWaitableEventState* state) {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (mFreeStates.size() < kMaxFreeStates) {
+                    mFreeStates.push_back(state);
+                    return;
+                }
+            }
+            delete state;
+        }
+
+      private:
+        // Bound the memory kept alive after a burst of tasks.
+        static constexpr size_t kMaxFreeStates = 256;
+
+        ~AsyncWaitableEventPool() override {
+            for (AsyncWaitableEventState* state : mFreeStates) {
+                delete state;
+            }
+        }
+
+        std::mutex mMutex;
+        std::vector<AsyncWaitableEventState*> mFreeStates;
     };
 
+    void AsyncWaitableEventState::Release() {
+        if (mRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // Keep the pool alive until the state is recycled: the pool may only be referenced
+            // by this state anymore.
+            Ref<AsyncWaitableEventPool> pool = std::move(mPool);
+            pool->Recycle(this);
+        }
+    }
+
+}  // namespace dawn_platform
+
+namespace {
+
     class AsyncWaitableEvent final : public dawn_platform::WaitableEvent {
       public:
-        explicit AsyncWaitableEvent()
-            : mWaitableEventImpl(std::make_shared<AsyncWaitableEventImpl>()) {
+        explicit AsyncWaitableEvent(dawn_platform::AsyncWaitableEventState* state)
+            : mState(state) {
         }
 
-        void Wait() override {
-            mWaitableEventImpl->Wait();
+        ~AsyncWaitableEvent() override {
+            mState->Release();
         }
 
-        bool IsComplete() override {
-            return mWaitableEventImpl->IsComplete();
+        void Wait() override {
+            mState->Wait();
         }
 
-        std::shared_ptr<AsyncWaitableEventImpl> GetWaitableEventImpl() const {
-            return mWaitableEventImpl;
+        bool IsComplete() override {
+            return mState->IsComplete();
         }
 
       private:
-        std::shared_ptr<AsyncWaitableEventImpl> mWaitableEventImpl;
+        dawn_platform::AsyncWaitableEventState* mState;
     };
 
+    // Used to post tasks from a worker thread directly to its own queue.
+    thread_local const void* tlCurrentWorkerPool = nullptr;
+    thread_local uint32_t tlCurrentWorkerIndex = 0;
+
+    // Having more worker threads than this doesn't help for the kind of tasks Dawn posts
+    // (shader and pipeline compilation) and would only add memory overhead.
+    constexpr uint32_t kMaxDefaultWorkerThreadCount = 16;
+
 }  // anonymous namespace
 
 namespace dawn_platform {
 
+    // static
+    uint32_t AsyncWorkerThreadPool::GetDefaultWorkerThreadCount() {
+        // hardware_concurrency() may return 0 when the value isn't computable.
+        uint32_t coreCount = std::thread::hardware_concurrency();
+        return std::max(1u, std::min(coreCount, kMaxDefaultWorkerThreadCount));
+    }
+
+    AsyncWorkerThreadPool::AsyncWorkerThreadPool()
+        : AsyncWorkerThreadPool(GetDefaultWorkerThreadCount()) {
+    }
+
+    AsyncWorkerThreadPool::AsyncWorkerThreadPool(uint32_t workerThreadCount)
+        : mWorkerThreadCount(workerThreadCount),
+          mThreadsStarted(false),
+          mQueuedTaskCount(0),
+          mNextQueue(0),
+          mEventPool(AcquireRef(new AsyncWaitableEventPool())) {
+        ASSERT(mWorkerThreadCount > 0);
+        mQueues.reserve(mWorkerThreadCount);
+        for (uint32_t i = 0; i < mWorkerThreadCount; ++i) {
+            mQueues.push_back(std::make_unique<WorkerQueue>());
+        }
+    }
+
+    AsyncWorkerThreadPool::~AsyncWorkerThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mSleepMutex);
+            mIsShuttingDown = true;
+        }
+        mSleepCondition.notify_all();
+
+        // The workers drain all the queues before exiting so that every event returned by
+        // PostWorkerTask() is eventually completed.
+        std::lock_guard<std::mutex> lock(mThreadsMutex);
+        for (std::thread& thread : mThreads) {
+            thread.join();
+        }
+        ASSERT(mQueuedTaskCount.load() == 0);
+    }
+
+    uint32_t AsyncWorkerThreadPool::GetWorkerThreadCount() const {
+        return mWorkerThreadCount;
+    }
+
     std::unique_ptr<dawn_platform::WaitableEvent> AsyncWorkerThreadPool::PostWorkerTask(
         dawn_platform::PostWorkerTaskCallback callback,
         void* userdata) {
-        std::unique_ptr<AsyncWaitableEvent> waitableEvent = std::make_unique<AsyncWaitableEvent>();
+        EnsureWorkerThreadsStarted();
 
-        std::function<void()> doTask =
-            [callback, userdata, waitableEventImpl = waitableEvent->GetWaitableEventImpl()]() {
-                callback(userdata);
-                waitableEventImpl->MarkAsComplete();
-            };
+        AsyncWaitableEventState* event = mEventPool->Acquire();
+        std::unique_ptr<dawn_platform::WaitableEvent> waitableEvent =
+            std::make_unique<AsyncWaitableEvent>(event);
 
-        std::thread thread(doTask);
-        thread.detach();
+        uint32_t queueIndex;
+        if (tlCurrentWorkerPool == this) {
+            queueIndex = tlCurrentWorkerIndex;
+        } else {
+            queueIndex =
+                mNextQueue.fetch_add(1, std::memory_order_relaxed) % mWorkerThreadCount;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mSleepMutex);
+            mQueuedTaskCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        {
+            WorkerQueue* queue = mQueues[queueIndex].get();
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            queue->tasks.push_back({callback, userdata, event});
+        }
+        mSleepCondition.notify_one();
 
         return waitableEvent;
     }
 
+    void AsyncWorkerThreadPool::EnsureWorkerThreadsStarted() {
+        if (mThreadsStarted.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mThreadsMutex);
+        if (mThreadsStarted.load(std::memory_order_relaxed)) {
+            return;
+        }
+        mThreads.reserve(mWorkerThreadCount);
+        for (uint32_t i = 0; i < mWorkerThreadCount; ++i) {
+            mThreads.emplace_back(&AsyncWorkerThreadPool::WorkerThreadMain, this, i);
+        }
+        mThreadsStarted.store(true, std::memory_order_release);
+    }
+
+    void AsyncWorkerThreadPool::WorkerThreadMain(uint32_t workerIndex) {
+        tlCurrentWorkerPool = this;
+        tlCurrentWorkerIndex = workerIndex;
+
+        Task task;
+        while (true) {
+            if (PopTask(workerIndex, &task)) {
+                RunTask(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mSleepMutex);
+            mSleepCondition.wait(lock, [this] {
+                return mIsShuttingDown || mQueuedTaskCount.load(std::memory_order_relaxed) != 0;
+            });
+            if (mIsShuttingDown && mQueuedTaskCount.load(std::memory_order_relaxed) == 0) {
+                return;
+            }
+        }
+    }
+
+    bool AsyncWorkerThreadPool::PopTask(uint32_t workerIndex, Task* task) {
+        // Look at our own queue first, then try to steal from the other workers. Tasks are
+        // always taken from the front so that they run roughly in the order they were posted.
+        for (uint32_t i = 0; i < mWorkerThreadCount; ++i) {
+            WorkerQueue* queue = mQueues[(workerIndex + i) % mWorkerThreadCount].get();
+
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            if (queue->tasks.empty()) {
+                continue;
+            }
+            *task = queue->tasks.front();
+            queue->tasks.pop_front();
+            mQueuedTaskCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    // static
+    void AsyncWorkerThreadPool::RunTask(const Task& task) {
+        task.callback(task.userdata);
+        task.event->MarkAsComplete();
+        task.event->Release();
+    }
+
 }  // namespace dawn_platform
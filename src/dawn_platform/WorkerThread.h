@@ -16,15 +16,78 @@
 #define COMMON_WORKERTHREAD_H_
 
 #include "common/NonCopyable.h"
+#include "common/RefCounted.h"
 #include "dawn_platform/DawnPlatform.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace dawn_platform {
 
-    class AsyncWorkerThreadPool : public dawn_platform::WorkerTaskPool, public NonCopyable {
+    class AsyncWaitableEventPool;
+    class AsyncWaitableEventState;
+
+    // AsyncWorkerThreadPool runs the posted tasks on a bounded set of persistent worker threads.
+    // Each worker owns a task queue; tasks posted from a worker thread go to its own queue and
+    // tasks posted from other threads are distributed round-robin. Idle workers steal from the
+    // queues of the other workers. The worker threads are started lazily on the first call to
+    // PostWorkerTask() so that pools that are never used don't cost any thread.
+    // It is exported so that it can be tested and benchmarked directly.
+    class DAWN_PLATFORM_EXPORT AsyncWorkerThreadPool : public dawn_platform::WorkerTaskPool,
+                                                       public NonCopyable {
       public:
+        // Uses a number of worker threads based on the number of cores of the system.
+        AsyncWorkerThreadPool();
+        explicit AsyncWorkerThreadPool(uint32_t workerThreadCount);
+        ~AsyncWorkerThreadPool() override;
+
         std::unique_ptr<dawn_platform::WaitableEvent> PostWorkerTask(
             dawn_platform::PostWorkerTaskCallback callback,
             void* userdata) override;
+
+        uint32_t GetWorkerThreadCount() const;
+
+        static uint32_t GetDefaultWorkerThreadCount();
+
+      private:
+        struct Task {
+            dawn_platform::PostWorkerTaskCallback callback;
+            void* userdata;
+            AsyncWaitableEventState* event;
+        };
+
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void EnsureWorkerThreadsStarted();
+        void WorkerThreadMain(uint32_t workerIndex);
+        bool PopTask(uint32_t workerIndex, Task* task);
+        static void RunTask(const Task& task);
+
+        const uint32_t mWorkerThreadCount;
+        std::vector<std::unique_ptr<WorkerQueue>> mQueues;
+
+        std::mutex mThreadsMutex;
+        std::vector<std::thread> mThreads;
+        std::atomic<bool> mThreadsStarted;
+
+        // Protects the sleep / wake-up of the workers. mQueuedTaskCount is only modified
+        // atomically but is always published under mSleepMutex to avoid lost wake-ups.
+        std::mutex mSleepMutex;
+        std::condition_variable mSleepCondition;
+        std::atomic<uint64_t> mQueuedTaskCount;
+        bool mIsShuttingDown = false;
+
+        std::atomic<uint32_t> mNextQueue;
+
+        Ref<AsyncWaitableEventPool> mEventPool;
     };
 
 }  // namespace dawn_platform
@@ -20,6 +20,21 @@ namespace dawn_wire {
         : mSerializer(serializer), mMaxAllocationSize(serializer->GetMaximumAllocationSize()) {
     }
 
+    bool ChunkedCommandSerializer::ReserveCommandSpace(size_t size,
+                                                       SerializeBuffer* reservation) {
+        ASSERT(size <= mMaxAllocationSize);
+        char* space = static_cast<char*>(mSerializer->GetCmdSpace(size));
+        if (space == nullptr) {
+            return false;
+        }
+        *reservation = SerializeBuffer(space, size);
+        return true;
+    }
+
+    size_t ChunkedCommandSerializer::GetMaximumAllocationSize() const {
+        return mMaxAllocationSize;
+    }
+
     void ChunkedCommandSerializer::SerializeChunkedCommand(const char* allocatedBuffer,
                                                            size_t remainingSize) {
         while (remainingSize > 0) {
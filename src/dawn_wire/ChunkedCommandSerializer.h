@@ -16,6 +16,7 @@
 #define DAWNWIRE_CHUNKEDCOMMANDSERIALIZER_H_
 
 #include "common/Alloc.h"
+#include "common/Assert.h"
 #include "common/Compiler.h"
 #include "dawn_wire/Wire.h"
 #include "dawn_wire/WireCmd_autogen.h"
@@ -67,7 +68,97 @@ namespace dawn_wire {
                 extraSize, std::forward<ExtraSizeSerializeFn>(SerializeExtraSize));
         }
 
+        // Serializes |cmd| followed by |dataSize| bytes of |data|, for commands with a trailing
+        // "skip_serialize" byte array. Commands larger than the maximum allocation size are
+        // streamed directly into successive chunks of the CommandSerializer instead of being
+        // copied in a temporary allocation first.
+        template <typename Cmd>
+        void SerializeCommandWithData(const Cmd& cmd,
+                                      const ObjectIdProvider& objectIdProvider,
+                                      const void* data,
+                                      size_t dataSize) {
+            SerializeCommandWithDataImpl(
+                cmd,
+                [&objectIdProvider](const Cmd& cmd, size_t requiredSize,
+                                    SerializeBuffer* serializeBuffer) {
+                    return cmd.Serialize(requiredSize, serializeBuffer, objectIdProvider);
+                },
+                data, dataSize);
+        }
+
+        // Reserves |size| bytes of command space with a single call to
+        // CommandSerializer::GetCmdSpace so that a burst of small commands can be serialized in
+        // it with SerializeReservedCommand(). |size| must be at most the maximum allocation size.
+        // Returns false if the space couldn't be allocated.
+        bool ReserveCommandSpace(size_t size, SerializeBuffer* reservation);
+
+        template <typename Cmd>
+        void SerializeReservedCommand(SerializeBuffer* reservation, const Cmd& cmd) {
+            size_t commandSize = cmd.GetRequiredSize();
+            ASSERT(commandSize <= reservation->AvailableSize());
+            if (DAWN_UNLIKELY(cmd.Serialize(commandSize, reservation) != WireResult::Success)) {
+                mSerializer->OnSerializeError();
+            }
+        }
+
+        template <typename Cmd>
+        void SerializeReservedCommand(SerializeBuffer* reservation,
+                                      const Cmd& cmd,
+                                      const ObjectIdProvider& objectIdProvider) {
+            size_t commandSize = cmd.GetRequiredSize();
+            ASSERT(commandSize <= reservation->AvailableSize());
+            if (DAWN_UNLIKELY(cmd.Serialize(commandSize, reservation, objectIdProvider) !=
+                              WireResult::Success)) {
+                mSerializer->OnSerializeError();
+            }
+        }
+
+        size_t GetMaximumAllocationSize() const;
+
       private:
+        template <typename Cmd, typename SerializeCmdFn>
+        void SerializeCommandWithDataImpl(const Cmd& cmd,
+                                          SerializeCmdFn&& SerializeCmd,
+                                          const void* data,
+                                          size_t dataSize) {
+            size_t commandSize = cmd.GetRequiredSize();
+            size_t requiredSize = commandSize + dataSize;
+
+            // Small commands fit in a single allocation. Commands whose non-data part doesn't fit
+            // in an allocation are extremely rare and use the slower path with a temporary copy.
+            if (requiredSize <= mMaxAllocationSize || commandSize > mMaxAllocationSize) {
+                SerializeCommandImpl(cmd, std::forward<SerializeCmdFn>(SerializeCmd), dataSize,
+                                     [&](SerializeBuffer* serializeBuffer) {
+                                         char* dataBuffer;
+                                         WIRE_TRY(serializeBuffer->NextN(dataSize, &dataBuffer));
+                                         if (dataSize > 0) {
+                                             memcpy(dataBuffer, data, dataSize);
+                                         }
+                                         return WireResult::Success;
+                                     });
+                return;
+            }
+
+            // Serialize the command in the first chunk, followed by as much data as fits. The
+            // command records the size of the whole command so that the ChunkedCommandHandler
+            // on the other side of the wire reassembles it.
+            char* firstChunk = static_cast<char*>(mSerializer->GetCmdSpace(mMaxAllocationSize));
+            if (firstChunk == nullptr) {
+                return;
+            }
+            SerializeBuffer serializeBuffer(firstChunk, commandSize);
+            if (DAWN_UNLIKELY(SerializeCmd(cmd, requiredSize, &serializeBuffer) !=
+                              WireResult::Success)) {
+                mSerializer->OnSerializeError();
+                return;
+            }
+
+            size_t firstChunkDataSize = mMaxAllocationSize - commandSize;
+            memcpy(firstChunk + commandSize, data, firstChunkDataSize);
+            SerializeChunkedCommand(static_cast<const char*>(data) + firstChunkDataSize,
+                                    dataSize - firstChunkDataSize);
+        }
+
         template <typename Cmd, typename SerializeCmdFn, typename ExtraSizeSerializeFn>
         void SerializeCommandImpl(const Cmd& cmd,
                                   SerializeCmdFn&& SerializeCmd,
@@ -0,0 +1,124 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNWIRE_PACKEDPASSCOMMANDS_H_
+#define DAWNWIRE_PACKEDPASSCOMMANDS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace dawn_wire {
+
+    // The commands recorded in the draw and dispatch loops of render and compute passes aren't
+    // sent as individual wire commands. The client packs them in a blob that is sent with a
+    // single PassEncoderPackedCommands command and that the server decodes in a single loop,
+    // calling the procs of the pass directly. Each command of the blob is a PackedPassCommand
+    // followed by its arguments, tightly packed without alignment. Objects are packed as their
+    // ObjectId and SetBindGroup is followed by its dynamic offsets.
+    //
+    // The version of the encoding is sent with each blob and the server rejects blobs with
+    // another version. It must be incremented for any change to the encoding.
+    static constexpr uint32_t kPackedPassCommandsVersion = 1;
+
+    enum class PackedPassCommand : uint32_t {
+        SetPipeline,
+        SetBindGroup,
+        SetVertexBuffer,
+        SetIndexBuffer,
+        Draw,
+        DrawIndexed,
+        DrawIndirect,
+        DrawIndexedIndirect,
+        Dispatch,
+        DispatchIndirect,
+    };
+
+    // The maximum size of a blob of packed commands, after which the client sends the blob and
+    // starts a new one.
+    static constexpr size_t kMaxPackedPassCommandsSize = 16 * 1024;
+
+    // SetBindGroup commands with more dynamic offsets than this are sent as regular commands.
+    static constexpr uint32_t kMaxPackedDynamicOffsetCount = 64;
+
+    constexpr size_t PackedSize() {
+        return 0;
+    }
+
+    template <typename T, typename... Args>
+    constexpr size_t PackedSize(const T&, const Args&... args) {
+        return sizeof(T) + PackedSize(args...);
+    }
+
+    inline uint8_t* Pack(uint8_t* destination) {
+        return destination;
+    }
+
+    // Packs |value| and |args| at |destination| and returns a pointer past the packed values.
+    template <typename T, typename... Args>
+    uint8_t* Pack(uint8_t* destination, const T& value, const Args&... args) {
+        memcpy(destination, &value, sizeof(T));
+        return Pack(destination + sizeof(T), args...);
+    }
+
+    // Reads the values of a blob of packed commands. The reads fail instead of going past the
+    // end of the blob.
+    class PackedPassCommandReader {
+      public:
+        PackedPassCommandReader(const uint8_t* data, size_t size)
+            : mCurrent(data), mEnd(data + size) {
+        }
+
+        bool IsEmpty() const {
+            return mCurrent == mEnd;
+        }
+
+        template <typename T>
+        bool Read(T* value) {
+            if (static_cast<size_t>(mEnd - mCurrent) < sizeof(T)) {
+                return false;
+            }
+            memcpy(value, mCurrent, sizeof(T));
+            mCurrent += sizeof(T);
+            return true;
+        }
+
+        template <typename T, typename... Args>
+        bool Read(T* value, Args*... args) {
+            return Read(value) && Read(args...);
+        }
+
+        // Copies the next |count| values of type T to |storage|, since the packed values aren't
+        // aligned.
+        template <typename T>
+        bool ReadArray(uint32_t count, T* storage) {
+            size_t size = count * sizeof(T);
+            if (static_cast<size_t>(mEnd - mCurrent) < size) {
+                return false;
+            }
+            if (size != 0) {
+                memcpy(storage, mCurrent, size);
+            }
+            mCurrent += size;
+            return true;
+        }
+
+      private:
+        const uint8_t* mCurrent;
+        const uint8_t* mEnd;
+    };
+
+}  // namespace dawn_wire
+
+#endif  // DAWNWIRE_PACKEDPASSCOMMANDS_H_
@@ -14,6 +14,8 @@
 
 #include "dawn_wire/Wire.h"
 
+#include "dawn_wire/WireCmd_autogen.h"
+
 namespace dawn_wire {
 
     CommandSerializer::CommandSerializer() = default;
@@ -25,4 +27,19 @@ namespace dawn_wire {
     CommandHandler::CommandHandler() = default;
     CommandHandler::~CommandHandler() = default;
 
+    size_t PeekWireCommand(const volatile char* commands, size_t size, const char** name) {
+        if (size < sizeof(CmdHeader) + sizeof(WireCmd)) {
+            return 0;
+        }
+
+        uint64_t commandSize = reinterpret_cast<const volatile CmdHeader*>(commands)->commandSize;
+        if (commandSize < sizeof(CmdHeader) + sizeof(WireCmd) || commandSize > size) {
+            return 0;
+        }
+
+        WireCmd cmdId = *reinterpret_cast<const volatile WireCmd*>(commands + sizeof(CmdHeader));
+        *name = GetWireCmdName(cmdId);
+        return static_cast<size_t>(commandSize);
+    }
+
 }  // namespace dawn_wire
@@ -53,6 +53,10 @@ namespace dawn_wire {
         mImpl->ReclaimDeviceReservation(reservation);
     }
 
+    void WireClient::SerializePendingCommands() {
+        mImpl->SerializePackedPassCommands();
+    }
+
     void WireClient::Disconnect() {
         mImpl->Disconnect();
     }
@@ -19,6 +19,8 @@
 #include "dawn_wire/client/Client.h"
 #include "dawn_wire/client/Device.h"
 
+#include <algorithm>
+
 namespace dawn_wire { namespace client {
 
     // static
@@ -75,7 +77,7 @@ namespace dawn_wire { namespace client {
         // This must happen after any potential device->CreateErrorBuffer()
         // as server expects allocating ids to be monotonically increasing
         auto* bufferObjectAndSerial = wireClient->BufferAllocator().New(wireClient);
-        Buffer* buffer = bufferObjectAndSerial->object.get();
+        Buffer* buffer = bufferObjectAndSerial->object;
         buffer->mDevice = device;
         buffer->mDeviceIsAlive = device->GetAliveWeakPtr();
         buffer->mSize = descriptor->size;
@@ -136,7 +138,7 @@ namespace dawn_wire { namespace client {
         cmd.result = ObjectHandle{allocation->object->id, allocation->generation};
         device->client->SerializeCommand(cmd);
 
-        return ToAPI(allocation->object.get());
+        return ToAPI(allocation->object);
     }
 
     Buffer::~Buffer() {
@@ -282,6 +284,7 @@ namespace dawn_wire { namespace client {
         if (!IsMappedForWriting() || !CheckGetMappedRangeOffsetSize(offset, size)) {
             return nullptr;
         }
+        MarkRangeWritten(offset, size);
         return static_cast<uint8_t*>(mMappedData) + offset;
     }
 
@@ -308,29 +311,13 @@ namespace dawn_wire { namespace client {
             mWriteHandle != nullptr) {
             // Writes need to be flushed before Unmap is sent. Unmap calls all associated
             // in-flight callbacks which may read the updated data.
-
-            // Get the serialization size of data update writes.
-            size_t writeDataUpdateInfoLength =
-                mWriteHandle->SizeOfSerializeDataUpdate(mMapOffset, mMapSize);
-
-            BufferUpdateMappedDataCmd cmd;
-            cmd.bufferId = id;
-            cmd.writeDataUpdateInfoLength = writeDataUpdateInfoLength;
-            cmd.writeDataUpdateInfo = nullptr;
-            cmd.offset = mMapOffset;
-            cmd.size = mMapSize;
-
-            client->SerializeCommand(
-                cmd, writeDataUpdateInfoLength, [&](SerializeBuffer* serializeBuffer) {
-                    char* writeHandleBuffer;
-                    WIRE_TRY(serializeBuffer->NextN(writeDataUpdateInfoLength, &writeHandleBuffer));
-
-                    // Serialize flush metadata into the space after the command.
-                    // This closes the handle for writing.
-                    mWriteHandle->SerializeDataUpdate(writeHandleBuffer, cmd.offset, cmd.size);
-
-                    return WireResult::Success;
-                });
+            if (mTracksWrittenRanges && !mWritesWholeMapping) {
+                for (const WrittenRange& range : mWrittenRanges) {
+                    SerializeDataUpdate(range.offset, range.size);
+                }
+            } else {
+                SerializeDataUpdate(mMapOffset, mMapSize);
+            }
 
             // If mDestructWriteHandleOnUnmap is true, that means the write handle is merely
             // for mappedAtCreation usage. It is destroyed on unmap after flush to server
@@ -350,6 +337,9 @@ namespace dawn_wire { namespace client {
         mMapState = MapState::Unmapped;
         mMapOffset = 0;
         mMapSize = 0;
+        mWrittenRanges.clear();
+        mTracksWrittenRanges = false;
+        mWritesWholeMapping = false;
 
         // Tag all mapping requests still in flight as unmapped before callback.
         for (auto& it : mRequests) {
@@ -400,6 +390,77 @@ namespace dawn_wire { namespace client {
         return offsetInMappedRange <= mMapSize - size;
     }
 
+    void Buffer::MarkRangeWritten(size_t offset, size_t size) {
+        if (size == 0) {
+            // GetMappedRange() defaults to a size of 0 and applications write the whole mapping
+            // through the pointer it returns, so the written ranges aren't known anymore.
+            mWritesWholeMapping = true;
+            return;
+        }
+        mTracksWrittenRanges = true;
+
+        // Insert the range, then merge it with the ranges it overlaps or touches.
+        auto it = std::lower_bound(
+            mWrittenRanges.begin(), mWrittenRanges.end(), offset,
+            [](const WrittenRange& range, size_t value) { return range.offset < value; });
+        it = mWrittenRanges.insert(it, {offset, size});
+        if (it != mWrittenRanges.begin() && (it - 1)->offset + (it - 1)->size >= offset) {
+            --it;
+        }
+
+        size_t end = it->offset + it->size;
+        auto next = it + 1;
+        while (next != mWrittenRanges.end() && next->offset <= end) {
+            end = std::max(end, next->offset + next->size);
+            ++next;
+        }
+        it->size = end - it->offset;
+        mWrittenRanges.erase(it + 1, next);
+
+        // Bound the number of data updates by merging the two ranges with the smallest gap
+        // between them. This sends the bytes of the gap again, which is harmless since they
+        // contain the data of the mapping.
+        if (mWrittenRanges.size() > kMaxWrittenRanges) {
+            size_t mergeIndex = 0;
+            size_t smallestGap = std::numeric_limits<size_t>::max();
+            for (size_t i = 0; i + 1 < mWrittenRanges.size(); ++i) {
+                size_t gap = mWrittenRanges[i + 1].offset -
+                             (mWrittenRanges[i].offset + mWrittenRanges[i].size);
+                if (gap < smallestGap) {
+                    smallestGap = gap;
+                    mergeIndex = i;
+                }
+            }
+            WrittenRange& merged = mWrittenRanges[mergeIndex];
+            const WrittenRange& following = mWrittenRanges[mergeIndex + 1];
+            merged.size = following.offset + following.size - merged.offset;
+            mWrittenRanges.erase(mWrittenRanges.begin() + mergeIndex + 1);
+        }
+    }
+
+    void Buffer::SerializeDataUpdate(size_t offset, size_t size) {
+        // Get the serialization size of data update writes.
+        size_t writeDataUpdateInfoLength = mWriteHandle->SizeOfSerializeDataUpdate(offset, size);
+
+        BufferUpdateMappedDataCmd cmd;
+        cmd.bufferId = id;
+        cmd.writeDataUpdateInfoLength = writeDataUpdateInfoLength;
+        cmd.writeDataUpdateInfo = nullptr;
+        cmd.offset = offset;
+        cmd.size = size;
+
+        client->SerializeCommand(
+            cmd, writeDataUpdateInfoLength, [&](SerializeBuffer* serializeBuffer) {
+                char* writeHandleBuffer;
+                WIRE_TRY(serializeBuffer->NextN(writeDataUpdateInfoLength, &writeHandleBuffer));
+
+                // Serialize flush metadata into the space after the command.
+                mWriteHandle->SerializeDataUpdate(writeHandleBuffer, cmd.offset, cmd.size);
+
+                return WireResult::Success;
+            });
+    }
+
     void Buffer::FreeMappedData() {
 #if defined(DAWN_ENABLE_ASSERTS)
         // When in "debug" mode, 0xCA-out the mapped data when we free it so that in we can detect
@@ -412,6 +473,9 @@ namespace dawn_wire { namespace client {
 
         mMapOffset = 0;
         mMapSize = 0;
+        mWrittenRanges.clear();
+        mTracksWrittenRanges = false;
+        mWritesWholeMapping = false;
         mReadHandle = nullptr;
         mWriteHandle = nullptr;
         mMappedData = nullptr;
@@ -21,6 +21,7 @@
 #include "dawn_wire/client/ObjectBase.h"
 
 #include <map>
+#include <vector>
 
 namespace dawn_wire { namespace client {
 
@@ -57,6 +58,9 @@ namespace dawn_wire { namespace client {
         bool IsMappedForWriting() const;
         bool CheckGetMappedRangeOffsetSize(size_t offset, size_t size) const;
 
+        void MarkRangeWritten(size_t offset, size_t size);
+        void SerializeDataUpdate(size_t offset, size_t size);
+
         void FreeMappedData();
 
         Device* mDevice;
@@ -102,6 +106,20 @@ namespace dawn_wire { namespace client {
         size_t mMapOffset = 0;
         size_t mMapSize = 0;
 
+        // The application can only write to the mapping through the pointers returned by
+        // GetMappedRange, so only the ranges it returned since the buffer was mapped for writing
+        // are sent to the server on Unmap, one data update per range. The ranges are sorted and
+        // disjoint. If GetMappedRange wasn't called, or was called with a size of 0, the whole
+        // mapped range is sent.
+        struct WrittenRange {
+            size_t offset;
+            size_t size;
+        };
+        static constexpr size_t kMaxWrittenRanges = 16;
+        std::vector<WrittenRange> mWrittenRanges;
+        bool mTracksWrittenRanges = false;
+        bool mWritesWholeMapping = false;
+
         std::weak_ptr<bool> mDeviceIsAlive;
     };
 
@@ -15,6 +15,7 @@
 #include "dawn_wire/client/Client.h"
 
 #include "common/Compiler.h"
+#include "dawn_wire/PackedPassCommands.h"
 #include "dawn_wire/client/Device.h"
 
 namespace dawn_wire { namespace client {
@@ -44,7 +45,10 @@ namespace dawn_wire { namespace client {
     }  // anonymous namespace
 
     Client::Client(CommandSerializer* serializer, MemoryTransferService* memoryTransferService)
-        : ClientBase(), mSerializer(serializer), mMemoryTransferService(memoryTransferService) {
+        : ClientBase(),
+          mSerializer(serializer),
+          mMemoryTransferService(memoryTransferService),
+          mPackedPassCommands(new uint8_t[kMaxPackedPassCommandsSize]) {
         if (mMemoryTransferService == nullptr) {
             // If a MemoryTransferService is not provided, fall back to inline memory.
             mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
@@ -56,31 +60,84 @@ namespace dawn_wire { namespace client {
         DestroyAllObjects();
     }
 
+    uint8_t* Client::GetPackedPassCommandSpace(ObjectType passType, ObjectId passId, size_t size) {
+        ASSERT(size <= kMaxPackedPassCommandsSize);
+        if (passType != mPackedPassType || passId != mPackedPassId ||
+            size > kMaxPackedPassCommandsSize - mPackedPassCommandsSize) {
+            SerializePackedPassCommands();
+            mPackedPassType = passType;
+            mPackedPassId = passId;
+        }
+
+        uint8_t* space = &mPackedPassCommands[mPackedPassCommandsSize];
+        mPackedPassCommandsSize += size;
+        return space;
+    }
+
+    void Client::SerializePackedPassCommandsImpl() {
+        PassEncoderPackedCommandsCmd cmd;
+        cmd.passType = mPackedPassType;
+        cmd.passId = mPackedPassId;
+        cmd.version = kPackedPassCommandsVersion;
+        cmd.size = mPackedPassCommandsSize;
+        cmd.commands = nullptr;
+
+        size_t size = mPackedPassCommandsSize;
+        mPackedPassCommandsSize = 0;
+        mSerializer.SerializeCommandWithData(cmd, *this, mPackedPassCommands.get(), size);
+    }
+
     void Client::DestroyAllObjects() {
+        // Keep the packed pass commands ordered before the destruction of the objects.
+        SerializePackedPassCommands();
+
         for (auto& objectList : mObjects) {
             ObjectType objectType = static_cast<ObjectType>(&objectList - mObjects.data());
             if (objectType == ObjectType::Device) {
                 continue;
             }
-            while (!objectList.empty()) {
-                ObjectBase* object = objectList.head()->value();
+            DestroyAllObjectsOfType(objectType);
+        }
 
-                DestroyObjectCmd cmd;
-                cmd.objectType = objectType;
-                cmd.objectId = object->id;
-                SerializeCommand(cmd);
-                FreeObject(objectType, object);
+        DestroyAllObjectsOfType(ObjectType::Device);
+    }
+
+    void Client::DestroyAllObjectsOfType(ObjectType objectType) {
+        LinkedList<ObjectBase>& objectList = mObjects[objectType];
+
+        // All the DestroyObjectCmds have the same size so they are serialized in batches that
+        // each use a single call to CommandSerializer::GetCmdSpace.
+        const size_t commandSize = DestroyObjectCmd().GetRequiredSize();
+        const size_t maxBatchSize = mSerializer.GetMaximumAllocationSize() / commandSize;
+
+        // Once disconnected, the serializer can't send anything so the objects are only freed.
+        if (IsDisconnected() || maxBatchSize == 0) {
+            while (!objectList.empty()) {
+                FreeObject(objectType, objectList.head()->value());
             }
+            return;
         }
 
-        while (!mObjects[ObjectType::Device].empty()) {
-            ObjectBase* object = mObjects[ObjectType::Device].head()->value();
+        while (!objectList.empty()) {
+            size_t batchSize = 0;
+            for (LinkNode<ObjectBase>* node = objectList.head();
+                 node != objectList.end() && batchSize < maxBatchSize; node = node->next()) {
+                batchSize++;
+            }
+
+            SerializeBuffer reservation(nullptr, 0);
+            bool isReserved = mSerializer.ReserveCommandSpace(batchSize * commandSize, &reservation);
+            for (size_t i = 0; i < batchSize; ++i) {
+                ObjectBase* object = objectList.head()->value();
 
-            DestroyObjectCmd cmd;
-            cmd.objectType = ObjectType::Device;
-            cmd.objectId = object->id;
-            SerializeCommand(cmd);
-            FreeObject(ObjectType::Device, object);
+                if (isReserved) {
+                    DestroyObjectCmd cmd;
+                    cmd.objectType = objectType;
+                    cmd.objectId = object->id;
+                    mSerializer.SerializeReservedCommand(&reservation, cmd, *this);
+                }
+                FreeObject(objectType, object);
+            }
         }
     }
 
@@ -88,7 +145,7 @@ namespace dawn_wire { namespace client {
         auto* allocation = TextureAllocator().New(this);
 
         ReservedTexture result;
-        result.texture = ToAPI(allocation->object.get());
+        result.texture = ToAPI(allocation->object);
         result.id = allocation->object->id;
         result.generation = allocation->generation;
         result.deviceId = FromAPI(device)->id;
@@ -100,7 +157,7 @@ namespace dawn_wire { namespace client {
         auto* allocation = SwapChainAllocator().New(this);
 
         ReservedSwapChain result;
-        result.swapchain = ToAPI(allocation->object.get());
+        result.swapchain = ToAPI(allocation->object);
         result.id = allocation->object->id;
         result.generation = allocation->generation;
         result.deviceId = FromAPI(device)->id;
@@ -112,7 +169,7 @@ namespace dawn_wire { namespace client {
         auto* allocation = DeviceAllocator().New(this);
 
         ReservedDevice result;
-        result.device = ToAPI(allocation->object.get());
+        result.device = ToAPI(allocation->object);
         result.id = allocation->object->id;
         result.generation = allocation->generation;
         return result;
@@ -133,6 +190,7 @@ namespace dawn_wire { namespace client {
     void Client::Disconnect() {
         mDisconnected = true;
         mSerializer = ChunkedCommandSerializer(NoopCommandSerializer::GetInstance());
+        mPackedPassCommandsSize = 0;
 
         auto& deviceList = mObjects[ObjectType::Device];
         {
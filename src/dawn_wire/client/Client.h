@@ -51,8 +51,11 @@ namespace dawn_wire { namespace client {
         void ReclaimSwapChainReservation(const ReservedSwapChain& reservation);
         void ReclaimDeviceReservation(const ReservedDevice& reservation);
 
+        // The pending packed pass commands are serialized before any other command so that the
+        // commands stay in order.
         template <typename Cmd>
         void SerializeCommand(const Cmd& cmd) {
+            SerializePackedPassCommands();
             mSerializer.SerializeCommand(cmd, *this);
         }
 
@@ -60,9 +63,28 @@ namespace dawn_wire { namespace client {
         void SerializeCommand(const Cmd& cmd,
                               size_t extraSize,
                               ExtraSizeSerializeFn&& SerializeExtraSize) {
+            SerializePackedPassCommands();
             mSerializer.SerializeCommand(cmd, *this, extraSize, SerializeExtraSize);
         }
 
+        template <typename Cmd>
+        void SerializeCommandWithData(const Cmd& cmd, const void* data, size_t dataSize) {
+            SerializePackedPassCommands();
+            mSerializer.SerializeCommandWithData(cmd, *this, data, dataSize);
+        }
+
+        // Returns space for |size| bytes of packed commands for the pass |passId| of type
+        // |passType|, see PackedPassCommands.h. The pending packed commands are serialized first
+        // if they are for another pass or if there isn't enough space left for |size| bytes.
+        uint8_t* GetPackedPassCommandSpace(ObjectType passType, ObjectId passId, size_t size);
+
+        // Serializes the pending packed pass commands in a PassEncoderPackedCommands command.
+        void SerializePackedPassCommands() {
+            if (mPackedPassCommandsSize != 0) {
+                SerializePackedPassCommandsImpl();
+            }
+        }
+
         void Disconnect();
         bool IsDisconnected() const;
 
@@ -72,7 +94,9 @@ namespace dawn_wire { namespace client {
         }
 
       private:
+        void SerializePackedPassCommandsImpl();
         void DestroyAllObjects();
+        void DestroyAllObjectsOfType(ObjectType objectType);
 
 #include "dawn_wire/client/ClientPrototypes_autogen.inc"
 
@@ -81,6 +105,11 @@ namespace dawn_wire { namespace client {
         MemoryTransferService* mMemoryTransferService = nullptr;
         std::unique_ptr<MemoryTransferService> mOwnedMemoryTransferService = nullptr;
 
+        std::unique_ptr<uint8_t[]> mPackedPassCommands;
+        size_t mPackedPassCommandsSize = 0;
+        ObjectType mPackedPassType = ObjectType::RenderPassEncoder;
+        ObjectId mPackedPassId = 0;
+
         PerObjectType<LinkedList<ObjectBase>> mObjects;
         bool mDisconnected = false;
     };
@@ -216,7 +216,7 @@ namespace dawn_wire { namespace client {
         if (mQueue == nullptr) {
             // Get the primary queue for this device.
             auto* allocation = client->QueueAllocator().New(client);
-            mQueue = allocation->object.get();
+            mQueue = allocation->object;
 
             DeviceGetQueueCmd cmd;
             cmd.self = ToAPI(this);
@@ -254,7 +254,7 @@ namespace dawn_wire { namespace client {
         cmd.descriptor = &localDescriptor;
         client->SerializeCommand(cmd);
 
-        return ToAPI(allocation->object.get());
+        return ToAPI(allocation->object);
     }
 
     void Device::CreateComputePipelineAsync(WGPUComputePipelineDescriptor const* descriptor,
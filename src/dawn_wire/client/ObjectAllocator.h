@@ -17,39 +17,49 @@
 
 #include "common/Assert.h"
 #include "common/Compiler.h"
+#include "common/SlabAllocator.h"
 #include "dawn_wire/WireCmd_autogen.h"
 
 #include <limits>
-#include <memory>
 #include <vector>
 
 namespace dawn_wire { namespace client {
 
+    // The objects are allocated out of per-type slabs because a lot of them, like command
+    // encoders, pass encoders and bind groups, are created and released every frame.
     template <typename T>
     class ObjectAllocator {
       public:
         struct ObjectAndSerial {
-            ObjectAndSerial(std::unique_ptr<T> object, uint32_t generation)
-                : object(std::move(object)), generation(generation) {
+            ObjectAndSerial(T* object, uint32_t generation)
+                : object(object), generation(generation) {
             }
-            std::unique_ptr<T> object;
+            T* object;
             uint32_t generation;
         };
 
-        ObjectAllocator() {
+        ObjectAllocator() : mSlabAllocator(kObjectsPerSlab * sizeof(T)) {
             // ID 0 is nullptr
             mObjects.emplace_back(nullptr, 0);
         }
 
+        ~ObjectAllocator() {
+            for (ObjectAndSerial& objectAndSerial : mObjects) {
+                if (objectAndSerial.object != nullptr) {
+                    DestroyObject(objectAndSerial.object);
+                }
+            }
+        }
+
         template <typename Client>
         ObjectAndSerial* New(Client* client) {
             uint32_t id = GetNewId();
-            auto object = std::make_unique<T>(client, 1, id);
-            client->TrackObject(object.get());
+            T* object = mSlabAllocator.Allocate(client, 1, id);
+            client->TrackObject(object);
 
             if (id >= mObjects.size()) {
                 ASSERT(id == mObjects.size());
-                mObjects.emplace_back(std::move(object), 0);
+                mObjects.emplace_back(object, 0);
             } else {
                 ASSERT(mObjects[id].object == nullptr);
 
@@ -58,26 +68,28 @@ namespace dawn_wire { namespace client {
                 // overflow their next generation.
                 ASSERT(mObjects[id].generation != 0);
 
-                mObjects[id].object = std::move(object);
+                mObjects[id].object = object;
             }
 
             return &mObjects[id];
         }
         void Free(T* obj) {
             ASSERT(obj->IsInList());
-            if (DAWN_LIKELY(mObjects[obj->id].generation != std::numeric_limits<uint32_t>::max())) {
+            uint32_t id = obj->id;
+            if (DAWN_LIKELY(mObjects[id].generation != std::numeric_limits<uint32_t>::max())) {
                 // Only recycle this ObjectId if the generation won't overflow on the next
                 // allocation.
-                FreeId(obj->id);
+                FreeId(id);
             }
-            mObjects[obj->id].object = nullptr;
+            mObjects[id].object = nullptr;
+            DestroyObject(obj);
         }
 
         T* GetObject(uint32_t id) {
             if (id >= mObjects.size()) {
                 return nullptr;
             }
-            return mObjects[id].object.get();
+            return mObjects[id].object;
         }
 
         uint32_t GetGeneration(uint32_t id) {
@@ -88,6 +100,13 @@ namespace dawn_wire { namespace client {
         }
 
       private:
+        static constexpr size_t kObjectsPerSlab = 64;
+
+        void DestroyObject(T* object) {
+            object->~T();
+            mSlabAllocator.Deallocate(object);
+        }
+
         uint32_t GetNewId() {
             if (mFreeIds.empty()) {
                 return mCurrentId++;
@@ -104,6 +123,7 @@ namespace dawn_wire { namespace client {
         uint32_t mCurrentId = 1;
         std::vector<uint32_t> mFreeIds;
         std::vector<ObjectAndSerial> mObjects;
+        SlabAllocator<T> mSlabAllocator;
     };
 }}  // namespace dawn_wire::client
 
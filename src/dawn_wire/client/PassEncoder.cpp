@@ -0,0 +1,148 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_wire/client/PassEncoder.h"
+
+#include "dawn_wire/PackedPassCommands.h"
+#include "dawn_wire/client/Client.h"
+
+namespace dawn_wire { namespace client {
+
+    namespace {
+
+        // Like ObjectIdProvider::GetId, the null object is packed as the ID 0.
+        template <typename T>
+        ObjectId GetPackedId(T object) {
+            return object == nullptr ? 0 : FromAPI(object)->id;
+        }
+
+        template <typename Pass, typename... Args>
+        void PackCommand(Pass* pass, PackedPassCommand command, const Args&... args) {
+            uint8_t* space = pass->client->GetPackedPassCommandSpace(
+                ObjectTypeToTypeEnum<Pass>::value, pass->id, PackedSize(command, args...));
+            Pack(space, command, args...);
+        }
+
+        template <typename SetBindGroupCmd, typename Pass>
+        void PackSetBindGroup(Pass* pass,
+                              uint32_t groupIndex,
+                              WGPUBindGroup group,
+                              uint32_t dynamicOffsetCount,
+                              const uint32_t* dynamicOffsets) {
+            if (dynamicOffsetCount > kMaxPackedDynamicOffsetCount) {
+                SetBindGroupCmd cmd;
+                cmd.self = ToAPI(pass);
+                cmd.groupIndex = groupIndex;
+                cmd.group = group;
+                cmd.dynamicOffsetCount = dynamicOffsetCount;
+                cmd.dynamicOffsets = dynamicOffsets;
+                pass->client->SerializeCommand(cmd);
+                return;
+            }
+
+            ObjectId groupId = GetPackedId(group);
+            size_t offsetsSize = dynamicOffsetCount * sizeof(uint32_t);
+            uint8_t* space = pass->client->GetPackedPassCommandSpace(
+                ObjectTypeToTypeEnum<Pass>::value, pass->id,
+                PackedSize(PackedPassCommand::SetBindGroup, groupIndex, groupId,
+                           dynamicOffsetCount) +
+                    offsetsSize);
+            space = Pack(space, PackedPassCommand::SetBindGroup, groupIndex, groupId,
+                         dynamicOffsetCount);
+            if (offsetsSize != 0) {
+                memcpy(space, dynamicOffsets, offsetsSize);
+            }
+        }
+
+    }  // anonymous namespace
+
+    void RenderPassEncoder::SetPipeline(WGPURenderPipeline pipeline) {
+        PackCommand(this, PackedPassCommand::SetPipeline, GetPackedId(pipeline));
+    }
+
+    void RenderPassEncoder::SetBindGroup(uint32_t groupIndex,
+                                         WGPUBindGroup group,
+                                         uint32_t dynamicOffsetCount,
+                                         const uint32_t* dynamicOffsets) {
+        PackSetBindGroup<RenderPassEncoderSetBindGroupCmd>(this, groupIndex, group,
+                                                           dynamicOffsetCount, dynamicOffsets);
+    }
+
+    void RenderPassEncoder::SetVertexBuffer(uint32_t slot,
+                                            WGPUBuffer buffer,
+                                            uint64_t offset,
+                                            uint64_t size) {
+        PackCommand(this, PackedPassCommand::SetVertexBuffer, slot, GetPackedId(buffer), offset,
+                    size);
+    }
+
+    void RenderPassEncoder::SetIndexBuffer(WGPUBuffer buffer,
+                                           WGPUIndexFormat format,
+                                           uint64_t offset,
+                                           uint64_t size) {
+        PackCommand(this, PackedPassCommand::SetIndexBuffer, GetPackedId(buffer),
+                    static_cast<uint32_t>(format), offset, size);
+    }
+
+    void RenderPassEncoder::Draw(uint32_t vertexCount,
+                                 uint32_t instanceCount,
+                                 uint32_t firstVertex,
+                                 uint32_t firstInstance) {
+        PackCommand(this, PackedPassCommand::Draw, vertexCount, instanceCount, firstVertex,
+                    firstInstance);
+    }
+
+    void RenderPassEncoder::DrawIndexed(uint32_t indexCount,
+                                        uint32_t instanceCount,
+                                        uint32_t firstIndex,
+                                        int32_t baseVertex,
+                                        uint32_t firstInstance) {
+        PackCommand(this, PackedPassCommand::DrawIndexed, indexCount, instanceCount, firstIndex,
+                    baseVertex, firstInstance);
+    }
+
+    void RenderPassEncoder::DrawIndirect(WGPUBuffer indirectBuffer, uint64_t indirectOffset) {
+        PackCommand(this, PackedPassCommand::DrawIndirect, GetPackedId(indirectBuffer),
+                    indirectOffset);
+    }
+
+    void RenderPassEncoder::DrawIndexedIndirect(WGPUBuffer indirectBuffer,
+                                                uint64_t indirectOffset) {
+        PackCommand(this, PackedPassCommand::DrawIndexedIndirect, GetPackedId(indirectBuffer),
+                    indirectOffset);
+    }
+
+    void ComputePassEncoder::SetPipeline(WGPUComputePipeline pipeline) {
+        PackCommand(this, PackedPassCommand::SetPipeline, GetPackedId(pipeline));
+    }
+
+    void ComputePassEncoder::SetBindGroup(uint32_t groupIndex,
+                                          WGPUBindGroup group,
+                                          uint32_t dynamicOffsetCount,
+                                          const uint32_t* dynamicOffsets) {
+        PackSetBindGroup<ComputePassEncoderSetBindGroupCmd>(this, groupIndex, group,
+                                                            dynamicOffsetCount, dynamicOffsets);
+    }
+
+    void ComputePassEncoder::Dispatch(uint32_t x, uint32_t y, uint32_t z) {
+        PackCommand(this, PackedPassCommand::Dispatch, x, y, z);
+    }
+
+    void ComputePassEncoder::DispatchIndirect(WGPUBuffer indirectBuffer,
+                                              uint64_t indirectOffset) {
+        PackCommand(this, PackedPassCommand::DispatchIndirect, GetPackedId(indirectBuffer),
+                    indirectOffset);
+    }
+
+}}  // namespace dawn_wire::client
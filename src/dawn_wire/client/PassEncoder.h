@@ -0,0 +1,68 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNWIRE_CLIENT_PASSENCODER_H_
+#define DAWNWIRE_CLIENT_PASSENCODER_H_
+
+#include <dawn/webgpu.h>
+
+#include "dawn_wire/client/ObjectBase.h"
+
+namespace dawn_wire { namespace client {
+
+    // The commands of the draw loops are packed by the client, see PackedPassCommands.h. The
+    // other commands of the passes are serialized individually.
+    class RenderPassEncoder final : public ObjectBase {
+      public:
+        using ObjectBase::ObjectBase;
+
+        void SetPipeline(WGPURenderPipeline pipeline);
+        void SetBindGroup(uint32_t groupIndex,
+                          WGPUBindGroup group,
+                          uint32_t dynamicOffsetCount,
+                          const uint32_t* dynamicOffsets);
+        void SetVertexBuffer(uint32_t slot, WGPUBuffer buffer, uint64_t offset, uint64_t size);
+        void SetIndexBuffer(WGPUBuffer buffer,
+                            WGPUIndexFormat format,
+                            uint64_t offset,
+                            uint64_t size);
+        void Draw(uint32_t vertexCount,
+                  uint32_t instanceCount,
+                  uint32_t firstVertex,
+                  uint32_t firstInstance);
+        void DrawIndexed(uint32_t indexCount,
+                         uint32_t instanceCount,
+                         uint32_t firstIndex,
+                         int32_t baseVertex,
+                         uint32_t firstInstance);
+        void DrawIndirect(WGPUBuffer indirectBuffer, uint64_t indirectOffset);
+        void DrawIndexedIndirect(WGPUBuffer indirectBuffer, uint64_t indirectOffset);
+    };
+
+    class ComputePassEncoder final : public ObjectBase {
+      public:
+        using ObjectBase::ObjectBase;
+
+        void SetPipeline(WGPUComputePipeline pipeline);
+        void SetBindGroup(uint32_t groupIndex,
+                          WGPUBindGroup group,
+                          uint32_t dynamicOffsetCount,
+                          const uint32_t* dynamicOffsets);
+        void Dispatch(uint32_t x, uint32_t y, uint32_t z);
+        void DispatchIndirect(WGPUBuffer indirectBuffer, uint64_t indirectOffset);
+    };
+
+}}  // namespace dawn_wire::client
+
+#endif  // DAWNWIRE_CLIENT_PASSENCODER_H_
@@ -70,10 +70,10 @@ namespace dawn_wire { namespace client {
         cmd.queueId = id;
         cmd.bufferId = buffer->id;
         cmd.bufferOffset = bufferOffset;
-        cmd.data = static_cast<const uint8_t*>(data);
+        cmd.data = nullptr;
         cmd.size = size;
 
-        client->SerializeCommand(cmd);
+        client->SerializeCommandWithData(cmd, data, size);
     }
 
     void Queue::WriteTexture(const WGPUImageCopyTexture* destination,
@@ -84,12 +84,12 @@ namespace dawn_wire { namespace client {
         QueueWriteTextureInternalCmd cmd;
         cmd.queueId = id;
         cmd.destination = destination;
-        cmd.data = static_cast<const uint8_t*>(data);
         cmd.dataSize = dataSize;
         cmd.dataLayout = dataLayout;
         cmd.writeSize = writeSize;
+        cmd.data = nullptr;
 
-        client->SerializeCommand(cmd);
+        client->SerializeCommandWithData(cmd, data, dataSize);
     }
 
     void Queue::CancelCallbacksForDisconnect() {
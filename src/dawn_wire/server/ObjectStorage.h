@@ -15,17 +15,42 @@
 #ifndef DAWNWIRE_SERVER_OBJECTSTORAGE_H_
 #define DAWNWIRE_SERVER_OBJECTSTORAGE_H_
 
+#include "common/LinkedList.h"
 #include "dawn_wire/WireCmd_autogen.h"
 #include "dawn_wire/WireServer.h"
 
 #include <algorithm>
+#include <deque>
 #include <map>
-#include <unordered_set>
+#include <vector>
 
 namespace dawn_wire { namespace server {
 
+    // Links the data of an object into the list of children of its device. It is stored inline
+    // in the object data so that tracking device children doesn't need any allocation.
+    struct DeviceChildLink : public LinkNode<DeviceChildLink> {
+        DeviceChildLink() = default;
+        DeviceChildLink(DeviceChildLink&& rhs) = default;
+        ~DeviceChildLink() {
+            if (IsInList()) {
+                RemoveFromList();
+            }
+        }
+
+        // Only used to reset the data of a free ObjectId, which isn't in any list.
+        DeviceChildLink& operator=(DeviceChildLink&& rhs) {
+            ASSERT(!IsInList() && !rhs.IsInList());
+            type = rhs.type;
+            id = rhs.id;
+            return *this;
+        }
+
+        ObjectType type{};
+        ObjectId id = 0;
+    };
+
     struct DeviceInfo {
-        std::unordered_set<uint64_t> childObjectTypesAndIds;
+        LinkedList<DeviceChildLink> children;
         Server* server;
         ObjectHandle self;
     };
@@ -48,6 +73,7 @@ namespace dawn_wire { namespace server {
 
         // This points to an allocation that is owned by the device.
         DeviceInfo* deviceInfo = nullptr;
+        DeviceChildLink deviceChildLink;
     };
 
     // Stores what the backend knows about the type.
@@ -67,21 +93,6 @@ namespace dawn_wire { namespace server {
         bool mappedAtCreation = false;
     };
 
-    // Pack the ObjectType and ObjectId as a single value for storage in
-    // an std::unordered_set. This lets us avoid providing our own hash and
-    // equality comparison operators.
-    inline uint64_t PackObjectTypeAndId(ObjectType type, ObjectId id) {
-        static_assert(sizeof(ObjectType) * 8 <= 32, "");
-        static_assert(sizeof(ObjectId) * 8 <= 32, "");
-        return (static_cast<uint64_t>(type) << 32) + id;
-    }
-
-    inline std::pair<ObjectType, ObjectId> UnpackObjectTypeAndId(uint64_t payload) {
-        ObjectType type = static_cast<ObjectType>(payload >> 32);
-        ObjectId id = payload & 0xFFFFFFFF;
-        return std::make_pair(type, id);
-    }
-
     template <>
     struct ObjectData<WGPUDevice> : public ObjectDataBase<WGPUDevice> {
         // Store |info| as a separate allocation so that its address does not move.
@@ -89,7 +100,8 @@ namespace dawn_wire { namespace server {
         std::unique_ptr<DeviceInfo> info = std::make_unique<DeviceInfo>();
     };
 
-    // Keeps track of the mapping between client IDs and backend objects.
+    // Keeps track of the mapping between client IDs and backend objects. The data is stored in a
+    // deque so that it doesn't move when new IDs are allocated, which the DeviceChildLinks rely on.
     template <typename T>
     class KnownObjects {
       public:
@@ -136,7 +148,7 @@ namespace dawn_wire { namespace server {
 
         // Allocates the data for a given ID and returns it.
         // Returns nullptr if the ID is already allocated, or too far ahead, or if ID is 0 (ID 0 is
-        // reserved for nullptr). Invalidates all the Data*
+        // reserved for nullptr).
         Data* Allocate(uint32_t id, AllocationState state = AllocationState::Allocated) {
             if (id == 0 || id > mKnown.size()) {
                 return nullptr;
@@ -190,7 +202,7 @@ namespace dawn_wire { namespace server {
         }
 
       private:
-        std::vector<Data> mKnown;
+        std::deque<Data> mKnown;
     };
 
     // ObjectIds are lost in deserialization. Store the ids of deserialized
@@ -61,7 +61,7 @@ namespace dawn_wire { namespace server {
         data->state = AllocationState::Allocated;
         data->deviceInfo = device->info.get();
 
-        if (!TrackDeviceChild(data->deviceInfo, ObjectType::Texture, id)) {
+        if (!TrackDeviceChild(data->deviceInfo, ObjectType::Texture, id, &data->deviceChildLink)) {
             return false;
         }
 
@@ -93,7 +93,8 @@ namespace dawn_wire { namespace server {
         data->state = AllocationState::Allocated;
         data->deviceInfo = device->info.get();
 
-        if (!TrackDeviceChild(data->deviceInfo, ObjectType::SwapChain, id)) {
+        if (!TrackDeviceChild(data->deviceInfo, ObjectType::SwapChain, id,
+                              &data->deviceChildLink)) {
             return false;
         }
 
@@ -169,23 +170,23 @@ namespace dawn_wire { namespace server {
         mProcs.deviceSetDeviceLostCallback(device, nullptr, nullptr);
     }
 
-    bool TrackDeviceChild(DeviceInfo* info, ObjectType type, ObjectId id) {
-        auto it = info->childObjectTypesAndIds.insert(PackObjectTypeAndId(type, id));
-        if (!it.second) {
+    bool TrackDeviceChild(DeviceInfo* info, ObjectType type, ObjectId id, DeviceChildLink* link) {
+        if (link->IsInList()) {
             // An object of this type and id already exists.
             return false;
         }
+        link->type = type;
+        link->id = id;
+        info->children.Append(link);
         return true;
     }
 
-    bool UntrackDeviceChild(DeviceInfo* info, ObjectType type, ObjectId id) {
-        auto& children = info->childObjectTypesAndIds;
-        auto it = children.find(PackObjectTypeAndId(type, id));
-        if (it == children.end()) {
+    bool UntrackDeviceChild(DeviceChildLink* link) {
+        if (!link->IsInList()) {
             // An object of this type and id was already deleted.
             return false;
         }
-        children.erase(it);
+        link->RemoveFromList();
         return true;
     }
 
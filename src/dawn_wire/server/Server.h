@@ -16,6 +16,7 @@
 #define DAWNWIRE_SERVER_SERVER_H_
 
 #include "dawn_wire/ChunkedCommandSerializer.h"
+#include "dawn_wire/PackedPassCommands.h"
 #include "dawn_wire/server/ServerBase_autogen.h"
 
 namespace dawn_wire { namespace server {
@@ -215,6 +216,12 @@ namespace dawn_wire { namespace server {
                                               const WGPUCompilationInfo* info,
                                               ShaderModuleGetCompilationInfoUserdata* userdata);
 
+        // Decoders of the packed pass commands sent with PassEncoderPackedCommands.
+        bool DoRenderPassPackedCommands(WGPURenderPassEncoder pass,
+                                        PackedPassCommandReader* commands);
+        bool DoComputePassPackedCommands(WGPUComputePassEncoder pass,
+                                         PackedPassCommandReader* commands);
+
 #include "dawn_wire/server/ServerPrototypes_autogen.inc"
 
         WireDeserializeAllocator mAllocator;
@@ -226,8 +233,8 @@ namespace dawn_wire { namespace server {
         std::shared_ptr<bool> mIsAlive;
     };
 
-    bool TrackDeviceChild(DeviceInfo* device, ObjectType type, ObjectId id);
-    bool UntrackDeviceChild(DeviceInfo* device, ObjectType type, ObjectId id);
+    bool TrackDeviceChild(DeviceInfo* device, ObjectType type, ObjectId id, DeviceChildLink* link);
+    bool UntrackDeviceChild(DeviceChildLink* link);
 
     std::unique_ptr<MemoryTransferService> CreateInlineMemoryTransferService();
 
@@ -117,7 +117,8 @@ namespace dawn_wire { namespace server {
         resultData->deviceInfo = device->info.get();
         resultData->usage = descriptor->usage;
         resultData->mappedAtCreation = descriptor->mappedAtCreation;
-        if (!TrackDeviceChild(resultData->deviceInfo, ObjectType::Buffer, bufferResult.id)) {
+        if (!TrackDeviceChild(resultData->deviceInfo, ObjectType::Buffer, bufferResult.id,
+                              &resultData->deviceChildLink)) {
             return false;
         }
 
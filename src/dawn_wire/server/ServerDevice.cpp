@@ -39,7 +39,8 @@ namespace dawn_wire { namespace server {
                 // This should be impossible to fail. It would require a command to be sent that
                 // creates a duplicate ObjectId, which would fail validation.
                 bool success = TrackDeviceChild(pipelineObject->deviceInfo, objectType,
-                                                data->pipelineObjectID);
+                                                data->pipelineObjectID,
+                                                &pipelineObject->deviceChildLink);
                 ASSERT(success);
             } else {
                 // Otherwise, free the ObjectId which will make it unusable.
@@ -0,0 +1,257 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_wire/server/Server.h"
+
+namespace dawn_wire { namespace server {
+
+    namespace {
+
+        // Like ObjectIdResolver::GetFromId, the objects must be known and not null.
+        template <typename T>
+        bool ReadObject(PackedPassCommandReader* commands,
+                        const KnownObjects<T>& objects,
+                        T* handle) {
+            ObjectId id;
+            if (!commands->Read(&id)) {
+                return false;
+            }
+            const auto* data = objects.Get(id);
+            if (data == nullptr) {
+                return false;
+            }
+            *handle = data->handle;
+            return true;
+        }
+
+    }  // anonymous namespace
+
+    bool Server::DoPassEncoderPackedCommands(ObjectType passType,
+                                             ObjectId passId,
+                                             uint32_t version,
+                                             uint64_t size,
+                                             const uint8_t* commands) {
+        if (version != kPackedPassCommandsVersion) {
+            return false;
+        }
+
+        // The commands were copied by the deserialization so |size| fits in a size_t.
+        PackedPassCommandReader reader(commands, static_cast<size_t>(size));
+        switch (passType) {
+            case ObjectType::RenderPassEncoder: {
+                auto* pass = RenderPassEncoderObjects().Get(passId);
+                if (pass == nullptr) {
+                    return false;
+                }
+                return DoRenderPassPackedCommands(pass->handle, &reader);
+            }
+            case ObjectType::ComputePassEncoder: {
+                auto* pass = ComputePassEncoderObjects().Get(passId);
+                if (pass == nullptr) {
+                    return false;
+                }
+                return DoComputePassPackedCommands(pass->handle, &reader);
+            }
+            default:
+                return false;
+        }
+    }
+
+    bool Server::DoRenderPassPackedCommands(WGPURenderPassEncoder pass,
+                                            PackedPassCommandReader* commands) {
+        while (!commands->IsEmpty()) {
+            PackedPassCommand command;
+            if (!commands->Read(&command)) {
+                return false;
+            }
+
+            switch (command) {
+                case PackedPassCommand::SetPipeline: {
+                    WGPURenderPipeline pipeline;
+                    if (!ReadObject(commands, RenderPipelineObjects(), &pipeline)) {
+                        return false;
+                    }
+                    mProcs.renderPassEncoderSetPipeline(pass, pipeline);
+                    break;
+                }
+
+                case PackedPassCommand::SetBindGroup: {
+                    uint32_t groupIndex;
+                    WGPUBindGroup group;
+                    uint32_t dynamicOffsetCount;
+                    uint32_t dynamicOffsets[kMaxPackedDynamicOffsetCount];
+                    if (!commands->Read(&groupIndex) ||
+                        !ReadObject(commands, BindGroupObjects(), &group) ||
+                        !commands->Read(&dynamicOffsetCount) ||
+                        dynamicOffsetCount > kMaxPackedDynamicOffsetCount ||
+                        !commands->ReadArray(dynamicOffsetCount, dynamicOffsets)) {
+                        return false;
+                    }
+                    mProcs.renderPassEncoderSetBindGroup(pass, groupIndex, group,
+                                                         dynamicOffsetCount, dynamicOffsets);
+                    break;
+                }
+
+                case PackedPassCommand::SetVertexBuffer: {
+                    uint32_t slot;
+                    WGPUBuffer buffer;
+                    uint64_t offset;
+                    uint64_t size;
+                    if (!commands->Read(&slot) || !ReadObject(commands, BufferObjects(), &buffer) ||
+                        !commands->Read(&offset, &size)) {
+                        return false;
+                    }
+                    mProcs.renderPassEncoderSetVertexBuffer(pass, slot, buffer, offset, size);
+                    break;
+                }
+
+                case PackedPassCommand::SetIndexBuffer: {
+                    WGPUBuffer buffer;
+                    uint32_t format;
+                    uint64_t offset;
+                    uint64_t size;
+                    if (!ReadObject(commands, BufferObjects(), &buffer) ||
+                        !commands->Read(&format, &offset, &size)) {
+                        return false;
+                    }
+                    mProcs.renderPassEncoderSetIndexBuffer(
+                        pass, buffer, static_cast<WGPUIndexFormat>(format), offset, size);
+                    break;
+                }
+
+                case PackedPassCommand::Draw: {
+                    uint32_t vertexCount;
+                    uint32_t instanceCount;
+                    uint32_t firstVertex;
+                    uint32_t firstInstance;
+                    if (!commands->Read(&vertexCount, &instanceCount, &firstVertex,
+                                        &firstInstance)) {
+                        return false;
+                    }
+                    mProcs.renderPassEncoderDraw(pass, vertexCount, instanceCount, firstVertex,
+                                                 firstInstance);
+                    break;
+                }
+
+                case PackedPassCommand::DrawIndexed: {
+                    uint32_t indexCount;
+                    uint32_t instanceCount;
+                    uint32_t firstIndex;
+                    int32_t baseVertex;
+                    uint32_t firstInstance;
+                    if (!commands->Read(&indexCount, &instanceCount, &firstIndex, &baseVertex,
+                                        &firstInstance)) {
+                        return false;
+                    }
+                    mProcs.renderPassEncoderDrawIndexed(pass, indexCount, instanceCount,
+                                                        firstIndex, baseVertex, firstInstance);
+                    break;
+                }
+
+                case PackedPassCommand::DrawIndirect: {
+                    WGPUBuffer indirectBuffer;
+                    uint64_t indirectOffset;
+                    if (!ReadObject(commands, BufferObjects(), &indirectBuffer) ||
+                        !commands->Read(&indirectOffset)) {
+                        return false;
+                    }
+                    mProcs.renderPassEncoderDrawIndirect(pass, indirectBuffer, indirectOffset);
+                    break;
+                }
+
+                case PackedPassCommand::DrawIndexedIndirect: {
+                    WGPUBuffer indirectBuffer;
+                    uint64_t indirectOffset;
+                    if (!ReadObject(commands, BufferObjects(), &indirectBuffer) ||
+                        !commands->Read(&indirectOffset)) {
+                        return false;
+                    }
+                    mProcs.renderPassEncoderDrawIndexedIndirect(pass, indirectBuffer,
+                                                                indirectOffset);
+                    break;
+                }
+
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    bool Server::DoComputePassPackedCommands(WGPUComputePassEncoder pass,
+                                             PackedPassCommandReader* commands) {
+        while (!commands->IsEmpty()) {
+            PackedPassCommand command;
+            if (!commands->Read(&command)) {
+                return false;
+            }
+
+            switch (command) {
+                case PackedPassCommand::SetPipeline: {
+                    WGPUComputePipeline pipeline;
+                    if (!ReadObject(commands, ComputePipelineObjects(), &pipeline)) {
+                        return false;
+                    }
+                    mProcs.computePassEncoderSetPipeline(pass, pipeline);
+                    break;
+                }
+
+                case PackedPassCommand::SetBindGroup: {
+                    uint32_t groupIndex;
+                    WGPUBindGroup group;
+                    uint32_t dynamicOffsetCount;
+                    uint32_t dynamicOffsets[kMaxPackedDynamicOffsetCount];
+                    if (!commands->Read(&groupIndex) ||
+                        !ReadObject(commands, BindGroupObjects(), &group) ||
+                        !commands->Read(&dynamicOffsetCount) ||
+                        dynamicOffsetCount > kMaxPackedDynamicOffsetCount ||
+                        !commands->ReadArray(dynamicOffsetCount, dynamicOffsets)) {
+                        return false;
+                    }
+                    mProcs.computePassEncoderSetBindGroup(pass, groupIndex, group,
+                                                          dynamicOffsetCount, dynamicOffsets);
+                    break;
+                }
+
+                case PackedPassCommand::Dispatch: {
+                    uint32_t x;
+                    uint32_t y;
+                    uint32_t z;
+                    if (!commands->Read(&x, &y, &z)) {
+                        return false;
+                    }
+                    mProcs.computePassEncoderDispatch(pass, x, y, z);
+                    break;
+                }
+
+                case PackedPassCommand::DispatchIndirect: {
+                    WGPUBuffer indirectBuffer;
+                    uint64_t indirectOffset;
+                    if (!ReadObject(commands, BufferObjects(), &indirectBuffer) ||
+                        !commands->Read(&indirectOffset)) {
+                        return false;
+                    }
+                    mProcs.computePassEncoderDispatchIndirect(pass, indirectBuffer,
+                                                              indirectOffset);
+                    break;
+                }
+
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+
+}}  // namespace dawn_wire::server
@@ -68,6 +68,8 @@ namespace dawn_wire { namespace server {
                                        "Data size too large for write texture.");
         }
 
+        // |data| points directly inside the command buffer (see "wire_is_data_only") and is only
+        // read once, by the copy of queueWriteBuffer.
         mProcs.queueWriteBuffer(queue->handle, buffer->handle, bufferOffset, data,
                                 static_cast<size_t>(size));
         return true;
@@ -75,10 +77,10 @@ namespace dawn_wire { namespace server {
 
     bool Server::DoQueueWriteTextureInternal(ObjectId queueId,
                                              const WGPUImageCopyTexture* destination,
-                                             const uint8_t* data,
                                              uint64_t dataSize,
                                              const WGPUTextureDataLayout* dataLayout,
-                                             const WGPUExtent3D* writeSize) {
+                                             const WGPUExtent3D* writeSize,
+                                             const uint8_t* data) {
         // The null object isn't valid as `self` so we can combine the check with the
         // check that the ID is valid.
         auto* queue = QueueObjects().Get(queueId);
@@ -96,6 +98,8 @@ namespace dawn_wire { namespace server {
                                        "Data size too large for write texture.");
         }
 
+        // |data| points directly inside the command buffer (see "wire_is_data_only") and is only
+        // read by the copies of queueWriteTexture.
         mProcs.queueWriteTexture(queue->handle, destination, data, static_cast<size_t>(dataSize),
                                  dataLayout, writeSize);
         return true;
@@ -192,6 +192,70 @@ namespace dawn_native {
     // Backdoor to get the number of deprecation warnings for testing
     DAWN_NATIVE_EXPORT size_t GetDeprecationWarningCountForTesting(WGPUDevice device);
 
+    // Counters of the render and compute pipeline creations of a device. A creation is either a
+    // hit in the pipeline cache, a join of an identical asynchronous creation still in flight,
+    // or a miss that compiles a new pipeline.
+    struct DAWN_NATIVE_EXPORT PipelineCreationStats {
+        uint64_t cacheHits = 0;
+        uint64_t cacheMisses = 0;
+        uint64_t pendingCreationJoins = 0;
+    };
+
+    // Query the pipeline creation counters of the device
+    DAWN_NATIVE_EXPORT PipelineCreationStats GetPipelineCreationStats(WGPUDevice device);
+
+    // Counters of the pool of memory blocks used to store the commands of the command buffers
+    // and render bundles of a device.
+    struct DAWN_NATIVE_EXPORT CommandBlockPoolStats {
+        // Blocks allocated from and freed to the system allocator.
+        uint64_t systemAllocations = 0;
+        uint64_t systemFrees = 0;
+        // Blocks allocated by reusing a block previously returned to the pool.
+        uint64_t recycledAllocations = 0;
+        // The blocks currently kept in the pool for reuse.
+        uint64_t cachedBlocks = 0;
+        uint64_t cachedBytes = 0;
+    };
+
+    // Query the command block pool counters of the device
+    DAWN_NATIVE_EXPORT CommandBlockPoolStats GetCommandBlockPoolStats(WGPUDevice device);
+
+    // Counters of the persistent cache of the blobs of a device, like compiled shaders.
+    struct DAWN_NATIVE_EXPORT PersistentCacheStats {
+        // Loads served by the in-memory tier, by the platform cache, or by neither of them.
+        uint64_t memoryHits = 0;
+        uint64_t platformHits = 0;
+        uint64_t misses = 0;
+        uint64_t stores = 0;
+        // Blobs evicted from the in-memory tier to stay within its byte budget.
+        uint64_t evictions = 0;
+        // The bytes of the keys and blobs held in the in-memory tier.
+        uint64_t memoryBytes = 0;
+    };
+
+    // Query the persistent cache counters of the device
+    DAWN_NATIVE_EXPORT PersistentCacheStats GetPersistentCacheStats(WGPUDevice device);
+
+    // Counters of the uploader that allocates the staging memory of WriteBuffer, WriteTexture and
+    // the other uploads of a device.
+    struct DAWN_NATIVE_EXPORT DynamicUploaderStats {
+        // The bytes of the uploads the GPU isn't done with, and the most reached at any time.
+        uint64_t bytesInFlight = 0;
+        uint64_t peakBytesInFlight = 0;
+        // The bytes of the staging buffers held by the uploader, in flight or kept for reuse.
+        uint64_t stagingBufferBytes = 0;
+        uint64_t ringBufferCount = 0;
+        // Staging buffers created, and bytes of staging buffers freed after staying unused.
+        uint64_t stagingBufferCreations = 0;
+        uint64_t trimmedBytes = 0;
+        // Allocations too large for the ring buffers, and those that reused a staging buffer.
+        uint64_t largeAllocations = 0;
+        uint64_t largeAllocationReuses = 0;
+    };
+
+    // Query the dynamic uploader counters of the device
+    DAWN_NATIVE_EXPORT DynamicUploaderStats GetDynamicUploaderStats(WGPUDevice device);
+
     //  Query if texture has been initialized
     DAWN_NATIVE_EXPORT bool IsTextureSubresourceInitialized(
         WGPUTexture texture,
@@ -61,6 +61,14 @@ namespace dawn_wire {
                                                           const volatile char* deserializeBuffer,
                                                           size_t deserializeBufferSize);
 
+    // Returns the size of the command at the start of |commands|, a stream of commands sent by a
+    // WireClient, and sets |name| to the name of the command, or nullptr if the command is
+    // unknown. Returns 0 if |commands| doesn't start with a whole command. This lets tools handle
+    // the commands of a wire trace one at a time.
+    DAWN_WIRE_EXPORT size_t PeekWireCommand(const volatile char* commands,
+                                            size_t size,
+                                            const char** name);
+
 }  // namespace dawn_wire
 
 #endif  // DAWNWIRE_WIRE_H_
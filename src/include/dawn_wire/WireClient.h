@@ -73,6 +73,12 @@ namespace dawn_wire {
         void ReclaimSwapChainReservation(const ReservedSwapChain& reservation);
         void ReclaimDeviceReservation(const ReservedDevice& reservation);
 
+        // The commands recorded in render and compute passes are packed together and serialized
+        // before the next command that isn't packed. Call this to serialize the pending packed
+        // commands before flushing the CommandSerializer when the server must see all the
+        // commands recorded so far.
+        void SerializePendingCommands();
+
         // Disconnects the client.
         // Commands allocated after this point will not be sent.
         void Disconnect();
@@ -151,7 +157,8 @@ namespace dawn_wire {
 
                 // Serialize a command to send the modified contents of
                 // the subrange (offset, offset + size) of the allocation at buffer unmap
-                // This subrange is always the whole mapped region for now
+                // It can be called for several disjoint subranges of the mapped region, the ranges
+                // that were returned by GetMappedRange
                 // There could be nothing to be serialized (if using shared memory)
                 virtual void SerializeDataUpdate(void* serializePointer,
                                                  size_t offset,
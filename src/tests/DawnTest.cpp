@@ -261,6 +261,18 @@ void DawnTestEnvironment::ParseArgs(int argc, char** argv) {
             continue;
         }
 
+        if (strcmp("--wire-server-thread", argv[i]) == 0) {
+            mUseWire = true;
+            mUseWireServerThread = true;
+            continue;
+        }
+
+        if (strcmp("--wire-shared-memory", argv[i]) == 0) {
+            mUseWire = true;
+            mUseWireSharedMemory = true;
+            continue;
+        }
+
         if (strcmp("--run-suppressed-tests", argv[i]) == 0) {
             mRunSuppressedTests = true;
             continue;
@@ -378,6 +390,10 @@ void DawnTestEnvironment::ParseArgs(int argc, char** argv) {
                    "[--enable-backend-validation[=full,partial,disabled]]\n"
                    "    [--exclusive-device-type-preference=integrated,cpu,discrete]\n\n"
                    "  -w, --use-wire: Run the tests through the wire (defaults to no wire)\n"
+                   "  --wire-server-thread: Run the tests through the wire with the server on a "
+                   "separate thread. Implies --use-wire\n"
+                   "  --wire-shared-memory: Run the tests through the wire with the mapped buffers "
+                   "in shared memory instead of copied in the commands. Implies --use-wire\n"
                    "  -c, --begin-capture-on-startup: Begin debug capture on startup "
                    "(defaults to no capture)\n"
                    "  --enable-backend-validation: Enables backend validation. Defaults to \n"
@@ -562,6 +578,12 @@ void DawnTestEnvironment::PrintTestConfigurationAndAdapterInfo(
            "---------------------\n"
            "UseWire: "
         << (mUseWire ? "true" : "false")
+        << "\n"
+           "UseWireServerThread: "
+        << (mUseWireServerThread ? "true" : "false")
+        << "\n"
+           "UseWireSharedMemory: "
+        << (mUseWireSharedMemory ? "true" : "false")
         << "\n"
            "Run suppressed tests: "
         << (mRunSuppressedTests ? "true" : "false")
@@ -644,6 +666,14 @@ bool DawnTestEnvironment::UsesWire() const {
     return mUseWire;
 }
 
+bool DawnTestEnvironment::UsesWireServerThread() const {
+    return mUseWireServerThread;
+}
+
+bool DawnTestEnvironment::UsesWireSharedMemory() const {
+    return mUseWireSharedMemory;
+}
+
 bool DawnTestEnvironment::RunSuppressedTests() const {
     return mRunSuppressedTests;
 }
@@ -691,7 +721,11 @@ const std::vector<std::string>& DawnTestEnvironment::GetDisabledToggles() const
 
 DawnTestBase::DawnTestBase(const AdapterTestParam& param)
     : mParam(param),
-      mWireHelper(utils::CreateWireHelper(gTestEnv->UsesWire(), gTestEnv->GetWireTraceDir())) {
+      mUsesWire(gTestEnv->UsesWire()),
+      mWireHelper(utils::CreateWireHelper(mUsesWire,
+                                          gTestEnv->GetWireTraceDir(),
+                                          gTestEnv->UsesWireServerThread(),
+                                          gTestEnv->UsesWireSharedMemory())) {
 }
 
 DawnTestBase::~DawnTestBase() {
@@ -800,7 +834,20 @@ bool DawnTestBase::IsMacOS(int32_t majorVersion, int32_t minorVersion) const {
 }
 
 bool DawnTestBase::UsesWire() const {
-    return gTestEnv->UsesWire();
+    return mUsesWire;
+}
+
+void DawnTestBase::ForceUsesWire() {
+    if (mUsesWire) {
+        return;
+    }
+
+    // The previous WireHelper must be destroyed first because it resets the procs on destruction.
+    mUsesWire = true;
+    mWireHelper = nullptr;
+    mWireHelper = utils::CreateWireHelper(true, gTestEnv->GetWireTraceDir(),
+                                          gTestEnv->UsesWireServerThread(),
+                                          gTestEnv->UsesWireSharedMemory());
 }
 
 bool DawnTestBase::IsBackendValidationEnabled() const {
@@ -1375,7 +1422,7 @@ void DawnTestBase::WaitABit() {
 }
 
 void DawnTestBase::FlushWire() {
-    if (gTestEnv->UsesWire()) {
+    if (mUsesWire) {
         bool C2SFlushed = mWireHelper->FlushClient();
         bool S2CFlushed = mWireHelper->FlushServer();
         ASSERT(C2SFlushed);
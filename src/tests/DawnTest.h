@@ -216,6 +216,8 @@ class DawnTestEnvironment : public testing::Environment {
     void TearDown() override;
 
     bool UsesWire() const;
+    bool UsesWireServerThread() const;
+    bool UsesWireSharedMemory() const;
     dawn_native::BackendValidationLevel GetBackendValidationLevel() const;
     dawn_native::Instance* GetInstance() const;
     bool HasVendorIdFilter() const;
@@ -241,6 +243,8 @@ class DawnTestEnvironment : public testing::Environment {
     void PrintTestConfigurationAndAdapterInfo(dawn_native::Instance* instance) const;
 
     bool mUseWire = false;
+    bool mUseWireServerThread = false;
+    bool mUseWireSharedMemory = false;
     dawn_native::BackendValidationLevel mBackendValidationLevel =
         dawn_native::BackendValidationLevel::Disabled;
     bool mBeginCaptureOnStartup = false;
@@ -473,6 +477,9 @@ class DawnTestBase {
 
     void WaitABit();
     void FlushWire();
+    // Makes the test use the wire even when the environment doesn't. Must be called in the
+    // constructor of the test, before the device is created in SetUp().
+    void ForceUsesWire();
     void WaitForAllOperations();
 
     bool SupportsExtensions(const std::vector<const char*>& extensions);
@@ -488,6 +495,7 @@ class DawnTestBase {
   private:
     utils::ScopedAutoreleasePool mObjCAutoreleasePool;
     AdapterTestParam mParam;
+    bool mUsesWire;
     std::unique_ptr<utils::WireHelper> mWireHelper;
 
     // Tracking for validation errors
@@ -14,6 +14,7 @@
 
 #include "tests/DawnTest.h"
 
+#include "dawn_native/DawnNative.h"
 #include "utils/ComboRenderPipelineDescriptor.h"
 #include "utils/WGPUHelpers.h"
 
@@ -386,6 +387,96 @@ TEST_P(CreatePipelineAsyncTest, CreateSamePipelineTwiceAtSameTime) {
     }
 }
 
+// Verify that a synchronous CreateComputePipeline() with the same descriptor as an asynchronous
+// creation that is still in flight returns the same pipeline object.
+TEST_P(CreatePipelineAsyncTest, CreateComputePipelineWhileSamePipelineIsCreatedAsync) {
+    wgpu::ComputePipelineDescriptor csDesc;
+    csDesc.compute.module = utils::CreateShaderModule(device, R"(
+        [[block]] struct SSBO {
+            value : u32;
+        };
+        [[group(0), binding(0)]] var<storage, read_write> ssbo : SSBO;
+
+        [[stage(compute), workgroup_size(1)]] fn main() {
+            ssbo.value = 1u;
+        })");
+    csDesc.compute.entryPoint = "main";
+
+    device.CreateComputePipelineAsync(
+        &csDesc,
+        [](WGPUCreatePipelineAsyncStatus status, WGPUComputePipeline returnPipeline,
+           const char* message, void* userdata) {
+            EXPECT_EQ(WGPUCreatePipelineAsyncStatus::WGPUCreatePipelineAsyncStatus_Success, status);
+
+            CreatePipelineAsyncTask* task = static_cast<CreatePipelineAsyncTask*>(userdata);
+            task->computePipeline = wgpu::ComputePipeline::Acquire(returnPipeline);
+            task->isCompleted = true;
+            task->message = message;
+        },
+        &task);
+
+    wgpu::ComputePipeline syncPipeline = device.CreateComputePipeline(&csDesc);
+    ASSERT_NE(nullptr, syncPipeline.Get());
+
+    ValidateCreateComputePipelineAsync();
+
+    if (!UsesWire()) {
+        EXPECT_EQ(syncPipeline.Get(), task.computePipeline.Get());
+    }
+}
+
+// Verify that a second CreateComputePipelineAsync() with the same descriptor as an asynchronous
+// creation that is still in flight doesn't compile the pipeline again.
+TEST_P(CreatePipelineAsyncTest, CreateSameComputePipelineAsyncJoinsPendingCreation) {
+    // The statistics are only available on the dawn_native device.
+    DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+    wgpu::ComputePipelineDescriptor csDesc;
+    csDesc.compute.module = utils::CreateShaderModule(device, R"(
+        [[block]] struct SSBO {
+            value : u32;
+        };
+        [[group(0), binding(0)]] var<storage, read_write> ssbo : SSBO;
+
+        [[stage(compute), workgroup_size(1)]] fn main() {
+            ssbo.value = 1u;
+        })");
+    csDesc.compute.entryPoint = "main";
+
+    auto callback = [](WGPUCreatePipelineAsyncStatus status, WGPUComputePipeline returnPipeline,
+                       const char* message, void* userdata) {
+        EXPECT_EQ(WGPUCreatePipelineAsyncStatus::WGPUCreatePipelineAsyncStatus_Success, status);
+
+        CreatePipelineAsyncTask* task = static_cast<CreatePipelineAsyncTask*>(userdata);
+        task->computePipeline = wgpu::ComputePipeline::Acquire(returnPipeline);
+        task->isCompleted = true;
+        task->message = message;
+    };
+
+    dawn_native::PipelineCreationStats statsBefore =
+        dawn_native::GetPipelineCreationStats(device.Get());
+
+    CreatePipelineAsyncTask anotherTask;
+    device.CreateComputePipelineAsync(&csDesc, callback, &task);
+    device.CreateComputePipelineAsync(&csDesc, callback, &anotherTask);
+
+    ValidateCreateComputePipelineAsync(&anotherTask);
+    ValidateCreateComputePipelineAsync(&task);
+    EXPECT_EQ(task.computePipeline.Get(), anotherTask.computePipeline.Get());
+
+    dawn_native::PipelineCreationStats statsAfter =
+        dawn_native::GetPipelineCreationStats(device.Get());
+    EXPECT_EQ(1u, statsAfter.cacheMisses - statsBefore.cacheMisses);
+
+    // The OpenGL backends create and cache the pipeline synchronously so the second creation is a
+    // cache hit there.
+    if (IsD3D12() || IsMetal() || IsVulkan()) {
+        EXPECT_EQ(1u, statsAfter.pendingCreationJoins - statsBefore.pendingCreationJoins);
+    } else {
+        EXPECT_EQ(1u, statsAfter.cacheHits - statsBefore.cacheHits);
+    }
+}
+
 DAWN_INSTANTIATE_TEST(CreatePipelineAsyncTest,
                       D3D12Backend(),
                       MetalBackend(),
@@ -14,16 +14,18 @@
 
 #include "tests/DawnTest.h"
 
+#include "dawn_native/DawnNative.h"
 #include "utils/ComboRenderPipelineDescriptor.h"
 #include "utils/WGPUHelpers.h"
 
-#define EXPECT_CACHE_HIT(N, statement)              \
-    do {                                            \
-        size_t before = mPersistentCache.mHitCount; \
-        statement;                                  \
-        FlushWire();                                \
-        size_t after = mPersistentCache.mHitCount;  \
-        EXPECT_EQ(N, after - before);               \
+// Counts the loads served by either the in-memory tier of the device's cache or the platform cache.
+#define EXPECT_CACHE_HIT(N, statement)        \
+    do {                                      \
+        uint64_t before = GetCacheHitCount(); \
+        statement;                            \
+        FlushWire();                          \
+        uint64_t after = GetCacheHitCount();  \
+        EXPECT_EQ(N, after - before);         \
     } while (0)
 
 // FakePersistentCache implements a in-memory persistent cache.
@@ -58,7 +60,6 @@ class FakePersistentCache : public dawn_platform::CachingInterface {
         if (valueSize >= entry->second.size()) {
             memcpy(value, entry->second.data(), entry->second.size());
         }
-        mHitCount++;
         return entry->second.size();
     }
 
@@ -67,7 +68,6 @@ class FakePersistentCache : public dawn_platform::CachingInterface {
 
     FakeCache mCache;
 
-    size_t mHitCount = 0;
     bool mIsDisabled = false;
 };
 
@@ -93,10 +93,17 @@ class D3D12CachingTests : public DawnTest {
         return std::make_unique<DawnTestPlatform>(&mPersistentCache);
     }
 
+    uint64_t GetCacheHitCount() const {
+        dawn_native::PersistentCacheStats stats =
+            dawn_native::GetPersistentCacheStats(backendDevice);
+        return stats.memoryHits + stats.platformHits;
+    }
+
     FakePersistentCache mPersistentCache;
 };
 
-// Test that duplicate WGSL still re-compiles HLSL even when the cache is not enabled.
+// Test that duplicate WGSL doesn't re-compile HLSL even when the platform cache doesn't store
+// anything, because the HLSL shaders are kept in the in-memory tier of the device's cache.
 TEST_P(D3D12CachingTests, SameShaderNoCache) {
     mPersistentCache.mIsDisabled = true;
 
@@ -123,7 +130,7 @@ TEST_P(D3D12CachingTests, SameShaderNoCache) {
 
     EXPECT_EQ(mPersistentCache.mCache.size(), 0u);
 
-    // Load the same WGSL shader from the cache.
+    // Load the same WGSL shader from the in-memory tier.
     {
         utils::ComboRenderPipelineDescriptor desc;
         desc.vertex.module = module;
@@ -131,7 +138,7 @@ TEST_P(D3D12CachingTests, SameShaderNoCache) {
         desc.cFragment.module = module;
         desc.cFragment.entryPoint = "fragment_main";
 
-        EXPECT_CACHE_HIT(0u, device.CreateRenderPipeline(&desc));
+        EXPECT_CACHE_HIT(2u, device.CreateRenderPipeline(&desc));
     }
 
     EXPECT_EQ(mPersistentCache.mCache.size(), 0u);
@@ -172,9 +179,8 @@ TEST_P(D3D12CachingTests, ReuseShaderWithMultipleEntryPointsPerStage) {
         desc.cFragment.module = module;
         desc.cFragment.entryPoint = "fragment_main";
 
-        // Cached HLSL shader calls LoadData twice (once to peek, again to get), so check 2 x
-        // kNumOfShaders hits.
-        EXPECT_CACHE_HIT(4u, device.CreateRenderPipeline(&desc));
+        // Each of the kNumOfShaders cached HLSL shaders is a hit.
+        EXPECT_CACHE_HIT(2u, device.CreateRenderPipeline(&desc));
     }
 
     EXPECT_EQ(mPersistentCache.mCache.size(), 2u);
@@ -199,8 +205,6 @@ TEST_P(D3D12CachingTests, ReuseShaderWithMultipleEntryPointsPerStage) {
         EXPECT_CACHE_HIT(0u, device.CreateRenderPipeline(&desc));
     }
 
-    // Cached HLSL shader calls LoadData twice (once to peek, again to get), so check 2 x
-    // kNumOfShaders hits.
     EXPECT_EQ(mPersistentCache.mCache.size(), 4u);
 }
 
@@ -242,15 +246,12 @@ TEST_P(D3D12CachingTests, ReuseShaderWithMultipleEntryPoints) {
         desc.compute.module = module;
         desc.compute.entryPoint = "write1";
 
-        // Cached HLSL shader calls LoadData twice (once to peek, again to get), so check 2 x
-        // kNumOfShaders hits.
-        EXPECT_CACHE_HIT(2u, device.CreateComputePipeline(&desc));
+        EXPECT_CACHE_HIT(1u, device.CreateComputePipeline(&desc));
 
         desc.compute.module = module;
         desc.compute.entryPoint = "write42";
 
-        // Cached HLSL shader calls LoadData twice, so check 2 x kNumOfShaders hits.
-        EXPECT_CACHE_HIT(2u, device.CreateComputePipeline(&desc));
+        EXPECT_CACHE_HIT(1u, device.CreateComputePipeline(&desc));
     }
 
     EXPECT_EQ(mPersistentCache.mCache.size(), 2u);
@@ -82,7 +82,9 @@ namespace {
 
 }  // namespace
 
-// Test uploading |kBufferSize| bytes of data |kNumIterations| times.
+// Test uploading |kBufferSize| bytes of data |kNumIterations| times. Run with --use-wire, then
+// with --wire-shared-memory, to compare the upload throughput when the mapped buffers are copied
+// in the wire commands and when they are shared with the server.
 class BufferUploadPerf : public DawnPerfTestWithParams<BufferUploadParams> {
   public:
     BufferUploadPerf()
@@ -92,6 +94,7 @@ class BufferUploadPerf : public DawnPerfTestWithParams<BufferUploadParams> {
     ~BufferUploadPerf() override = default;
 
     void SetUp() override;
+    void TearDown() override;
 
   private:
     void Step() override;
@@ -108,6 +111,14 @@ void BufferUploadPerf::SetUp() {
     desc.usage = wgpu::BufferUsage::CopyDst;
 
     dst = device.CreateBuffer(&desc);
+
+    SetThroughputResult("upload_throughput",
+                        static_cast<double>(kNumIterations) * data.size() / (1024 * 1024), "MB/s");
+}
+
+void BufferUploadPerf::TearDown() {
+    dst = nullptr;
+    DawnPerfTestWithParams<BufferUploadParams>::TearDown();
 }
 
 void BufferUploadPerf::Step() {
@@ -148,7 +159,8 @@ TEST_P(BufferUploadPerf, Run) {
 }
 
 DAWN_INSTANTIATE_TEST_P(BufferUploadPerf,
-                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {D3D12Backend(), MetalBackend(), NullBackend(), OpenGLBackend(),
+                         VulkanBackend()},
                         {UploadMethod::WriteBuffer, UploadMethod::MappedAtCreation},
                         {UploadSize::BufferSize_1KB, UploadSize::BufferSize_64KB,
                          UploadSize::BufferSize_1MB, UploadSize::BufferSize_4MB,
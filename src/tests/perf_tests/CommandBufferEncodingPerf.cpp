@@ -0,0 +1,136 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_native/DawnNative.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kCommandBuffersPerStep = 1000;
+
+    struct CommandBufferEncodingParams : AdapterTestParam {
+        CommandBufferEncodingParams(const AdapterTestParam& param,
+                                    uint32_t commandsPerBuffer,
+                                    uint32_t commandBuffersPerSubmit)
+            : AdapterTestParam(param),
+              commandsPerBuffer(commandsPerBuffer),
+              commandBuffersPerSubmit(commandBuffersPerSubmit) {
+        }
+
+        uint32_t commandsPerBuffer;
+        uint32_t commandBuffersPerSubmit;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const CommandBufferEncodingParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        ostream << "_" << param.commandsPerBuffer << "CommandsPerBuffer";
+        ostream << "_" << param.commandBuffersPerSubmit << "BuffersPerSubmit";
+        return ostream;
+    }
+
+}  // namespace
+
+// Test encoding, submitting and releasing many tiny command buffers, like an application that
+// records a command buffer per small piece of work. The cost is dominated by the fixed overhead
+// of each command buffer, including the allocation of the blocks storing its commands, so the
+// number of blocks allocated with the system allocator per step is reported as well.
+class CommandBufferEncodingPerf : public DawnPerfTestWithParams<CommandBufferEncodingParams> {
+  public:
+    CommandBufferEncodingPerf() : DawnPerfTestWithParams(kCommandBuffersPerStep, 1) {
+    }
+    ~CommandBufferEncodingPerf() override = default;
+
+    void SetUp() override;
+    void TearDown() override;
+
+  private:
+    void Step() override;
+
+    wgpu::Buffer mSrcBuffer;
+    wgpu::Buffer mDstBuffer;
+    std::vector<wgpu::CommandBuffer> mCommandBuffers;
+
+    dawn_native::CommandBlockPoolStats mStartStats;
+    uint64_t mStepCount = 0;
+};
+
+void CommandBufferEncodingPerf::SetUp() {
+    DawnPerfTestWithParams<CommandBufferEncodingParams>::SetUp();
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 256;
+    descriptor.usage = wgpu::BufferUsage::CopySrc;
+    mSrcBuffer = device.CreateBuffer(&descriptor);
+    descriptor.usage = wgpu::BufferUsage::CopyDst;
+    mDstBuffer = device.CreateBuffer(&descriptor);
+
+    mCommandBuffers.reserve(GetParam().commandBuffersPerSubmit);
+    mStartStats = dawn_native::GetCommandBlockPoolStats(backendDevice);
+}
+
+void CommandBufferEncodingPerf::TearDown() {
+    if (mStepCount > 0) {
+        dawn_native::CommandBlockPoolStats stats =
+            dawn_native::GetCommandBlockPoolStats(backendDevice);
+        PrintResult("system_block_allocations_per_step",
+                    static_cast<double>(stats.systemAllocations - mStartStats.systemAllocations) /
+                        mStepCount,
+                    "count", true);
+        PrintResult("recycled_block_allocations_per_step",
+                    static_cast<double>(stats.recycledAllocations -
+                                        mStartStats.recycledAllocations) /
+                        mStepCount,
+                    "count", false);
+    }
+
+    mCommandBuffers.clear();
+    mSrcBuffer = nullptr;
+    mDstBuffer = nullptr;
+    DawnPerfTestWithParams<CommandBufferEncodingParams>::TearDown();
+}
+
+void CommandBufferEncodingPerf::Step() {
+    const CommandBufferEncodingParams& params = GetParam();
+
+    for (unsigned int i = 0; i < kCommandBuffersPerStep; ++i) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        for (uint32_t j = 0; j < params.commandsPerBuffer; ++j) {
+            encoder.CopyBufferToBuffer(mSrcBuffer, 0, mDstBuffer, 0, 4);
+        }
+        mCommandBuffers.push_back(encoder.Finish());
+
+        if (mCommandBuffers.size() == params.commandBuffersPerSubmit) {
+            queue.Submit(static_cast<uint32_t>(mCommandBuffers.size()), mCommandBuffers.data());
+            // Release the command buffers so that their blocks are returned to the pool.
+            mCommandBuffers.clear();
+        }
+    }
+
+    // Tick the device like an application would once per frame, this trims the pool.
+    device.Tick();
+    mStepCount++;
+}
+
+TEST_P(CommandBufferEncodingPerf, Run) {
+    RunTest();
+}
+
+// The block pool doesn't depend on the backend, only run on the Null backend.
+DAWN_INSTANTIATE_TEST_P(CommandBufferEncodingPerf,
+                        {NullBackend()},
+                        {1u, 16u},
+                        {1u, 100u});
@@ -0,0 +1,162 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "utils/WGPUHelpers.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kBindGroupsPerStep = 10000;
+    constexpr uint64_t kUniformBufferSize = 256;
+
+    // The order of the entries of the BindGroupDescriptors compared to the BindGroupLayout.
+    enum class EntryOrder {
+        Sorted,    // The entries are sorted by binding number.
+        Reversed,  // The entries are sorted in the reverse order of the binding numbers.
+    };
+
+    // The binding numbers of the layout.
+    enum class BindingNumbers {
+        Dense,   // 0, 1, 2...
+        Sparse,  // 0, 1000, 2000...
+    };
+
+    struct CreateBindGroupParams : AdapterTestParam {
+        CreateBindGroupParams(const AdapterTestParam& param,
+                              uint32_t entryCount,
+                              EntryOrder entryOrder,
+                              BindingNumbers bindingNumbers)
+            : AdapterTestParam(param),
+              entryCount(entryCount),
+              entryOrder(entryOrder),
+              bindingNumbers(bindingNumbers) {
+        }
+
+        uint32_t entryCount;
+        EntryOrder entryOrder;
+        BindingNumbers bindingNumbers;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const CreateBindGroupParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        ostream << "_" << param.entryCount << "Entries";
+
+        switch (param.entryOrder) {
+            case EntryOrder::Sorted:
+                ostream << "_Sorted";
+                break;
+            case EntryOrder::Reversed:
+                ostream << "_Reversed";
+                break;
+        }
+
+        switch (param.bindingNumbers) {
+            case BindingNumbers::Dense:
+                ostream << "_Dense";
+                break;
+            case BindingNumbers::Sparse:
+                ostream << "_Sparse";
+                break;
+        }
+
+        return ostream;
+    }
+
+}  // namespace
+
+// Test creating |kBindGroupsPerStep| bind groups of uniform buffers every step, like renderers
+// that create the bind groups of their draws every frame. The number of bind groups created per
+// second is reported.
+class CreateBindGroupPerf : public DawnPerfTestWithParams<CreateBindGroupParams> {
+  public:
+    CreateBindGroupPerf() : DawnPerfTestWithParams(kBindGroupsPerStep, 1) {
+    }
+    ~CreateBindGroupPerf() override = default;
+
+    void SetUp() override;
+    void TearDown() override;
+
+  private:
+    void Step() override;
+
+    wgpu::Buffer mUniformBuffer;
+    wgpu::BindGroupLayout mLayout;
+    std::vector<wgpu::BindGroupEntry> mEntries;
+};
+
+void CreateBindGroupPerf::SetUp() {
+    DawnPerfTestWithParams<CreateBindGroupParams>::SetUp();
+    const CreateBindGroupParams& params = GetParam();
+
+    wgpu::BufferDescriptor bufferDesc;
+    bufferDesc.size = kUniformBufferSize;
+    bufferDesc.usage = wgpu::BufferUsage::Uniform;
+    mUniformBuffer = device.CreateBuffer(&bufferDesc);
+
+    uint32_t bindingStride = params.bindingNumbers == BindingNumbers::Dense ? 1 : 1000;
+    std::vector<wgpu::BindGroupLayoutEntry> layoutEntries(params.entryCount);
+    mEntries.resize(params.entryCount);
+    for (uint32_t i = 0; i < params.entryCount; ++i) {
+        layoutEntries[i].binding = i * bindingStride;
+        layoutEntries[i].visibility = wgpu::ShaderStage::Vertex | wgpu::ShaderStage::Fragment;
+        layoutEntries[i].buffer.type = wgpu::BufferBindingType::Uniform;
+
+        mEntries[i].binding = i * bindingStride;
+        mEntries[i].buffer = mUniformBuffer;
+        mEntries[i].size = kUniformBufferSize;
+    }
+    if (params.entryOrder == EntryOrder::Reversed) {
+        std::reverse(mEntries.begin(), mEntries.end());
+    }
+
+    wgpu::BindGroupLayoutDescriptor layoutDesc;
+    layoutDesc.entryCount = layoutEntries.size();
+    layoutDesc.entries = layoutEntries.data();
+    mLayout = device.CreateBindGroupLayout(&layoutDesc);
+
+    SetThroughputResult("bind_groups_per_second", kBindGroupsPerStep, "bind groups");
+}
+
+void CreateBindGroupPerf::TearDown() {
+    mEntries.clear();
+    mLayout = nullptr;
+    mUniformBuffer = nullptr;
+    DawnPerfTestWithParams<CreateBindGroupParams>::TearDown();
+}
+
+void CreateBindGroupPerf::Step() {
+    wgpu::BindGroupDescriptor descriptor;
+    descriptor.layout = mLayout;
+    descriptor.entryCount = mEntries.size();
+    descriptor.entries = mEntries.data();
+    for (unsigned int i = 0; i < kBindGroupsPerStep; ++i) {
+        wgpu::BindGroup bindGroup = device.CreateBindGroup(&descriptor);
+    }
+}
+
+TEST_P(CreateBindGroupPerf, Run) {
+    RunTest();
+}
+
+// The validation of bind groups doesn't depend on the backend, only run on the Null backend.
+DAWN_INSTANTIATE_TEST_P(CreateBindGroupPerf,
+                        {NullBackend()},
+                        {1u, 4u, 12u},
+                        {EntryOrder::Sorted, EntryOrder::Reversed},
+                        {BindingNumbers::Dense, BindingNumbers::Sparse});
@@ -230,6 +230,14 @@ void DawnPerfTestBase::RunTest() {
     platform->EnableTraceEventRecording(false);
 }
 
+void DawnPerfTestBase::SetThroughputResult(const char* trace,
+                                           double amountPerStep,
+                                           const char* units) {
+    mThroughputTrace = trace;
+    mThroughputAmountPerStep = amountPerStep;
+    mThroughputUnits = units;
+}
+
 void DawnPerfTestBase::DoRunLoop(double maxRunTime) {
     dawn_platform::Platform* platform = gTestEnv->GetPlatform();
 
@@ -351,6 +359,12 @@ void DawnPerfTestBase::OutputResults() {
     PrintPerIterationResultFromSeconds("validation_time", totalValidationTime, true);
     PrintPerIterationResultFromSeconds("recording_time", totalRecordingTime, true);
 
+    if (mThroughputTrace != nullptr && mTimer->GetElapsedTime() > 0) {
+        PrintResult(mThroughputTrace,
+                    mThroughputAmountPerStep * mNumStepsPerformed / mTimer->GetElapsedTime(),
+                    mThroughputUnits, true);
+    }
+
     const char* traceFile = gTestEnv->GetTraceFile();
     if (traceFile != nullptr) {
         DumpTraceEventsToJSONFile(traceEventBuffer, traceFile);
@@ -75,6 +75,13 @@ class DawnPerfTestBase {
     void AbortTest();
 
     void RunTest();
+
+    // Makes each trial also report |trace|, the throughput of the test in |units|, computed from
+    // the |amountPerStep| of work done by each step and the wall time of the trial. The wall time
+    // includes the flushes of the wire and the waits for the GPU between the steps. It can be
+    // called in Step() if the amount of work is only known once it is recorded.
+    void SetThroughputResult(const char* trace, double amountPerStep, const char* units);
+
     void PrintPerIterationResultFromSeconds(const std::string& trace,
                                             double valueInSeconds,
                                             bool important) const;
@@ -106,6 +113,10 @@ class DawnPerfTestBase {
     unsigned int mNumStepsPerformed = 0;
     double mCpuTime;
     std::unique_ptr<utils::Timer> mTimer;
+
+    const char* mThroughputTrace = nullptr;
+    double mThroughputAmountPerStep = 0;
+    const char* mThroughputUnits = nullptr;
 };
 
 template <typename Params = AdapterTestParam>
@@ -20,10 +20,17 @@
 #include "utils/ComboRenderPipelineDescriptor.h"
 #include "utils/WGPUHelpers.h"
 
+#include <vector>
+
 namespace {
 
     constexpr unsigned int kNumDraws = 2000;
 
+    // The number of bundles the draws are split in with RenderBundle::Many, and the number of
+    // times each bundle is executed in the pass with RenderBundle::ManyRepeated.
+    constexpr unsigned int kNumRenderBundles = 200;
+    constexpr unsigned int kRenderBundleRepeatCount = 4;
+
     constexpr uint32_t kTextureSize = 64;
     constexpr size_t kUniformSize = 3 * sizeof(float);
 
@@ -87,8 +94,15 @@ namespace {
     };
 
     enum class RenderBundle {
-        No,   // Record commands in a render pass
-        Yes,  // Record commands in a render bundle
+        No,            // Record commands in a render pass
+        Yes,           // Record commands in a render bundle
+        Many,          // Record commands in many render bundles that each use a few resources
+        ManyRepeated,  // Same as Many, but execute each render bundle several times in the pass
+    };
+
+    enum class Wire {
+        No,   // Use the wire only if the test environment does
+        Yes,  // Always send the commands over the wire
     };
 
     struct DrawCallParam {
@@ -97,10 +111,11 @@ namespace {
         BindGroup bindGroupType;
         UniformData uniformDataType;
         RenderBundle withRenderBundle;
+        Wire wire;
     };
 
     using DrawCallParamTuple =
-        std::tuple<Pipeline, VertexBuffer, BindGroup, UniformData, RenderBundle>;
+        std::tuple<Pipeline, VertexBuffer, BindGroup, UniformData, RenderBundle, Wire>;
 
     template <typename T>
     unsigned int AssignParam(T& lhs, T rhs) {
@@ -116,11 +131,12 @@ namespace {
     //  - BindGroup::NoChange
     //  - UniformData::Static
     //  - RenderBundle::No
+    //  - Wire::No
     template <typename... Ts>
     DrawCallParam MakeParam(Ts... args) {
         // Baseline param
         DrawCallParamTuple paramTuple{Pipeline::Static, VertexBuffer::NoChange, BindGroup::NoChange,
-                                      UniformData::Static, RenderBundle::No};
+                                      UniformData::Static, RenderBundle::No, Wire::No};
 
         unsigned int unused[] = {
             0,  // Avoid making a 0-sized array.
@@ -131,7 +147,7 @@ namespace {
         return DrawCallParam{
             std::get<Pipeline>(paramTuple),     std::get<VertexBuffer>(paramTuple),
             std::get<BindGroup>(paramTuple),    std::get<UniformData>(paramTuple),
-            std::get<RenderBundle>(paramTuple),
+            std::get<RenderBundle>(paramTuple), std::get<Wire>(paramTuple),
         };
     }
 
@@ -199,6 +215,20 @@ namespace {
             case RenderBundle::Yes:
                 ostream << "_RenderBundle";
                 break;
+            case RenderBundle::Many:
+                ostream << "_ManyRenderBundles";
+                break;
+            case RenderBundle::ManyRepeated:
+                ostream << "_ManyRepeatedRenderBundles";
+                break;
+        }
+
+        switch (param.wire) {
+            case Wire::No:
+                break;
+            case Wire::Yes:
+                ostream << "_Wire";
+                break;
         }
 
         return ostream;
@@ -217,12 +247,18 @@ namespace {
 //   - Static/Dynamic pipelines: In addition to a change to GPU state, changing the pipeline
 //     layout incurs additional state tracking costs in Dawn.
 //   - With/Without render bundles: All of the above can have lower validation costs if
-//     precomputed in a render bundle.
+//     precomputed in a render bundle. Executing many bundles, or the same bundles several
+//     times, tests the cost of merging the resource usage of the bundles in the pass.
 //   - Static/Dynamic data: Updating data for each draw is a common use case. It also tests
 //     the efficiency of resource transitions.
+//   - With/Without the wire: Tests the cost of sending the pass commands to the server. The
+//     number of pass calls per second is reported.
 class DrawCallPerf : public DawnPerfTestWithParams<DrawCallParamForTest> {
   public:
     DrawCallPerf() : DawnPerfTestWithParams(kNumDraws, 3) {
+        if (GetParam().wire == Wire::Yes) {
+            ForceUsesWire();
+        }
     }
     ~DrawCallPerf() override = default;
 
@@ -233,8 +269,11 @@ class DrawCallPerf : public DawnPerfTestWithParams<DrawCallParamForTest> {
         return DawnPerfTestWithParams::GetParam().param;
     }
 
+    // Returns the number of calls recorded in the encoder.
     template <typename Encoder>
-    void RecordRenderCommands(Encoder encoder);
+    uint32_t RecordRenderCommands(Encoder encoder,
+                                  unsigned int firstDraw = 0,
+                                  unsigned int drawCount = kNumDraws);
 
   private:
     void Step() override;
@@ -263,7 +302,7 @@ class DrawCallPerf : public DawnPerfTestWithParams<DrawCallParamForTest> {
     wgpu::TextureView mColorAttachment;
     wgpu::TextureView mDepthStencilAttachment;
 
-    wgpu::RenderBundle mRenderBundle;
+    std::vector<wgpu::RenderBundle> mRenderBundles;
 };
 
 void DrawCallPerf::SetUp() {
@@ -451,30 +490,40 @@ void DrawCallPerf::SetUp() {
     }
 
     // If using render bundles, record the render commands now.
-    if (GetParam().withRenderBundle == RenderBundle::Yes) {
+    if (GetParam().withRenderBundle != RenderBundle::No) {
         wgpu::RenderBundleEncoderDescriptor descriptor = {};
         descriptor.colorFormatsCount = 1;
         descriptor.colorFormats = &renderPipelineDesc.cTargets[0].format;
         descriptor.depthStencilFormat = wgpu::TextureFormat::Depth24PlusStencil8;
 
-        wgpu::RenderBundleEncoder encoder = device.CreateRenderBundleEncoder(&descriptor);
-        RecordRenderCommands(encoder);
-        mRenderBundle = encoder.Finish();
+        unsigned int bundleCount =
+            GetParam().withRenderBundle == RenderBundle::Yes ? 1 : kNumRenderBundles;
+        unsigned int drawsPerBundle = kNumDraws / bundleCount;
+        for (unsigned int i = 0; i < bundleCount; ++i) {
+            wgpu::RenderBundleEncoder encoder = device.CreateRenderBundleEncoder(&descriptor);
+            RecordRenderCommands(encoder, i * drawsPerBundle, drawsPerBundle);
+            mRenderBundles.push_back(encoder.Finish());
+        }
     }
 }
 
 template <typename Encoder>
-void DrawCallPerf::RecordRenderCommands(Encoder pass) {
+uint32_t DrawCallPerf::RecordRenderCommands(Encoder pass,
+                                            unsigned int firstDraw,
+                                            unsigned int drawCount) {
     uint32_t uniformBindGroupIndex = 0;
+    uint32_t callCount = 0;
 
     if (GetParam().pipelineType == Pipeline::Static) {
         // Static pipeline can be set now.
         pass.SetPipeline(mPipelines[0]);
+        callCount++;
     }
 
     if (GetParam().vertexBufferType == VertexBuffer::NoChange) {
         // Static vertex buffer can be set now.
         pass.SetVertexBuffer(0, mVertexBuffers[0]);
+        callCount++;
     }
 
     if (GetParam().bindGroupType == BindGroup::NoChange) {
@@ -483,24 +532,28 @@ void DrawCallPerf::RecordRenderCommands(Encoder pass) {
 
         // Static bind group can be set now.
         pass.SetBindGroup(uniformBindGroupIndex, mUniformBindGroups[0]);
+        callCount++;
     }
 
-    for (unsigned int i = 0; i < kNumDraws; ++i) {
+    for (unsigned int i = firstDraw; i < firstDraw + drawCount; ++i) {
         switch (GetParam().pipelineType) {
             case Pipeline::Static:
                 break;
             case Pipeline::Redundant:
                 pass.SetPipeline(mPipelines[0]);
+                callCount++;
                 break;
             case Pipeline::Dynamic: {
                 // If the pipeline is dynamic, ping pong between two pipelines.
                 pass.SetPipeline(mPipelines[i % 2]);
+                callCount++;
 
                 // The pipelines have different layouts so we change the binding index here.
                 uniformBindGroupIndex = i % 2;
                 if (uniformBindGroupIndex == 1) {
                     // Because of the pipeline layout change, we need to rebind bind group index 0.
                     pass.SetBindGroup(0, mConstantBindGroup);
+                    callCount++;
                 }
                 break;
             }
@@ -513,10 +566,12 @@ void DrawCallPerf::RecordRenderCommands(Encoder pass) {
 
             case VertexBuffer::Multiple:
                 pass.SetVertexBuffer(0, mVertexBuffers[i]);
+                callCount++;
                 break;
 
             case VertexBuffer::Dynamic:
                 pass.SetVertexBuffer(0, mVertexBuffers[0], i * mAlignedVertexDataSize);
+                callCount++;
                 break;
         }
 
@@ -527,22 +582,26 @@ void DrawCallPerf::RecordRenderCommands(Encoder pass) {
 
             case BindGroup::Redundant:
                 pass.SetBindGroup(uniformBindGroupIndex, mUniformBindGroups[0]);
+                callCount++;
                 break;
 
             case BindGroup::NoReuse: {
                 wgpu::BindGroup bindGroup = utils::MakeBindGroup(
                     device, mUniformBindGroupLayout, {{0, mUniformBuffers[i], 0, kUniformSize}});
                 pass.SetBindGroup(uniformBindGroupIndex, bindGroup);
+                callCount++;
                 break;
             }
 
             case BindGroup::Multiple:
                 pass.SetBindGroup(uniformBindGroupIndex, mUniformBindGroups[i]);
+                callCount++;
                 break;
 
             case BindGroup::Dynamic: {
                 uint32_t dynamicOffset = static_cast<uint32_t>(i * mAlignedUniformSize);
                 pass.SetBindGroup(uniformBindGroupIndex, mUniformBindGroups[0], 1, &dynamicOffset);
+                callCount++;
                 break;
             }
 
@@ -551,7 +610,9 @@ void DrawCallPerf::RecordRenderCommands(Encoder pass) {
                 break;
         }
         pass.Draw(3);
+        callCount++;
     }
+    return callCount;
 }
 
 void DrawCallPerf::Step() {
@@ -585,12 +646,21 @@ void DrawCallPerf::Step() {
     utils::ComboRenderPassDescriptor renderPass({mColorAttachment}, mDepthStencilAttachment);
     wgpu::RenderPassEncoder pass = commands.BeginRenderPass(&renderPass);
 
+    uint32_t passCallsPerStep = 0;
     switch (GetParam().withRenderBundle) {
         case RenderBundle::No:
-            RecordRenderCommands(pass);
+            passCallsPerStep = RecordRenderCommands(pass);
             break;
         case RenderBundle::Yes:
-            pass.ExecuteBundles(1, &mRenderBundle);
+        case RenderBundle::Many:
+            pass.ExecuteBundles(mRenderBundles.size(), mRenderBundles.data());
+            passCallsPerStep = 1;
+            break;
+        case RenderBundle::ManyRepeated:
+            for (unsigned int i = 0; i < kRenderBundleRepeatCount; ++i) {
+                pass.ExecuteBundles(mRenderBundles.size(), mRenderBundles.data());
+            }
+            passCallsPerStep = kRenderBundleRepeatCount;
             break;
         default:
             UNREACHABLE();
@@ -600,6 +670,8 @@ void DrawCallPerf::Step() {
     pass.EndPass();
     wgpu::CommandBuffer commandBuffer = commands.Finish();
     queue.Submit(1, &commandBuffer);
+
+    SetThroughputResult("calls_per_second", passCallsPerStep, "calls");
 }
 
 TEST_P(DrawCallPerf, Run) {
@@ -609,7 +681,7 @@ TEST_P(DrawCallPerf, Run) {
 DAWN_INSTANTIATE_TEST_P(
     DrawCallPerf,
     {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend(),
-     VulkanBackend({"skip_validation"})},
+     VulkanBackend({"skip_validation"}), VulkanBackend({"defer_draw_validation"})},
     {
         // Baseline
         MakeParam(),
@@ -652,6 +724,12 @@ DAWN_INSTANTIATE_TEST_P(
                   BindGroup::Dynamic,
                   RenderBundle::Yes),  // Dynamic bind groups w/ dynamic pipeline w/ render bundle
 
+        // Split the draws in many render bundles, each using a few of the resources, and execute
+        // them once, or several times, per pass.
+        MakeParam(BindGroup::Multiple, RenderBundle::Many),
+        MakeParam(BindGroup::Multiple, RenderBundle::ManyRepeated),
+        MakeParam(VertexBuffer::Multiple, BindGroup::Multiple, RenderBundle::ManyRepeated),
+
         // ----------- Render Bundles (end)-------
 
         // Update per-draw data in the bind group(s). This will cause resource transitions between
@@ -660,4 +738,12 @@ DAWN_INSTANTIATE_TEST_P(
                   UniformData::Dynamic),  // Update per-draw data: Multiple bind groups
         MakeParam(BindGroup::Dynamic,
                   UniformData::Dynamic),  // Update per-draw data: Dynamic bind groups
+
+        // Send the pass commands over the wire to test the cost of serializing and handling them.
+        MakeParam(Wire::Yes),
+        MakeParam(VertexBuffer::Dynamic, Wire::Yes),  // Dynamic vertex buffer over the wire
+        MakeParam(BindGroup::Dynamic, Wire::Yes),     // Dynamic bind groups over the wire
+        MakeParam(Pipeline::Dynamic,
+                  BindGroup::Multiple,
+                  Wire::Yes),  // Multiple bind groups w/ dynamic pipeline over the wire
     });
@@ -0,0 +1,144 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_native/DawnNative.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kUploadsPerStep = 2;
+
+    // Streaming upload sizes that need ring buffers larger than the initial one, and larger than
+    // the largest ring buffer.
+    enum class UploadSize {
+        UploadSize_6MB = 6 * 1024 * 1024,
+        UploadSize_24MB = 24 * 1024 * 1024,
+        UploadSize_64MB = 64 * 1024 * 1024,
+    };
+
+    struct DynamicUploaderParams : AdapterTestParam {
+        DynamicUploaderParams(const AdapterTestParam& param, UploadSize uploadSize)
+            : AdapterTestParam(param), uploadSize(uploadSize) {
+        }
+
+        UploadSize uploadSize;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const DynamicUploaderParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.uploadSize) {
+            case UploadSize::UploadSize_6MB:
+                ostream << "_UploadSize_6MB";
+                break;
+            case UploadSize::UploadSize_24MB:
+                ostream << "_UploadSize_24MB";
+                break;
+            case UploadSize::UploadSize_64MB:
+                ostream << "_UploadSize_64MB";
+                break;
+        }
+
+        return ostream;
+    }
+
+}  // namespace
+
+// Test streaming |kUploadsPerStep| uploads of the same size with WriteBuffer every step, like
+// applications that upload new data every frame. The throughput is reported along with the
+// staging buffers that the DynamicUploader creates per step and how often the staging buffers of
+// the uploads too large for its ring buffers are reused.
+class DynamicUploaderPerf : public DawnPerfTestWithParams<DynamicUploaderParams> {
+  public:
+    DynamicUploaderPerf()
+        : DawnPerfTestWithParams(kUploadsPerStep, 1),
+          mData(static_cast<size_t>(GetParam().uploadSize)) {
+    }
+    ~DynamicUploaderPerf() override = default;
+
+    void SetUp() override;
+    void TearDown() override;
+
+  private:
+    void Step() override;
+
+    wgpu::Buffer mDst;
+    std::vector<uint8_t> mData;
+
+    dawn_native::DynamicUploaderStats mStartStats;
+    uint64_t mStepCount = 0;
+};
+
+void DynamicUploaderPerf::SetUp() {
+    DawnPerfTestWithParams<DynamicUploaderParams>::SetUp();
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = mData.size();
+    descriptor.usage = wgpu::BufferUsage::CopyDst;
+    mDst = device.CreateBuffer(&descriptor);
+
+    mStartStats = dawn_native::GetDynamicUploaderStats(backendDevice);
+
+    SetThroughputResult("upload_throughput",
+                        static_cast<double>(kUploadsPerStep) * mData.size() / (1024 * 1024),
+                        "MB/s");
+}
+
+void DynamicUploaderPerf::TearDown() {
+    if (mStepCount > 0) {
+        dawn_native::DynamicUploaderStats stats =
+            dawn_native::GetDynamicUploaderStats(backendDevice);
+        PrintResult("staging_buffer_creations_per_step",
+                    static_cast<double>(stats.stagingBufferCreations -
+                                        mStartStats.stagingBufferCreations) /
+                        mStepCount,
+                    "count", true);
+        PrintResult("peak_bytes_in_flight",
+                    static_cast<double>(stats.peakBytesInFlight) / (1024 * 1024), "MB", false);
+
+        uint64_t largeAllocations = stats.largeAllocations - mStartStats.largeAllocations;
+        if (largeAllocations > 0) {
+            PrintResult("large_allocation_reuse_rate",
+                        100.0 *
+                            (stats.largeAllocationReuses - mStartStats.largeAllocationReuses) /
+                            largeAllocations,
+                        "%", false);
+        }
+    }
+
+    mDst = nullptr;
+    DawnPerfTestWithParams<DynamicUploaderParams>::TearDown();
+}
+
+void DynamicUploaderPerf::Step() {
+    mStepCount++;
+    for (unsigned int i = 0; i < kUploadsPerStep; ++i) {
+        queue.WriteBuffer(mDst, 0, mData.data(), mData.size());
+    }
+    queue.Submit(0, nullptr);
+}
+
+TEST_P(DynamicUploaderPerf, Run) {
+    RunTest();
+}
+
+// The Null backend writes the data of WriteBuffer directly to the buffer without using the
+// DynamicUploader, so the test doesn't run on it.
+DAWN_INSTANTIATE_TEST_P(DynamicUploaderPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {UploadSize::UploadSize_6MB, UploadSize::UploadSize_24MB,
+                         UploadSize::UploadSize_64MB});
@@ -0,0 +1,193 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_native/ContentLessObjectCache.h"
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kLookupsPerStep = 64 * 1024;
+    // The number of distinct objects looked up. Half of them are kept alive by the test so that
+    // the other half is repeatedly created, inserted and erased like short-lived cached objects.
+    constexpr size_t kObjectCount = 256;
+
+    enum class CacheType {
+        // All the objects in a single shard, which is equivalent to a single mutex around the
+        // std::unordered_set that DeviceBase::Caches used previously.
+        SingleLock,
+        Sharded,
+    };
+
+    struct ObjectCacheParams : AdapterTestParam {
+        ObjectCacheParams(const AdapterTestParam& param, CacheType cacheType, uint32_t threadCount)
+            : AdapterTestParam(param), cacheType(cacheType), threadCount(threadCount) {
+        }
+
+        CacheType cacheType;
+        uint32_t threadCount;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const ObjectCacheParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.cacheType) {
+            case CacheType::SingleLock:
+                ostream << "_SingleLock";
+                break;
+            case CacheType::Sharded:
+                ostream << "_Sharded";
+                break;
+        }
+
+        ostream << "_" << param.threadCount << "Threads";
+        return ostream;
+    }
+
+    // A cached object with a content hash that is cheap to compute, so that the benchmark
+    // measures the cost of the cache itself.
+    template <size_t kShardCount>
+    class CachedTestObject : public RefCounted {
+      public:
+        using Cache =
+            dawn_native::ContentLessObjectCache<CachedTestObject, CachedTestObject, kShardCount>;
+
+        CachedTestObject(Cache* cache, size_t value) : mCache(cache), mValue(value) {
+        }
+        ~CachedTestObject() override {
+            if (mCache != nullptr) {
+                mCache->Erase(this);
+            }
+        }
+
+        struct HashFunc {
+            size_t operator()(const CachedTestObject* object) const {
+                return object->mValue * 0x9E3779B9u;
+            }
+        };
+        struct EqualityFunc {
+            bool operator()(const CachedTestObject* a, const CachedTestObject* b) const {
+                return a->mValue == b->mValue;
+            }
+        };
+
+        static Ref<CachedTestObject> GetOrCreate(Cache* cache, size_t value) {
+            CachedTestObject blueprint(nullptr, value);
+            Ref<CachedTestObject> result = cache->Find(&blueprint);
+            if (result == nullptr) {
+                result = AcquireRef(new CachedTestObject(cache, value));
+                result = cache->Insert(result.Get()).first;
+            }
+            return result;
+        }
+
+      private:
+        Cache* mCache;
+        size_t mValue;
+    };
+
+    template <size_t kShardCount>
+    class CacheWorkload {
+      public:
+        using Object = CachedTestObject<kShardCount>;
+
+        CacheWorkload() {
+            for (size_t value = 0; value < kObjectCount; value += 2) {
+                mKeptObjects.push_back(Object::GetOrCreate(&mCache, value));
+            }
+        }
+
+        ~CacheWorkload() {
+            mKeptObjects.clear();
+        }
+
+        void Run(uint32_t threadCount) {
+            const unsigned int lookupsPerThread = kLookupsPerStep / threadCount;
+
+            std::vector<std::thread> threads;
+            for (uint32_t t = 0; t < threadCount; ++t) {
+                threads.emplace_back([this, t, lookupsPerThread]() {
+                    // Each thread walks the objects from a different starting point.
+                    size_t value = t * (kObjectCount / 8);
+                    for (unsigned int i = 0; i < lookupsPerThread; ++i) {
+                        Object::GetOrCreate(&mCache, value);
+                        value = (value + 1) % kObjectCount;
+                    }
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+        }
+
+      private:
+        typename Object::Cache mCache;
+        std::vector<Ref<Object>> mKeptObjects;
+    };
+
+}  // namespace
+
+// Test the throughput of GetOrCreate-style lookups in the device object caches from multiple
+// threads. The per-iteration time is the amortized cost of one lookup across all the threads.
+class ObjectCachePerf : public DawnPerfTestWithParams<ObjectCacheParams> {
+  public:
+    ObjectCachePerf() : DawnPerfTestWithParams(kLookupsPerStep, 1) {
+    }
+    ~ObjectCachePerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    std::unique_ptr<CacheWorkload<1>> mSingleLockWorkload;
+    std::unique_ptr<CacheWorkload<16>> mShardedWorkload;
+};
+
+void ObjectCachePerf::SetUp() {
+    DawnPerfTestWithParams<ObjectCacheParams>::SetUp();
+
+    switch (GetParam().cacheType) {
+        case CacheType::SingleLock:
+            mSingleLockWorkload = std::make_unique<CacheWorkload<1>>();
+            break;
+        case CacheType::Sharded:
+            mShardedWorkload = std::make_unique<CacheWorkload<16>>();
+            break;
+    }
+}
+
+void ObjectCachePerf::Step() {
+    switch (GetParam().cacheType) {
+        case CacheType::SingleLock:
+            mSingleLockWorkload->Run(GetParam().threadCount);
+            break;
+        case CacheType::Sharded:
+            mShardedWorkload->Run(GetParam().threadCount);
+            break;
+    }
+}
+
+TEST_P(ObjectCachePerf, Run) {
+    RunTest();
+}
+
+// The caches don't depend on the backend, only run on the Null backend.
+DAWN_INSTANTIATE_TEST_P(ObjectCachePerf,
+                        {NullBackend()},
+                        {CacheType::SingleLock, CacheType::Sharded},
+                        {1u, 4u, 8u});
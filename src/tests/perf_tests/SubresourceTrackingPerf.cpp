@@ -14,9 +14,12 @@
 
 #include "tests/perf_tests/DawnPerfTest.h"
 
+#include "dawn_native/DawnNative.h"
 #include "utils/ComboRenderPipelineDescriptor.h"
 #include "utils/WGPUHelpers.h"
 
+#include <vector>
+
 struct SubresourceTrackingParams : AdapterTestParam {
     SubresourceTrackingParams(const AdapterTestParam& param,
                               uint32_t arrayLayerCountIn,
@@ -149,3 +152,71 @@ DAWN_INSTANTIATE_TEST_P(SubresourceTrackingPerf,
                         {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
                         {1, 4, 16, 256},
                         {2, 3, 8});
+
+// Test the performance of the queries of the initialization state of subresources that are done
+// for lazy clears by copies and at the beginning of render passes. One layer of a 2D array
+// texture with mipmaps is partially initialized, then the state of the whole texture, of each of
+// its layers, and of the initialized subresource are queried.
+class SubresourceInitializationPerf : public DawnPerfTestWithParams<SubresourceTrackingParams> {
+  public:
+    static constexpr unsigned int kNumIterations = 50;
+    static constexpr unsigned int kNumQueries = 100;
+
+    SubresourceInitializationPerf() : DawnPerfTestWithParams(kNumIterations, 1) {
+    }
+    ~SubresourceInitializationPerf() override = default;
+
+    void SetUp() override {
+        DawnPerfTestWithParams<SubresourceTrackingParams>::SetUp();
+        // The initialization state is queried directly on the dawn_native texture.
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+        const SubresourceTrackingParams& params = GetParam();
+
+        uint32_t size = 1u << (params.mipLevelCount - 1);
+        wgpu::TextureDescriptor descriptor;
+        descriptor.dimension = wgpu::TextureDimension::e2D;
+        descriptor.size = {size, size, params.arrayLayerCount};
+        descriptor.mipLevelCount = params.mipLevelCount;
+        descriptor.usage = wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopyDst;
+        descriptor.format = wgpu::TextureFormat::R8Unorm;
+        mTexture = device.CreateTexture(&descriptor);
+
+        // Initialize the first mip level of the layer in the middle of the array.
+        std::vector<uint8_t> data(size * size, 0);
+        wgpu::ImageCopyTexture destination =
+            utils::CreateImageCopyTexture(mTexture, 0, {0, 0, params.arrayLayerCount / 2});
+        wgpu::TextureDataLayout dataLayout = utils::CreateTextureDataLayout(0, size);
+        wgpu::Extent3D copySize = {size, size, 1};
+        queue.WriteTexture(&destination, data.data(), data.size(), &dataLayout, &copySize);
+    }
+
+  private:
+    void Step() override {
+        const SubresourceTrackingParams& params = GetParam();
+        WGPUTexture texture = mTexture.Get();
+
+        uint32_t initializedCount = 0;
+        for (unsigned int i = 0; i < kNumQueries; ++i) {
+            initializedCount += dawn_native::IsTextureSubresourceInitialized(
+                texture, 0, params.mipLevelCount, 0, params.arrayLayerCount);
+            for (uint32_t layer = 0; layer < params.arrayLayerCount; ++layer) {
+                initializedCount += dawn_native::IsTextureSubresourceInitialized(
+                    texture, 0, params.mipLevelCount, layer, 1);
+            }
+            initializedCount += dawn_native::IsTextureSubresourceInitialized(
+                texture, 0, 1, params.arrayLayerCount / 2, 1);
+        }
+        EXPECT_EQ(initializedCount, kNumQueries);
+    }
+
+    wgpu::Texture mTexture;
+};
+
+TEST_P(SubresourceInitializationPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(SubresourceInitializationPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {1, 256, 2048},
+                        {2, 8});
@@ -0,0 +1,169 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_wire/WireClient.h"
+#include "tests/perf_tests/WirePerfHelper.h"
+#include "utils/TerribleCommandBuffer.h"
+
+#include <cstring>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 10;
+    constexpr uint64_t kBufferSize = 16 * 1024 * 1024;
+
+    struct WireBufferMappingParams : AdapterTestParam {
+        WireBufferMappingParams(const AdapterTestParam& param,
+                                uint32_t writtenKB,
+                                uint32_t writtenRangeCount)
+            : AdapterTestParam(param), writtenKB(writtenKB), writtenRangeCount(writtenRangeCount) {
+        }
+
+        uint32_t writtenKB;
+        uint32_t writtenRangeCount;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WireBufferMappingParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        ostream << "_" << param.writtenKB << "KBWritten";
+        ostream << "_" << param.writtenRangeCount << "Ranges";
+        return ostream;
+    }
+
+    // Counts the bytes of the commands serialized by the client.
+    class CountingCommandBuffer : public utils::TerribleCommandBuffer {
+      public:
+        void* GetCmdSpace(size_t size) override {
+            mSerializedBytes += size;
+            return TerribleCommandBuffer::GetCmdSpace(size);
+        }
+
+        uint64_t GetSerializedBytes() const {
+            return mSerializedBytes;
+        }
+
+      private:
+        uint64_t mSerializedBytes = 0;
+    };
+
+}  // namespace
+
+// Test mapping a 16MB buffer for writing through the wire and writing |writtenKB| of it, split in
+// |writtenRangeCount| ranges spread over the buffer, like a streaming workload updating a part
+// of a large buffer each frame. The test uses its own wire, connected to a separate device, so
+// that it can count the bytes the client serializes on Unmap, which are reported against the
+// fraction of the buffer that is written.
+class WireBufferMappingPerf : public DawnPerfTestWithParams<WireBufferMappingParams> {
+  public:
+    WireBufferMappingPerf() : DawnPerfTestWithParams(kNumIterations, 1) {
+    }
+    ~WireBufferMappingPerf() override = default;
+
+    void SetUp() override;
+    void TearDown() override;
+
+  private:
+    void Step() override;
+
+    const DawnProcTable& mClientProcs = dawn_wire::client::GetProcs();
+    std::unique_ptr<WirePerfHelper> mWire;
+    // Owned by |mWire|.
+    CountingCommandBuffer* mC2sBuf = nullptr;
+    WGPUBuffer mBuffer = nullptr;
+
+    uint64_t mUnmapCount = 0;
+    uint64_t mUnmapBytes = 0;
+};
+
+void WireBufferMappingPerf::SetUp() {
+    DawnPerfTestWithParams<WireBufferMappingParams>::SetUp();
+
+    const WireBufferMappingParams& params = GetParam();
+    ASSERT_LE(uint64_t(params.writtenKB) * 1024, kBufferSize);
+
+    WGPUDevice serverDevice = GetAdapter().CreateDevice();
+    ASSERT_NE(serverDevice, nullptr);
+    std::unique_ptr<CountingCommandBuffer> c2sBuf = std::make_unique<CountingCommandBuffer>();
+    mC2sBuf = c2sBuf.get();
+    mWire = std::make_unique<WirePerfHelper>(serverDevice, std::move(c2sBuf));
+
+    WGPUBufferDescriptor descriptor = {};
+    descriptor.size = kBufferSize;
+    descriptor.usage = WGPUBufferUsage_MapWrite | WGPUBufferUsage_CopySrc;
+    mBuffer = mClientProcs.deviceCreateBuffer(mWire->GetClientDevice(), &descriptor);
+    ASSERT_TRUE(mWire->Flush());
+}
+
+void WireBufferMappingPerf::TearDown() {
+    if (mUnmapCount > 0) {
+        const WireBufferMappingParams& params = GetParam();
+        PrintResult("unmap_bytes_on_wire", static_cast<double>(mUnmapBytes) / mUnmapCount, "bytes",
+                    true);
+        PrintResult("written_fraction",
+                    static_cast<double>(params.writtenKB) * 1024 / kBufferSize * 100, "%", false);
+    }
+
+    if (mWire != nullptr) {
+        mClientProcs.bufferRelease(mBuffer);
+        mWire = nullptr;
+        mC2sBuf = nullptr;
+    }
+    DawnPerfTestWithParams<WireBufferMappingParams>::TearDown();
+}
+
+void WireBufferMappingPerf::Step() {
+    const WireBufferMappingParams& params = GetParam();
+    const size_t rangeSize = size_t(params.writtenKB) * 1024 / params.writtenRangeCount;
+    const size_t rangeStride = kBufferSize / params.writtenRangeCount;
+
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        bool mapped = false;
+        mClientProcs.bufferMapAsync(
+            mBuffer, WGPUMapMode_Write, 0, kBufferSize,
+            [](WGPUBufferMapAsyncStatus status, void* userdata) {
+                ASSERT(status == WGPUBufferMapAsyncStatus_Success);
+                *static_cast<bool*>(userdata) = true;
+            },
+            &mapped);
+        while (!mapped) {
+            mClientProcs.deviceTick(mWire->GetClientDevice());
+            ASSERT_TRUE(mWire->Flush());
+        }
+
+        for (uint32_t range = 0; range < params.writtenRangeCount; ++range) {
+            void* data =
+                mClientProcs.bufferGetMappedRange(mBuffer, range * rangeStride, rangeSize);
+            ASSERT(data != nullptr);
+            memset(data, i, rangeSize);
+        }
+
+        uint64_t bytesBeforeUnmap = mC2sBuf->GetSerializedBytes();
+        mClientProcs.bufferUnmap(mBuffer);
+        mUnmapBytes += mC2sBuf->GetSerializedBytes() - bytesBeforeUnmap;
+        mUnmapCount++;
+        ASSERT_TRUE(mWire->Flush());
+    }
+}
+
+TEST_P(WireBufferMappingPerf, Run) {
+    RunTest();
+}
+
+// The data updates of the wire don't depend on the backend, only run on the Null backend.
+DAWN_INSTANTIATE_TEST_P(WireBufferMappingPerf,
+                        {NullBackend()},
+                        {4u, 64u, 1024u, 16u * 1024u},
+                        {1u, 16u});
@@ -0,0 +1,180 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_wire/WireClient.h"
+#include "tests/perf_tests/WirePerfHelper.h"
+#include "utils/TerribleCommandBuffer.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumObjects = 100000;
+
+    enum class TransientObject {
+        CommandEncoder,
+        BindGroup,
+    };
+
+    enum class WireSide {
+        Client,           // Only the client side of the wire is used.
+        ClientAndServer,  // The commands are handled by a server connected to the backend.
+    };
+
+    struct WireObjectAllocationParams : AdapterTestParam {
+        WireObjectAllocationParams(const AdapterTestParam& param,
+                                   TransientObject object,
+                                   WireSide side)
+            : AdapterTestParam(param), object(object), side(side) {
+        }
+
+        TransientObject object;
+        WireSide side;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WireObjectAllocationParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.object) {
+            case TransientObject::CommandEncoder:
+                ostream << "_CommandEncoder";
+                break;
+            case TransientObject::BindGroup:
+                ostream << "_BindGroup";
+                break;
+        }
+
+        switch (param.side) {
+            case WireSide::Client:
+                ostream << "_Client";
+                break;
+            case WireSide::ClientAndServer:
+                ostream << "_ClientAndServer";
+                break;
+        }
+
+        return ostream;
+    }
+
+    // A CommandSerializer that discards the commands so that only the cost of the client is
+    // measured. It allocates as much command space as a utils::TerribleCommandBuffer.
+    class DiscardingCommandSerializer final : public dawn_wire::CommandSerializer {
+      public:
+        DiscardingCommandSerializer()
+            : mBuffer(utils::TerribleCommandBuffer::kMaxAllocationSize) {
+        }
+
+        size_t GetMaximumAllocationSize() const override {
+            return mBuffer.size();
+        }
+
+        void* GetCmdSpace(size_t) override {
+            return mBuffer.data();
+        }
+
+        bool Flush() override {
+            return true;
+        }
+
+      private:
+        std::vector<char> mBuffer;
+    };
+
+}  // namespace
+
+// Test creating and releasing |kNumObjects| transient objects, like the command encoders and bind
+// groups that applications create every frame, through the wire. The objects are created and
+// released one after the other so that each allocation reuses the ObjectId and the memory of
+// the previous object. The number of objects handled per second is reported.
+class WireObjectAllocationPerf : public DawnPerfTestWithParams<WireObjectAllocationParams> {
+  public:
+    WireObjectAllocationPerf() : DawnPerfTestWithParams(kNumObjects, 1) {
+    }
+    ~WireObjectAllocationPerf() override = default;
+
+    void SetUp() override;
+    void TearDown() override;
+
+  private:
+    void Step() override;
+
+    const DawnProcTable& mClientProcs = dawn_wire::client::GetProcs();
+    std::unique_ptr<WirePerfHelper> mWire;
+    WGPUDevice mClientDevice = nullptr;
+    WGPUBindGroupLayout mBindGroupLayout = nullptr;
+};
+
+void WireObjectAllocationPerf::SetUp() {
+    DawnPerfTestWithParams<WireObjectAllocationParams>::SetUp();
+
+    if (GetParam().side == WireSide::Client) {
+        mWire = std::make_unique<WirePerfHelper>(std::make_unique<DiscardingCommandSerializer>());
+    } else {
+        WGPUDevice serverDevice = GetAdapter().CreateDevice();
+        ASSERT_NE(serverDevice, nullptr);
+        mWire = std::make_unique<WirePerfHelper>(serverDevice);
+    }
+    mClientDevice = mWire->GetClientDevice();
+
+    WGPUBindGroupLayoutDescriptor bglDesc = {};
+    mBindGroupLayout = mClientProcs.deviceCreateBindGroupLayout(mClientDevice, &bglDesc);
+    ASSERT_TRUE(mWire->Flush());
+
+    SetThroughputResult("objects_per_second", kNumObjects, "objects");
+}
+
+void WireObjectAllocationPerf::TearDown() {
+    if (mWire != nullptr) {
+        mClientProcs.bindGroupLayoutRelease(mBindGroupLayout);
+        mWire = nullptr;
+    }
+    DawnPerfTestWithParams<WireObjectAllocationParams>::TearDown();
+}
+
+void WireObjectAllocationPerf::Step() {
+    switch (GetParam().object) {
+        case TransientObject::CommandEncoder: {
+            for (unsigned int i = 0; i < kNumObjects; ++i) {
+                WGPUCommandEncoder encoder =
+                    mClientProcs.deviceCreateCommandEncoder(mClientDevice, nullptr);
+                mClientProcs.commandEncoderRelease(encoder);
+            }
+            break;
+        }
+
+        case TransientObject::BindGroup: {
+            WGPUBindGroupDescriptor descriptor = {};
+            descriptor.layout = mBindGroupLayout;
+            for (unsigned int i = 0; i < kNumObjects; ++i) {
+                WGPUBindGroup bindGroup =
+                    mClientProcs.deviceCreateBindGroup(mClientDevice, &descriptor);
+                mClientProcs.bindGroupRelease(bindGroup);
+            }
+            break;
+        }
+    }
+    ASSERT_TRUE(mWire->Flush());
+}
+
+TEST_P(WireObjectAllocationPerf, Run) {
+    RunTest();
+}
+
+// The object allocation of the wire doesn't depend on the backend, only run on the Null backend.
+DAWN_INSTANTIATE_TEST_P(WireObjectAllocationPerf,
+                        {NullBackend()},
+                        {TransientObject::CommandEncoder, TransientObject::BindGroup},
+                        {WireSide::Client, WireSide::ClientAndServer});
@@ -0,0 +1,74 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/WirePerfHelper.h"
+
+#include "common/Assert.h"
+#include "dawn_native/DawnNative.h"
+#include "dawn_wire/WireClient.h"
+#include "dawn_wire/WireServer.h"
+#include "utils/TerribleCommandBuffer.h"
+
+WirePerfHelper::WirePerfHelper(std::unique_ptr<dawn_wire::CommandSerializer> c2sSerializer,
+                               std::unique_ptr<utils::TerribleCommandBuffer> s2cBuf)
+    : mC2sSerializer(std::move(c2sSerializer)), mS2cBuf(std::move(s2cBuf)) {
+    dawn_wire::WireClientDescriptor clientDesc = {};
+    clientDesc.serializer = mC2sSerializer.get();
+    mWireClient = std::make_unique<dawn_wire::WireClient>(clientDesc);
+}
+
+WirePerfHelper::WirePerfHelper(std::unique_ptr<dawn_wire::CommandSerializer> c2sSerializer)
+    : WirePerfHelper(std::move(c2sSerializer), nullptr) {
+    mClientDevice = mWireClient->ReserveDevice().device;
+}
+
+WirePerfHelper::WirePerfHelper(WGPUDevice serverDevice,
+                               std::unique_ptr<utils::TerribleCommandBuffer> c2sBuf)
+    : WirePerfHelper(c2sBuf != nullptr ? std::move(c2sBuf)
+                                       : std::make_unique<utils::TerribleCommandBuffer>(),
+                     std::make_unique<utils::TerribleCommandBuffer>()) {
+    ASSERT(serverDevice != nullptr);
+    mS2cBuf->SetHandler(mWireClient.get());
+
+    dawn_wire::WireServerDescriptor serverDesc = {};
+    serverDesc.procs = &dawn_native::GetProcs();
+    serverDesc.serializer = mS2cBuf.get();
+    mWireServer = std::make_unique<dawn_wire::WireServer>(serverDesc);
+    static_cast<utils::TerribleCommandBuffer*>(mC2sSerializer.get())
+        ->SetHandler(mWireServer.get());
+
+    dawn_wire::ReservedDevice reservation = mWireClient->ReserveDevice();
+    mWireServer->InjectDevice(serverDevice, reservation.id, reservation.generation);
+    dawn_native::GetProcs().deviceRelease(serverDevice);
+    mClientDevice = reservation.device;
+}
+
+WirePerfHelper::~WirePerfHelper() {
+    dawn_wire::client::GetProcs().deviceRelease(mClientDevice);
+    Flush();
+
+    mWireClient = nullptr;
+    mWireServer = nullptr;
+}
+
+WGPUDevice WirePerfHelper::GetClientDevice() const {
+    return mClientDevice;
+}
+
+bool WirePerfHelper::Flush() {
+    if (!mC2sSerializer->Flush()) {
+        return false;
+    }
+    return mS2cBuf == nullptr || mS2cBuf->Flush();
+}
@@ -0,0 +1,66 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TESTS_PERFTESTS_WIREPERFHELPER_H_
+#define TESTS_PERFTESTS_WIREPERFHELPER_H_
+
+#include "dawn/webgpu.h"
+
+#include <memory>
+
+namespace dawn_wire {
+    class CommandSerializer;
+    class WireClient;
+    class WireServer;
+}  // namespace dawn_wire
+
+namespace utils {
+    class TerribleCommandBuffer;
+}  // namespace utils
+
+// The wire of the perf tests that measure the cost of the wire itself. Unlike utils::WireHelper,
+// the tests choose the serializer of the client, for example to count the serialized commands,
+// and the wire is separate from the device of the test.
+class WirePerfHelper {
+  public:
+    // Only the client side of the wire is used, its commands are serialized to |c2sSerializer|
+    // and are never handled.
+    explicit WirePerfHelper(std::unique_ptr<dawn_wire::CommandSerializer> c2sSerializer);
+
+    // The commands of the client are serialized to |c2sBuf|, or to a utils::TerribleCommandBuffer
+    // if it is nullptr, and handled by a server that injects |serverDevice| and takes ownership
+    // of it.
+    WirePerfHelper(WGPUDevice serverDevice,
+                   std::unique_ptr<utils::TerribleCommandBuffer> c2sBuf = nullptr);
+
+    // Releases the client device and flushes the wire before destroying it.
+    ~WirePerfHelper();
+
+    WGPUDevice GetClientDevice() const;
+
+    // Flushes the commands of the client, then the replies of the server if there is one.
+    bool Flush();
+
+  private:
+    WirePerfHelper(std::unique_ptr<dawn_wire::CommandSerializer> c2sSerializer,
+                   std::unique_ptr<utils::TerribleCommandBuffer> s2cBuf);
+
+    std::unique_ptr<dawn_wire::CommandSerializer> mC2sSerializer;
+    std::unique_ptr<utils::TerribleCommandBuffer> mS2cBuf;
+    std::unique_ptr<dawn_wire::WireServer> mWireServer;
+    std::unique_ptr<dawn_wire::WireClient> mWireClient;
+    WGPUDevice mClientDevice = nullptr;
+};
+
+#endif  // TESTS_PERFTESTS_WIREPERFHELPER_H_
@@ -0,0 +1,135 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_wire/WireClient.h"
+#include "tests/perf_tests/WirePerfHelper.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 50;
+
+    enum class WriteSize {
+        WriteSize_64KB = 64 * 1024,
+        WriteSize_512KB = 512 * 1024,
+        WriteSize_4MB = 4 * 1024 * 1024,
+        WriteSize_16MB = 16 * 1024 * 1024,
+    };
+
+    struct WireQueueWriteParams : AdapterTestParam {
+        WireQueueWriteParams(const AdapterTestParam& param, WriteSize writeSize)
+            : AdapterTestParam(param), writeSize(writeSize) {
+        }
+
+        WriteSize writeSize;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WireQueueWriteParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.writeSize) {
+            case WriteSize::WriteSize_64KB:
+                ostream << "_WriteSize_64KB";
+                break;
+            case WriteSize::WriteSize_512KB:
+                ostream << "_WriteSize_512KB";
+                break;
+            case WriteSize::WriteSize_4MB:
+                ostream << "_WriteSize_4MB";
+                break;
+            case WriteSize::WriteSize_16MB:
+                ostream << "_WriteSize_16MB";
+                break;
+        }
+
+        return ostream;
+    }
+
+}  // namespace
+
+// Test sending |kNumIterations| WriteBuffer commands of |writeSize| bytes through the wire to the
+// server, like a renderer process streaming large uploads. The test uses its own wire connected
+// to a separate device. The time of each write includes its serialization by the client, its
+// deserialization by the server and the write of its data to the buffer. Writes larger than the
+// maximum allocation size of utils::TerribleCommandBuffer are sent in several chunks that the
+// server gathers before deserializing them, which happens while the client serializes them.
+class WireQueueWritePerf : public DawnPerfTestWithParams<WireQueueWriteParams> {
+  public:
+    WireQueueWritePerf()
+        : DawnPerfTestWithParams(kNumIterations, 1),
+          mData(static_cast<size_t>(GetParam().writeSize)) {
+    }
+    ~WireQueueWritePerf() override = default;
+
+    void SetUp() override;
+    void TearDown() override;
+
+  private:
+    void Step() override;
+
+    std::vector<uint8_t> mData;
+    const DawnProcTable& mClientProcs = dawn_wire::client::GetProcs();
+    std::unique_ptr<WirePerfHelper> mWire;
+    WGPUQueue mClientQueue = nullptr;
+    WGPUBuffer mClientBuffer = nullptr;
+};
+
+void WireQueueWritePerf::SetUp() {
+    DawnPerfTestWithParams<WireQueueWriteParams>::SetUp();
+
+    WGPUDevice serverDevice = GetAdapter().CreateDevice();
+    ASSERT_NE(serverDevice, nullptr);
+    mWire = std::make_unique<WirePerfHelper>(serverDevice);
+    mClientQueue = mClientProcs.deviceGetQueue(mWire->GetClientDevice());
+
+    WGPUBufferDescriptor bufferDesc = {};
+    bufferDesc.size = mData.size();
+    bufferDesc.usage = WGPUBufferUsage_CopyDst;
+    mClientBuffer = mClientProcs.deviceCreateBuffer(mWire->GetClientDevice(), &bufferDesc);
+    ASSERT_TRUE(mWire->Flush());
+
+    SetThroughputResult("write_throughput",
+                        static_cast<double>(kNumIterations) * mData.size() / (1024 * 1024),
+                        "MB/s");
+}
+
+void WireQueueWritePerf::TearDown() {
+    if (mWire != nullptr) {
+        mClientProcs.bufferRelease(mClientBuffer);
+        mClientProcs.queueRelease(mClientQueue);
+        mWire = nullptr;
+    }
+    DawnPerfTestWithParams<WireQueueWriteParams>::TearDown();
+}
+
+void WireQueueWritePerf::Step() {
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        mClientProcs.queueWriteBuffer(mClientQueue, mClientBuffer, 0, mData.data(), mData.size());
+        ASSERT_TRUE(mWire->Flush());
+    }
+}
+
+TEST_P(WireQueueWritePerf, Run) {
+    RunTest();
+}
+
+// The Null backend writes the data directly to the buffer so that the test measures the cost of
+// the wire, only run on the Null backend.
+DAWN_INSTANTIATE_TEST_P(WireQueueWritePerf,
+                        {NullBackend()},
+                        {WriteSize::WriteSize_64KB, WriteSize::WriteSize_512KB,
+                         WriteSize::WriteSize_4MB, WriteSize::WriteSize_16MB});
@@ -0,0 +1,178 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_wire/WireClient.h"
+#include "utils/TerribleCommandBuffer.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 50;
+    constexpr size_t kMaxAllocationSize = utils::TerribleCommandBuffer::kMaxAllocationSize;
+
+    enum class WriteSize {
+        WriteSize_1KB = 1 * 1024,
+        WriteSize_256KB = 256 * 1024,
+        WriteSize_4MB = 4 * 1024 * 1024,
+        WriteSize_16MB = 16 * 1024 * 1024,
+    };
+
+    struct WireSerializationParams : AdapterTestParam {
+        WireSerializationParams(const AdapterTestParam& param, WriteSize writeSize)
+            : AdapterTestParam(param), writeSize(writeSize) {
+        }
+
+        WriteSize writeSize;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WireSerializationParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.writeSize) {
+            case WriteSize::WriteSize_1KB:
+                ostream << "_WriteSize_1KB";
+                break;
+            case WriteSize::WriteSize_256KB:
+                ostream << "_WriteSize_256KB";
+                break;
+            case WriteSize::WriteSize_4MB:
+                ostream << "_WriteSize_4MB";
+                break;
+            case WriteSize::WriteSize_16MB:
+                ostream << "_WriteSize_16MB";
+                break;
+        }
+
+        return ostream;
+    }
+
+    // A CommandSerializer that discards the commands so that only the cost of the client-side
+    // serialization is measured. It counts the calls to GetCmdSpace.
+    class CountingCommandSerializer final : public dawn_wire::CommandSerializer {
+      public:
+        CountingCommandSerializer() : mBuffer(kMaxAllocationSize) {
+        }
+
+        size_t GetMaximumAllocationSize() const override {
+            return kMaxAllocationSize;
+        }
+
+        void* GetCmdSpace(size_t) override {
+            mAllocationCount++;
+            return mBuffer.data();
+        }
+
+        bool Flush() override {
+            return true;
+        }
+
+        uint64_t GetAllocationCount() const {
+            return mAllocationCount;
+        }
+
+      private:
+        std::vector<char> mBuffer;
+        uint64_t mAllocationCount = 0;
+    };
+
+}  // namespace
+
+// Test serializing |kNumIterations| WriteBuffer commands of |writeSize| bytes with the wire
+// client. Commands larger than |kMaxAllocationSize| are split in several chunks. In addition to
+// the time per command, the throughput of the serialization and the number of allocations of
+// command space per step are reported.
+class WireSerializationPerf : public DawnPerfTestWithParams<WireSerializationParams> {
+  public:
+    WireSerializationPerf()
+        : DawnPerfTestWithParams(kNumIterations, 1),
+          mData(static_cast<size_t>(GetParam().writeSize)) {
+    }
+    ~WireSerializationPerf() override = default;
+
+    void SetUp() override;
+    void TearDown() override;
+
+  private:
+    void Step() override;
+
+    std::vector<uint8_t> mData;
+    CountingCommandSerializer mSerializer;
+    std::unique_ptr<dawn_wire::WireClient> mWireClient;
+    WGPUDevice mClientDevice = nullptr;
+    WGPUQueue mClientQueue = nullptr;
+    WGPUBuffer mClientBuffer = nullptr;
+
+    uint64_t mStepCount = 0;
+    uint64_t mAllocationsBeforeSteps = 0;
+};
+
+void WireSerializationPerf::SetUp() {
+    DawnPerfTestWithParams<WireSerializationParams>::SetUp();
+
+    dawn_wire::WireClientDescriptor clientDesc = {};
+    clientDesc.serializer = &mSerializer;
+    mWireClient = std::make_unique<dawn_wire::WireClient>(clientDesc);
+
+    const DawnProcTable& procs = dawn_wire::client::GetProcs();
+    mClientDevice = mWireClient->ReserveDevice().device;
+    mClientQueue = procs.deviceGetQueue(mClientDevice);
+
+    WGPUBufferDescriptor bufferDesc = {};
+    bufferDesc.size = mData.size();
+    bufferDesc.usage = WGPUBufferUsage_CopyDst;
+    mClientBuffer = procs.deviceCreateBuffer(mClientDevice, &bufferDesc);
+
+    mAllocationsBeforeSteps = mSerializer.GetAllocationCount();
+
+    SetThroughputResult("serialization_throughput",
+                        static_cast<double>(kNumIterations) * mData.size() / (1024 * 1024),
+                        "MB/s");
+}
+
+void WireSerializationPerf::TearDown() {
+    if (mStepCount > 0) {
+        uint64_t allocations = mSerializer.GetAllocationCount() - mAllocationsBeforeSteps;
+        PrintResult("cmd_space_allocations_per_step",
+                    static_cast<double>(allocations) / mStepCount, "count", false);
+    }
+
+    const DawnProcTable& procs = dawn_wire::client::GetProcs();
+    procs.bufferRelease(mClientBuffer);
+    procs.queueRelease(mClientQueue);
+    mWireClient = nullptr;
+
+    DawnPerfTestWithParams<WireSerializationParams>::TearDown();
+}
+
+void WireSerializationPerf::Step() {
+    const DawnProcTable& procs = dawn_wire::client::GetProcs();
+
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        procs.queueWriteBuffer(mClientQueue, mClientBuffer, 0, mData.data(), mData.size());
+    }
+    mStepCount++;
+}
+
+TEST_P(WireSerializationPerf, Run) {
+    RunTest();
+}
+
+// Only the client side of the wire is used, which doesn't depend on the backend.
+DAWN_INSTANTIATE_TEST_P(WireSerializationPerf,
+                        {NullBackend()},
+                        {WriteSize::WriteSize_1KB, WriteSize::WriteSize_256KB,
+                         WriteSize::WriteSize_4MB, WriteSize::WriteSize_16MB});
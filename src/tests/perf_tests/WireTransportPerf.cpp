@@ -0,0 +1,182 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "utils/RingBufferCommandTransport.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+    constexpr unsigned int kNumCommands = 4096;
+    constexpr unsigned int kCommandsPerFlush = 64;
+
+    enum class CommandSize {
+        CommandSize_64B = 64,
+        CommandSize_4KB = 4 * 1024,
+        CommandSize_64KB = 64 * 1024,
+    };
+
+    struct WireTransportParams : AdapterTestParam {
+        WireTransportParams(const AdapterTestParam& param,
+                            utils::RingBufferFlushPolicy flushPolicy,
+                            CommandSize commandSize)
+            : AdapterTestParam(param), flushPolicy(flushPolicy), commandSize(commandSize) {
+        }
+
+        utils::RingBufferFlushPolicy flushPolicy;
+        CommandSize commandSize;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WireTransportParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.flushPolicy) {
+            case utils::RingBufferFlushPolicy::NonBlocking:
+                ostream << "_NonBlocking";
+                break;
+            case utils::RingBufferFlushPolicy::Blocking:
+                ostream << "_Blocking";
+                break;
+        }
+
+        switch (param.commandSize) {
+            case CommandSize::CommandSize_64B:
+                ostream << "_CommandSize_64B";
+                break;
+            case CommandSize::CommandSize_4KB:
+                ostream << "_CommandSize_4KB";
+                break;
+            case CommandSize::CommandSize_64KB:
+                ostream << "_CommandSize_64KB";
+                break;
+        }
+
+        return ostream;
+    }
+
+    // A CommandHandler that reads the commands like a deserializer would, without doing anything
+    // with them.
+    class ReadingCommandHandler final : public dawn_wire::CommandHandler {
+      public:
+        const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+            uint64_t checksum = 0;
+            for (size_t i = 0; i < size; i += sizeof(uint64_t)) {
+                checksum += commands[i];
+            }
+            mChecksum += checksum;
+            return commands + size;
+        }
+
+      private:
+        uint64_t mChecksum = 0;
+    };
+
+}  // namespace
+
+// Test streaming commands of |commandSize| bytes through a RingBufferCommandTransport to a
+// consumer thread, like the client of the wire does to a server running on another thread. The
+// throughput of the transport and the average latency of the flushes are reported. With the
+// blocking policy, the latency includes waiting for the consumer to handle the commands.
+class WireTransportPerf : public DawnPerfTestWithParams<WireTransportParams> {
+  public:
+    WireTransportPerf() : DawnPerfTestWithParams(kNumCommands, 1) {
+    }
+    ~WireTransportPerf() override = default;
+
+    void SetUp() override;
+    void TearDown() override;
+
+  private:
+    void Step() override;
+
+    std::unique_ptr<utils::RingBufferCommandTransport> mTransport;
+    ReadingCommandHandler mHandler;
+    std::thread mConsumerThread;
+
+    uint64_t mStepCount = 0;
+    uint64_t mFlushCount = 0;
+    std::chrono::duration<double> mFlushDuration{0};
+};
+
+void WireTransportPerf::SetUp() {
+    DawnPerfTestWithParams<WireTransportParams>::SetUp();
+
+    utils::RingBufferCommandTransportDescriptor transportDesc;
+    transportDesc.flushPolicy = GetParam().flushPolicy;
+    mTransport = std::make_unique<utils::RingBufferCommandTransport>(transportDesc);
+    ASSERT_LE(static_cast<size_t>(GetParam().commandSize),
+              mTransport->GetMaximumAllocationSize());
+
+    mConsumerThread = std::thread([this]() {
+        while (mTransport->WaitForCommands()) {
+            mTransport->ConsumeCommands(&mHandler);
+        }
+    });
+
+    SetThroughputResult("transport_throughput",
+                        static_cast<double>(kNumCommands) *
+                            static_cast<uint64_t>(GetParam().commandSize) / (1024 * 1024),
+                        "MB/s");
+}
+
+void WireTransportPerf::TearDown() {
+    if (mTransport != nullptr) {
+        mTransport->Close();
+        mConsumerThread.join();
+    }
+
+    if (mStepCount > 0) {
+        PrintResult("flush_latency", mFlushDuration.count() * 1e6 / mFlushCount, "us", true);
+        PrintResult("producer_waits_per_step",
+                    static_cast<double>(mTransport->GetProducerWaitCount()) / mStepCount, "count",
+                    false);
+    }
+
+    mTransport = nullptr;
+    DawnPerfTestWithParams<WireTransportParams>::TearDown();
+}
+
+void WireTransportPerf::Step() {
+    const size_t commandSize = static_cast<size_t>(GetParam().commandSize);
+
+    for (unsigned int i = 0; i < kNumCommands; ++i) {
+        char* space = static_cast<char*>(mTransport->GetCmdSpace(commandSize));
+        ASSERT(space != nullptr);
+        memset(space, i, commandSize);
+
+        if ((i + 1) % kCommandsPerFlush == 0) {
+            auto flushStart = std::chrono::steady_clock::now();
+            mTransport->Flush();
+            mFlushDuration += std::chrono::steady_clock::now() - flushStart;
+            mFlushCount++;
+        }
+    }
+    mStepCount++;
+}
+
+TEST_P(WireTransportPerf, Run) {
+    RunTest();
+}
+
+// The transport doesn't depend on the backend, only run on the Null backend.
+DAWN_INSTANTIATE_TEST_P(WireTransportPerf,
+                        {NullBackend()},
+                        {utils::RingBufferFlushPolicy::NonBlocking,
+                         utils::RingBufferFlushPolicy::Blocking},
+                        {CommandSize::CommandSize_64B, CommandSize::CommandSize_4KB,
+                         CommandSize::CommandSize_64KB});
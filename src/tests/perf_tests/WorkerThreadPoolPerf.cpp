@@ -0,0 +1,201 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_platform/WorkerThread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+    constexpr unsigned int kNumTasksPerStep = 256;
+
+    enum class PoolType {
+        // Mimics the previous implementation of dawn_platform::AsyncWorkerThreadPool that
+        // spawned and detached a new thread for every task.
+        ThreadPerTask,
+        // The persistent, bounded dawn_platform::AsyncWorkerThreadPool.
+        Persistent,
+    };
+
+    enum class TaskSize {
+        Empty,
+        Small,
+    };
+
+    struct WorkerThreadPoolParams : AdapterTestParam {
+        WorkerThreadPoolParams(const AdapterTestParam& param,
+                               PoolType poolType,
+                               TaskSize taskSize)
+            : AdapterTestParam(param), poolType(poolType), taskSize(taskSize) {
+        }
+
+        PoolType poolType;
+        TaskSize taskSize;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WorkerThreadPoolParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.poolType) {
+            case PoolType::ThreadPerTask:
+                ostream << "_ThreadPerTask";
+                break;
+            case PoolType::Persistent:
+                ostream << "_Persistent";
+                break;
+        }
+
+        switch (param.taskSize) {
+            case TaskSize::Empty:
+                ostream << "_EmptyTask";
+                break;
+            case TaskSize::Small:
+                ostream << "_SmallTask";
+                break;
+        }
+
+        return ostream;
+    }
+
+    class ThreadPerTaskWaitableEvent final : public dawn_platform::WaitableEvent {
+      public:
+        struct State {
+            std::mutex mutex;
+            std::condition_variable condition;
+            bool isComplete = false;
+        };
+
+        ThreadPerTaskWaitableEvent() : mState(std::make_shared<State>()) {
+        }
+
+        void Wait() override {
+            std::unique_lock<std::mutex> lock(mState->mutex);
+            mState->condition.wait(lock, [this] { return mState->isComplete; });
+        }
+
+        bool IsComplete() override {
+            std::lock_guard<std::mutex> lock(mState->mutex);
+            return mState->isComplete;
+        }
+
+        std::shared_ptr<State> GetState() const {
+            return mState;
+        }
+
+      private:
+        std::shared_ptr<State> mState;
+    };
+
+    class ThreadPerTaskPool final : public dawn_platform::WorkerTaskPool {
+      public:
+        std::unique_ptr<dawn_platform::WaitableEvent> PostWorkerTask(
+            dawn_platform::PostWorkerTaskCallback callback,
+            void* userdata) override {
+            std::unique_ptr<ThreadPerTaskWaitableEvent> event =
+                std::make_unique<ThreadPerTaskWaitableEvent>();
+            std::thread thread([callback, userdata, state = event->GetState()]() {
+                callback(userdata);
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->isComplete = true;
+                }
+                state->condition.notify_all();
+            });
+            thread.detach();
+            return event;
+        }
+    };
+
+    struct TaskData {
+        std::atomic<uint64_t> result;
+        TaskSize taskSize;
+    };
+
+    void DoTask(void* userdata) {
+        TaskData* data = static_cast<TaskData*>(userdata);
+        if (data->taskSize == TaskSize::Empty) {
+            return;
+        }
+
+        // Emulate a small amount of CPU work, much smaller than a pipeline compilation so that
+        // the scheduling overhead stays visible.
+        uint64_t value = 0;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            value = value * 6364136223846793005ull + i;
+        }
+        data->result.fetch_add(value, std::memory_order_relaxed);
+    }
+
+}  // namespace
+
+// Test the overhead of posting |kNumTasksPerStep| tasks to a WorkerTaskPool and waiting for
+// them. The per-iteration time is the amortized cost of a single task, its inverse is the
+// throughput of the pool.
+class WorkerThreadPoolPerf : public DawnPerfTestWithParams<WorkerThreadPoolParams> {
+  public:
+    WorkerThreadPoolPerf() : DawnPerfTestWithParams(kNumTasksPerStep, 1) {
+    }
+    ~WorkerThreadPoolPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    std::unique_ptr<dawn_platform::WorkerTaskPool> mPool;
+    std::vector<std::unique_ptr<dawn_platform::WaitableEvent>> mEvents;
+    TaskData mTaskData;
+};
+
+void WorkerThreadPoolPerf::SetUp() {
+    DawnPerfTestWithParams<WorkerThreadPoolParams>::SetUp();
+
+    switch (GetParam().poolType) {
+        case PoolType::ThreadPerTask:
+            mPool = std::make_unique<ThreadPerTaskPool>();
+            break;
+        case PoolType::Persistent:
+            mPool = std::make_unique<dawn_platform::AsyncWorkerThreadPool>();
+            break;
+    }
+
+    mTaskData.result = 0;
+    mTaskData.taskSize = GetParam().taskSize;
+    mEvents.reserve(kNumTasksPerStep);
+}
+
+void WorkerThreadPoolPerf::Step() {
+    for (unsigned int i = 0; i < kNumTasksPerStep; ++i) {
+        mEvents.push_back(mPool->PostWorkerTask(DoTask, &mTaskData));
+    }
+    for (std::unique_ptr<dawn_platform::WaitableEvent>& event : mEvents) {
+        event->Wait();
+    }
+    mEvents.clear();
+}
+
+TEST_P(WorkerThreadPoolPerf, Run) {
+    RunTest();
+}
+
+// The worker pool doesn't depend on the backend, only run on the Null backend.
+DAWN_INSTANTIATE_TEST_P(WorkerThreadPoolPerf,
+                        {NullBackend()},
+                        {PoolType::ThreadPerTask, PoolType::Persistent},
+                        {TaskSize::Empty, TaskSize::Small});
@@ -0,0 +1,184 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "common/Assert.h"
+#include "common/Constants.h"
+#include "common/Math.h"
+#include "utils/TextureUtils.h"
+#include "utils/WGPUHelpers.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 10;
+
+    enum class TextureSize {
+        Small2D,  // 64x64
+        Large2D,  // 2048x2048
+        Thin3D,   // 16x16x256, many small rows
+        Cube3D,   // 128x128x128
+    };
+
+    // How the rows of the uploaded data are laid out.
+    enum class DataLayout {
+        Tight,   // The rows and images are tightly packed.
+        Padded,  // The rows are aligned to kTextureBytesPerRowAlignment, like for buffer copies.
+    };
+
+    struct WriteTextureParams : AdapterTestParam {
+        WriteTextureParams(const AdapterTestParam& param,
+                           wgpu::TextureFormat format,
+                           TextureSize size,
+                           DataLayout layout)
+            : AdapterTestParam(param), format(format), size(size), layout(layout) {
+        }
+
+        wgpu::TextureFormat format;
+        TextureSize size;
+        DataLayout layout;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WriteTextureParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.format) {
+            case wgpu::TextureFormat::R8Unorm:
+                ostream << "_R8Unorm";
+                break;
+            case wgpu::TextureFormat::RGBA8Unorm:
+                ostream << "_RGBA8Unorm";
+                break;
+            case wgpu::TextureFormat::RGBA32Float:
+                ostream << "_RGBA32Float";
+                break;
+            default:
+                UNREACHABLE();
+        }
+
+        switch (param.size) {
+            case TextureSize::Small2D:
+                ostream << "_Small2D";
+                break;
+            case TextureSize::Large2D:
+                ostream << "_Large2D";
+                break;
+            case TextureSize::Thin3D:
+                ostream << "_Thin3D";
+                break;
+            case TextureSize::Cube3D:
+                ostream << "_Cube3D";
+                break;
+        }
+
+        switch (param.layout) {
+            case DataLayout::Tight:
+                ostream << "_Tight";
+                break;
+            case DataLayout::Padded:
+                ostream << "_Padded";
+                break;
+        }
+
+        return ostream;
+    }
+
+}  // namespace
+
+// Test uploading the whole content of a texture with WriteTexture |kNumIterations| times. The
+// data is repacked in the staging memory to the row alignment required by the backend, which is
+// done row by row when the strides differ.
+class WriteTexturePerf : public DawnPerfTestWithParams<WriteTextureParams> {
+  public:
+    WriteTexturePerf() : DawnPerfTestWithParams(kNumIterations, 1) {
+    }
+    ~WriteTexturePerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    wgpu::Texture mTexture;
+    wgpu::Extent3D mSize;
+    wgpu::TextureDataLayout mDataLayout;
+    std::vector<uint8_t> mData;
+};
+
+void WriteTexturePerf::SetUp() {
+    DawnPerfTestWithParams<WriteTextureParams>::SetUp();
+    const WriteTextureParams& params = GetParam();
+
+    wgpu::TextureDescriptor descriptor;
+    descriptor.dimension = wgpu::TextureDimension::e3D;
+    switch (params.size) {
+        case TextureSize::Small2D:
+            descriptor.dimension = wgpu::TextureDimension::e2D;
+            mSize = {64, 64, 1};
+            break;
+        case TextureSize::Large2D:
+            descriptor.dimension = wgpu::TextureDimension::e2D;
+            mSize = {2048, 2048, 1};
+            break;
+        case TextureSize::Thin3D:
+            mSize = {16, 16, 256};
+            break;
+        case TextureSize::Cube3D:
+            mSize = {128, 128, 128};
+            break;
+    }
+    descriptor.size = mSize;
+    descriptor.format = params.format;
+    descriptor.usage = wgpu::TextureUsage::CopyDst;
+    mTexture = device.CreateTexture(&descriptor);
+
+    uint32_t bytesPerRow = mSize.width * utils::GetTexelBlockSizeInBytes(params.format);
+    uint64_t uploadedBytesPerIteration =
+        uint64_t(bytesPerRow) * mSize.height * mSize.depthOrArrayLayers;
+    if (params.layout == DataLayout::Padded) {
+        bytesPerRow = Align(bytesPerRow, kTextureBytesPerRowAlignment);
+    }
+    mDataLayout = utils::CreateTextureDataLayout(0, bytesPerRow, mSize.height);
+    mData.resize(uint64_t(bytesPerRow) * mSize.height * mSize.depthOrArrayLayers);
+
+    SetThroughputResult("upload_throughput",
+                        static_cast<double>(kNumIterations) * uploadedBytesPerIteration /
+                            (1024 * 1024),
+                        "MB/s");
+}
+
+void WriteTexturePerf::Step() {
+    wgpu::ImageCopyTexture destination = utils::CreateImageCopyTexture(mTexture, 0, {0, 0, 0});
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        queue.WriteTexture(&destination, mData.data(), mData.size(), &mDataLayout, &mSize);
+    }
+    // Make sure all WriteTexture's are flushed.
+    queue.Submit(0, nullptr);
+}
+
+TEST_P(WriteTexturePerf, Run) {
+    RunTest();
+}
+
+// The repacking of the data is done on the CPU independently of the backend so the Null backend
+// measures it without the cost of the GPU copies.
+DAWN_INSTANTIATE_TEST_P(WriteTexturePerf,
+                        {NullBackend()},
+                        {wgpu::TextureFormat::R8Unorm, wgpu::TextureFormat::RGBA8Unorm,
+                         wgpu::TextureFormat::RGBA32Float},
+                        {TextureSize::Small2D, TextureSize::Large2D, TextureSize::Thin3D,
+                         TextureSize::Cube3D},
+                        {DataLayout::Tight, DataLayout::Padded});
@@ -17,8 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <set>
+#include <vector>
 
 #include "common/NonCopyable.h"
 #include "dawn_native/AsyncTask.h"
@@ -52,6 +55,45 @@ namespace {
         std::vector<std::unique_ptr<SimpleTaskResult>> mTaskResults;
     };
 
+    class NoopWaitableEvent final : public dawn_platform::WaitableEvent {
+      public:
+        void Wait() override {
+        }
+        bool IsComplete() override {
+            return true;
+        }
+    };
+
+    // A WorkerTaskPool that only runs the posted tasks when asked to, on the calling thread.
+    class ManualWorkerTaskPool final : public dawn_platform::WorkerTaskPool {
+      public:
+        std::unique_ptr<dawn_platform::WaitableEvent> PostWorkerTask(
+            dawn_platform::PostWorkerTaskCallback callback,
+            void* userdata) override {
+            mTasks.push_back({callback, userdata});
+            return std::make_unique<NoopWaitableEvent>();
+        }
+
+        void RunAll() {
+            std::vector<Task> tasks;
+            tasks.swap(mTasks);
+            for (const Task& task : tasks) {
+                task.callback(task.userdata);
+            }
+        }
+
+        size_t GetPostedTaskCount() const {
+            return mTasks.size();
+        }
+
+      private:
+        struct Task {
+            dawn_platform::PostWorkerTaskCallback callback;
+            void* userdata;
+        };
+        std::vector<Task> mTasks;
+    };
+
     void DoTask(ConcurrentTaskResultQueue* resultQueue, uint32_t id) {
         std::unique_ptr<SimpleTaskResult> result = std::make_unique<SimpleTaskResult>();
         result->id = id;
@@ -73,8 +115,7 @@ TEST_F(AsyncTaskTest, Basic) {
     constexpr size_t kTaskCount = 4u;
     std::set<uint32_t> idset;
     for (uint32_t i = 0; i < kTaskCount; ++i) {
-        dawn_native::AsyncTask asyncTask([&taskResultQueue, i] { DoTask(&taskResultQueue, i); });
-        taskManager.PostTask(std::move(asyncTask));
+        taskManager.PostTask([&taskResultQueue, i] { DoTask(&taskResultQueue, i); });
         idset.insert(i);
     }
 
@@ -87,3 +128,108 @@ TEST_F(AsyncTaskTest, Basic) {
     }
     ASSERT_TRUE(idset.empty());
 }
+
+// Test that tasks waiting for a worker thread run in priority order, then in posting order.
+TEST_F(AsyncTaskTest, Priority) {
+    ManualWorkerTaskPool pool;
+    dawn_native::AsyncTaskManager taskManager(&pool);
+
+    std::vector<uint32_t> order;
+    taskManager.PostTask([&order] { order.push_back(0); }, dawn_native::AsyncTaskPriority::Low);
+    taskManager.PostTask([&order] { order.push_back(1); });
+    taskManager.PostTask([&order] { order.push_back(2); }, dawn_native::AsyncTaskPriority::High);
+    taskManager.PostTask([&order] { order.push_back(3); });
+
+    ASSERT_TRUE(taskManager.HasPendingTasks());
+    pool.RunAll();
+    ASSERT_FALSE(taskManager.HasPendingTasks());
+
+    EXPECT_EQ((std::vector<uint32_t>{2, 1, 3, 0}), order);
+}
+
+// Test that cancelling a task that hasn't started calls its cancel function instead of its body.
+TEST_F(AsyncTaskTest, Cancel) {
+    ManualWorkerTaskPool pool;
+    dawn_native::AsyncTaskManager taskManager(&pool);
+
+    bool bodyRan = false;
+    bool cancelled = false;
+    Ref<dawn_native::AsyncTask> task = taskManager.PostTask(
+        [&bodyRan] { bodyRan = true; }, dawn_native::AsyncTaskPriority::Normal,
+        [&cancelled] { cancelled = true; });
+
+    EXPECT_TRUE(task->Cancel());
+    EXPECT_TRUE(cancelled);
+    EXPECT_TRUE(task->IsComplete());
+    EXPECT_TRUE(task->IsCancelled());
+    EXPECT_FALSE(taskManager.HasPendingTasks());
+
+    // Cancelling again or running the task is a noop.
+    EXPECT_FALSE(task->Cancel());
+    EXPECT_FALSE(task->RunNow());
+
+    pool.RunAll();
+    EXPECT_FALSE(bodyRan);
+}
+
+// Test that a completed task cannot be cancelled.
+TEST_F(AsyncTaskTest, CancelAfterCompletion) {
+    ManualWorkerTaskPool pool;
+    dawn_native::AsyncTaskManager taskManager(&pool);
+
+    bool cancelled = false;
+    Ref<dawn_native::AsyncTask> task = taskManager.PostTask(
+        [] {}, dawn_native::AsyncTaskPriority::Normal, [&cancelled] { cancelled = true; });
+
+    pool.RunAll();
+    EXPECT_TRUE(task->IsComplete());
+    EXPECT_FALSE(task->Cancel());
+    EXPECT_FALSE(task->IsCancelled());
+    EXPECT_FALSE(cancelled);
+}
+
+// Test that RunNow() runs the body of a task that hasn't started on the calling thread, and that
+// the worker thread skips it afterwards.
+TEST_F(AsyncTaskTest, RunNow) {
+    ManualWorkerTaskPool pool;
+    dawn_native::AsyncTaskManager taskManager(&pool);
+
+    uint32_t runCount = 0;
+    Ref<dawn_native::AsyncTask> task = taskManager.PostTask([&runCount] { runCount++; });
+
+    EXPECT_TRUE(task->RunNow());
+    EXPECT_EQ(1u, runCount);
+    EXPECT_TRUE(task->IsComplete());
+    EXPECT_FALSE(taskManager.HasPendingTasks());
+
+    // The task was stolen so the worker doesn't run it again, and RunNow() doesn't either.
+    pool.RunAll();
+    EXPECT_TRUE(task->RunNow());
+    EXPECT_EQ(1u, runCount);
+}
+
+// Test that CancelAllPendingTasks() cancels the tasks that haven't started and waits for the
+// others.
+TEST_F(AsyncTaskTest, CancelAllPendingTasks) {
+    dawn_platform::Platform platform;
+    std::unique_ptr<dawn_platform::WorkerTaskPool> pool = platform.CreateWorkerTaskPool();
+    dawn_native::AsyncTaskManager taskManager(pool.get());
+
+    constexpr uint32_t kTaskCount = 64;
+    std::atomic<uint32_t> ranCount(0);
+    std::atomic<uint32_t> cancelledCount(0);
+    std::vector<Ref<dawn_native::AsyncTask>> tasks;
+    for (uint32_t i = 0; i < kTaskCount; ++i) {
+        tasks.push_back(taskManager.PostTask([&ranCount] { ranCount++; },
+                                             dawn_native::AsyncTaskPriority::Normal,
+                                             [&cancelledCount] { cancelledCount++; }));
+    }
+
+    taskManager.CancelAllPendingTasks();
+    EXPECT_FALSE(taskManager.HasPendingTasks());
+    EXPECT_EQ(kTaskCount, ranCount.load() + cancelledCount.load());
+
+    for (Ref<dawn_native::AsyncTask>& task : tasks) {
+        EXPECT_TRUE(task->IsComplete());
+    }
+}
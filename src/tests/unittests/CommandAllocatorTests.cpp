@@ -17,6 +17,7 @@
 #include "dawn_native/CommandAllocator.h"
 
 #include <limits>
+#include <vector>
 
 using namespace dawn_native;
 
@@ -447,3 +448,102 @@ TEST(CommandAllocator, AllocateDataDefaultInitializes) {
     CommandIterator iterator(std::move(allocator));
     iterator.MakeEmptyAsDataWasDestroyed();
 }
+
+// Test that the blocks of destroyed commands are reused by the next allocators using the pool.
+TEST(CommandBlockPool, BlocksAreRecycled) {
+    Ref<CommandBlockPool> pool = AcquireRef(new CommandBlockPool());
+
+    for (int i = 0; i < 10; i++) {
+        CommandAllocator allocator(pool.Get());
+        CommandDraw* draw = allocator.Allocate<CommandDraw>(CommandType::Draw);
+        draw->first = i;
+        draw->count = 1;
+
+        CommandIterator iterator(std::move(allocator));
+        CommandType type;
+        ASSERT_TRUE(iterator.NextCommandId(&type));
+        ASSERT_EQ(type, CommandType::Draw);
+        ASSERT_EQ(iterator.NextCommand<CommandDraw>()->first, static_cast<uint32_t>(i));
+        iterator.MakeEmptyAsDataWasDestroyed();
+    }
+
+    CommandBlockPoolStats stats = pool->GetStats();
+    EXPECT_EQ(stats.systemAllocations, 1u);
+    EXPECT_EQ(stats.recycledAllocations, 9u);
+    EXPECT_EQ(stats.systemFrees, 0u);
+    EXPECT_EQ(stats.cachedBlocks, 1u);
+    EXPECT_EQ(stats.cachedBytes, CommandBlockPool::kMinPooledBlockSize);
+}
+
+// Test that the commands keep the pool alive and return their blocks to it.
+TEST(CommandBlockPool, CommandsKeepPoolAlive) {
+    Ref<CommandBlockPool> pool = AcquireRef(new CommandBlockPool());
+    CommandAllocator allocator(pool.Get());
+    allocator.Allocate<CommandDraw>(CommandType::Draw);
+    CommandIterator iterator(std::move(allocator));
+
+    CommandBlockPool* poolPtr = pool.Get();
+    pool = nullptr;
+    EXPECT_EQ(poolPtr->GetStats().cachedBlocks, 0u);
+
+    CommandIterator movedIterator(std::move(iterator));
+    movedIterator.MakeEmptyAsDataWasDestroyed();
+}
+
+// Test that blocks larger than the largest size class aren't pooled.
+TEST(CommandBlockPool, LargeBlocksAreNotPooled) {
+    Ref<CommandBlockPool> pool = AcquireRef(new CommandBlockPool());
+
+    // The big command is in its own block, the draws that follow it are in a pooled block.
+    CommandAllocator allocator(pool.Get());
+    allocator.Allocate<CommandBig>(CommandType::Big);
+    for (int i = 0; i < 1000; i++) {
+        allocator.Allocate<CommandDraw>(CommandType::Draw);
+    }
+    CommandIterator iterator(std::move(allocator));
+    iterator.MakeEmptyAsDataWasDestroyed();
+
+    CommandBlockPoolStats stats = pool->GetStats();
+    EXPECT_EQ(stats.systemAllocations, 2u);
+    EXPECT_EQ(stats.systemFrees, 1u);
+    EXPECT_EQ(stats.cachedBlocks, 1u);
+}
+
+// Test that Trim() only keeps the blocks needed to reach the high-water mark of the blocks used
+// since the previous Trim().
+TEST(CommandBlockPool, TrimToHighWaterMark) {
+    Ref<CommandBlockPool> pool = AcquireRef(new CommandBlockPool());
+
+    auto AllocateCommands = [&](size_t count) {
+        std::vector<CommandIterator> iterators(count);
+        for (CommandIterator& iterator : iterators) {
+            CommandAllocator allocator(pool.Get());
+            allocator.Allocate<CommandDraw>(CommandType::Draw);
+            iterator = std::move(allocator);
+        }
+        for (CommandIterator& iterator : iterators) {
+            iterator.MakeEmptyAsDataWasDestroyed();
+        }
+    };
+
+    // A burst of 8 command buffers in flight at the same time.
+    AllocateCommands(8);
+    EXPECT_EQ(pool->GetStats().cachedBlocks, 8u);
+
+    // The blocks were needed since the last Trim() so they are kept.
+    pool->Trim();
+    EXPECT_EQ(pool->GetStats().cachedBlocks, 8u);
+
+    // Only 2 command buffers are in flight at the same time, the excess blocks are released.
+    AllocateCommands(2);
+    pool->Trim();
+    CommandBlockPoolStats stats = pool->GetStats();
+    EXPECT_EQ(stats.cachedBlocks, 2u);
+    EXPECT_EQ(stats.systemFrees, 6u);
+    EXPECT_EQ(stats.systemAllocations, 8u);
+
+    // Nothing was used since the last Trim(), all the blocks are released.
+    pool->Trim();
+    EXPECT_EQ(pool->GetStats().cachedBlocks, 0u);
+    EXPECT_EQ(pool->GetStats().cachedBytes, 0u);
+}
@@ -0,0 +1,201 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_native/ContentLessObjectCache.h"
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace dawn_native;
+
+namespace {
+
+    class CacheTestObject;
+    using TestCache = ContentLessObjectCache<CacheTestObject>;
+
+    // Blueprints are created on the stack with a null cache, like the blueprints of DeviceBase.
+    class CacheTestObject : public RefCounted {
+      public:
+        CacheTestObject(TestCache* cache, size_t value) : mCache(cache), mValue(value) {
+        }
+        ~CacheTestObject() override {
+            if (onDestruction) {
+                onDestruction();
+            }
+            if (mCache != nullptr) {
+                bool erased = mCache->Erase(this);
+                if (wasErased != nullptr) {
+                    *wasErased = erased;
+                }
+            }
+        }
+
+        struct HashFunc {
+            size_t operator()(const CacheTestObject* object) const {
+                return object->mValue;
+            }
+        };
+        struct EqualityFunc {
+            bool operator()(const CacheTestObject* a, const CacheTestObject* b) const {
+                return a->mValue == b->mValue;
+            }
+        };
+
+        size_t GetValue() const {
+            return mValue;
+        }
+
+        // Called in the destructor before the object removes itself from the cache.
+        std::function<void()> onDestruction;
+        // Set in the destructor to whether the object was still in the cache.
+        bool* wasErased = nullptr;
+
+      private:
+        TestCache* mCache;
+        size_t mValue;
+    };
+
+    Ref<CacheTestObject> GetOrCreate(TestCache* cache, size_t value) {
+        CacheTestObject blueprint(nullptr, value);
+        Ref<CacheTestObject> result = cache->Find(&blueprint);
+        if (result == nullptr) {
+            result = AcquireRef(new CacheTestObject(cache, value));
+            result = cache->Insert(result.Get()).first;
+        }
+        return result;
+    }
+
+}  // anonymous namespace
+
+// Test that Find returns nullptr for objects that aren't cached.
+TEST(ContentLessObjectCacheTests, FindMissing) {
+    TestCache cache;
+    CacheTestObject blueprint(nullptr, 1);
+    EXPECT_EQ(nullptr, cache.Find(&blueprint).Get());
+    EXPECT_TRUE(cache.Empty());
+}
+
+// Test that objects are found by value after they are inserted.
+TEST(ContentLessObjectCacheTests, InsertThenFind) {
+    TestCache cache;
+    Ref<CacheTestObject> object = AcquireRef(new CacheTestObject(&cache, 1));
+
+    auto insertion = cache.Insert(object.Get());
+    EXPECT_TRUE(insertion.second);
+    EXPECT_EQ(object.Get(), insertion.first.Get());
+
+    CacheTestObject blueprint(nullptr, 1);
+    EXPECT_EQ(object.Get(), cache.Find(&blueprint).Get());
+}
+
+// Test that inserting an object equal to a cached one returns the cached one.
+TEST(ContentLessObjectCacheTests, InsertDuplicateReturnsExisting) {
+    TestCache cache;
+    Ref<CacheTestObject> first = AcquireRef(new CacheTestObject(&cache, 1));
+    cache.Insert(first.Get());
+
+    bool duplicateWasErased = true;
+    {
+        Ref<CacheTestObject> second = AcquireRef(new CacheTestObject(&cache, 1));
+        second->wasErased = &duplicateWasErased;
+        auto insertion = cache.Insert(second.Get());
+        EXPECT_FALSE(insertion.second);
+        EXPECT_EQ(first.Get(), insertion.first.Get());
+    }
+
+    // The duplicate didn't remove the cached object when it was destroyed.
+    EXPECT_FALSE(duplicateWasErased);
+    CacheTestObject blueprint(nullptr, 1);
+    EXPECT_EQ(first.Get(), cache.Find(&blueprint).Get());
+}
+
+// Test that objects are removed from the cache when they are destroyed.
+TEST(ContentLessObjectCacheTests, ErasedOnDestruction) {
+    TestCache cache;
+    bool wasErased = false;
+    {
+        Ref<CacheTestObject> object = AcquireRef(new CacheTestObject(&cache, 1));
+        object->wasErased = &wasErased;
+        cache.Insert(object.Get());
+        EXPECT_FALSE(cache.Empty());
+    }
+    EXPECT_TRUE(wasErased);
+    EXPECT_TRUE(cache.Empty());
+}
+
+// Test that objects that are being destroyed aren't returned and are replaced on insertion.
+TEST(ContentLessObjectCacheTests, ObjectBeingDestroyed) {
+    TestCache cache;
+    Ref<CacheTestObject> replacement;
+    bool dyingWasErased = true;
+    {
+        Ref<CacheTestObject> dying = AcquireRef(new CacheTestObject(&cache, 1));
+        dying->wasErased = &dyingWasErased;
+        cache.Insert(dying.Get());
+
+        // Emulate another thread using the cache between the last Release() of the object and
+        // its removal from the cache.
+        dying->onDestruction = [&cache, &replacement]() {
+            CacheTestObject blueprint(nullptr, 1);
+            EXPECT_EQ(nullptr, cache.Find(&blueprint).Get());
+
+            replacement = AcquireRef(new CacheTestObject(&cache, 1));
+            EXPECT_TRUE(cache.Insert(replacement.Get()).second);
+        };
+    }
+
+    // The dying object didn't remove its replacement.
+    EXPECT_FALSE(dyingWasErased);
+    CacheTestObject blueprint(nullptr, 1);
+    EXPECT_EQ(replacement.Get(), cache.Find(&blueprint).Get());
+}
+
+// Test that concurrent GetOrCreate of the same values from multiple threads end up with a single
+// cached object per value.
+TEST(ContentLessObjectCacheTests, ConcurrentGetOrCreate) {
+    constexpr size_t kValueCount = 64;
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kIterationCount = 200;
+
+    TestCache cache;
+    std::vector<Ref<CacheTestObject>> kept;
+    for (size_t value = 0; value < kValueCount; value += 2) {
+        kept.push_back(GetOrCreate(&cache, value));
+    }
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&cache, &kept]() {
+            for (uint32_t i = 0; i < kIterationCount; ++i) {
+                for (size_t value = 0; value < kValueCount; ++value) {
+                    Ref<CacheTestObject> object = GetOrCreate(&cache, value);
+                    EXPECT_EQ(value, object->GetValue());
+                    // Values kept alive are always returned as the same object.
+                    if (value % 2 == 0) {
+                        EXPECT_EQ(kept[value / 2].Get(), object.Get());
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    kept.clear();
+    EXPECT_TRUE(cache.Empty());
+}
@@ -0,0 +1,227 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_native/Device.h"
+#include "dawn_native/DynamicUploader.h"
+#include "dawn_native/Instance.h"
+#include "dawn_native/Queue.h"
+#include "dawn_native/Texture.h"
+#include "dawn_native/null/DeviceNull.h"
+
+#include <memory>
+#include <vector>
+
+using namespace dawn_native;
+
+namespace {
+
+    constexpr uint64_t kMB = 1024 * 1024;
+
+}  // anonymous namespace
+
+// Tests of the ring buffers and staging buffer pool of the DynamicUploader, using the staging
+// buffers of a device of the null backend.
+class DynamicUploaderTests : public testing::Test {
+  public:
+    DynamicUploaderTests()
+        : testing::Test(),
+          mInstanceBase(InstanceBase::Create()),
+          mAdapterBase(mInstanceBase.Get()) {
+    }
+
+  protected:
+    void SetUp() override {
+        Adapter adapter(&mAdapterBase);
+        mDevice = AcquireRef(reinterpret_cast<DeviceBase*>(adapter.CreateDevice()));
+        ASSERT_NE(mDevice.Get(), nullptr);
+        mUploader = std::make_unique<DynamicUploader>(mDevice.Get());
+    }
+
+    void TearDown() override {
+        // Free the staging buffers before the device checks that its memory was released.
+        mUploader = nullptr;
+        mDevice = nullptr;
+    }
+
+    UploadHandle Allocate(uint64_t size, uint64_t serial) {
+        ResultOrError<UploadHandle> result = mUploader->Allocate(size, ExecutionSerial(serial), 1);
+        EXPECT_FALSE(result.IsError());
+        if (result.IsError()) {
+            result.AcquireError();
+            return {};
+        }
+        return result.AcquireSuccess();
+    }
+
+    // Uploads a small amount of data on |serial| and completes it, which ticks the uploader once
+    // while keeping the first ring buffer in use.
+    void UploadAndComplete(uint64_t serial) {
+        Allocate(kMB, serial);
+        mUploader->Deallocate(ExecutionSerial(serial));
+    }
+
+    Ref<InstanceBase> mInstanceBase;
+    null::Adapter mAdapterBase;
+    Ref<DeviceBase> mDevice;
+    std::unique_ptr<DynamicUploader> mUploader;
+};
+
+// Test that a new ring buffer at least twice as large as the largest one is created when the
+// existing ones are full, and that the ring buffers are reused once their uploads complete.
+TEST_F(DynamicUploaderTests, RingBuffersGrow) {
+    // The first ring buffer is created lazily with the minimum size.
+    Allocate(kMB, 1);
+    DynamicUploaderStats stats = mUploader->GetStats();
+    EXPECT_EQ(stats.ringBufferCount, 1u);
+    EXPECT_EQ(stats.stagingBufferBytes, DynamicUploader::kMinRingBufferSize);
+    EXPECT_EQ(stats.stagingBufferCreations, 1u);
+
+    Allocate(6 * kMB, 1);
+    stats = mUploader->GetStats();
+    EXPECT_EQ(stats.ringBufferCount, 2u);
+    EXPECT_EQ(stats.stagingBufferBytes, 12 * kMB);
+
+    Allocate(12 * kMB, 1);
+    stats = mUploader->GetStats();
+    EXPECT_EQ(stats.ringBufferCount, 3u);
+    EXPECT_EQ(stats.stagingBufferBytes, 28 * kMB);
+
+    // The growth is capped to the maximum ring buffer size.
+    Allocate(60 * kMB, 1);
+    stats = mUploader->GetStats();
+    EXPECT_EQ(stats.ringBufferCount, 4u);
+    EXPECT_EQ(stats.stagingBufferBytes, 28 * kMB + DynamicUploader::kMaxRingBufferSize);
+    EXPECT_EQ(stats.stagingBufferCreations, 4u);
+    EXPECT_EQ(stats.bytesInFlight, 79 * kMB);
+    EXPECT_EQ(stats.peakBytesInFlight, 79 * kMB);
+
+    // Completing the uploads frees the ring buffers without destroying them, so the next uploads
+    // don't create staging buffers.
+    mUploader->Deallocate(ExecutionSerial(1));
+    EXPECT_EQ(mUploader->GetStats().bytesInFlight, 0u);
+
+    Allocate(12 * kMB, 2);
+    stats = mUploader->GetStats();
+    EXPECT_EQ(stats.ringBufferCount, 4u);
+    EXPECT_EQ(stats.stagingBufferCreations, 4u);
+    EXPECT_EQ(stats.bytesInFlight, 12 * kMB);
+}
+
+// Test that the staging buffers of allocations larger than the ring buffers are reused once their
+// uploads complete, and only then.
+TEST_F(DynamicUploaderTests, LargeAllocationReuse) {
+    // Large allocations are rounded up to a size class, 80MB for this one.
+    constexpr uint64_t kLargeSize = DynamicUploader::kMaxRingBufferSize + 1;
+    constexpr uint64_t kSizeClass = 80 * kMB;
+
+    UploadHandle first = Allocate(kLargeSize, 1);
+    DynamicUploaderStats stats = mUploader->GetStats();
+    EXPECT_EQ(stats.largeAllocations, 1u);
+    EXPECT_EQ(stats.largeAllocationReuses, 0u);
+    EXPECT_EQ(stats.stagingBufferCreations, 1u);
+    EXPECT_EQ(stats.stagingBufferBytes, kSizeClass);
+
+    // The staging buffer of the first allocation is still in flight so it can't be reused.
+    Allocate(kLargeSize, 2);
+    stats = mUploader->GetStats();
+    EXPECT_EQ(stats.largeAllocationReuses, 0u);
+    EXPECT_EQ(stats.stagingBufferCreations, 2u);
+    EXPECT_EQ(stats.stagingBufferBytes, 2 * kSizeClass);
+
+    // Once serial 1 completes, its staging buffer is reused.
+    mUploader->Deallocate(ExecutionSerial(1));
+    UploadHandle third = Allocate(kLargeSize, 3);
+    stats = mUploader->GetStats();
+    EXPECT_EQ(stats.largeAllocations, 3u);
+    EXPECT_EQ(stats.largeAllocationReuses, 1u);
+    EXPECT_EQ(stats.stagingBufferCreations, 2u);
+    EXPECT_EQ(stats.stagingBufferBytes, 2 * kSizeClass);
+    EXPECT_EQ(third.stagingBuffer, first.stagingBuffer);
+}
+
+// Test that the ring buffers and pooled staging buffers that stay unused for more than
+// kIdleTicksBeforeTrim ticks are freed, while the ones in use are kept.
+TEST_F(DynamicUploaderTests, TrimAfterIdleTicks) {
+    // Create a 4MB and an 8MB ring buffer, last used on tick 0, and an 80MB staging buffer that
+    // returns to the pool on tick 1.
+    Allocate(kMB, 1);
+    Allocate(6 * kMB, 1);
+    Allocate(DynamicUploader::kMaxRingBufferSize + 1, 1);
+    mUploader->Deallocate(ExecutionSerial(1));
+    EXPECT_EQ(mUploader->GetStats().stagingBufferBytes, 92 * kMB);
+
+    // Each tick keeps using the 4MB ring buffer. Nothing is idle for long enough to be trimmed.
+    uint64_t tick = 2;
+    for (; tick <= DynamicUploader::kIdleTicksBeforeTrim; tick++) {
+        UploadAndComplete(tick);
+    }
+    DynamicUploaderStats stats = mUploader->GetStats();
+    EXPECT_EQ(stats.trimmedBytes, 0u);
+    EXPECT_EQ(stats.ringBufferCount, 2u);
+    EXPECT_EQ(stats.stagingBufferBytes, 92 * kMB);
+
+    // The 8MB ring buffer is trimmed first.
+    UploadAndComplete(tick++);
+    stats = mUploader->GetStats();
+    EXPECT_EQ(stats.trimmedBytes, 8 * kMB);
+    EXPECT_EQ(stats.ringBufferCount, 1u);
+    EXPECT_EQ(stats.stagingBufferBytes, 84 * kMB);
+
+    // Then the pooled staging buffer.
+    UploadAndComplete(tick++);
+    stats = mUploader->GetStats();
+    EXPECT_EQ(stats.trimmedBytes, 88 * kMB);
+    EXPECT_EQ(stats.ringBufferCount, 1u);
+    EXPECT_EQ(stats.stagingBufferBytes, DynamicUploader::kMinRingBufferSize);
+
+    // The ring buffer in use is never trimmed.
+    for (uint64_t i = 0; i < 2 * DynamicUploader::kIdleTicksBeforeTrim; i++) {
+        UploadAndComplete(tick++);
+    }
+    stats = mUploader->GetStats();
+    EXPECT_EQ(stats.trimmedBytes, 88 * kMB);
+    EXPECT_EQ(stats.stagingBufferCreations, 3u);
+}
+
+// Test that GetDynamicUploaderStats reports the uploads of the device.
+TEST_F(DynamicUploaderTests, DeviceStats) {
+    WGPUDevice device = reinterpret_cast<WGPUDevice>(mDevice.Get());
+    DynamicUploaderStats stats = GetDynamicUploaderStats(device);
+    EXPECT_EQ(stats.stagingBufferCreations, 0u);
+    EXPECT_EQ(stats.stagingBufferBytes, 0u);
+
+    TextureDescriptor descriptor;
+    descriptor.size = {4, 4, 1};
+    descriptor.format = wgpu::TextureFormat::RGBA8Unorm;
+    descriptor.usage = wgpu::TextureUsage::CopyDst;
+    Ref<TextureBase> texture = AcquireRef(mDevice->APICreateTexture(&descriptor));
+
+    std::vector<uint8_t> data(4 * 4 * 4);
+    ImageCopyTexture imageCopyTexture;
+    imageCopyTexture.texture = texture.Get();
+    TextureDataLayout textureDataLayout;
+    textureDataLayout.bytesPerRow = 4 * 4;
+    Extent3D copySize = {4, 4, 1};
+    Ref<QueueBase> queue = AcquireRef(mDevice->APIGetQueue());
+    queue->APIWriteTexture(&imageCopyTexture, data.data(), data.size(), &textureDataLayout,
+                           &copySize);
+
+    stats = GetDynamicUploaderStats(device);
+    EXPECT_EQ(stats.ringBufferCount, 1u);
+    EXPECT_EQ(stats.stagingBufferCreations, 1u);
+    EXPECT_EQ(stats.stagingBufferBytes, DynamicUploader::kMinRingBufferSize);
+    EXPECT_GE(stats.peakBytesInFlight, data.size());
+}
@@ -0,0 +1,109 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/FlatPointerSet.h"
+
+#include <vector>
+
+namespace {
+
+    struct Object {
+        int value = 0;
+    };
+
+}  // anonymous namespace
+
+// Test inserting and finding pointers in a small set.
+TEST(FlatPointerSetTests, InsertAndFind) {
+    Object a, b;
+    FlatPointerSet<Object> set;
+    EXPECT_TRUE(set.Empty());
+    EXPECT_EQ(FlatPointerSet<Object>::kNotFound, set.Find(&a));
+
+    auto insertion = set.Insert(&a);
+    EXPECT_EQ(0u, insertion.first);
+    EXPECT_TRUE(insertion.second);
+
+    insertion = set.Insert(&b);
+    EXPECT_EQ(1u, insertion.first);
+    EXPECT_TRUE(insertion.second);
+
+    // Inserting again returns the index of the existing element.
+    insertion = set.Insert(&a);
+    EXPECT_EQ(0u, insertion.first);
+    EXPECT_FALSE(insertion.second);
+
+    EXPECT_EQ(2u, set.Size());
+    EXPECT_EQ(0u, set.Find(&a));
+    EXPECT_EQ(1u, set.Find(&b));
+}
+
+// Test that the elements are kept in insertion order and that the indices stay valid when the set
+// grows past the size at which it uses a hash table.
+TEST(FlatPointerSetTests, LargeSetKeepsInsertionOrder) {
+    constexpr size_t kObjectCount = 1000;
+    std::vector<Object> objects(kObjectCount);
+
+    // Insert the objects in an order that isn't the order of their addresses.
+    std::vector<Object*> expectedOrder;
+    for (size_t i = 0; i < kObjectCount; ++i) {
+        expectedOrder.push_back(&objects[(i * 7) % kObjectCount]);
+    }
+
+    FlatPointerSet<Object> set;
+    for (size_t i = 0; i < kObjectCount; ++i) {
+        auto insertion = set.Insert(expectedOrder[i]);
+        ASSERT_TRUE(insertion.second);
+        ASSERT_EQ(i, insertion.first);
+
+        // Previously inserted objects are still found at their index.
+        ASSERT_EQ(i / 2, set.Find(expectedOrder[i / 2]));
+    }
+
+    for (size_t i = 0; i < kObjectCount; ++i) {
+        auto insertion = set.Insert(expectedOrder[i]);
+        EXPECT_FALSE(insertion.second);
+        EXPECT_EQ(i, insertion.first);
+    }
+
+    Object notInserted;
+    EXPECT_EQ(FlatPointerSet<Object>::kNotFound, set.Find(&notInserted));
+    EXPECT_EQ(expectedOrder, set.GetElements());
+}
+
+// Test that the set can be reused after its elements are acquired.
+TEST(FlatPointerSetTests, AcquireElementsClears) {
+    std::vector<Object> objects(100);
+
+    FlatPointerSet<Object> set;
+    for (Object& object : objects) {
+        set.Insert(&object);
+    }
+    std::vector<Object*> elements = set.AcquireElements();
+    EXPECT_EQ(objects.size(), elements.size());
+    EXPECT_TRUE(set.Empty());
+    EXPECT_EQ(FlatPointerSet<Object>::kNotFound, set.Find(&objects[50]));
+
+    // Insert a different number of elements so that the stale hash table would give wrong indices
+    // if it was used.
+    for (size_t i = 0; i < 20; ++i) {
+        auto insertion = set.Insert(&objects[99 - i]);
+        EXPECT_TRUE(insertion.second);
+        EXPECT_EQ(i, insertion.first);
+    }
+    EXPECT_EQ(FlatPointerSet<Object>::kNotFound, set.Find(&objects[0]));
+    EXPECT_EQ(0u, set.Find(&objects[99]));
+}
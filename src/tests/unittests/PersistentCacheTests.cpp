@@ -0,0 +1,219 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/SystemUtils.h"
+#include "dawn_native/PersistentCache.h"
+#include "dawn_platform/FileCachingInterface.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dawn_native;
+
+namespace {
+
+    PersistentCacheKey MakeKey(const std::string& name) {
+        // Include the name of the test in the keys so that the entries of the file caches used by
+        // different tests don't collide.
+        std::string key =
+            ::testing::UnitTest::GetInstance()->current_test_info()->name() + ("/" + name);
+        return PersistentCacheKey(key.begin(), key.end());
+    }
+
+    // Loads |key| from |cache|, storing |value| if it isn't cached. Returns whether the blob was
+    // loaded from the cache and checks that the loaded blob is |value|.
+    bool LoadOrStore(PersistentCache* cache,
+                     const PersistentCacheKey& key,
+                     const std::vector<uint8_t>& value) {
+        bool created = false;
+        ResultOrError<ScopedCachedBlob> result =
+            cache->GetOrCreate(key, [&](auto doCache) -> MaybeError {
+                created = true;
+                doCache(value.data(), value.size());
+                return {};
+            });
+        if (result.IsError()) {
+            ADD_FAILURE();
+            return false;
+        }
+
+        ScopedCachedBlob blob = result.AcquireSuccess();
+
+        if (!created) {
+            EXPECT_EQ(std::vector<uint8_t>(blob.buffer.get(), blob.buffer.get() + blob.bufferSize),
+                      value);
+        }
+        return !created;
+    }
+
+    class ScopedFileCache {
+      public:
+        ScopedFileCache() : mCache(GetExecutableDirectory()) {
+        }
+        ~ScopedFileCache() {
+            for (const PersistentCacheKey& key : mKeys) {
+                mCache.DeleteData(key.data(), key.size());
+            }
+        }
+
+        dawn_platform::FileCachingInterface* Get(const std::vector<PersistentCacheKey>& keys) {
+            mKeys = keys;
+            // Remove the entries left by a previous run of the test that didn't clean up.
+            for (const PersistentCacheKey& key : mKeys) {
+                mCache.DeleteData(key.data(), key.size());
+            }
+            return &mCache;
+        }
+
+      private:
+        dawn_platform::FileCachingInterface mCache;
+        std::vector<PersistentCacheKey> mKeys;
+    };
+
+}  // anonymous namespace
+
+// Test that stored blobs are loaded from the in-memory tier when there is no platform cache.
+TEST(PersistentCacheTests, MemoryTier) {
+    PersistentCache cache(nullptr, nullptr, PersistentCache::kDefaultMemoryBudget);
+    PersistentCacheKey key = MakeKey("key");
+    std::vector<uint8_t> value = {1, 2, 3, 4};
+
+    EXPECT_FALSE(LoadOrStore(&cache, key, value));
+    EXPECT_TRUE(LoadOrStore(&cache, key, value));
+    EXPECT_TRUE(LoadOrStore(&cache, key, value));
+
+    PersistentCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.memoryHits, 2u);
+    EXPECT_EQ(stats.platformHits, 0u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.stores, 1u);
+    EXPECT_EQ(stats.memoryBytes, key.size() + value.size());
+}
+
+// Test that the in-memory tier stays within its budget by evicting blobs, and that blobs larger
+// than the budget aren't kept in memory.
+TEST(PersistentCacheTests, MemoryBudget) {
+    constexpr size_t kBudget = 16 * 1024;
+    PersistentCache cache(nullptr, nullptr, kBudget);
+    std::vector<uint8_t> value(500, 42);
+
+    constexpr uint32_t kKeyCount = 200;
+    for (uint32_t i = 0; i < kKeyCount; ++i) {
+        PersistentCacheKey key = MakeKey(std::to_string(i));
+        EXPECT_FALSE(LoadOrStore(&cache, key, value));
+        EXPECT_LE(cache.GetStats().memoryBytes, kBudget);
+
+        // The most recently stored blob is never evicted.
+        EXPECT_TRUE(LoadOrStore(&cache, key, value));
+    }
+
+    PersistentCacheStats stats = cache.GetStats();
+    EXPECT_GT(stats.evictions, 0u);
+    EXPECT_EQ(stats.stores, kKeyCount);
+
+    // A blob that doesn't fit in the budget isn't kept.
+    PersistentCacheKey bigKey = MakeKey("big");
+    std::vector<uint8_t> bigValue(kBudget, 1);
+    EXPECT_FALSE(LoadOrStore(&cache, bigKey, bigValue));
+    EXPECT_FALSE(LoadOrStore(&cache, bigKey, bigValue));
+}
+
+// Test that blobs are loaded from the platform cache by a new cache, then from its memory tier.
+TEST(PersistentCacheTests, PlatformTier) {
+    PersistentCacheKey key = MakeKey("key");
+    std::vector<uint8_t> value = {5, 6, 7, 8, 9};
+
+    ScopedFileCache fileCache;
+    dawn_platform::FileCachingInterface* platformCache = fileCache.Get({key});
+
+    {
+        PersistentCache cache(nullptr, platformCache, PersistentCache::kDefaultMemoryBudget);
+        EXPECT_FALSE(LoadOrStore(&cache, key, value));
+    }
+
+    PersistentCache cache(nullptr, platformCache, PersistentCache::kDefaultMemoryBudget);
+    EXPECT_TRUE(LoadOrStore(&cache, key, value));
+    EXPECT_TRUE(LoadOrStore(&cache, key, value));
+
+    PersistentCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.platformHits, 1u);
+    EXPECT_EQ(stats.memoryHits, 1u);
+    EXPECT_EQ(stats.misses, 0u);
+}
+
+// Test the file-backed caching interface directly.
+TEST(PersistentCacheTests, FileCachingInterface) {
+    PersistentCacheKey key = MakeKey("key");
+    PersistentCacheKey otherKey = MakeKey("otherKey");
+
+    ScopedFileCache fileCache;
+    dawn_platform::FileCachingInterface* platformCache = fileCache.Get({key, otherKey});
+
+    EXPECT_EQ(platformCache->LoadData(nullptr, key.data(), key.size(), nullptr, 0), 0u);
+
+    std::vector<uint8_t> value = {1, 2, 3};
+    platformCache->StoreData(nullptr, key.data(), key.size(), value.data(), value.size());
+    EXPECT_EQ(platformCache->LoadData(nullptr, key.data(), key.size(), nullptr, 0), value.size());
+    EXPECT_EQ(platformCache->LoadData(nullptr, otherKey.data(), otherKey.size(), nullptr, 0), 0u);
+
+    // Storing again replaces the value.
+    std::vector<uint8_t> newValue = {4, 5, 6, 7};
+    platformCache->StoreData(nullptr, key.data(), key.size(), newValue.data(), newValue.size());
+    std::vector<uint8_t> loaded(newValue.size());
+    EXPECT_EQ(platformCache->LoadData(nullptr, key.data(), key.size(), loaded.data(),
+                                      loaded.size()),
+              newValue.size());
+    EXPECT_EQ(loaded, newValue);
+
+    platformCache->DeleteData(key.data(), key.size());
+    EXPECT_EQ(platformCache->LoadData(nullptr, key.data(), key.size(), nullptr, 0), 0u);
+}
+
+// Test loading and storing blobs from multiple threads.
+TEST(PersistentCacheTests, ConcurrentAccesses) {
+    constexpr uint32_t kThreadCount = 8;
+    constexpr uint32_t kKeyCount = 64;
+    constexpr uint32_t kLoadsPerThread = 1000;
+
+    std::vector<PersistentCacheKey> keys;
+    for (uint32_t i = 0; i < kKeyCount; ++i) {
+        keys.push_back(MakeKey(std::to_string(i)));
+    }
+
+    ScopedFileCache fileCache;
+    PersistentCache cache(nullptr, fileCache.Get(keys), 8 * 1024);
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            for (uint32_t i = 0; i < kLoadsPerThread; ++i) {
+                uint32_t keyIndex = (t * 7 + i) % kKeyCount;
+                std::vector<uint8_t> value(100, static_cast<uint8_t>(keyIndex));
+                LoadOrStore(&cache, keys[keyIndex], value);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    PersistentCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.memoryHits + stats.platformHits + stats.misses,
+              uint64_t(kThreadCount) * kLoadsPerThread);
+    EXPECT_EQ(stats.stores, stats.misses);
+    EXPECT_LE(stats.memoryBytes, 8u * 1024u);
+}
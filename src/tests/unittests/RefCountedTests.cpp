@@ -101,6 +101,43 @@ TEST(RefCounted, RaceOnReferenceRelease) {
     EXPECT_TRUE(deleted);
 }
 
+// Test that TryReference adds a reference to live objects but not to objects being deleted.
+TEST(RefCounted, TryReference) {
+    struct TryReferenceInDestructor : public RefCounted {
+        TryReferenceInDestructor(bool* referencedInDestructor)
+            : mReferencedInDestructor(referencedInDestructor) {
+        }
+        ~TryReferenceInDestructor() override {
+            *mReferencedInDestructor = TryReference();
+        }
+
+      private:
+        bool* mReferencedInDestructor;
+    };
+
+    bool referencedInDestructor = true;
+    auto* test = new TryReferenceInDestructor(&referencedInDestructor);
+
+    EXPECT_TRUE(test->TryReference());
+    EXPECT_EQ(test->GetRefCountForTesting(), 2u);
+
+    test->Release();
+    test->Release();
+    EXPECT_FALSE(referencedInDestructor);
+}
+
+// Test that TryReference doesn't change the payload.
+TEST(RefCounted, TryReferenceKeepsPayload) {
+    auto* test = new RCTest(1);
+
+    EXPECT_TRUE(test->TryReference());
+    EXPECT_EQ(test->GetRefCountForTesting(), 2u);
+    EXPECT_EQ(test->GetRefCountPayload(), 1u);
+
+    test->Release();
+    test->Release();
+}
+
 // Test Ref remove reference when going out of scope
 TEST(Ref, EndOfScopeRemovesRef) {
     bool deleted = false;
@@ -0,0 +1,229 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "utils/RingBufferCommandTransport.h"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace utils;
+
+namespace {
+
+    // A handler that records the bytes of the commands it receives.
+    class RecordingHandler : public dawn_wire::CommandHandler {
+      public:
+        const volatile char* HandleCommands(const volatile char* commands,
+                                            size_t size) override {
+            const char* bytes = const_cast<const char*>(commands);
+            received.insert(received.end(), bytes, bytes + size);
+            handleCount++;
+            return failHandling ? nullptr : commands + size;
+        }
+
+        std::vector<char> received;
+        std::atomic<uint32_t> handleCount{0};
+        bool failHandling = false;
+    };
+
+    // Writes |size| bytes of a sequence that depends on |seed| in the transport.
+    bool WriteCommand(RingBufferCommandTransport* transport, size_t size, uint32_t seed) {
+        char* space = static_cast<char*>(transport->GetCmdSpace(size));
+        if (space == nullptr) {
+            return false;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            space[i] = static_cast<char>(seed + i);
+        }
+        return true;
+    }
+
+    void AppendExpectedCommand(std::vector<char>* expected, size_t size, uint32_t seed) {
+        for (size_t i = 0; i < size; ++i) {
+            expected->push_back(static_cast<char>(seed + i));
+        }
+    }
+
+    RingBufferCommandTransportDescriptor TransportDescriptor(size_t capacity,
+                                                             RingBufferFlushPolicy flushPolicy) {
+        RingBufferCommandTransportDescriptor descriptor;
+        descriptor.capacity = capacity;
+        descriptor.flushPolicy = flushPolicy;
+        return descriptor;
+    }
+
+}  // anonymous namespace
+
+// Test that the commands are only visible to the consumer once they are flushed.
+TEST(RingBufferCommandTransportTests, CommandsArePublishedOnFlush) {
+    RingBufferCommandTransport transport;
+    RecordingHandler handler;
+
+    ASSERT_TRUE(WriteCommand(&transport, 16, 0));
+    ASSERT_TRUE(WriteCommand(&transport, 24, 1));
+    EXPECT_FALSE(transport.HasPublishedCommands());
+    EXPECT_TRUE(transport.ConsumeCommands(&handler));
+    EXPECT_EQ(0u, handler.handleCount);
+
+    EXPECT_TRUE(transport.Flush());
+    EXPECT_TRUE(transport.HasPublishedCommands());
+    EXPECT_TRUE(transport.ConsumeCommands(&handler));
+    EXPECT_FALSE(transport.HasPublishedCommands());
+
+    // Contiguous commands are handled together.
+    EXPECT_EQ(1u, handler.handleCount);
+    std::vector<char> expected;
+    AppendExpectedCommand(&expected, 16, 0);
+    AppendExpectedCommand(&expected, 24, 1);
+    EXPECT_EQ(expected, handler.received);
+}
+
+// Test that allocations larger than the maximum allocation size fail.
+TEST(RingBufferCommandTransportTests, MaximumAllocationSize) {
+    RingBufferCommandTransport transport(
+        TransportDescriptor(1024, RingBufferFlushPolicy::Blocking));
+    EXPECT_LT(transport.GetMaximumAllocationSize(), 1024u);
+
+    EXPECT_EQ(nullptr, transport.GetCmdSpace(transport.GetMaximumAllocationSize() + 1));
+    EXPECT_NE(nullptr, transport.GetCmdSpace(transport.GetMaximumAllocationSize()));
+}
+
+// Test that commands that don't fit at the end of the ring are written at its beginning without
+// being split.
+TEST(RingBufferCommandTransportTests, Wraparound) {
+    RingBufferCommandTransport transport(
+        TransportDescriptor(1024, RingBufferFlushPolicy::NonBlocking));
+    RecordingHandler handler;
+
+    std::vector<char> expected;
+    for (uint32_t i = 0; i < 100; ++i) {
+        // Sizes that aren't aligned and don't divide the capacity so that the segments end at
+        // various offsets.
+        size_t size = 1 + (i * 37) % transport.GetMaximumAllocationSize();
+        ASSERT_TRUE(WriteCommand(&transport, size, i));
+        AppendExpectedCommand(&expected, size, i);
+
+        ASSERT_TRUE(transport.Flush());
+        size_t receivedBefore = handler.received.size();
+        ASSERT_TRUE(transport.ConsumeCommands(&handler));
+        // Each command is received in a single piece.
+        ASSERT_EQ(receivedBefore + size, handler.received.size());
+    }
+    EXPECT_EQ(expected, handler.received);
+    EXPECT_EQ(0u, transport.GetProducerWaitCount());
+}
+
+// Test that failures of the handler are reported by the next Flush().
+TEST(RingBufferCommandTransportTests, HandlerFailure) {
+    RingBufferCommandTransport transport;
+    RecordingHandler handler;
+
+    handler.failHandling = true;
+    ASSERT_TRUE(WriteCommand(&transport, 8, 0));
+    EXPECT_TRUE(transport.Flush());
+    EXPECT_FALSE(transport.ConsumeCommands(&handler));
+    EXPECT_FALSE(transport.HasPublishedCommands());
+    EXPECT_FALSE(transport.Flush());
+
+    // The failure is only reported once.
+    handler.failHandling = false;
+    ASSERT_TRUE(WriteCommand(&transport, 8, 0));
+    EXPECT_TRUE(transport.Flush());
+    EXPECT_TRUE(transport.ConsumeCommands(&handler));
+    EXPECT_TRUE(transport.Flush());
+}
+
+// Test that the producer can't allocate once the ring is full and closed.
+TEST(RingBufferCommandTransportTests, Close) {
+    RingBufferCommandTransport transport(
+        TransportDescriptor(1024, RingBufferFlushPolicy::NonBlocking));
+    RecordingHandler handler;
+
+    // The fifth command doesn't fit, which publishes the first four.
+    size_t size = transport.GetMaximumAllocationSize();
+    for (uint32_t i = 0; i < 4; ++i) {
+        ASSERT_TRUE(WriteCommand(&transport, size, i));
+    }
+    transport.Close();
+    EXPECT_EQ(nullptr, transport.GetCmdSpace(size));
+
+    // The published commands can still be consumed.
+    EXPECT_TRUE(transport.WaitForCommands());
+    EXPECT_TRUE(transport.ConsumeCommands(&handler));
+    EXPECT_EQ(4 * size, handler.received.size());
+    EXPECT_FALSE(transport.WaitForCommands());
+}
+
+// Test streaming commands to a consumer thread through a small ring, such that the producer has
+// to wait for the consumer to free space.
+TEST(RingBufferCommandTransportTests, Backpressure) {
+    RingBufferCommandTransport transport(
+        TransportDescriptor(4096, RingBufferFlushPolicy::NonBlocking));
+    RecordingHandler handler;
+
+    std::thread consumer([&transport, &handler]() {
+        while (transport.WaitForCommands()) {
+            transport.ConsumeCommands(&handler);
+        }
+    });
+
+    std::vector<char> expected;
+    for (uint32_t i = 0; i < 10000; ++i) {
+        size_t size = 1 + (i * 13) % 200;
+        ASSERT_TRUE(WriteCommand(&transport, size, i));
+        AppendExpectedCommand(&expected, size, i);
+        if (i % 64 == 0) {
+            ASSERT_TRUE(transport.Flush());
+        }
+    }
+    ASSERT_TRUE(transport.Flush());
+
+    transport.Close();
+    consumer.join();
+
+    EXPECT_EQ(expected, handler.received);
+    EXPECT_GT(transport.GetProducerWaitCount(), 0u);
+}
+
+// Test that the blocking policy makes Flush() wait until the consumer handled the commands.
+TEST(RingBufferCommandTransportTests, BlockingFlush) {
+    RingBufferCommandTransport transport(
+        TransportDescriptor(4096, RingBufferFlushPolicy::Blocking));
+    RecordingHandler handler;
+
+    std::thread consumer([&transport, &handler]() {
+        while (transport.WaitForCommands()) {
+            transport.ConsumeCommands(&handler);
+        }
+    });
+
+    size_t expectedSize = 0;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        size_t size = 1 + i % 100;
+        ASSERT_TRUE(WriteCommand(&transport, size, i));
+        expectedSize += size;
+
+        ASSERT_TRUE(transport.Flush());
+        EXPECT_FALSE(transport.HasPublishedCommands());
+        // The handler isn't used concurrently by the consumer after the flush.
+        ASSERT_EQ(expectedSize, handler.received.size());
+    }
+
+    transport.Close();
+    consumer.join();
+}
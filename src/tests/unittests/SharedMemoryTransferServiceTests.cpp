@@ -0,0 +1,165 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "utils/SharedMemoryTransferService.h"
+
+#include <cstring>
+#include <vector>
+
+using ClientReadHandle = dawn_wire::client::MemoryTransferService::ReadHandle;
+using ClientWriteHandle = dawn_wire::client::MemoryTransferService::WriteHandle;
+using ServerReadHandle = dawn_wire::server::MemoryTransferService::ReadHandle;
+using ServerWriteHandle = dawn_wire::server::MemoryTransferService::WriteHandle;
+
+class SharedMemoryTransferServiceTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        if (!utils::IsSharedMemoryTransferServiceSupported()) {
+            GTEST_SKIP();
+        }
+        mServices = utils::CreateSharedMemoryTransferServices();
+    }
+
+    template <typename Handle>
+    std::vector<uint8_t> SerializeCreate(Handle* handle) {
+        std::vector<uint8_t> serialized(handle->SerializeCreateSize());
+        handle->SerializeCreate(serialized.data());
+        return serialized;
+    }
+
+    utils::SharedMemoryTransferServices mServices;
+};
+
+// Test that the data written by the client is copied to the target of the server handle without
+// being serialized.
+TEST_F(SharedMemoryTransferServiceTests, WriteHandle) {
+    constexpr size_t kSize = 4096;
+    std::unique_ptr<ClientWriteHandle> clientHandle(mServices.client->CreateWriteHandle(kSize));
+    ASSERT_NE(clientHandle, nullptr);
+
+    std::vector<uint8_t> createInfo = SerializeCreate(clientHandle.get());
+    ServerWriteHandle* serverHandlePtr = nullptr;
+    ASSERT_TRUE(mServices.server->DeserializeWriteHandle(createInfo.data(), createInfo.size(),
+                                                         &serverHandlePtr));
+    std::unique_ptr<ServerWriteHandle> serverHandle(serverHandlePtr);
+
+    std::vector<uint8_t> target(kSize, 0);
+    serverHandle->SetTarget(target.data());
+    serverHandle->SetDataLength(kSize);
+
+    // The shared memory starts zero-initialized.
+    uint8_t* data = static_cast<uint8_t*>(clientHandle->GetData());
+    EXPECT_EQ(data[0], 0u);
+    EXPECT_EQ(data[kSize - 1], 0u);
+
+    memset(data + 256, 0x42, 512);
+    EXPECT_EQ(clientHandle->SizeOfSerializeDataUpdate(256, 512), 0u);
+    clientHandle->SerializeDataUpdate(nullptr, 256, 512);
+    ASSERT_TRUE(serverHandle->DeserializeDataUpdate(nullptr, 0, 256, 512));
+
+    EXPECT_EQ(target[255], 0u);
+    EXPECT_EQ(target[256], 0x42);
+    EXPECT_EQ(target[767], 0x42);
+    EXPECT_EQ(target[768], 0u);
+
+    // Out-of-bounds updates are rejected.
+    EXPECT_FALSE(serverHandle->DeserializeDataUpdate(nullptr, 0, kSize - 4, 8));
+}
+
+// Test that the data written by the server is visible to the client without being serialized.
+TEST_F(SharedMemoryTransferServiceTests, ReadHandle) {
+    constexpr size_t kSize = 1024;
+    std::unique_ptr<ClientReadHandle> clientHandle(mServices.client->CreateReadHandle(kSize));
+    ASSERT_NE(clientHandle, nullptr);
+
+    std::vector<uint8_t> createInfo = SerializeCreate(clientHandle.get());
+    ServerReadHandle* serverHandlePtr = nullptr;
+    ASSERT_TRUE(mServices.server->DeserializeReadHandle(createInfo.data(), createInfo.size(),
+                                                        &serverHandlePtr));
+    std::unique_ptr<ServerReadHandle> serverHandle(serverHandlePtr);
+
+    std::vector<uint8_t> source(128, 0x17);
+    EXPECT_EQ(serverHandle->SizeOfSerializeDataUpdate(64, source.size()), 0u);
+    serverHandle->SerializeDataUpdate(source.data(), 64, source.size(), nullptr);
+    ASSERT_TRUE(clientHandle->DeserializeDataUpdate(nullptr, 0, 64, source.size()));
+
+    const uint8_t* data = static_cast<const uint8_t*>(clientHandle->GetData());
+    EXPECT_EQ(data[63], 0u);
+    EXPECT_EQ(data[64], 0x17);
+    EXPECT_EQ(data[191], 0x17);
+    EXPECT_EQ(data[192], 0u);
+
+    EXPECT_FALSE(clientHandle->DeserializeDataUpdate(nullptr, 0, kSize, 1));
+}
+
+// Test that the server can open a region after the client handle is destroyed, like when a buffer
+// mapped at creation is unmapped before the server handles its creation.
+TEST_F(SharedMemoryTransferServiceTests, ClientHandleDestroyedFirst) {
+    std::vector<uint8_t> createInfo;
+    {
+        std::unique_ptr<ClientWriteHandle> clientHandle(mServices.client->CreateWriteHandle(16));
+        ASSERT_NE(clientHandle, nullptr);
+        memset(clientHandle->GetData(), 3, 16);
+        createInfo = SerializeCreate(clientHandle.get());
+    }
+
+    ServerWriteHandle* serverHandlePtr = nullptr;
+    ASSERT_TRUE(mServices.server->DeserializeWriteHandle(createInfo.data(), createInfo.size(),
+                                                         &serverHandlePtr));
+    std::unique_ptr<ServerWriteHandle> serverHandle(serverHandlePtr);
+
+    std::vector<uint8_t> target(16, 0);
+    serverHandle->SetTarget(target.data());
+    serverHandle->SetDataLength(16);
+    ASSERT_TRUE(serverHandle->DeserializeDataUpdate(nullptr, 0, 0, 16));
+    EXPECT_EQ(target, std::vector<uint8_t>(16, 3));
+}
+
+// Test that invalid or reused region descriptors are rejected by the server.
+TEST_F(SharedMemoryTransferServiceTests, InvalidDescriptors) {
+    std::unique_ptr<ClientWriteHandle> clientHandle(mServices.client->CreateWriteHandle(64));
+    ASSERT_NE(clientHandle, nullptr);
+    std::vector<uint8_t> createInfo = SerializeCreate(clientHandle.get());
+
+    ServerWriteHandle* serverHandle = nullptr;
+    EXPECT_FALSE(mServices.server->DeserializeWriteHandle(createInfo.data(),
+                                                          createInfo.size() - 1, &serverHandle));
+
+    // A descriptor claiming a larger region than the shared memory is rejected.
+    std::vector<uint8_t> largerInfo = createInfo;
+    uint64_t largerSize = 1024 * 1024;
+    memcpy(largerInfo.data() + largerInfo.size() - sizeof(uint64_t), &largerSize,
+           sizeof(largerSize));
+    EXPECT_FALSE(mServices.server->DeserializeWriteHandle(largerInfo.data(), largerInfo.size(),
+                                                          &serverHandle));
+
+    // The region was consumed by the failed attempt above, so it can't be opened anymore.
+    EXPECT_FALSE(mServices.server->DeserializeWriteHandle(createInfo.data(), createInfo.size(),
+                                                          &serverHandle));
+}
+
+// Test that zero-sized handles work.
+TEST_F(SharedMemoryTransferServiceTests, ZeroSize) {
+    std::unique_ptr<ClientWriteHandle> clientHandle(mServices.client->CreateWriteHandle(0));
+    ASSERT_NE(clientHandle, nullptr);
+    EXPECT_NE(clientHandle->GetData(), nullptr);
+
+    std::vector<uint8_t> createInfo = SerializeCreate(clientHandle.get());
+    ServerWriteHandle* serverHandlePtr = nullptr;
+    ASSERT_TRUE(mServices.server->DeserializeWriteHandle(createInfo.data(), createInfo.size(),
+                                                         &serverHandlePtr));
+    std::unique_ptr<ServerWriteHandle> serverHandle(serverHandlePtr);
+}
@@ -675,3 +675,78 @@ TEST(SubresourceStorageTest, AspectDecompressionUpdatesLayer0) {
 //  - Two != being converted to == during a rework.
 //  - (with ASSERT) that RecompressAspect didn't check that aspect 0 was compressed.
 //  - Missing decompression of layer 0 after introducing mInlineAspectData.
+
+// Calls Iterate on `range` and checks that the ranges iterateFunc is called with aggregate to
+// exactly `range`, that their data is the same as in the fake storage, and returns the number of
+// calls to iterateFunc.
+template <typename T>
+uint32_t CheckIterateRange(const SubresourceStorage<T>& s,
+                           const FakeStorage<T>& f,
+                           const SubresourceRange& range) {
+    uint32_t callCount = 0;
+    RangeTracker tracker(s);
+    s.Iterate(range, [&](const SubresourceRange& iteratedRange, const T& data) {
+        for (Aspect aspect : IterateEnumMask(iteratedRange.aspects)) {
+            for (uint32_t layer = iteratedRange.baseArrayLayer;
+                 layer < iteratedRange.baseArrayLayer + iteratedRange.layerCount; layer++) {
+                for (uint32_t level = iteratedRange.baseMipLevel;
+                     level < iteratedRange.baseMipLevel + iteratedRange.levelCount; level++) {
+                    EXPECT_EQ(data, f.Get(aspect, layer, level));
+                }
+            }
+        }
+
+        tracker.Track(iteratedRange);
+        callCount++;
+    });
+    tracker.CheckTrackedExactly(range);
+    return callCount;
+}
+
+// Test iterating over sub-ranges of a storage with compressed and decompressed aspects and layers.
+TEST(SubresourceStorageTest, IterateRange) {
+    const uint32_t kLayers = 5;
+    const uint32_t kLevels = 4;
+    const Aspect kAspects = Aspect::Depth | Aspect::Stencil;
+    SubresourceStorage<int> s(kAspects, kLayers, kLevels);
+    FakeStorage<int> f(kAspects, kLayers, kLevels);
+
+    // Decompress the stencil aspect and layers 1 to 3 of it, and the last layer of depth only at
+    // the aspect level.
+    {
+        SubresourceRange range(Aspect::Stencil, {1, 3}, {2, 1});
+        CallUpdateOnBoth(&s, &f, range, [](const SubresourceRange&, int* data) { *data = 1; });
+    }
+    {
+        SubresourceRange range(Aspect::Depth, {kLayers - 1, 1}, {0, kLevels});
+        CallUpdateOnBoth(&s, &f, range, [](const SubresourceRange&, int* data) { *data = 2; });
+    }
+    CheckAspectCompressed(s, Aspect::Depth, false);
+    CheckLayerCompressed(s, Aspect::Depth, kLayers - 1, true);
+    CheckLayerCompressed(s, Aspect::Stencil, 1, false);
+
+    // A range of a compressed aspect is iterated at once.
+    {
+        SubresourceStorage<int> compressed(kAspects, kLayers, kLevels, 3);
+        FakeStorage<int> fakeCompressed(kAspects, kLayers, kLevels, 3);
+        SubresourceRange range(kAspects, {1, 2}, {1, 3});
+        EXPECT_EQ(CheckIterateRange(compressed, fakeCompressed, range), 2u);
+    }
+
+    // Each compressed layer in the range is iterated at once.
+    {
+        SubresourceRange range(Aspect::Depth, {0, kLayers}, {1, 2});
+        EXPECT_EQ(CheckIterateRange(s, f, range), kLayers);
+    }
+
+    // Decompressed layers are iterated per level.
+    {
+        SubresourceRange range(Aspect::Stencil, {0, 2}, {1, 3});
+        EXPECT_EQ(CheckIterateRange(s, f, range), 1u + 3u);
+    }
+
+    // Single subresources and the full range.
+    CheckIterateRange(s, f, SubresourceRange::MakeSingle(Aspect::Stencil, 2, 2));
+    CheckIterateRange(s, f, SubresourceRange::MakeSingle(Aspect::Depth, kLayers - 1, 3));
+    CheckIterateRange(s, f, SubresourceRange::MakeFull(kAspects, kLayers, kLevels));
+}
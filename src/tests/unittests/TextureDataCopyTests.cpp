@@ -0,0 +1,108 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_native/TextureDataCopy.h"
+#include "dawn_platform/WorkerThread.h"
+
+#include <vector>
+
+using namespace dawn_native;
+
+namespace {
+
+    struct CopyLayout {
+        uint32_t depth;
+        uint32_t rowsPerImage;
+        uint64_t imageAdditionalStride;
+        uint32_t actualBytesPerRow;
+        uint32_t dstBytesPerRow;
+        uint32_t srcBytesPerRow;
+    };
+
+    // Copies the data with CopyTextureData and checks that the copied bytes are the same as the
+    // source and that the padding of the destination isn't written.
+    void CheckCopy(const CopyLayout& layout,
+                   dawn_platform::WorkerTaskPool* workerTaskPool = nullptr) {
+        uint64_t srcBytesPerImage =
+            uint64_t(layout.rowsPerImage) * layout.srcBytesPerRow + layout.imageAdditionalStride;
+        uint64_t dstBytesPerImage = uint64_t(layout.rowsPerImage) * layout.dstBytesPerRow;
+
+        std::vector<uint8_t> src(layout.depth * srcBytesPerImage);
+        for (size_t i = 0; i < src.size(); ++i) {
+            src[i] = static_cast<uint8_t>(i * 7 + i / 251);
+        }
+
+        constexpr uint8_t kPadding = 0xCD;
+        std::vector<uint8_t> dst(layout.depth * dstBytesPerImage, kPadding);
+
+        CopyTextureData(dst.data(), src.data(), layout.depth, layout.rowsPerImage,
+                        layout.imageAdditionalStride, layout.actualBytesPerRow,
+                        layout.dstBytesPerRow, layout.srcBytesPerRow, workerTaskPool);
+
+        for (uint32_t d = 0; d < layout.depth; ++d) {
+            for (uint32_t row = 0; row < layout.rowsPerImage; ++row) {
+                const uint8_t* srcRow =
+                    src.data() + d * srcBytesPerImage + uint64_t(row) * layout.srcBytesPerRow;
+                const uint8_t* dstRow =
+                    dst.data() + d * dstBytesPerImage + uint64_t(row) * layout.dstBytesPerRow;
+                ASSERT_EQ(memcmp(srcRow, dstRow, layout.actualBytesPerRow), 0)
+                    << "image " << d << " row " << row;
+                for (uint32_t i = layout.actualBytesPerRow; i < layout.dstBytesPerRow; ++i) {
+                    ASSERT_EQ(dstRow[i], kPadding) << "image " << d << " row " << row;
+                }
+            }
+        }
+    }
+
+}  // anonymous namespace
+
+// Test copies of tightly packed data, which are done at once or layer by layer.
+TEST(TextureDataCopyTests, TightlyPacked) {
+    CheckCopy({1, 7, 0, 256, 256, 256});
+    CheckCopy({3, 7, 0, 12, 12, 12});
+    CheckCopy({3, 7, 24, 12, 12, 12});
+}
+
+// Test copies row by row for all the sizes of rows that have specialized copies and others.
+TEST(TextureDataCopyTests, RowByRow) {
+    for (uint32_t bytesPerRow : {1u, 4u, 8u, 12u, 16u, 32u, 60u, 64u, 128u, 132u, 1000u}) {
+        SCOPED_TRACE(bytesPerRow);
+        // Padding in the destination.
+        CheckCopy({2, 5, 0, bytesPerRow, bytesPerRow + 256, bytesPerRow});
+        // Padding in the source.
+        CheckCopy({2, 5, 0, bytesPerRow, bytesPerRow, bytesPerRow + 4});
+        // Padding in both, and between source images.
+        CheckCopy({3, 5, 3 * bytesPerRow, bytesPerRow, bytesPerRow + 256, bytesPerRow + 8});
+    }
+}
+
+// Test that copying nothing doesn't touch the data.
+TEST(TextureDataCopyTests, EmptyCopy) {
+    CheckCopy({0, 5, 0, 16, 256, 16});
+    CheckCopy({2, 0, 0, 16, 256, 16});
+}
+
+// Test copies large enough to be split between the worker threads.
+TEST(TextureDataCopyTests, ParallelCopy) {
+    dawn_platform::AsyncWorkerThreadPool workerTaskPool(3);
+
+    // Rows copied one by one with images separated in the source.
+    CheckCopy({2, 2100, 12000, 4000, 4096, 4000}, &workerTaskPool);
+    // Evenly spaced rows with an image boundary in the middle of the rows of a task.
+    CheckCopy({3, 1401, 0, 4000, 4096, 4096}, &workerTaskPool);
+    // Tightly packed data.
+    CheckCopy({1, 4100, 0, 4096, 4096, 4096}, &workerTaskPool);
+}
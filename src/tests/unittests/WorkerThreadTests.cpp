@@ -0,0 +1,159 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// WorkerThreadTests:
+//     Tests for dawn_platform::AsyncWorkerThreadPool.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "dawn_platform/WorkerThread.h"
+
+namespace {
+
+    struct CounterTask {
+        std::atomic<uint32_t>* counter;
+    };
+
+    void IncrementCounter(void* userdata) {
+        CounterTask* task = static_cast<CounterTask*>(userdata);
+        task->counter->fetch_add(1);
+    }
+
+    struct RecordThreadTask {
+        std::thread::id threadId;
+    };
+
+    void RecordThread(void* userdata) {
+        static_cast<RecordThreadTask*>(userdata)->threadId = std::this_thread::get_id();
+    }
+
+}  // anonymous namespace
+
+class WorkerThreadTests : public testing::Test {};
+
+// Test that all the posted tasks are run and that their events get completed.
+TEST_F(WorkerThreadTests, AllTasksComplete) {
+    dawn_platform::AsyncWorkerThreadPool pool(4);
+
+    constexpr uint32_t kTaskCount = 1000;
+    std::atomic<uint32_t> counter(0);
+    CounterTask task = {&counter};
+
+    std::vector<std::unique_ptr<dawn_platform::WaitableEvent>> events;
+    for (uint32_t i = 0; i < kTaskCount; ++i) {
+        events.push_back(pool.PostWorkerTask(IncrementCounter, &task));
+    }
+    for (auto& event : events) {
+        event->Wait();
+        EXPECT_TRUE(event->IsComplete());
+    }
+
+    EXPECT_EQ(kTaskCount, counter.load());
+}
+
+// Test that the tasks run on a bounded number of threads that aren't the posting thread.
+TEST_F(WorkerThreadTests, BoundedThreadCount) {
+    constexpr uint32_t kWorkerThreadCount = 2;
+    dawn_platform::AsyncWorkerThreadPool pool(kWorkerThreadCount);
+    EXPECT_EQ(kWorkerThreadCount, pool.GetWorkerThreadCount());
+
+    constexpr uint32_t kTaskCount = 64;
+    std::vector<RecordThreadTask> tasks(kTaskCount);
+    std::vector<std::unique_ptr<dawn_platform::WaitableEvent>> events;
+    for (RecordThreadTask& task : tasks) {
+        events.push_back(pool.PostWorkerTask(RecordThread, &task));
+    }
+    for (auto& event : events) {
+        event->Wait();
+    }
+
+    std::set<std::thread::id> threadIds;
+    for (const RecordThreadTask& task : tasks) {
+        EXPECT_NE(std::this_thread::get_id(), task.threadId);
+        threadIds.insert(task.threadId);
+    }
+    EXPECT_LE(threadIds.size(), kWorkerThreadCount);
+}
+
+// Test posting tasks from inside a worker task.
+TEST_F(WorkerThreadTests, PostFromWorker) {
+    struct NestedTask {
+        dawn_platform::AsyncWorkerThreadPool* pool;
+        CounterTask counterTask;
+        std::unique_ptr<dawn_platform::WaitableEvent> nestedEvent;
+    };
+
+    dawn_platform::AsyncWorkerThreadPool pool(1);
+    std::atomic<uint32_t> counter(0);
+    NestedTask task = {&pool, {&counter}, nullptr};
+
+    std::unique_ptr<dawn_platform::WaitableEvent> event = pool.PostWorkerTask(
+        [](void* userdata) {
+            NestedTask* task = static_cast<NestedTask*>(userdata);
+            task->nestedEvent = task->pool->PostWorkerTask(IncrementCounter, &task->counterTask);
+        },
+        &task);
+
+    event->Wait();
+    ASSERT_NE(nullptr, task.nestedEvent);
+    task.nestedEvent->Wait();
+    EXPECT_EQ(1u, counter.load());
+}
+
+// Test that destroying the pool runs the tasks that are still queued and that the events can
+// outlive the pool.
+TEST_F(WorkerThreadTests, EventsOutlivePool) {
+    constexpr uint32_t kTaskCount = 100;
+    std::atomic<uint32_t> counter(0);
+    CounterTask task = {&counter};
+
+    std::vector<std::unique_ptr<dawn_platform::WaitableEvent>> events;
+    {
+        dawn_platform::AsyncWorkerThreadPool pool(2);
+        for (uint32_t i = 0; i < kTaskCount; ++i) {
+            events.push_back(pool.PostWorkerTask(IncrementCounter, &task));
+        }
+    }
+
+    EXPECT_EQ(kTaskCount, counter.load());
+    for (auto& event : events) {
+        EXPECT_TRUE(event->IsComplete());
+        event->Wait();
+    }
+}
+
+// Test that events are recycled correctly when they are dropped before their task completes.
+TEST_F(WorkerThreadTests, DropEventsBeforeCompletion) {
+    dawn_platform::AsyncWorkerThreadPool pool(2);
+
+    constexpr uint32_t kTaskCount = 1000;
+    std::atomic<uint32_t> counter(0);
+    CounterTask task = {&counter};
+    for (uint32_t i = 0; i < kTaskCount; ++i) {
+        pool.PostWorkerTask(IncrementCounter, &task);
+    }
+
+    std::unique_ptr<dawn_platform::WaitableEvent> last =
+        pool.PostWorkerTask(IncrementCounter, &task);
+    last->Wait();
+    while (counter.load() != kTaskCount + 1) {
+        std::this_thread::yield();
+    }
+}
@@ -136,6 +136,39 @@ TEST_F(BindGroupValidationTest, BindingSetTwice) {
     ASSERT_DEVICE_ERROR(utils::MakeBindGroup(device, layout, {{0, mSampler}, {0, mSampler}}));
 }
 
+// Check that the bindings are found whatever the order of the entries, both for layouts with
+// small binding numbers and for layouts with sparse, large binding numbers.
+TEST_F(BindGroupValidationTest, BindingNumberLookup) {
+    for (uint32_t largeBinding : {5u, 100000u}) {
+        wgpu::BindGroupLayout layout = utils::MakeBindGroupLayout(
+            device,
+            {{largeBinding, wgpu::ShaderStage::Fragment, wgpu::SamplerBindingType::Filtering},
+             {0, wgpu::ShaderStage::Fragment, wgpu::SamplerBindingType::Filtering},
+             {2, wgpu::ShaderStage::Fragment, wgpu::SamplerBindingType::Filtering}});
+
+        // Control case: the entries can be sorted by binding number or not.
+        utils::MakeBindGroup(device, layout,
+                             {{0, mSampler}, {2, mSampler}, {largeBinding, mSampler}});
+        utils::MakeBindGroup(device, layout,
+                             {{largeBinding, mSampler}, {0, mSampler}, {2, mSampler}});
+        utils::MakeBindGroup(device, layout,
+                             {{2, mSampler}, {largeBinding, mSampler}, {0, mSampler}});
+
+        // Check that bindings between, or after, the bindings of the layout are invalid.
+        ASSERT_DEVICE_ERROR(utils::MakeBindGroup(device, layout,
+                                                 {{0, mSampler}, {1, mSampler}, {2, mSampler}}));
+        ASSERT_DEVICE_ERROR(utils::MakeBindGroup(
+            device, layout, {{0, mSampler}, {2, mSampler}, {largeBinding + 1, mSampler}}));
+
+        // Check that setting the same binding twice is invalid, also when it is at its position
+        // in the sorted bindings.
+        ASSERT_DEVICE_ERROR(
+            utils::MakeBindGroup(device, layout, {{0, mSampler}, {0, mSampler}, {2, mSampler}}));
+        ASSERT_DEVICE_ERROR(
+            utils::MakeBindGroup(device, layout, {{2, mSampler}, {2, mSampler}, {0, mSampler}}));
+    }
+}
+
 // Check that a sampler binding must contain exactly one sampler
 TEST_F(BindGroupValidationTest, SamplerBindingType) {
     wgpu::BindGroupLayout layout = utils::MakeBindGroupLayout(
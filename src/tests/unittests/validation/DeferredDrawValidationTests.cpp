@@ -0,0 +1,279 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/WGPUHelpers.h"
+
+#include <functional>
+
+namespace {
+
+    constexpr uint32_t kRTSize = 4;
+    constexpr uint32_t kFloat32x4Stride = 4 * sizeof(float);
+
+    // The buffers used by the tests hold enough data for kVertexCount vertices, kInstanceCount
+    // instances and kIndexCount indices.
+    constexpr uint32_t kVertexCount = 3;
+    constexpr uint32_t kInstanceCount = 2;
+    constexpr uint32_t kIndexCount = 6;
+
+    struct TestObjects {
+        wgpu::RenderPipeline pipeline;
+        wgpu::Buffer vertexBuffer;
+        wgpu::Buffer instanceBuffer;
+        wgpu::Buffer indexBuffer;
+    };
+
+    using RecordPassFn = std::function<void(wgpu::RenderPassEncoder pass, const TestObjects&)>;
+
+    void SetObjects(wgpu::RenderPassEncoder pass, const TestObjects& objects) {
+        pass.SetPipeline(objects.pipeline);
+        pass.SetVertexBuffer(0, objects.vertexBuffer);
+        pass.SetVertexBuffer(1, objects.instanceBuffer);
+        pass.SetIndexBuffer(objects.indexBuffer, wgpu::IndexFormat::Uint32);
+    }
+
+}  // anonymous namespace
+
+// Tests that validating the draws of render passes lazily with the defer_draw_validation toggle
+// produces the same errors as validating each draw when it is recorded. The same commands are
+// recorded on |device|, which has the toggle enabled, and on a device that has it disabled.
+class DeferredDrawValidationTest : public ValidationTest {
+  protected:
+    WGPUDevice CreateTestDevice() override {
+        dawn_native::DeviceDescriptor descriptor;
+        descriptor.forceDisabledToggles.push_back("disallow_unsafe_apis");
+        descriptor.forceEnabledToggles.push_back("defer_draw_validation");
+        return adapter.CreateDevice(&descriptor);
+    }
+
+    void SetUp() override {
+        ValidationTest::SetUp();
+        ASSERT_TRUE(HasToggleEnabled("defer_draw_validation"));
+
+        dawn_native::DeviceDescriptor descriptor;
+        descriptor.forceDisabledToggles.push_back("disallow_unsafe_apis");
+        descriptor.forceDisabledToggles.push_back("defer_draw_validation");
+        mEagerDevice = RegisterDevice(adapter.CreateDevice(&descriptor));
+    }
+
+    TestObjects CreateTestObjects(const wgpu::Device& testDevice) {
+        utils::ComboRenderPipelineDescriptor descriptor;
+        descriptor.vertex.module = utils::CreateShaderModule(testDevice, R"(
+            [[stage(vertex)]] fn main([[location(0)]] pos : vec4<f32>,
+                                      [[location(1)]] offset : vec4<f32>)
+                -> [[builtin(position)]] vec4<f32> {
+                return pos + offset;
+            })");
+        descriptor.cFragment.module = utils::CreateShaderModule(testDevice, R"(
+            [[stage(fragment)]] fn main() -> [[location(0)]] vec4<f32> {
+                return vec4<f32>(0.0, 1.0, 0.0, 1.0);
+            })");
+        descriptor.vertex.bufferCount = 2;
+        descriptor.cBuffers[0].arrayStride = kFloat32x4Stride;
+        descriptor.cBuffers[0].stepMode = wgpu::VertexStepMode::Vertex;
+        descriptor.cBuffers[0].attributeCount = 1;
+        descriptor.cBuffers[0].attributes = &descriptor.cAttributes[0];
+        descriptor.cAttributes[0].shaderLocation = 0;
+        descriptor.cAttributes[0].format = wgpu::VertexFormat::Float32x4;
+        descriptor.cBuffers[1].arrayStride = kFloat32x4Stride;
+        descriptor.cBuffers[1].stepMode = wgpu::VertexStepMode::Instance;
+        descriptor.cBuffers[1].attributeCount = 1;
+        descriptor.cBuffers[1].attributes = &descriptor.cAttributes[1];
+        descriptor.cAttributes[1].shaderLocation = 1;
+        descriptor.cAttributes[1].format = wgpu::VertexFormat::Float32x4;
+
+        TestObjects objects;
+        objects.pipeline = testDevice.CreateRenderPipeline(&descriptor);
+        objects.vertexBuffer = CreateBuffer(testDevice, kVertexCount * kFloat32x4Stride,
+                                            wgpu::BufferUsage::Vertex);
+        objects.instanceBuffer = CreateBuffer(testDevice, kInstanceCount * kFloat32x4Stride,
+                                              wgpu::BufferUsage::Vertex);
+        objects.indexBuffer =
+            CreateBuffer(testDevice, kIndexCount * sizeof(uint32_t), wgpu::BufferUsage::Index);
+        return objects;
+    }
+
+    // Records the commands of |recordPass| in a render pass of |testDevice| and returns the
+    // message of the validation error they produce, or an empty string.
+    std::string GetEncodingError(const wgpu::Device& testDevice,
+                                 const RecordPassFn& recordPass,
+                                 bool endPass) {
+        TestObjects objects = CreateTestObjects(testDevice);
+        utils::BasicRenderPass renderPass =
+            utils::CreateBasicRenderPass(testDevice, kRTSize, kRTSize);
+
+        testDevice.PushErrorScope(wgpu::ErrorFilter::Validation);
+        {
+            wgpu::CommandEncoder encoder = testDevice.CreateCommandEncoder();
+            wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+            recordPass(pass, objects);
+            if (endPass) {
+                pass.EndPass();
+            }
+            encoder.Finish();
+        }
+
+        std::string message;
+        testDevice.PopErrorScope(
+            [](WGPUErrorType, const char* message, void* userdata) {
+                *static_cast<std::string*>(userdata) = message != nullptr ? message : "";
+            },
+            &message);
+        FlushWire();
+        return message;
+    }
+
+    void ExpectSameError(const RecordPassFn& recordPass, bool endPass = true) {
+        std::string eagerError = GetEncodingError(mEagerDevice, recordPass, endPass);
+        std::string deferredError = GetEncodingError(device, recordPass, endPass);
+        EXPECT_NE(eagerError, "");
+        EXPECT_EQ(eagerError, deferredError);
+    }
+
+    void ExpectNoError(const RecordPassFn& recordPass) {
+        EXPECT_EQ(GetEncodingError(mEagerDevice, recordPass, true), "");
+        EXPECT_EQ(GetEncodingError(device, recordPass, true), "");
+    }
+
+  private:
+    static wgpu::Buffer CreateBuffer(const wgpu::Device& testDevice,
+                                     uint64_t size,
+                                     wgpu::BufferUsage usage) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = size;
+        descriptor.usage = usage;
+        return testDevice.CreateBuffer(&descriptor);
+    }
+
+    wgpu::Device mEagerDevice;
+};
+
+// Control case: valid draws spread over several state changes don't produce errors.
+TEST_F(DeferredDrawValidationTest, ValidDraws) {
+    ExpectNoError([](wgpu::RenderPassEncoder pass, const TestObjects& objects) {
+        SetObjects(pass, objects);
+        for (uint32_t i = 0; i < 10; ++i) {
+            pass.Draw(kVertexCount, kInstanceCount);
+            pass.Draw(1, 1, kVertexCount - 1, kInstanceCount - 1);
+            pass.DrawIndexed(kIndexCount, kInstanceCount);
+            pass.DrawIndexed(1, 1, kIndexCount - 1, -5, kInstanceCount - 1);
+            pass.SetVertexBuffer(1, objects.instanceBuffer);
+        }
+    });
+}
+
+// Test draws without a pipeline or without an index buffer.
+TEST_F(DeferredDrawValidationTest, MissingState) {
+    ExpectSameError([](wgpu::RenderPassEncoder pass, const TestObjects&) { pass.Draw(1); });
+
+    ExpectSameError([](wgpu::RenderPassEncoder pass, const TestObjects& objects) {
+        pass.SetPipeline(objects.pipeline);
+        pass.SetVertexBuffer(0, objects.vertexBuffer);
+        pass.SetVertexBuffer(1, objects.instanceBuffer);
+        pass.Draw(1);
+        pass.DrawIndexed(1);
+    });
+}
+
+// Test that the error of the first invalid draw is produced when several draws made with the
+// same state are out of bounds.
+TEST_F(DeferredDrawValidationTest, FirstOutOfBoundsDraw) {
+    // The vertex range then the instance range is out of bounds.
+    ExpectSameError([](wgpu::RenderPassEncoder pass, const TestObjects& objects) {
+        SetObjects(pass, objects);
+        pass.Draw(kVertexCount);
+        pass.Draw(kVertexCount, 1, 1);
+        pass.Draw(1, kInstanceCount + 1);
+        pass.SetPipeline(objects.pipeline);
+    });
+
+    // The instance range then the vertex range is out of bounds.
+    ExpectSameError([](wgpu::RenderPassEncoder pass, const TestObjects& objects) {
+        SetObjects(pass, objects);
+        pass.Draw(1, kInstanceCount, 0, 1);
+        pass.Draw(kVertexCount + 1);
+    });
+
+    // The index range is out of bounds after a valid non-indexed draw.
+    ExpectSameError([](wgpu::RenderPassEncoder pass, const TestObjects& objects) {
+        SetObjects(pass, objects);
+        pass.Draw(kVertexCount, kInstanceCount);
+        pass.DrawIndexed(kIndexCount);
+        pass.DrawIndexed(1, 1, kIndexCount);
+        pass.Draw(kVertexCount + 1);
+    });
+}
+
+// Test that the error of an invalid draw is produced before the errors of the commands recorded
+// after it.
+TEST_F(DeferredDrawValidationTest, DrawErrorBeforeLaterErrors) {
+    // An error in a state change.
+    ExpectSameError([](wgpu::RenderPassEncoder pass, const TestObjects& objects) {
+        SetObjects(pass, objects);
+        pass.Draw(kVertexCount + 1);
+        pass.SetVertexBuffer(0, objects.indexBuffer);
+    });
+
+    // An error in a command that doesn't change the state of the draws.
+    ExpectSameError([](wgpu::RenderPassEncoder pass, const TestObjects& objects) {
+        SetObjects(pass, objects);
+        pass.DrawIndexed(kIndexCount + 1);
+        pass.SetScissorRect(0, 0, kRTSize + 1, kRTSize + 1);
+    });
+
+    // An error when ending the pass.
+    ExpectSameError([](wgpu::RenderPassEncoder pass, const TestObjects& objects) {
+        SetObjects(pass, objects);
+        pass.Draw(1, kInstanceCount + 1);
+        pass.PopDebugGroup();
+    });
+
+    // The draws are validated before the state is reset by ExecuteBundles.
+    ExpectSameError([](wgpu::RenderPassEncoder pass, const TestObjects& objects) {
+        SetObjects(pass, objects);
+        pass.Draw(kVertexCount + 1);
+        pass.ExecuteBundles(0, nullptr);
+        pass.Draw(1);
+    });
+}
+
+// Test that the error of an invalid draw is produced when the pass isn't ended.
+TEST_F(DeferredDrawValidationTest, PassNotEnded) {
+    ExpectSameError(
+        [](wgpu::RenderPassEncoder pass, const TestObjects& objects) {
+            SetObjects(pass, objects);
+            pass.Draw(kVertexCount + 1);
+        },
+        false);
+}
+
+// Test that releasing a pass that isn't ended after Finish doesn't validate the draws recorded
+// after an error, which would produce a second error.
+TEST_F(DeferredDrawValidationTest, ReleasePassAfterFinishWithError) {
+    TestObjects objects = CreateTestObjects(device);
+    utils::BasicRenderPass renderPass = utils::CreateBasicRenderPass(device, kRTSize, kRTSize);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+    SetObjects(pass, objects);
+    pass.SetScissorRect(0, 0, kRTSize + 1, kRTSize + 1);
+    pass.Draw(kVertexCount + 1);
+    ASSERT_DEVICE_ERROR(encoder.Finish());
+
+    pass = nullptr;
+    FlushWire();
+}
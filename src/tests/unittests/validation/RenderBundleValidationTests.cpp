@@ -684,6 +684,18 @@ TEST_F(RenderBundleValidationTest, UsageTracking) {
         ASSERT_DEVICE_ERROR(commandEncoder.Finish());
     }
 
+    // The usage of a render bundle that is executed again in the pass is still merged with the
+    // usage of the other render bundles.
+    {
+        wgpu::CommandEncoder commandEncoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = commandEncoder.BeginRenderPass(&renderPass);
+        pass.ExecuteBundles(1, &renderBundle0);
+        pass.ExecuteBundles(1, &renderBundle0);
+        pass.ExecuteBundles(1, &renderBundle1);
+        pass.EndPass();
+        ASSERT_DEVICE_ERROR(commandEncoder.Finish());
+    }
+
     // |vertexStorageBuffer| is used as both read and write usage. This is invalid.
     // The render pass uses |vertexStorageBuffer| as a storage buffer.
     // renderBundle1 uses |vertexStorageBuffer| as a vertex buffer.
@@ -0,0 +1,247 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_native/vulkan/BatchedBarriers.h"
+#include "dawn_native/vulkan/VulkanFunctions.h"
+
+#include <vector>
+
+namespace dawn_native { namespace vulkan {
+
+    namespace {
+
+        template <typename T>
+        T MakeHandle(uint64_t value) {
+            return T::CreateFromHandle(
+                NativeNonDispatachableHandleFromU64<decltype(T().GetHandle())>(value));
+        }
+
+        // A vkCmdPipelineBarrier call recorded by the stub.
+        struct RecordedBarrier {
+            VkPipelineStageFlags srcStages;
+            VkPipelineStageFlags dstStages;
+            uint32_t bufferBarrierCount;
+            uint32_t imageBarrierCount;
+        };
+        std::vector<RecordedBarrier>* sRecordedBarriers = nullptr;
+
+        VKAPI_ATTR void VKAPI_CALL
+        StubCmdPipelineBarrier(::VkCommandBuffer,
+                               VkPipelineStageFlags srcStageMask,
+                               VkPipelineStageFlags dstStageMask,
+                               VkDependencyFlags,
+                               uint32_t,
+                               const VkMemoryBarrier*,
+                               uint32_t bufferMemoryBarrierCount,
+                               const VkBufferMemoryBarrier*,
+                               uint32_t imageMemoryBarrierCount,
+                               const VkImageMemoryBarrier*) {
+            sRecordedBarriers->push_back({srcStageMask, dstStageMask, bufferMemoryBarrierCount,
+                                          imageMemoryBarrierCount});
+        }
+
+        SubresourceRange MakeRange(Aspect aspects,
+                                   uint32_t baseMipLevel,
+                                   uint32_t levelCount,
+                                   uint32_t baseArrayLayer,
+                                   uint32_t layerCount) {
+            SubresourceRange range;
+            range.aspects = aspects;
+            range.baseMipLevel = baseMipLevel;
+            range.levelCount = levelCount;
+            range.baseArrayLayer = baseArrayLayer;
+            range.layerCount = layerCount;
+            return range;
+        }
+
+        VkBufferMemoryBarrier BufferBarrier(uint64_t buffer) {
+            VkBufferMemoryBarrier barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            barrier.buffer = MakeHandle<VkBuffer>(buffer).GetHandle();
+            return barrier;
+        }
+
+        VkImageMemoryBarrier ImageBarrier(uint64_t image) {
+            VkImageMemoryBarrier barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.image = MakeHandle<VkImage>(image).GetHandle();
+            return barrier;
+        }
+
+    }  // anonymous namespace
+
+    class BatchedBarriersTests : public testing::Test {
+      protected:
+        void SetUp() override {
+            sRecordedBarriers = &mRecordedBarriers;
+            mFunctions.CmdPipelineBarrier = StubCmdPipelineBarrier;
+        }
+
+        void TearDown() override {
+            sRecordedBarriers = nullptr;
+        }
+
+        std::vector<RecordedBarrier> mRecordedBarriers;
+        VulkanFunctions mFunctions;
+    };
+
+    // Test that no pipeline barrier is recorded when there are no barriers.
+    TEST_F(BatchedBarriersTests, EmptyRecordsNothing) {
+        BatchedBarriers barriers;
+        EXPECT_TRUE(barriers.IsEmpty());
+        barriers.Record(mFunctions, VK_NULL_HANDLE);
+        EXPECT_TRUE(mRecordedBarriers.empty());
+    }
+
+    // Test that the barriers of several resources are recorded with a single pipeline barrier
+    // that waits on all their stages, and that the batch is cleared after it.
+    TEST_F(BatchedBarriersTests, SinglePipelineBarrier) {
+        BatchedBarriers barriers;
+        barriers.bufferBarriers.push_back(BufferBarrier(1));
+        barriers.bufferBarriers.push_back(BufferBarrier(2));
+        barriers.imageBarriers.push_back(ImageBarrier(3));
+        barriers.srcStages |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+        barriers.srcStages |= VK_PIPELINE_STAGE_HOST_BIT;
+        barriers.dstStages |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+        EXPECT_FALSE(barriers.IsEmpty());
+
+        barriers.Record(mFunctions, VK_NULL_HANDLE);
+
+        ASSERT_EQ(mRecordedBarriers.size(), 1u);
+        EXPECT_EQ(mRecordedBarriers[0].srcStages,
+                  VkPipelineStageFlags(VK_PIPELINE_STAGE_TRANSFER_BIT) |
+                      VkPipelineStageFlags(VK_PIPELINE_STAGE_HOST_BIT));
+        EXPECT_EQ(mRecordedBarriers[0].dstStages,
+                  VkPipelineStageFlags(VK_PIPELINE_STAGE_TRANSFER_BIT));
+        EXPECT_EQ(mRecordedBarriers[0].bufferBarrierCount, 2u);
+        EXPECT_EQ(mRecordedBarriers[0].imageBarrierCount, 1u);
+
+        EXPECT_TRUE(barriers.IsEmpty());
+        EXPECT_EQ(barriers.srcStages, 0u);
+        EXPECT_EQ(barriers.dstStages, 0u);
+        barriers.Record(mFunctions, VK_NULL_HANDLE);
+        EXPECT_EQ(mRecordedBarriers.size(), 1u);
+    }
+
+    // Simulate the batching of RecordTransfers: the barriers of copies that don't depend on each
+    // other are recorded once, and a new pipeline barrier is recorded before a copy that depends
+    // on the previous ones.
+    TEST_F(BatchedBarriersTests, TransferBatches) {
+        struct Copy {
+            uint64_t src;
+            uint64_t dst;
+        };
+        // Uploads from a staging buffer to distinct buffers, then a copy reading one of the
+        // uploaded buffers.
+        std::vector<Copy> copies = {{1, 10}, {1, 11}, {1, 12}, {1, 13}, {11, 20}, {12, 21}};
+
+        TransferBatchTracker tracker;
+        BatchedBarriers barriers;
+        for (const Copy& copy : copies) {
+            VkBuffer src = MakeHandle<VkBuffer>(copy.src);
+            VkBuffer dst = MakeHandle<VkBuffer>(copy.dst);
+            if (!tracker.CanUseBuffer(src, false) || !tracker.CanUseBuffer(dst, true)) {
+                barriers.Record(mFunctions, VK_NULL_HANDLE);
+                tracker.Reset();
+            }
+            tracker.UseBuffer(src, false);
+            tracker.UseBuffer(dst, true);
+
+            barriers.bufferBarriers.push_back(BufferBarrier(copy.dst));
+            barriers.srcStages |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+            barriers.dstStages |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+        }
+        barriers.Record(mFunctions, VK_NULL_HANDLE);
+
+        ASSERT_EQ(mRecordedBarriers.size(), 2u);
+        EXPECT_EQ(mRecordedBarriers[0].bufferBarrierCount, 4u);
+        EXPECT_EQ(mRecordedBarriers[1].bufferBarrierCount, 2u);
+    }
+
+    class TransferBatchTrackerTests : public testing::Test {};
+
+    // Test the buffer uses that can be in the same batch.
+    TEST_F(TransferBatchTrackerTests, Buffers) {
+        VkBuffer a = MakeHandle<VkBuffer>(1);
+        VkBuffer b = MakeHandle<VkBuffer>(2);
+
+        TransferBatchTracker tracker;
+        EXPECT_TRUE(tracker.IsEmpty());
+        EXPECT_TRUE(tracker.CanUseBuffer(a, true));
+
+        // Several reads of the same buffer.
+        tracker.UseBuffer(a, false);
+        EXPECT_FALSE(tracker.IsEmpty());
+        EXPECT_TRUE(tracker.CanUseBuffer(a, false));
+        tracker.UseBuffer(a, false);
+
+        // A write after a read.
+        EXPECT_FALSE(tracker.CanUseBuffer(a, true));
+
+        // Other buffers aren't affected.
+        EXPECT_TRUE(tracker.CanUseBuffer(b, true));
+        tracker.UseBuffer(b, true);
+
+        // A read or a write after a write.
+        EXPECT_FALSE(tracker.CanUseBuffer(b, false));
+        EXPECT_FALSE(tracker.CanUseBuffer(b, true));
+
+        tracker.Reset();
+        EXPECT_TRUE(tracker.IsEmpty());
+        EXPECT_TRUE(tracker.CanUseBuffer(a, true));
+        EXPECT_TRUE(tracker.CanUseBuffer(b, false));
+    }
+
+    // Test that texture uses only conflict when their subresources overlap.
+    TEST_F(TransferBatchTrackerTests, TextureSubresources) {
+        VkImage image = MakeHandle<VkImage>(1);
+        VkImage otherImage = MakeHandle<VkImage>(2);
+
+        TransferBatchTracker tracker;
+        // Write mip level 1 of layers 2 and 3.
+        tracker.UseTexture(image, MakeRange(Aspect::Color, 1, 1, 2, 2), true);
+
+        // Other mip levels and layers can be written.
+        EXPECT_TRUE(tracker.CanUseTexture(image, MakeRange(Aspect::Color, 0, 1, 2, 2), true));
+        EXPECT_TRUE(tracker.CanUseTexture(image, MakeRange(Aspect::Color, 2, 3, 0, 6), true));
+        EXPECT_TRUE(tracker.CanUseTexture(image, MakeRange(Aspect::Color, 1, 1, 0, 2), true));
+        EXPECT_TRUE(tracker.CanUseTexture(image, MakeRange(Aspect::Color, 1, 1, 4, 1), false));
+
+        // Overlapping ranges can't be read or written.
+        EXPECT_FALSE(tracker.CanUseTexture(image, MakeRange(Aspect::Color, 1, 1, 3, 1), false));
+        EXPECT_FALSE(tracker.CanUseTexture(image, MakeRange(Aspect::Color, 0, 2, 0, 3), true));
+
+        // Other textures aren't affected.
+        EXPECT_TRUE(tracker.CanUseTexture(otherImage, MakeRange(Aspect::Color, 1, 1, 2, 2), true));
+
+        // Reads of the same subresources don't conflict, but writing them does.
+        tracker.UseTexture(image, MakeRange(Aspect::Color, 0, 1, 0, 1), false);
+        EXPECT_TRUE(tracker.CanUseTexture(image, MakeRange(Aspect::Color, 0, 1, 0, 1), false));
+        EXPECT_FALSE(tracker.CanUseTexture(image, MakeRange(Aspect::Color, 0, 1, 0, 1), true));
+    }
+
+    // Test that the aspects of texture uses are taken into account.
+    TEST_F(TransferBatchTrackerTests, TextureAspects) {
+        VkImage image = MakeHandle<VkImage>(1);
+
+        TransferBatchTracker tracker;
+        tracker.UseTexture(image, MakeRange(Aspect::Plane0, 0, 1, 0, 1), true);
+        EXPECT_TRUE(tracker.CanUseTexture(image, MakeRange(Aspect::Plane1, 0, 1, 0, 1), true));
+        EXPECT_FALSE(tracker.CanUseTexture(
+            image, MakeRange(Aspect::Plane0 | Aspect::Plane1, 0, 1, 0, 1), false));
+    }
+
+}}  // namespace dawn_native::vulkan
@@ -0,0 +1,248 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_native/vulkan/DescriptorSetUpdater.h"
+#include "dawn_native/vulkan/VulkanFunctions.h"
+
+#include <vector>
+
+namespace dawn_native { namespace vulkan {
+
+    namespace {
+
+        template <typename T>
+        T MakeHandle(uint64_t value) {
+            return T::CreateFromHandle(
+                NativeNonDispatachableHandleFromU64<decltype(T().GetHandle())>(value));
+        }
+
+        // The calls recorded by the stubbed functions.
+        struct RecordedCalls {
+            // vkCreateDescriptorUpdateTemplate
+            std::vector<VkDescriptorUpdateTemplateEntry> templateEntries;
+            VkDescriptorUpdateTemplateCreateInfo templateCreateInfo = {};
+            uint32_t createdTemplates = 0;
+            uint32_t destroyedTemplates = 0;
+
+            // vkUpdateDescriptorSetWithTemplate
+            uint32_t templateUpdates = 0;
+            const void* templateUpdateData = nullptr;
+
+            // vkUpdateDescriptorSets
+            uint32_t updates = 0;
+            std::vector<VkWriteDescriptorSet> writes;
+        };
+        RecordedCalls* sRecordedCalls = nullptr;
+
+        constexpr uint64_t kTemplateHandle = 42;
+
+        VKAPI_ATTR ::VkResult VKAPI_CALL
+        StubCreateDescriptorUpdateTemplate(::VkDevice,
+                                           const VkDescriptorUpdateTemplateCreateInfo* createInfo,
+                                           const VkAllocationCallbacks*,
+                                           ::VkDescriptorUpdateTemplate* updateTemplate) {
+            sRecordedCalls->createdTemplates++;
+            sRecordedCalls->templateCreateInfo = *createInfo;
+            sRecordedCalls->templateEntries.assign(
+                createInfo->pDescriptorUpdateEntries,
+                createInfo->pDescriptorUpdateEntries + createInfo->descriptorUpdateEntryCount);
+            sRecordedCalls->templateCreateInfo.pDescriptorUpdateEntries = nullptr;
+            *updateTemplate = MakeHandle<VkDescriptorUpdateTemplate>(kTemplateHandle).GetHandle();
+            return VK_SUCCESS;
+        }
+
+        VKAPI_ATTR void VKAPI_CALL
+        StubDestroyDescriptorUpdateTemplate(::VkDevice,
+                                            ::VkDescriptorUpdateTemplate updateTemplate,
+                                            const VkAllocationCallbacks*) {
+            EXPECT_EQ(updateTemplate,
+                      MakeHandle<VkDescriptorUpdateTemplate>(kTemplateHandle).GetHandle());
+            sRecordedCalls->destroyedTemplates++;
+        }
+
+        VKAPI_ATTR void VKAPI_CALL
+        StubUpdateDescriptorSetWithTemplate(::VkDevice,
+                                            ::VkDescriptorSet,
+                                            ::VkDescriptorUpdateTemplate updateTemplate,
+                                            const void* data) {
+            EXPECT_EQ(updateTemplate,
+                      MakeHandle<VkDescriptorUpdateTemplate>(kTemplateHandle).GetHandle());
+            sRecordedCalls->templateUpdates++;
+            sRecordedCalls->templateUpdateData = data;
+        }
+
+        VKAPI_ATTR void VKAPI_CALL StubUpdateDescriptorSets(::VkDevice,
+                                                            uint32_t writeCount,
+                                                            const VkWriteDescriptorSet* writes,
+                                                            uint32_t,
+                                                            const VkCopyDescriptorSet*) {
+            sRecordedCalls->updates++;
+            sRecordedCalls->writes.assign(writes, writes + writeCount);
+        }
+
+    }  // anonymous namespace
+
+    class DescriptorSetUpdaterTests : public testing::Test {
+      protected:
+        void SetUp() override {
+            sRecordedCalls = &mRecordedCalls;
+            mFunctions.CreateDescriptorUpdateTemplate = StubCreateDescriptorUpdateTemplate;
+            mFunctions.DestroyDescriptorUpdateTemplate = StubDestroyDescriptorUpdateTemplate;
+            mFunctions.UpdateDescriptorSetWithTemplate = StubUpdateDescriptorSetWithTemplate;
+            mFunctions.UpdateDescriptorSets = StubUpdateDescriptorSets;
+        }
+
+        void TearDown() override {
+            sRecordedCalls = nullptr;
+        }
+
+        std::unique_ptr<DescriptorSetUpdater> CreateUpdater(bool useUpdateTemplate) {
+            ResultOrError<std::unique_ptr<DescriptorSetUpdater>> result =
+                DescriptorSetUpdater::Create(&mFunctions, VK_NULL_HANDLE, mLayout, mTypes,
+                                             useUpdateTemplate);
+            EXPECT_TRUE(result.IsSuccess());
+            return result.AcquireSuccess();
+        }
+
+        // Returns valid descriptors for the bindings of mTypes.
+        std::vector<DescriptorInfo> MakeDescriptors() {
+            std::vector<DescriptorInfo> descriptors(mTypes.size());
+            descriptors[0].buffer.buffer = MakeHandle<VkBuffer>(1).GetHandle();
+            descriptors[0].buffer.offset = 256;
+            descriptors[0].buffer.range = 64;
+            descriptors[1].image.sampler = MakeHandle<VkSampler>(2).GetHandle();
+            descriptors[2].image.imageView = MakeHandle<VkImageView>(3).GetHandle();
+            descriptors[2].image.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            descriptors[3].buffer.buffer = MakeHandle<VkBuffer>(4).GetHandle();
+            descriptors[4].image.imageView = MakeHandle<VkImageView>(5).GetHandle();
+            descriptors[4].image.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+            return descriptors;
+        }
+
+        const std::vector<VkDescriptorType> mTypes = {
+            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_DESCRIPTOR_TYPE_SAMPLER,
+            VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
+            VK_DESCRIPTOR_TYPE_STORAGE_IMAGE};
+        const VkDescriptorSetLayout mLayout = MakeHandle<VkDescriptorSetLayout>(7);
+        const VkDescriptorSet mSet = MakeHandle<VkDescriptorSet>(8);
+
+        RecordedCalls mRecordedCalls;
+        VulkanFunctions mFunctions;
+    };
+
+    // Test that the template has one entry per binding reading the packed array of DescriptorInfo,
+    // and that it is destroyed with the updater.
+    TEST_F(DescriptorSetUpdaterTests, TemplateLayout) {
+        std::unique_ptr<DescriptorSetUpdater> updater = CreateUpdater(true);
+        EXPECT_EQ(mRecordedCalls.createdTemplates, 1u);
+        EXPECT_NE(updater->GetUpdateTemplate(), VK_NULL_HANDLE);
+
+        const VkDescriptorUpdateTemplateCreateInfo& createInfo = mRecordedCalls.templateCreateInfo;
+        EXPECT_EQ(createInfo.sType, VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO);
+        EXPECT_EQ(createInfo.templateType, VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET);
+        EXPECT_EQ(createInfo.descriptorSetLayout, mLayout.GetHandle());
+        EXPECT_EQ(createInfo.descriptorUpdateEntryCount, mTypes.size());
+
+        ASSERT_EQ(mRecordedCalls.templateEntries.size(), mTypes.size());
+        for (uint32_t i = 0; i < mTypes.size(); ++i) {
+            const VkDescriptorUpdateTemplateEntry& entry = mRecordedCalls.templateEntries[i];
+            EXPECT_EQ(entry.dstBinding, i);
+            EXPECT_EQ(entry.dstArrayElement, 0u);
+            EXPECT_EQ(entry.descriptorCount, 1u);
+            EXPECT_EQ(entry.descriptorType, mTypes[i]);
+            EXPECT_EQ(entry.offset, i * sizeof(DescriptorInfo));
+            EXPECT_EQ(entry.stride, sizeof(DescriptorInfo));
+        }
+
+        updater = nullptr;
+        EXPECT_EQ(mRecordedCalls.destroyedTemplates, 1u);
+    }
+
+    // Test that descriptor sets are updated with a single template update reading the packed
+    // array directly.
+    TEST_F(DescriptorSetUpdaterTests, UpdateWithTemplate) {
+        std::unique_ptr<DescriptorSetUpdater> updater = CreateUpdater(true);
+        std::vector<DescriptorInfo> descriptors = MakeDescriptors();
+
+        updater->Update(mSet, descriptors.data());
+        updater->Update(mSet, descriptors.data());
+
+        EXPECT_EQ(mRecordedCalls.templateUpdates, 2u);
+        EXPECT_EQ(mRecordedCalls.templateUpdateData, descriptors.data());
+        EXPECT_EQ(mRecordedCalls.updates, 0u);
+    }
+
+    // Test that the writes used without templates match the template entries.
+    TEST_F(DescriptorSetUpdaterTests, UpdateWithoutTemplate) {
+        std::unique_ptr<DescriptorSetUpdater> updater = CreateUpdater(false);
+        EXPECT_EQ(mRecordedCalls.createdTemplates, 0u);
+        EXPECT_EQ(updater->GetUpdateTemplate(), VK_NULL_HANDLE);
+
+        std::vector<DescriptorInfo> descriptors = MakeDescriptors();
+        updater->Update(mSet, descriptors.data());
+
+        EXPECT_EQ(mRecordedCalls.templateUpdates, 0u);
+        EXPECT_EQ(mRecordedCalls.updates, 1u);
+        ASSERT_EQ(mRecordedCalls.writes.size(), mTypes.size());
+        for (uint32_t i = 0; i < mTypes.size(); ++i) {
+            const VkWriteDescriptorSet& write = mRecordedCalls.writes[i];
+            EXPECT_EQ(write.dstSet, mSet.GetHandle());
+            EXPECT_EQ(write.dstBinding, i);
+            EXPECT_EQ(write.descriptorCount, 1u);
+            EXPECT_EQ(write.descriptorType, mTypes[i]);
+        }
+        EXPECT_EQ(mRecordedCalls.writes[0].pBufferInfo, &descriptors[0].buffer);
+        EXPECT_EQ(mRecordedCalls.writes[1].pImageInfo, &descriptors[1].image);
+        EXPECT_EQ(mRecordedCalls.writes[2].pImageInfo, &descriptors[2].image);
+        EXPECT_EQ(mRecordedCalls.writes[3].pBufferInfo, &descriptors[3].buffer);
+        EXPECT_EQ(mRecordedCalls.writes[4].pImageInfo, &descriptors[4].image);
+    }
+
+    // Test that the descriptors of destroyed resources are skipped, which isn't possible with the
+    // template.
+    TEST_F(DescriptorSetUpdaterTests, SkipDestroyedResources) {
+        std::unique_ptr<DescriptorSetUpdater> updater = CreateUpdater(true);
+        std::vector<DescriptorInfo> descriptors = MakeDescriptors();
+        descriptors[0].buffer.buffer = VK_NULL_HANDLE;
+        descriptors[4].image.imageView = VK_NULL_HANDLE;
+
+        updater->Update(mSet, descriptors.data());
+
+        EXPECT_EQ(mRecordedCalls.templateUpdates, 0u);
+        EXPECT_EQ(mRecordedCalls.updates, 1u);
+        ASSERT_EQ(mRecordedCalls.writes.size(), 3u);
+        EXPECT_EQ(mRecordedCalls.writes[0].dstBinding, 1u);
+        EXPECT_EQ(mRecordedCalls.writes[1].dstBinding, 2u);
+        EXPECT_EQ(mRecordedCalls.writes[2].dstBinding, 3u);
+    }
+
+    // Test that no template is created for empty layouts since they have nothing to update.
+    TEST_F(DescriptorSetUpdaterTests, EmptyLayout) {
+        ResultOrError<std::unique_ptr<DescriptorSetUpdater>> result =
+            DescriptorSetUpdater::Create(&mFunctions, VK_NULL_HANDLE, mLayout, {}, true);
+        ASSERT_TRUE(result.IsSuccess());
+        std::unique_ptr<DescriptorSetUpdater> updater = result.AcquireSuccess();
+        EXPECT_EQ(mRecordedCalls.createdTemplates, 0u);
+
+        updater->Update(mSet, nullptr);
+        EXPECT_EQ(mRecordedCalls.templateUpdates, 0u);
+        EXPECT_EQ(mRecordedCalls.updates, 0u);
+
+        updater = nullptr;
+        EXPECT_EQ(mRecordedCalls.destroyedTemplates, 0u);
+    }
+
+}}  // namespace dawn_native::vulkan
@@ -0,0 +1,276 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_native/vulkan/FramebufferCache.h"
+#include "dawn_native/vulkan/VulkanFunctions.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace dawn_native { namespace vulkan {
+
+    namespace {
+
+        template <typename T>
+        T MakeHandle(uint64_t value) {
+            return T::CreateFromHandle(
+                NativeNonDispatachableHandleFromU64<decltype(T().GetHandle())>(value));
+        }
+
+        // The state of the stubbed Vulkan entry points, they can't capture the test fixture.
+        struct StubState {
+            std::vector<VkFramebufferCreateInfo> createInfos;
+            std::vector<std::vector<::VkImageView>> createdAttachments;
+            std::vector<::VkFramebuffer> destroyed;
+            uint64_t nextHandle = 1;
+            ::VkResult createResult = VK_SUCCESS;
+        };
+        StubState* sStubState = nullptr;
+
+        VKAPI_ATTR ::VkResult VKAPI_CALL StubCreateFramebuffer(::VkDevice,
+                                                              const VkFramebufferCreateInfo* info,
+                                                              const VkAllocationCallbacks*,
+                                                              ::VkFramebuffer* framebuffer) {
+            if (sStubState->createResult != VK_SUCCESS) {
+                return sStubState->createResult;
+            }
+            sStubState->createInfos.push_back(*info);
+            sStubState->createdAttachments.emplace_back(
+                info->pAttachments, info->pAttachments + info->attachmentCount);
+            *framebuffer =
+                NativeNonDispatachableHandleFromU64<::VkFramebuffer>(sStubState->nextHandle++);
+            return VK_SUCCESS;
+        }
+
+        VKAPI_ATTR void VKAPI_CALL StubDestroyFramebuffer(::VkDevice,
+                                                          ::VkFramebuffer framebuffer,
+                                                          const VkAllocationCallbacks*) {
+            sStubState->destroyed.push_back(framebuffer);
+        }
+
+    }  // anonymous namespace
+
+    // Tests the FramebufferCache with Vulkan entry points that hand out fake handles so that no
+    // GPU is needed.
+    class FramebufferCacheTests : public testing::Test {
+      protected:
+        void SetUp() override {
+            sStubState = &mStubState;
+            mFunctions.CreateFramebuffer = StubCreateFramebuffer;
+            mFunctions.DestroyFramebuffer = StubDestroyFramebuffer;
+            mCache = std::make_unique<FramebufferCache>(
+                &mFunctions, VK_NULL_HANDLE,
+                [this](VkFramebuffer framebuffer) { mDeletedWhenUnused.push_back(framebuffer); });
+        }
+
+        void TearDown() override {
+            mCache = nullptr;
+            sStubState = nullptr;
+        }
+
+        FramebufferCacheQuery MakeQuery(uint64_t renderPass,
+                                        std::vector<uint64_t> views,
+                                        uint32_t width = 16,
+                                        uint32_t height = 16) {
+            FramebufferCacheQuery query;
+            query.SetRenderPass(MakeHandle<VkRenderPass>(renderPass), width, height);
+            for (uint64_t view : views) {
+                query.AddAttachment(MakeHandle<VkImageView>(view));
+            }
+            return query;
+        }
+
+        VkFramebuffer Get(const FramebufferCacheQuery& query) {
+            ResultOrError<VkFramebuffer> result = mCache->GetFramebuffer(query);
+            EXPECT_TRUE(result.IsSuccess());
+            return result.AcquireSuccess();
+        }
+
+        bool WasDeletedWhenUnused(VkFramebuffer framebuffer) const {
+            return std::find(mDeletedWhenUnused.begin(), mDeletedWhenUnused.end(), framebuffer) !=
+                   mDeletedWhenUnused.end();
+        }
+
+        StubState mStubState;
+        VulkanFunctions mFunctions;
+        std::vector<VkFramebuffer> mDeletedWhenUnused;
+        std::unique_ptr<FramebufferCache> mCache;
+    };
+
+    // Test that the same query returns the same framebuffer and only creates it once.
+    TEST_F(FramebufferCacheTests, SameQueryHits) {
+        FramebufferCacheQuery query = MakeQuery(1, {10, 11});
+
+        VkFramebuffer framebuffer = Get(query);
+        EXPECT_NE(framebuffer, VK_NULL_HANDLE);
+        EXPECT_EQ(Get(query), framebuffer);
+        EXPECT_EQ(Get(MakeQuery(1, {10, 11})), framebuffer);
+
+        EXPECT_EQ(mStubState.createInfos.size(), 1u);
+        EXPECT_EQ(mCache->GetFramebufferCount(), 1u);
+        EXPECT_EQ(mCache->GetStats().hits, 2u);
+        EXPECT_EQ(mCache->GetStats().misses, 1u);
+        EXPECT_EQ(mCache->GetStats().evictions, 0u);
+    }
+
+    // Test that the framebuffer is created with the render pass, attachments and extent of the
+    // query.
+    TEST_F(FramebufferCacheTests, CreateInfo) {
+        Get(MakeQuery(3, {10, 12, 11}, 32, 8));
+
+        ASSERT_EQ(mStubState.createInfos.size(), 1u);
+        const VkFramebufferCreateInfo& info = mStubState.createInfos[0];
+        EXPECT_EQ(info.sType, VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO);
+        EXPECT_EQ(info.renderPass, MakeHandle<VkRenderPass>(3).GetHandle());
+        EXPECT_EQ(info.width, 32u);
+        EXPECT_EQ(info.height, 8u);
+        EXPECT_EQ(info.layers, 1u);
+
+        std::vector<::VkImageView> expectedAttachments = {
+            MakeHandle<VkImageView>(10).GetHandle(), MakeHandle<VkImageView>(12).GetHandle(),
+            MakeHandle<VkImageView>(11).GetHandle()};
+        EXPECT_EQ(mStubState.createdAttachments[0], expectedAttachments);
+    }
+
+    // Test that each part of the key is taken into account.
+    TEST_F(FramebufferCacheTests, DifferentQueriesMiss) {
+        std::vector<FramebufferCacheQuery> queries = {
+            MakeQuery(1, {10, 11}),         MakeQuery(2, {10, 11}),
+            MakeQuery(1, {11, 10}),         MakeQuery(1, {10}),
+            MakeQuery(1, {10, 11, 12}),     MakeQuery(1, {10, 12}),
+            MakeQuery(1, {10, 11}, 16, 32), MakeQuery(1, {10, 11}, 32, 16),
+        };
+
+        std::vector<VkFramebuffer> framebuffers;
+        for (const FramebufferCacheQuery& query : queries) {
+            VkFramebuffer framebuffer = Get(query);
+            EXPECT_EQ(std::find(framebuffers.begin(), framebuffers.end(), framebuffer),
+                      framebuffers.end());
+            framebuffers.push_back(framebuffer);
+        }
+
+        EXPECT_EQ(mStubState.createInfos.size(), queries.size());
+        EXPECT_EQ(mCache->GetStats().hits, 0u);
+        EXPECT_EQ(mCache->GetStats().misses, queries.size());
+
+        // All of them are still cached.
+        for (size_t i = 0; i < queries.size(); ++i) {
+            EXPECT_EQ(Get(queries[i]), framebuffers[i]);
+        }
+        EXPECT_EQ(mCache->GetStats().hits, queries.size());
+    }
+
+    // Test that destroying a view evicts exactly the framebuffers that use it.
+    TEST_F(FramebufferCacheTests, ViewDestructionEvicts) {
+        VkFramebuffer framebufferA = Get(MakeQuery(1, {10, 11}));
+        VkFramebuffer framebufferB = Get(MakeQuery(1, {11, 12}));
+        VkFramebuffer framebufferC = Get(MakeQuery(1, {12}));
+
+        mCache->OnImageViewDestroyed(MakeHandle<VkImageView>(11));
+
+        EXPECT_EQ(mDeletedWhenUnused.size(), 2u);
+        EXPECT_TRUE(WasDeletedWhenUnused(framebufferA));
+        EXPECT_TRUE(WasDeletedWhenUnused(framebufferB));
+        EXPECT_EQ(mCache->GetFramebufferCount(), 1u);
+        EXPECT_EQ(mCache->GetStats().evictions, 2u);
+
+        // The evicted framebuffers are handed to the deleter, not destroyed immediately.
+        EXPECT_TRUE(mStubState.destroyed.empty());
+
+        // The framebuffer that doesn't use the view is still cached.
+        EXPECT_EQ(Get(MakeQuery(1, {12})), framebufferC);
+
+        // The other views of the evicted framebuffers no longer refer to them.
+        mCache->OnImageViewDestroyed(MakeHandle<VkImageView>(10));
+        EXPECT_EQ(mDeletedWhenUnused.size(), 2u);
+
+        mCache->OnImageViewDestroyed(MakeHandle<VkImageView>(12));
+        EXPECT_EQ(mDeletedWhenUnused.size(), 3u);
+        EXPECT_TRUE(WasDeletedWhenUnused(framebufferC));
+        EXPECT_EQ(mCache->GetFramebufferCount(), 0u);
+    }
+
+    // Test that destroying a view that isn't used by any framebuffer does nothing.
+    TEST_F(FramebufferCacheTests, UnusedViewDestruction) {
+        VkFramebuffer framebuffer = Get(MakeQuery(1, {10}));
+
+        mCache->OnImageViewDestroyed(MakeHandle<VkImageView>(20));
+
+        EXPECT_TRUE(mDeletedWhenUnused.empty());
+        EXPECT_EQ(Get(MakeQuery(1, {10})), framebuffer);
+    }
+
+    // Test that a query is created again after its framebuffer is evicted, for example when the
+    // driver reuses the handle of a destroyed view.
+    TEST_F(FramebufferCacheTests, RecreateAfterEviction) {
+        FramebufferCacheQuery query = MakeQuery(1, {10, 11});
+        Get(query);
+
+        mCache->OnImageViewDestroyed(MakeHandle<VkImageView>(10));
+        VkFramebuffer framebuffer = Get(query);
+        EXPECT_EQ(mStubState.createInfos.size(), 2u);
+        EXPECT_EQ(mCache->GetStats().misses, 2u);
+
+        // The new entry is tracked for all its views.
+        mCache->OnImageViewDestroyed(MakeHandle<VkImageView>(11));
+        EXPECT_TRUE(WasDeletedWhenUnused(framebuffer));
+        EXPECT_EQ(mCache->GetFramebufferCount(), 0u);
+    }
+
+    // Test that a view used by several attachments of the same framebuffer is handled.
+    TEST_F(FramebufferCacheTests, ViewUsedTwice) {
+        VkFramebuffer framebuffer = Get(MakeQuery(1, {10, 10}));
+
+        mCache->OnImageViewDestroyed(MakeHandle<VkImageView>(10));
+        EXPECT_EQ(mDeletedWhenUnused.size(), 1u);
+        EXPECT_TRUE(WasDeletedWhenUnused(framebuffer));
+        EXPECT_EQ(mCache->GetFramebufferCount(), 0u);
+    }
+
+    // Test that a failed creation is returned as an error and isn't cached.
+    TEST_F(FramebufferCacheTests, CreationError) {
+        mStubState.createResult = VK_ERROR_OUT_OF_HOST_MEMORY;
+        ResultOrError<VkFramebuffer> result = mCache->GetFramebuffer(MakeQuery(1, {10}));
+        ASSERT_TRUE(result.IsError());
+        result.AcquireError();
+
+        EXPECT_EQ(mCache->GetFramebufferCount(), 0u);
+        EXPECT_EQ(mCache->GetStats().misses, 0u);
+
+        // Destroying the view doesn't find a stale entry.
+        mCache->OnImageViewDestroyed(MakeHandle<VkImageView>(10));
+        EXPECT_TRUE(mDeletedWhenUnused.empty());
+
+        mStubState.createResult = VK_SUCCESS;
+        Get(MakeQuery(1, {10}));
+        EXPECT_EQ(mCache->GetFramebufferCount(), 1u);
+    }
+
+    // Test that the framebuffers still cached are destroyed with the cache.
+    TEST_F(FramebufferCacheTests, DestructionDestroysCachedFramebuffers) {
+        VkFramebuffer framebufferA = Get(MakeQuery(1, {10}));
+        VkFramebuffer framebufferB = Get(MakeQuery(1, {11}));
+        mCache->OnImageViewDestroyed(MakeHandle<VkImageView>(10));
+
+        mCache = nullptr;
+
+        ASSERT_EQ(mStubState.destroyed.size(), 1u);
+        EXPECT_EQ(mStubState.destroyed[0], framebufferB.GetHandle());
+        EXPECT_TRUE(WasDeletedWhenUnused(framebufferA));
+    }
+
+}}  // namespace dawn_native::vulkan
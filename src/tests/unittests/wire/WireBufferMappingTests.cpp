@@ -16,6 +16,8 @@
 
 #include "dawn_wire/WireClient.h"
 
+#include <array>
+
 using namespace testing;
 using namespace dawn_wire;
 
@@ -67,9 +69,9 @@ class WireBufferMappingTests : public WireTest {
         Mock::VerifyAndClearExpectations(&mockBufferMapCallback);
     }
 
-    void SetupBuffer(WGPUBufferUsageFlags usage) {
+    void SetupBuffer(WGPUBufferUsageFlags usage, uint64_t size = kBufferSize) {
         WGPUBufferDescriptor descriptor = {};
-        descriptor.size = kBufferSize;
+        descriptor.size = size;
         descriptor.usage = usage;
 
         buffer = wgpuDeviceCreateBuffer(device, &descriptor);
@@ -409,6 +411,99 @@ TEST_F(WireBufferMappingWriteTests, MappingForWriteSuccessBuffer) {
     ASSERT_EQ(serverBufferContent, updatedContent);
 }
 
+// Check that only the ranges returned by GetMappedRange are sent to the server on Unmap, so the
+// rest of the mapping keeps the content of the server.
+TEST_F(WireBufferMappingTests, MappingForWriteOnlyUpdatesWrittenRanges) {
+    constexpr uint64_t kSize = 16 * sizeof(uint32_t);
+    SetupBuffer(WGPUBufferUsage_MapWrite, kSize);
+
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kSize, ToMockBufferMapCallback, nullptr);
+
+    std::array<uint32_t, 16> serverBufferContent;
+    serverBufferContent.fill(31337);
+
+    EXPECT_CALL(api, OnBufferMapAsync(apiBuffer, WGPUMapMode_Write, 0, kSize, _, _))
+        .WillOnce(InvokeWithoutArgs([&]() {
+            api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Success);
+        }));
+    EXPECT_CALL(api, BufferGetMappedRange(apiBuffer, 0, kSize))
+        .WillOnce(Return(serverBufferContent.data()));
+
+    FlushClient();
+
+    EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_Success, _)).Times(1);
+
+    FlushServer();
+
+    // Write to elements 2 and 3 through overlapping ranges, then to elements 10 to 13 through
+    // adjacent ranges.
+    uint32_t* first = static_cast<uint32_t*>(wgpuBufferGetMappedRange(buffer, 8, 8));
+    uint32_t* firstAgain = static_cast<uint32_t*>(wgpuBufferGetMappedRange(buffer, 8, 4));
+    first[1] = 2;
+    firstAgain[0] = 1;
+    uint32_t* second = static_cast<uint32_t*>(wgpuBufferGetMappedRange(buffer, 40, 8));
+    uint32_t* third = static_cast<uint32_t*>(wgpuBufferGetMappedRange(buffer, 48, 8));
+    second[0] = 3;
+    second[1] = 4;
+    third[0] = 5;
+    third[1] = 6;
+
+    wgpuBufferUnmap(buffer);
+    EXPECT_CALL(api, BufferUnmap(apiBuffer)).Times(1);
+
+    FlushClient();
+
+    std::array<uint32_t, 16> expected;
+    expected.fill(31337);
+    expected[2] = 1;
+    expected[3] = 2;
+    expected[10] = 3;
+    expected[11] = 4;
+    expected[12] = 5;
+    expected[13] = 6;
+    EXPECT_EQ(serverBufferContent, expected);
+}
+
+// Check that the whole mapping is sent to the server on Unmap when GetMappedRange is called with
+// its default arguments, even if other ranges are also returned by GetMappedRange.
+TEST_F(WireBufferMappingTests, MappingForWriteWithDefaultGetMappedRange) {
+    constexpr uint64_t kSize = 4 * sizeof(uint32_t);
+    SetupBuffer(WGPUBufferUsage_MapWrite, kSize);
+
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kSize, ToMockBufferMapCallback, nullptr);
+
+    std::array<uint32_t, 4> serverBufferContent;
+    serverBufferContent.fill(31337);
+
+    EXPECT_CALL(api, OnBufferMapAsync(apiBuffer, WGPUMapMode_Write, 0, kSize, _, _))
+        .WillOnce(InvokeWithoutArgs([&]() {
+            api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Success);
+        }));
+    EXPECT_CALL(api, BufferGetMappedRange(apiBuffer, 0, kSize))
+        .WillOnce(Return(serverBufferContent.data()));
+
+    FlushClient();
+
+    EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_Success, _)).Times(1);
+
+    FlushServer();
+
+    // wgpu::Buffer::GetMappedRange() defaults to an offset and a size of 0.
+    uint32_t* mapping = static_cast<uint32_t*>(wgpuBufferGetMappedRange(buffer, 0, 0));
+    uint32_t* last = static_cast<uint32_t*>(wgpuBufferGetMappedRange(buffer, 8, 8));
+    mapping[0] = 1;
+    mapping[1] = 2;
+    last[1] = 4;
+
+    wgpuBufferUnmap(buffer);
+    EXPECT_CALL(api, BufferUnmap(apiBuffer)).Times(1);
+
+    FlushClient();
+
+    std::array<uint32_t, 4> expected = {1, 2, 0, 4};
+    EXPECT_EQ(serverBufferContent, expected);
+}
+
 // Check that things work correctly when a validation error happens when mapping the buffer for
 // writing
 TEST_F(WireBufferMappingWriteTests, ErrorWhileMappingForWrite) {
@@ -164,3 +164,30 @@ TEST_F(WireDisconnectTests, DeleteClientDestroysObjects) {
     // Signal that we already released and cleared callbacks for |apiDevice|
     DefaultApiDeviceWasReleased();
 }
+
+// Test that destroying the WireClient after a disconnect frees its objects without sending any
+// command to the server.
+TEST_F(WireDisconnectTests, DeleteClientAfterDisconnect) {
+    WGPUSamplerDescriptor desc = {};
+    wgpuDeviceCreateCommandEncoder(device, nullptr);
+    wgpuDeviceCreateSampler(device, &desc);
+
+    WGPUCommandEncoder apiCommandEncoder = api.GetNewCommandEncoder();
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .WillOnce(Return(apiCommandEncoder));
+
+    WGPUSampler apiSampler = api.GetNewSampler();
+    EXPECT_CALL(api, DeviceCreateSampler(apiDevice, _)).WillOnce(Return(apiSampler));
+
+    FlushClient();
+
+    GetWireClient()->Disconnect();
+    DeleteClient();
+
+    // The objects are still alive on the server, they are released with it.
+    EXPECT_CALL(api, CommandEncoderRelease(_)).Times(0);
+    EXPECT_CALL(api, SamplerRelease(_)).Times(0);
+    EXPECT_CALL(api, QueueRelease(_)).Times(0);
+    EXPECT_CALL(api, DeviceRelease(_)).Times(0);
+    FlushClient();
+}
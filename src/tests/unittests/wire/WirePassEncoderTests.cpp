@@ -0,0 +1,198 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/wire/WireTest.h"
+
+#include "dawn_wire/PackedPassCommands.h"
+
+#include <vector>
+
+using namespace testing;
+using namespace dawn_wire;
+
+class WirePassEncoderTests : public WireTest {
+  protected:
+    void SetUp() override {
+        WireTest::SetUp();
+
+        encoder = wgpuDeviceCreateCommandEncoder(device, nullptr);
+        apiEncoder = api.GetNewCommandEncoder();
+        EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+            .WillOnce(Return(apiEncoder));
+
+        computePass = wgpuCommandEncoderBeginComputePass(encoder, nullptr);
+        apiComputePass = api.GetNewComputePassEncoder();
+        EXPECT_CALL(api, CommandEncoderBeginComputePass(apiEncoder, nullptr))
+            .WillOnce(Return(apiComputePass));
+
+        FlushClient();
+    }
+
+    WGPUBindGroup CreateBindGroup(WGPUBindGroup apiBindGroup) {
+        WGPUBindGroupLayoutDescriptor bglDescriptor = {};
+        WGPUBindGroupLayout bgl = wgpuDeviceCreateBindGroupLayout(device, &bglDescriptor);
+        WGPUBindGroupLayout apiBgl = api.GetNewBindGroupLayout();
+        EXPECT_CALL(api, DeviceCreateBindGroupLayout(apiDevice, _)).WillOnce(Return(apiBgl));
+
+        WGPUBindGroupDescriptor bindGroupDescriptor = {};
+        bindGroupDescriptor.layout = bgl;
+        WGPUBindGroup bindGroup = wgpuDeviceCreateBindGroup(device, &bindGroupDescriptor);
+        EXPECT_CALL(api, DeviceCreateBindGroup(apiDevice, _)).WillOnce(Return(apiBindGroup));
+
+        FlushClient();
+        return bindGroup;
+    }
+
+    WGPUBuffer CreateBuffer(WGPUBuffer apiBuffer) {
+        WGPUBufferDescriptor descriptor = {};
+        descriptor.size = 256;
+        WGPUBuffer buffer = wgpuDeviceCreateBuffer(device, &descriptor);
+        EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiBuffer));
+
+        FlushClient();
+        return buffer;
+    }
+
+    WGPUCommandEncoder encoder;
+    WGPUCommandEncoder apiEncoder;
+    WGPUComputePassEncoder computePass;
+    WGPUComputePassEncoder apiComputePass;
+};
+
+// Test that the packed commands stay ordered with the commands of the pass that aren't packed.
+TEST_F(WirePassEncoderTests, PackedCommandsStayOrdered) {
+    wgpuComputePassEncoderDispatch(computePass, 1, 2, 3);
+    wgpuComputePassEncoderPushDebugGroup(computePass, "group");
+    wgpuComputePassEncoderDispatch(computePass, 4, 5, 6);
+    wgpuComputePassEncoderPopDebugGroup(computePass);
+    wgpuComputePassEncoderDispatch(computePass, 7, 8, 9);
+    wgpuComputePassEncoderEndPass(computePass);
+
+    InSequence s;
+    EXPECT_CALL(api, ComputePassEncoderDispatch(apiComputePass, 1, 2, 3));
+    EXPECT_CALL(api, ComputePassEncoderPushDebugGroup(apiComputePass, StrEq("group")));
+    EXPECT_CALL(api, ComputePassEncoderDispatch(apiComputePass, 4, 5, 6));
+    EXPECT_CALL(api, ComputePassEncoderPopDebugGroup(apiComputePass));
+    EXPECT_CALL(api, ComputePassEncoderDispatch(apiComputePass, 7, 8, 9));
+    EXPECT_CALL(api, ComputePassEncoderEndPass(apiComputePass));
+
+    FlushClient();
+}
+
+// Test that the packed commands are handled before the release of the objects they use.
+TEST_F(WirePassEncoderTests, PackedCommandsBeforeObjectRelease) {
+    WGPUBindGroup apiBindGroup = api.GetNewBindGroup();
+    WGPUBindGroup bindGroup = CreateBindGroup(apiBindGroup);
+
+    wgpuComputePassEncoderSetBindGroup(computePass, 0, bindGroup, 0, nullptr);
+    wgpuBindGroupRelease(bindGroup);
+
+    InSequence s;
+    EXPECT_CALL(api, ComputePassEncoderSetBindGroup(apiComputePass, 0, apiBindGroup, 0, _));
+    EXPECT_CALL(api, BindGroupRelease(apiBindGroup));
+
+    FlushClient();
+}
+
+// Test that more packed commands than fit in a single blob are all handled in order.
+TEST_F(WirePassEncoderTests, ManyPackedCommands) {
+    constexpr uint32_t kDispatchCount = 2 * kMaxPackedPassCommandsSize / 16;
+    for (uint32_t i = 0; i < kDispatchCount; ++i) {
+        wgpuComputePassEncoderDispatch(computePass, i, 1, 1);
+    }
+
+    InSequence s;
+    for (uint32_t i = 0; i < kDispatchCount; ++i) {
+        EXPECT_CALL(api, ComputePassEncoderDispatch(apiComputePass, i, 1, 1));
+    }
+
+    FlushClient();
+}
+
+// Test the dynamic offsets of packed SetBindGroup commands, and that SetBindGroup commands with
+// too many dynamic offsets to be packed are sent in order with the packed commands.
+TEST_F(WirePassEncoderTests, SetBindGroupDynamicOffsets) {
+    WGPUBindGroup apiBindGroup = api.GetNewBindGroup();
+    WGPUBindGroup bindGroup = CreateBindGroup(apiBindGroup);
+
+    std::vector<uint32_t> fewOffsets = {0, 256, 0xFFFF'FFFFu};
+    std::vector<uint32_t> manyOffsets(kMaxPackedDynamicOffsetCount + 1);
+    for (uint32_t i = 0; i < manyOffsets.size(); ++i) {
+        manyOffsets[i] = i * 256;
+    }
+
+    wgpuComputePassEncoderSetBindGroup(computePass, 0, bindGroup, fewOffsets.size(),
+                                       fewOffsets.data());
+    wgpuComputePassEncoderSetBindGroup(computePass, 1, bindGroup, manyOffsets.size(),
+                                       manyOffsets.data());
+    wgpuComputePassEncoderSetBindGroup(computePass, 2, bindGroup, fewOffsets.size(),
+                                       fewOffsets.data());
+
+    auto MatchesOffsets = [](const std::vector<uint32_t>& expected) {
+        return MatchesLambda([expected](const uint32_t* offsets) -> bool {
+            for (size_t i = 0; i < expected.size(); i++) {
+                if (offsets[i] != expected[i]) {
+                    return false;
+                }
+            }
+            return true;
+        });
+    };
+
+    InSequence s;
+    EXPECT_CALL(api, ComputePassEncoderSetBindGroup(apiComputePass, 0, apiBindGroup,
+                                                    fewOffsets.size(), MatchesOffsets(fewOffsets)));
+    EXPECT_CALL(api,
+                ComputePassEncoderSetBindGroup(apiComputePass, 1, apiBindGroup, manyOffsets.size(),
+                                               MatchesOffsets(manyOffsets)));
+    EXPECT_CALL(api, ComputePassEncoderSetBindGroup(apiComputePass, 2, apiBindGroup,
+                                                    fewOffsets.size(), MatchesOffsets(fewOffsets)));
+
+    FlushClient();
+}
+
+// Test that the packed commands of a compute pass and of a render pass are kept separate.
+TEST_F(WirePassEncoderTests, PackedRenderPassCommands) {
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    WGPUBuffer buffer = CreateBuffer(apiBuffer);
+
+    wgpuComputePassEncoderDispatchIndirect(computePass, buffer, 16);
+    wgpuComputePassEncoderEndPass(computePass);
+
+    WGPURenderPassDescriptor renderPassDescriptor = {};
+    WGPURenderPassEncoder renderPass =
+        wgpuCommandEncoderBeginRenderPass(encoder, &renderPassDescriptor);
+    wgpuRenderPassEncoderSetVertexBuffer(renderPass, 1, buffer, 8, 64);
+    wgpuRenderPassEncoderSetIndexBuffer(renderPass, buffer, WGPUIndexFormat_Uint32, 4, 32);
+    wgpuRenderPassEncoderDraw(renderPass, 3, 1, 0, 0);
+    wgpuRenderPassEncoderDrawIndexed(renderPass, 6, 2, 1, -3, 4);
+    wgpuRenderPassEncoderDrawIndirect(renderPass, buffer, 0);
+    wgpuRenderPassEncoderDrawIndexedIndirect(renderPass, buffer, 1ull << 40);
+
+    WGPURenderPassEncoder apiRenderPass = api.GetNewRenderPassEncoder();
+
+    InSequence s;
+    EXPECT_CALL(api, ComputePassEncoderDispatchIndirect(apiComputePass, apiBuffer, 16));
+    EXPECT_CALL(api, ComputePassEncoderEndPass(apiComputePass));
+    EXPECT_CALL(api, CommandEncoderBeginRenderPass(apiEncoder, _)).WillOnce(Return(apiRenderPass));
+    EXPECT_CALL(api, RenderPassEncoderSetVertexBuffer(apiRenderPass, 1, apiBuffer, 8, 64));
+    EXPECT_CALL(api, RenderPassEncoderSetIndexBuffer(apiRenderPass, apiBuffer,
+                                                     WGPUIndexFormat_Uint32, 4, 32));
+    EXPECT_CALL(api, RenderPassEncoderDraw(apiRenderPass, 3, 1, 0, 0));
+    EXPECT_CALL(api, RenderPassEncoderDrawIndexed(apiRenderPass, 6, 2, 1, -3, 4));
+    EXPECT_CALL(api, RenderPassEncoderDrawIndirect(apiRenderPass, apiBuffer, 0));
+    EXPECT_CALL(api, RenderPassEncoderDrawIndexedIndirect(apiRenderPass, apiBuffer, 1ull << 40));
+
+    FlushClient();
+}
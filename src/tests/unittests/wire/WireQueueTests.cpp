@@ -16,6 +16,9 @@
 
 #include "dawn_wire/WireClient.h"
 
+#include <cstring>
+#include <vector>
+
 using namespace testing;
 using namespace dawn_wire;
 
@@ -138,3 +141,77 @@ TEST_F(WireQueueTests, OnSubmittedWorkDoneInsideCallbackBeforeDisconnect) {
 // Only one default queue is supported now so we cannot test ~Queue triggering ClearAllCallbacks
 // since it is always destructed after the test TearDown, and we cannot create a new queue obj
 // with wgpuDeviceGetQueue
+
+// Test that the data of WriteBuffer is forwarded to the server, both when it fits in a single
+// allocation of the serializer and when it is streamed in several chunks.
+TEST_F(WireQueueTests, WriteBuffer) {
+    // The second size is larger than the maximum allocation size of the TerribleCommandBuffer.
+    constexpr uint64_t kOffset = 8;
+    constexpr size_t kSizes[] = {16, 2500000};
+
+    WGPUBufferDescriptor descriptor = {};
+    descriptor.size = kOffset + kSizes[1];
+    descriptor.usage = WGPUBufferUsage_CopyDst;
+
+    WGPUBuffer buffer = wgpuDeviceCreateBuffer(device, &descriptor);
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiBuffer));
+    FlushClient();
+
+    for (size_t size : kSizes) {
+        std::vector<uint8_t> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<uint8_t>(i * 7);
+        }
+
+        wgpuQueueWriteBuffer(queue, buffer, kOffset, data.data(), size);
+        EXPECT_CALL(api, QueueWriteBuffer(apiQueue, apiBuffer, kOffset, _, size))
+            .WillOnce(WithArg<3>(Invoke([&data](const void* writtenData) {
+                EXPECT_EQ(0, memcmp(data.data(), writtenData, data.size()));
+            })));
+        FlushClient();
+    }
+}
+
+// Test that the arguments and data of WriteTexture are forwarded to the server.
+TEST_F(WireQueueTests, WriteTexture) {
+    WGPUTextureDescriptor descriptor = {};
+    descriptor.size = {4, 4, 1};
+    descriptor.mipLevelCount = 1;
+    descriptor.sampleCount = 1;
+    descriptor.format = WGPUTextureFormat_RGBA8Unorm;
+    descriptor.usage = WGPUTextureUsage_CopyDst;
+
+    WGPUTexture texture = wgpuDeviceCreateTexture(device, &descriptor);
+    WGPUTexture apiTexture = api.GetNewTexture();
+    EXPECT_CALL(api, DeviceCreateTexture(apiDevice, _)).WillOnce(Return(apiTexture));
+    FlushClient();
+
+    std::vector<uint8_t> data(4 * 4 * 4);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+
+    WGPUImageCopyTexture destination = {};
+    destination.texture = texture;
+    destination.origin = {0, 0, 0};
+    destination.aspect = WGPUTextureAspect_All;
+    WGPUTextureDataLayout dataLayout = {};
+    dataLayout.bytesPerRow = 16;
+    dataLayout.rowsPerImage = 4;
+    WGPUExtent3D writeSize = {4, 4, 1};
+
+    wgpuQueueWriteTexture(queue, &destination, data.data(), data.size(), &dataLayout, &writeSize);
+    EXPECT_CALL(api, QueueWriteTexture(apiQueue, _, _, data.size(), _, _))
+        .WillOnce(Invoke([&](WGPUQueue, const WGPUImageCopyTexture* apiDestination,
+                             const void* writtenData, size_t, const WGPUTextureDataLayout* layout,
+                             const WGPUExtent3D* size) {
+            EXPECT_EQ(apiTexture, apiDestination->texture);
+            EXPECT_EQ(16u, layout->bytesPerRow);
+            EXPECT_EQ(4u, layout->rowsPerImage);
+            EXPECT_EQ(4u, size->width);
+            EXPECT_EQ(4u, size->height);
+            EXPECT_EQ(0, memcmp(data.data(), writtenData, data.size()));
+        }));
+    FlushClient();
+}
@@ -110,6 +110,9 @@ void WireTest::DefaultApiDeviceWasReleased() {
 }
 
 void WireTest::FlushClient(bool success) {
+    if (mWireClient != nullptr) {
+        mWireClient->SerializePendingCommands();
+    }
     ASSERT_EQ(mC2sBuf->Flush(), success);
 
     Mock::VerifyAndClearExpectations(&api);
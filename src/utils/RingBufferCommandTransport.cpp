@@ -0,0 +1,219 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "utils/RingBufferCommandTransport.h"
+
+#include "common/Assert.h"
+#include "common/Math.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace utils {
+
+    namespace {
+
+        // Each segment starts with a header containing the size of its commands. The header of
+        // a segment that doesn't fit at the end of the ring is replaced by kPaddingHeader and the
+        // segment starts at the beginning of the ring instead.
+        using SegmentHeader = uint64_t;
+        constexpr size_t kHeaderSize = sizeof(SegmentHeader);
+        constexpr SegmentHeader kPaddingHeader = ~SegmentHeader(0);
+
+        // Segments start on aligned offsets so that their header can be read directly.
+        constexpr size_t kSegmentAlignment = alignof(SegmentHeader);
+
+        // The smallest capacity such that the maximum allocation size is still reasonable.
+        constexpr size_t kMinCapacity = 256;
+
+    }  // anonymous namespace
+
+    // RingBufferSignal
+
+    void RingBufferSignal::Notify() {
+        if (mWaiterCount.load() == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCondition.notify_all();
+    }
+
+    // RingBufferCommandTransport
+
+    RingBufferCommandTransport::RingBufferCommandTransport(
+        const RingBufferCommandTransportDescriptor& descriptor)
+        : mCapacity(NextPowerOfTwo(std::max(descriptor.capacity, kMinCapacity))),
+          // An allocation after the end of the ring may need to skip up to its size plus a
+          // header, so limiting allocations to a quarter of the ring guarantees that a segment
+          // with a single allocation always fits once the consumer caught up.
+          mMaxAllocationSize(mCapacity / 4 - kHeaderSize),
+          mFlushPolicy(descriptor.flushPolicy),
+          mSignal(descriptor.signal),
+          mBuffer(new char[mCapacity]) {
+        if (mSignal == nullptr) {
+            mSignal = std::make_shared<RingBufferSignal>();
+        }
+    }
+
+    RingBufferCommandTransport::~RingBufferCommandTransport() = default;
+
+    size_t RingBufferCommandTransport::GetMaximumAllocationSize() const {
+        return mMaxAllocationSize;
+    }
+
+    void* RingBufferCommandTransport::GetCmdSpace(size_t size) {
+        // Note: This returns non-null even if size is zero.
+        if (size > mMaxAllocationSize) {
+            return nullptr;
+        }
+
+        const uint64_t mask = mCapacity - 1;
+
+        // Append to the segment being written if it stays contiguous and there is space.
+        if (mHasOpenSegment) {
+            uint64_t segmentEnd = mReservedOffset + size;
+            bool isContiguous =
+                (mSegmentOffset & mask) + (segmentEnd - mSegmentOffset) <= mCapacity;
+            if (isContiguous && segmentEnd - mConsumedOffset.load() <= mCapacity) {
+                char* result = &mBuffer[mReservedOffset & mask];
+                mReservedOffset = segmentEnd;
+                return result;
+            }
+            PublishSegment();
+        }
+
+        // Otherwise start a new segment, at the beginning of the ring if it doesn't fit before
+        // the end.
+        ASSERT(mReservedOffset % kSegmentAlignment == 0);
+        size_t spaceBeforeEnd = mCapacity - (mReservedOffset & mask);
+        size_t padding = spaceBeforeEnd < kHeaderSize + size ? spaceBeforeEnd : 0;
+        if (!WaitForSpace(padding + kHeaderSize + size)) {
+            return nullptr;
+        }
+
+        if (padding != 0) {
+            memcpy(&mBuffer[mReservedOffset & mask], &kPaddingHeader, kHeaderSize);
+            mReservedOffset += padding;
+        }
+
+        mHasOpenSegment = true;
+        mSegmentOffset = mReservedOffset;
+        mReservedOffset += kHeaderSize + size;
+        return &mBuffer[(mSegmentOffset & mask) + kHeaderSize];
+    }
+
+    bool RingBufferCommandTransport::Flush() {
+        PublishSegment();
+
+        if (mFlushPolicy == RingBufferFlushPolicy::Blocking) {
+            uint64_t publishedOffset = mPublishedOffset.load(std::memory_order_relaxed);
+            mSignal->Wait([this, publishedOffset]() {
+                return mConsumedOffset.load() >= publishedOffset || mClosed.load();
+            });
+        }
+
+        // With the non-blocking policy, the failures of the consumer are reported by the next
+        // call to Flush().
+        return !mHandlerFailed.exchange(false);
+    }
+
+    void RingBufferCommandTransport::PublishSegment() {
+        if (!mHasOpenSegment) {
+            return;
+        }
+        mHasOpenSegment = false;
+
+        SegmentHeader header = mReservedOffset - mSegmentOffset - kHeaderSize;
+        memcpy(&mBuffer[mSegmentOffset & (mCapacity - 1)], &header, kHeaderSize);
+
+        // The end of the ring is aligned so the alignment never makes a segment wrap around.
+        mReservedOffset = Align(mReservedOffset, kSegmentAlignment);
+        mPublishedOffset.store(mReservedOffset);
+        mSignal->Notify();
+    }
+
+    bool RingBufferCommandTransport::WaitForSpace(size_t size) {
+        ASSERT(!mHasOpenSegment);
+        auto HasSpace = [this, size]() {
+            return mReservedOffset + size - mConsumedOffset.load() <= mCapacity;
+        };
+        if (HasSpace()) {
+            return true;
+        }
+
+        mProducerWaitCount.fetch_add(1, std::memory_order_relaxed);
+        mSignal->Wait([this, &HasSpace]() { return HasSpace() || mClosed.load(); });
+        return HasSpace();
+    }
+
+    bool RingBufferCommandTransport::ConsumeCommands(dawn_wire::CommandHandler* handler) {
+        const uint64_t mask = mCapacity - 1;
+        bool success = true;
+
+        uint64_t consumedOffset = mConsumedOffset.load(std::memory_order_relaxed);
+        uint64_t publishedOffset = mPublishedOffset.load();
+        while (consumedOffset != publishedOffset) {
+            const char* segment = &mBuffer[consumedOffset & mask];
+            SegmentHeader header;
+            memcpy(&header, segment, kHeaderSize);
+
+            if (header == kPaddingHeader) {
+                consumedOffset += mCapacity - (consumedOffset & mask);
+            } else {
+                ASSERT((consumedOffset & mask) + kHeaderSize + header <= mCapacity);
+                if (handler->HandleCommands(segment + kHeaderSize, header) == nullptr) {
+                    success = false;
+                }
+                consumedOffset = Align(consumedOffset + kHeaderSize + header, kSegmentAlignment);
+            }
+
+            // Free the space of each segment as soon as it is handled so that the producer
+            // waits as little as possible.
+            mConsumedOffset.store(consumedOffset);
+            mSignal->Notify();
+
+            if (consumedOffset == publishedOffset) {
+                publishedOffset = mPublishedOffset.load();
+            }
+        }
+
+        if (!success) {
+            mHandlerFailed.store(true);
+        }
+        return success;
+    }
+
+    bool RingBufferCommandTransport::WaitForCommands() {
+        mSignal->Wait([this]() { return HasPublishedCommands() || mClosed.load(); });
+        return HasPublishedCommands();
+    }
+
+    void RingBufferCommandTransport::Close() {
+        mClosed.store(true);
+        mSignal->Notify();
+    }
+
+    bool RingBufferCommandTransport::HasPublishedCommands() const {
+        return mPublishedOffset.load() != mConsumedOffset.load();
+    }
+
+    RingBufferSignal* RingBufferCommandTransport::GetSignal() const {
+        return mSignal.get();
+    }
+
+    uint64_t RingBufferCommandTransport::GetProducerWaitCount() const {
+        return mProducerWaitCount.load(std::memory_order_relaxed);
+    }
+
+}  // namespace utils
@@ -0,0 +1,151 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILS_RINGBUFFERCOMMANDTRANSPORT_H_
+#define UTILS_RINGBUFFERCOMMANDTRANSPORT_H_
+
+#include "dawn_wire/Wire.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace utils {
+
+    // Wakes up the threads waiting on RingBufferCommandTransports. A signal can be shared by the
+    // transports of both directions of a wire so that a thread can wait for progress on either.
+    // Notify() only takes the lock when a thread is waiting, so it is cheap on the fast path.
+    class RingBufferSignal {
+      public:
+        void Notify();
+
+        template <typename Predicate>
+        void Wait(Predicate predicate);
+
+      private:
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::atomic<uint32_t> mWaiterCount{0};
+    };
+
+    enum class RingBufferFlushPolicy {
+        // Flush() publishes the commands and returns immediately.
+        NonBlocking,
+        // Flush() publishes the commands and waits until the consumer has handled all of them.
+        Blocking,
+    };
+
+    struct RingBufferCommandTransportDescriptor {
+        // Rounded up to a power of two.
+        size_t capacity = 4 * 1024 * 1024;
+        RingBufferFlushPolicy flushPolicy = RingBufferFlushPolicy::NonBlocking;
+        // Optional, a signal private to the transport is used if it is null.
+        std::shared_ptr<RingBufferSignal> signal;
+    };
+
+    // A transport for the wire between a producer thread that serializes the commands and a
+    // consumer thread that hands them to a dawn_wire::CommandHandler, like the client and the
+    // server of the wire running on different threads.
+    //
+    // The commands are written in place in a lock-free single-producer/single-consumer ring. The
+    // space returned by GetCmdSpace() is grouped in segments of contiguous commands that are
+    // published to the consumer in Flush(). A segment never wraps around the end of the ring: the
+    // producer skips the end of the ring instead, which is why the maximum allocation size is a
+    // fraction of the capacity. When the ring is full, the producer publishes its pending
+    // commands and waits for the consumer to free space.
+    //
+    // Only the producer thread may call the CommandSerializer methods and only the consumer thread
+    // may call ConsumeCommands() and WaitForCommands().
+    class RingBufferCommandTransport : public dawn_wire::CommandSerializer {
+      public:
+        explicit RingBufferCommandTransport(
+            const RingBufferCommandTransportDescriptor& descriptor = {});
+        ~RingBufferCommandTransport() override;
+
+        // Producer side.
+        size_t GetMaximumAllocationSize() const override;
+        void* GetCmdSpace(size_t size) override;
+        bool Flush() override;
+
+        // Consumer side.
+        // Hands all the published commands to |handler|. Returns false if |handler| failed to
+        // handle some of them. The commands are consumed even if they failed to be handled.
+        bool ConsumeCommands(dawn_wire::CommandHandler* handler);
+        // Waits until there are published commands to consume. Returns false if the transport
+        // was closed and all the commands were consumed.
+        bool WaitForCommands();
+
+        // Either side.
+        // Wakes up the waiting threads. After this, the waits of the producer fail and
+        // WaitForCommands() returns false once the published commands are consumed.
+        void Close();
+        // Returns whether some published commands weren't handled by the consumer yet.
+        bool HasPublishedCommands() const;
+        RingBufferSignal* GetSignal() const;
+
+        // The number of times the producer waited for the consumer to free space in the ring.
+        uint64_t GetProducerWaitCount() const;
+
+      private:
+        // Publishes the segment being written, if any.
+        void PublishSegment();
+        // Waits until |size| bytes can be written after the end of the reserved space. Returns
+        // false if the transport is closed.
+        bool WaitForSpace(size_t size);
+
+        const size_t mCapacity;
+        const size_t mMaxAllocationSize;
+        const RingBufferFlushPolicy mFlushPolicy;
+        std::shared_ptr<RingBufferSignal> mSignal;
+        std::unique_ptr<char[]> mBuffer;
+
+        // The offsets grow monotonically and are wrapped with (offset & (mCapacity - 1)). They
+        // are written by a single thread and are padded so the two sides don't share a cache
+        // line.
+        alignas(64) std::atomic<uint64_t> mPublishedOffset{0};
+        alignas(64) std::atomic<uint64_t> mConsumedOffset{0};
+        alignas(64) std::atomic<bool> mClosed{false};
+        std::atomic<bool> mHandlerFailed{false};
+        std::atomic<uint64_t> mProducerWaitCount{0};
+
+        // State owned by the producer. |mSegmentOffset| is the offset of the header of the
+        // segment being written, and |mReservedOffset| the end of the space returned by
+        // GetCmdSpace().
+        bool mHasOpenSegment = false;
+        uint64_t mSegmentOffset = 0;
+        uint64_t mReservedOffset = 0;
+    };
+
+    template <typename Predicate>
+    void RingBufferSignal::Wait(Predicate predicate) {
+        // Spin shortly first as the other side is usually about to make progress.
+        for (uint32_t i = 0; i < 64; ++i) {
+            if (predicate()) {
+                return;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        // The waiter count is incremented before checking the predicate so that a concurrent
+        // Notify() either sees the waiter or happens before the check.
+        mWaiterCount.fetch_add(1);
+        mCondition.wait(lock, predicate);
+        mWaiterCount.fetch_sub(1);
+    }
+
+}  // namespace utils
+
+#endif  // UTILS_RINGBUFFERCOMMANDTRANSPORT_H_
@@ -0,0 +1,397 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "utils/SharedMemoryTransferService.h"
+
+#include "common/Assert.h"
+#include "common/Platform.h"
+
+#if defined(DAWN_PLATFORM_LINUX)
+#    include <linux/memfd.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+
+#    include <algorithm>
+#    include <cstring>
+#    include <mutex>
+#    include <unordered_map>
+#endif
+
+namespace utils {
+
+#if defined(DAWN_PLATFORM_LINUX)
+
+    namespace {
+
+        // Serialized by the client when a handle is created, instead of the contents of the
+        // buffer.
+        struct SharedMemoryRegionDescriptor {
+            uint64_t id;
+            uint64_t size;
+        };
+
+        // A mapping of a whole shared memory file. Zero-sized handles still map a byte so that
+        // their data pointer isn't null.
+        class SharedMemoryMapping {
+          public:
+            static std::unique_ptr<SharedMemoryMapping> Map(int fd, size_t size) {
+                size_t mappedSize = std::max(size, size_t(1));
+                void* data = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (data == MAP_FAILED) {
+                    return nullptr;
+                }
+                return std::unique_ptr<SharedMemoryMapping>(
+                    new SharedMemoryMapping(static_cast<uint8_t*>(data), size, mappedSize));
+            }
+
+            ~SharedMemoryMapping() {
+                munmap(mData, mMappedSize);
+            }
+
+            uint8_t* GetData() const {
+                return mData;
+            }
+
+            size_t GetSize() const {
+                return mSize;
+            }
+
+            bool ContainsRange(size_t offset, size_t size) const {
+                return offset <= mSize && size <= mSize - offset;
+            }
+
+          private:
+            SharedMemoryMapping(uint8_t* data, size_t size, size_t mappedSize)
+                : mData(data), mSize(size), mMappedSize(mappedSize) {
+            }
+
+            uint8_t* mData;
+            size_t mSize;
+            size_t mMappedSize;
+        };
+
+        // Hands the file descriptors of the regions created by the client over to the server.
+        // The client only keeps a handle while its buffer is mapped, which can end before the
+        // server handles the command creating the handle, so the table owns the descriptor until
+        // the server takes it. An embedder with the server in another process would send the
+        // descriptors over its IPC channel instead (for example with SCM_RIGHTS).
+        class SharedMemoryRegionTable {
+          public:
+            ~SharedMemoryRegionTable() {
+                for (const auto& it : mFds) {
+                    close(it.second);
+                }
+            }
+
+            uint64_t Register(int fd) {
+                std::lock_guard<std::mutex> lock(mMutex);
+                uint64_t id = mNextId++;
+                mFds[id] = fd;
+                return id;
+            }
+
+            // Returns the descriptor registered with |id| and transfers its ownership to the
+            // caller, or -1 if there is none.
+            int Take(uint64_t id) {
+                std::lock_guard<std::mutex> lock(mMutex);
+                auto it = mFds.find(id);
+                if (it == mFds.end()) {
+                    return -1;
+                }
+                int fd = it->second;
+                mFds.erase(it);
+                return fd;
+            }
+
+          private:
+            std::mutex mMutex;
+            uint64_t mNextId = 1;
+            std::unordered_map<uint64_t, int> mFds;
+        };
+
+        // Creates a zero-initialized shared memory region of |size| bytes, maps it and registers
+        // it in |table|.
+        std::unique_ptr<SharedMemoryMapping> CreateRegion(
+            SharedMemoryRegionTable* table,
+            size_t size,
+            SharedMemoryRegionDescriptor* descriptor) {
+            int fd = static_cast<int>(syscall(__NR_memfd_create, "dawn_wire", MFD_CLOEXEC));
+            if (fd < 0) {
+                return nullptr;
+            }
+
+            std::unique_ptr<SharedMemoryMapping> mapping;
+            if (ftruncate(fd, std::max(size, size_t(1))) == 0) {
+                mapping = SharedMemoryMapping::Map(fd, size);
+            }
+            if (mapping == nullptr) {
+                close(fd);
+                return nullptr;
+            }
+
+            descriptor->id = table->Register(fd);
+            descriptor->size = size;
+            return mapping;
+        }
+
+        // Maps the region described by the |deserializeSize| bytes at |deserializePointer|.
+        std::unique_ptr<SharedMemoryMapping> OpenRegion(SharedMemoryRegionTable* table,
+                                                        const void* deserializePointer,
+                                                        size_t deserializeSize) {
+            SharedMemoryRegionDescriptor descriptor;
+            if (deserializeSize != sizeof(descriptor) || deserializePointer == nullptr) {
+                return nullptr;
+            }
+            memcpy(&descriptor, deserializePointer, sizeof(descriptor));
+
+            int fd = table->Take(descriptor.id);
+            if (fd < 0) {
+                return nullptr;
+            }
+
+            // Check the size of the file so that accesses past its end can't fault.
+            std::unique_ptr<SharedMemoryMapping> mapping;
+            const size_t size = static_cast<size_t>(descriptor.size);
+            struct stat fileStat;
+            if (size == descriptor.size && fstat(fd, &fileStat) == 0 &&
+                fileStat.st_size >= static_cast<off_t>(std::max(size, size_t(1)))) {
+                mapping = SharedMemoryMapping::Map(fd, size);
+            }
+            close(fd);
+            return mapping;
+        }
+
+        class ClientSharedMemoryTransferService : public dawn_wire::client::MemoryTransferService {
+            class ReadHandleImpl : public ReadHandle {
+              public:
+                ReadHandleImpl(std::unique_ptr<SharedMemoryMapping> mapping,
+                               const SharedMemoryRegionDescriptor& descriptor)
+                    : mMapping(std::move(mapping)), mDescriptor(descriptor) {
+                }
+                ~ReadHandleImpl() override = default;
+
+                size_t SerializeCreateSize() override {
+                    return sizeof(mDescriptor);
+                }
+
+                void SerializeCreate(void* serializePointer) override {
+                    memcpy(serializePointer, &mDescriptor, sizeof(mDescriptor));
+                }
+
+                const void* GetData() override {
+                    return mMapping->GetData();
+                }
+
+                bool DeserializeDataUpdate(const void* deserializePointer,
+                                           size_t deserializeSize,
+                                           size_t offset,
+                                           size_t size) override {
+                    // The server already wrote the data in the shared memory.
+                    return deserializeSize == 0 && mMapping->ContainsRange(offset, size);
+                }
+
+              private:
+                std::unique_ptr<SharedMemoryMapping> mMapping;
+                SharedMemoryRegionDescriptor mDescriptor;
+            };
+
+            class WriteHandleImpl : public WriteHandle {
+              public:
+                WriteHandleImpl(std::unique_ptr<SharedMemoryMapping> mapping,
+                                const SharedMemoryRegionDescriptor& descriptor)
+                    : mMapping(std::move(mapping)), mDescriptor(descriptor) {
+                }
+                ~WriteHandleImpl() override = default;
+
+                size_t SerializeCreateSize() override {
+                    return sizeof(mDescriptor);
+                }
+
+                void SerializeCreate(void* serializePointer) override {
+                    memcpy(serializePointer, &mDescriptor, sizeof(mDescriptor));
+                }
+
+                void* GetData() override {
+                    return mMapping->GetData();
+                }
+
+                size_t SizeOfSerializeDataUpdate(size_t offset, size_t size) override {
+                    ASSERT(mMapping->ContainsRange(offset, size));
+                    return 0;
+                }
+
+                void SerializeDataUpdate(void*, size_t offset, size_t size) override {
+                    // The server reads the data from the shared memory, the update only orders
+                    // the writes of the client before the server copies them.
+                    ASSERT(mMapping->ContainsRange(offset, size));
+                }
+
+              private:
+                std::unique_ptr<SharedMemoryMapping> mMapping;
+                SharedMemoryRegionDescriptor mDescriptor;
+            };
+
+          public:
+            explicit ClientSharedMemoryTransferService(
+                std::shared_ptr<SharedMemoryRegionTable> table)
+                : mTable(std::move(table)) {
+            }
+            ~ClientSharedMemoryTransferService() override = default;
+
+            ReadHandle* CreateReadHandle(size_t size) override {
+                SharedMemoryRegionDescriptor descriptor;
+                std::unique_ptr<SharedMemoryMapping> mapping =
+                    CreateRegion(mTable.get(), size, &descriptor);
+                if (mapping == nullptr) {
+                    return nullptr;
+                }
+                return new ReadHandleImpl(std::move(mapping), descriptor);
+            }
+
+            WriteHandle* CreateWriteHandle(size_t size) override {
+                SharedMemoryRegionDescriptor descriptor;
+                std::unique_ptr<SharedMemoryMapping> mapping =
+                    CreateRegion(mTable.get(), size, &descriptor);
+                if (mapping == nullptr) {
+                    return nullptr;
+                }
+                return new WriteHandleImpl(std::move(mapping), descriptor);
+            }
+
+          private:
+            std::shared_ptr<SharedMemoryRegionTable> mTable;
+        };
+
+        class ServerSharedMemoryTransferService : public dawn_wire::server::MemoryTransferService {
+            class ReadHandleImpl : public ReadHandle {
+              public:
+                explicit ReadHandleImpl(std::unique_ptr<SharedMemoryMapping> mapping)
+                    : mMapping(std::move(mapping)) {
+                }
+                ~ReadHandleImpl() override = default;
+
+                size_t SizeOfSerializeDataUpdate(size_t offset, size_t size) override {
+                    return 0;
+                }
+
+                void SerializeDataUpdate(const void* data,
+                                         size_t offset,
+                                         size_t size,
+                                         void* serializePointer) override {
+                    // |offset| and |size| come from the validated map request.
+                    ASSERT(mMapping->ContainsRange(offset, size));
+                    if (size > 0) {
+                        ASSERT(data != nullptr);
+                        memcpy(mMapping->GetData() + offset, data, size);
+                    }
+                }
+
+              private:
+                std::unique_ptr<SharedMemoryMapping> mMapping;
+            };
+
+            class WriteHandleImpl : public WriteHandle {
+              public:
+                explicit WriteHandleImpl(std::unique_ptr<SharedMemoryMapping> mapping)
+                    : mMapping(std::move(mapping)) {
+                }
+                ~WriteHandleImpl() override = default;
+
+                bool DeserializeDataUpdate(const void* deserializePointer,
+                                           size_t deserializeSize,
+                                           size_t offset,
+                                           size_t size) override {
+                    if (deserializeSize != 0 || mTargetData == nullptr) {
+                        return false;
+                    }
+                    if (offset > mDataLength || size > mDataLength - offset ||
+                        !mMapping->ContainsRange(offset, size)) {
+                        return false;
+                    }
+                    memcpy(static_cast<uint8_t*>(mTargetData) + offset,
+                           mMapping->GetData() + offset, size);
+                    return true;
+                }
+
+              private:
+                std::unique_ptr<SharedMemoryMapping> mMapping;
+            };
+
+          public:
+            explicit ServerSharedMemoryTransferService(
+                std::shared_ptr<SharedMemoryRegionTable> table)
+                : mTable(std::move(table)) {
+            }
+            ~ServerSharedMemoryTransferService() override = default;
+
+            bool DeserializeReadHandle(const void* deserializePointer,
+                                       size_t deserializeSize,
+                                       ReadHandle** readHandle) override {
+                ASSERT(readHandle != nullptr);
+                std::unique_ptr<SharedMemoryMapping> mapping =
+                    OpenRegion(mTable.get(), deserializePointer, deserializeSize);
+                if (mapping == nullptr) {
+                    return false;
+                }
+                *readHandle = new ReadHandleImpl(std::move(mapping));
+                return true;
+            }
+
+            bool DeserializeWriteHandle(const void* deserializePointer,
+                                        size_t deserializeSize,
+                                        WriteHandle** writeHandle) override {
+                ASSERT(writeHandle != nullptr);
+                std::unique_ptr<SharedMemoryMapping> mapping =
+                    OpenRegion(mTable.get(), deserializePointer, deserializeSize);
+                if (mapping == nullptr) {
+                    return false;
+                }
+                *writeHandle = new WriteHandleImpl(std::move(mapping));
+                return true;
+            }
+
+          private:
+            std::shared_ptr<SharedMemoryRegionTable> mTable;
+        };
+
+    }  // anonymous namespace
+
+    bool IsSharedMemoryTransferServiceSupported() {
+        return true;
+    }
+
+    SharedMemoryTransferServices CreateSharedMemoryTransferServices() {
+        auto table = std::make_shared<SharedMemoryRegionTable>();
+
+        SharedMemoryTransferServices services;
+        services.client = std::make_unique<ClientSharedMemoryTransferService>(table);
+        services.server = std::make_unique<ServerSharedMemoryTransferService>(table);
+        return services;
+    }
+
+#else  // defined(DAWN_PLATFORM_LINUX)
+
+    bool IsSharedMemoryTransferServiceSupported() {
+        return false;
+    }
+
+    SharedMemoryTransferServices CreateSharedMemoryTransferServices() {
+        return {};
+    }
+
+#endif  // defined(DAWN_PLATFORM_LINUX)
+
+}  // namespace utils
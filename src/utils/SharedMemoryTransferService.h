@@ -0,0 +1,43 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILS_SHAREDMEMORYTRANSFERSERVICE_H_
+#define UTILS_SHAREDMEMORYTRANSFERSERVICE_H_
+
+#include "dawn_wire/WireClient.h"
+#include "dawn_wire/WireServer.h"
+
+#include <memory>
+
+namespace utils {
+
+    struct SharedMemoryTransferServices {
+        std::unique_ptr<dawn_wire::client::MemoryTransferService> client;
+        std::unique_ptr<dawn_wire::server::MemoryTransferService> server;
+    };
+
+    // Returns whether CreateSharedMemoryTransferServices is supported on this platform.
+    bool IsSharedMemoryTransferServiceSupported();
+
+    // Creates a pair of memory transfer services that back the read and write handles with
+    // shared memory regions (memfd) mapped by both the client and the server. Only a descriptor of
+    // the region is serialized when a handle is created, and the data updates are empty so the
+    // contents of the mapped buffers are never copied through the command stream. The two
+    // services must be used by the client and the server of the same wire, in the same process.
+    // Returns null services if the platform isn't supported.
+    SharedMemoryTransferServices CreateSharedMemoryTransferServices();
+
+}  // namespace utils
+
+#endif  // UTILS_SHAREDMEMORYTRANSFERSERVICE_H_
@@ -21,6 +21,8 @@ namespace utils {
 
     class TerribleCommandBuffer : public dawn_wire::CommandSerializer {
       public:
+        static constexpr size_t kMaxAllocationSize = 1000000;
+
         TerribleCommandBuffer();
         TerribleCommandBuffer(dawn_wire::CommandHandler* handler);
 
@@ -34,7 +36,7 @@ namespace utils {
       private:
         dawn_wire::CommandHandler* mHandler = nullptr;
         size_t mOffset = 0;
-        char mBuffer[1000000];
+        char mBuffer[kMaxAllocationSize];
     };
 
 }  // namespace utils
@@ -16,69 +16,25 @@
 
 #include "common/Assert.h"
 #include "common/Log.h"
-#include "common/SystemUtils.h"
 #include "dawn/dawn_proc.h"
 #include "dawn_native/DawnNative.h"
 #include "dawn_wire/WireClient.h"
 #include "dawn_wire/WireServer.h"
+#include "utils/RingBufferCommandTransport.h"
+#include "utils/SharedMemoryTransferService.h"
 #include "utils/TerribleCommandBuffer.h"
+#include "utils/WireServerTraceLayer.h"
 
-#include <algorithm>
 #include <cstring>
-#include <fstream>
 #include <iomanip>
 #include <set>
 #include <sstream>
+#include <thread>
 
 namespace utils {
 
     namespace {
 
-        class WireServerTraceLayer : public dawn_wire::CommandHandler {
-          public:
-            WireServerTraceLayer(const char* dir, dawn_wire::CommandHandler* handler)
-                : dawn_wire::CommandHandler(), mDir(dir), mHandler(handler) {
-                const char* sep = GetPathSeparator();
-                if (mDir.size() > 0 && mDir.back() != *sep) {
-                    mDir += sep;
-                }
-            }
-
-            void BeginWireTrace(const char* name) {
-                std::string filename = name;
-                // Replace slashes in gtest names with underscores so everything is in one
-                // directory.
-                std::replace(filename.begin(), filename.end(), '/', '_');
-                std::replace(filename.begin(), filename.end(), '\\', '_');
-
-                // Prepend the filename with the directory.
-                filename = mDir + filename;
-
-                ASSERT(!mFile.is_open());
-                mFile.open(filename,
-                           std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
-
-                // Write the initial 8 bytes. This means the fuzzer should never inject an
-                // error.
-                const uint64_t injectedErrorIndex = 0xFFFF'FFFF'FFFF'FFFF;
-                mFile.write(reinterpret_cast<const char*>(&injectedErrorIndex),
-                            sizeof(injectedErrorIndex));
-            }
-
-            const volatile char* HandleCommands(const volatile char* commands,
-                                                size_t size) override {
-                if (mFile.is_open()) {
-                    mFile.write(const_cast<const char*>(commands), size);
-                }
-                return mHandler->HandleCommands(commands, size);
-            }
-
-          private:
-            std::string mDir;
-            dawn_wire::CommandHandler* mHandler;
-            std::ofstream mFile;
-        };
-
         class WireHelperDirect : public WireHelper {
           public:
             WireHelperDirect() {
@@ -104,13 +60,18 @@ namespace utils {
 
         class WireHelperProxy : public WireHelper {
           public:
-            explicit WireHelperProxy(const char* wireTraceDir) {
+            WireHelperProxy(const char* wireTraceDir, bool useSharedMemoryTransfer) {
                 mC2sBuf = std::make_unique<utils::TerribleCommandBuffer>();
                 mS2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
 
+                if (useSharedMemoryTransfer) {
+                    mMemoryTransferServices = CreateSharedMemoryTransferServices();
+                }
+
                 dawn_wire::WireServerDescriptor serverDesc = {};
                 serverDesc.procs = &dawn_native::GetProcs();
                 serverDesc.serializer = mS2cBuf.get();
+                serverDesc.memoryTransferService = mMemoryTransferServices.server.get();
 
                 mWireServer.reset(new dawn_wire::WireServer(serverDesc));
                 mC2sBuf->SetHandler(mWireServer.get());
@@ -123,6 +84,7 @@ namespace utils {
 
                 dawn_wire::WireClientDescriptor clientDesc = {};
                 clientDesc.serializer = mC2sBuf.get();
+                clientDesc.memoryTransferService = mMemoryTransferServices.client.get();
 
                 mWireClient.reset(new dawn_wire::WireClient(clientDesc));
                 mS2cBuf->SetHandler(mWireClient.get());
@@ -146,6 +108,7 @@ namespace utils {
             }
 
             bool FlushClient() override {
+                mWireClient->SerializePendingCommands();
                 return mC2sBuf->Flush();
             }
 
@@ -156,16 +119,164 @@ namespace utils {
           private:
             std::unique_ptr<utils::TerribleCommandBuffer> mC2sBuf;
             std::unique_ptr<utils::TerribleCommandBuffer> mS2cBuf;
+            // Declared before the client and the server so that it outlives their handles.
+            SharedMemoryTransferServices mMemoryTransferServices;
+            std::unique_ptr<WireServerTraceLayer> mWireServerTraceLayer;
+            std::unique_ptr<dawn_wire::WireServer> mWireServer;
+            std::unique_ptr<dawn_wire::WireClient> mWireClient;
+        };
+
+        // Flushes the replies of the server after each batch of commands it handles, so that
+        // the replies are published by the time the client sees its commands consumed.
+        class FlushRepliesLayer : public dawn_wire::CommandHandler {
+          public:
+            FlushRepliesLayer(dawn_wire::CommandHandler* handler,
+                              dawn_wire::CommandSerializer* replySerializer)
+                : mHandler(handler), mReplySerializer(replySerializer) {
+            }
+
+            void SetHandler(dawn_wire::CommandHandler* handler) {
+                mHandler = handler;
+            }
+
+            const volatile char* HandleCommands(const volatile char* commands,
+                                                size_t size) override {
+                const volatile char* result = mHandler->HandleCommands(commands, size);
+                mReplySerializer->Flush();
+                return result;
+            }
+
+          private:
+            dawn_wire::CommandHandler* mHandler;
+            dawn_wire::CommandSerializer* mReplySerializer;
+        };
+
+        // Runs the server of the wire on a separate thread, connected to the client with
+        // RingBufferCommandTransports. FlushClient() waits for the server thread to handle the
+        // commands so that the tests behave like with WireHelperProxy.
+        class WireHelperServerThread : public WireHelper {
+          public:
+            WireHelperServerThread(const char* wireTraceDir, bool useSharedMemoryTransfer)
+                : mSignal(std::make_shared<RingBufferSignal>()) {
+                RingBufferCommandTransportDescriptor transportDesc;
+                transportDesc.signal = mSignal;
+                mC2sBuf = std::make_unique<RingBufferCommandTransport>(transportDesc);
+                mS2cBuf = std::make_unique<RingBufferCommandTransport>(transportDesc);
+
+                if (useSharedMemoryTransfer) {
+                    mMemoryTransferServices = CreateSharedMemoryTransferServices();
+                }
+
+                dawn_wire::WireServerDescriptor serverDesc = {};
+                serverDesc.procs = &dawn_native::GetProcs();
+                serverDesc.serializer = mS2cBuf.get();
+                serverDesc.memoryTransferService = mMemoryTransferServices.server.get();
+
+                mWireServer.reset(new dawn_wire::WireServer(serverDesc));
+                mServerHandler.reset(new FlushRepliesLayer(mWireServer.get(), mS2cBuf.get()));
+
+                if (wireTraceDir != nullptr && strlen(wireTraceDir) > 0) {
+                    mWireServerTraceLayer.reset(
+                        new WireServerTraceLayer(wireTraceDir, mWireServer.get()));
+                    mServerHandler->SetHandler(mWireServerTraceLayer.get());
+                }
+
+                dawn_wire::WireClientDescriptor clientDesc = {};
+                clientDesc.serializer = mC2sBuf.get();
+                clientDesc.memoryTransferService = mMemoryTransferServices.client.get();
+
+                mWireClient.reset(new dawn_wire::WireClient(clientDesc));
+                dawnProcSetProcs(&dawn_wire::client::GetProcs());
+
+                mServerThread = std::thread([this]() {
+                    while (mC2sBuf->WaitForCommands()) {
+                        mC2sBuf->ConsumeCommands(mServerHandler.get());
+                    }
+                });
+            }
+
+            ~WireHelperServerThread() override {
+                // Stop the server thread before the client and the server are destroyed. The
+                // commands they serialize while being destroyed are dropped like with
+                // WireHelperProxy.
+                mC2sBuf->Close();
+                mS2cBuf->Close();
+                mServerThread.join();
+            }
+
+            std::pair<wgpu::Device, WGPUDevice> RegisterDevice(WGPUDevice backendDevice) override {
+                ASSERT(backendDevice != nullptr);
+                ASSERT(!mC2sBuf->HasPublishedCommands());
+
+                auto reservation = mWireClient->ReserveDevice();
+                mWireServer->InjectDevice(backendDevice, reservation.id, reservation.generation);
+                dawn_native::GetProcs().deviceRelease(backendDevice);
+
+                return std::make_pair(wgpu::Device::Acquire(reservation.device), backendDevice);
+            }
+
+            void BeginWireTrace(const char* name) override {
+                ASSERT(!mC2sBuf->HasPublishedCommands());
+                if (mWireServerTraceLayer) {
+                    return mWireServerTraceLayer->BeginWireTrace(name);
+                }
+            }
+
+            bool FlushClient() override {
+                mWireClient->SerializePendingCommands();
+                bool success = mC2sBuf->Flush();
+
+                // Handle the replies while waiting for the server thread, otherwise it could wait
+                // forever for space in a full server-to-client ring.
+                while (mC2sBuf->HasPublishedCommands()) {
+                    mSignal->Wait([this]() {
+                        return !mC2sBuf->HasPublishedCommands() || mS2cBuf->HasPublishedCommands();
+                    });
+                    if (!mS2cBuf->ConsumeCommands(mWireClient.get())) {
+                        mRepliesFailed = true;
+                    }
+                }
+
+                // The failures of the server are reported by Flush() once it handled the
+                // commands. The commands serialized by the callbacks of the replies above are
+                // published too but aren't waited on, like for the callbacks in FlushServer().
+                return mC2sBuf->Flush() && success;
+            }
+
+            bool FlushServer() override {
+                bool success = mS2cBuf->ConsumeCommands(mWireClient.get()) && !mRepliesFailed;
+                mRepliesFailed = false;
+                return success;
+            }
+
+          private:
+            std::shared_ptr<RingBufferSignal> mSignal;
+            std::unique_ptr<RingBufferCommandTransport> mC2sBuf;
+            std::unique_ptr<RingBufferCommandTransport> mS2cBuf;
+            // Declared before the client and the server so that it outlives their handles.
+            SharedMemoryTransferServices mMemoryTransferServices;
             std::unique_ptr<WireServerTraceLayer> mWireServerTraceLayer;
+            std::unique_ptr<FlushRepliesLayer> mServerHandler;
             std::unique_ptr<dawn_wire::WireServer> mWireServer;
             std::unique_ptr<dawn_wire::WireClient> mWireClient;
+            bool mRepliesFailed = false;
+            std::thread mServerThread;
         };
 
     }  // anonymous namespace
 
-    std::unique_ptr<WireHelper> CreateWireHelper(bool useWire, const char* wireTraceDir) {
-        if (useWire) {
-            return std::unique_ptr<WireHelper>(new WireHelperProxy(wireTraceDir));
+    std::unique_ptr<WireHelper> CreateWireHelper(bool useWire,
+                                                 const char* wireTraceDir,
+                                                 bool useServerThread,
+                                                 bool useSharedMemoryTransfer) {
+        useSharedMemoryTransfer =
+            useSharedMemoryTransfer && IsSharedMemoryTransferServiceSupported();
+        if (useWire && useServerThread) {
+            return std::unique_ptr<WireHelper>(
+                new WireHelperServerThread(wireTraceDir, useSharedMemoryTransfer));
+        } else if (useWire) {
+            return std::unique_ptr<WireHelper>(
+                new WireHelperProxy(wireTraceDir, useSharedMemoryTransfer));
         } else {
             return std::unique_ptr<WireHelper>(new WireHelperDirect());
         }
@@ -37,7 +37,14 @@ namespace utils {
         virtual bool FlushServer() = 0;
     };
 
-    std::unique_ptr<WireHelper> CreateWireHelper(bool useWire, const char* wireTraceDir = nullptr);
+    // With |useServerThread|, the server of the wire runs on a separate thread and is connected to
+    // the client with RingBufferCommandTransports. With |useSharedMemoryTransfer|, the mapped
+    // buffers are shared between the client and the server with the memory transfer services of
+    // CreateSharedMemoryTransferServices, if they are supported.
+    std::unique_ptr<WireHelper> CreateWireHelper(bool useWire,
+                                                 const char* wireTraceDir = nullptr,
+                                                 bool useServerThread = false,
+                                                 bool useSharedMemoryTransfer = false);
 
 }  // namespace utils
 
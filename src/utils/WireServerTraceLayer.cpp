@@ -0,0 +1,58 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "utils/WireServerTraceLayer.h"
+
+#include "common/Assert.h"
+#include "common/SystemUtils.h"
+
+#include <algorithm>
+
+namespace utils {
+
+    WireServerTraceLayer::WireServerTraceLayer(const char* dir, dawn_wire::CommandHandler* handler)
+        : dawn_wire::CommandHandler(), mDir(dir), mHandler(handler) {
+        const char* sep = GetPathSeparator();
+        if (mDir.size() > 0 && mDir.back() != *sep) {
+            mDir += sep;
+        }
+    }
+
+    void WireServerTraceLayer::BeginWireTrace(const char* name) {
+        std::string filename = name;
+        // Replace slashes in gtest names with underscores so everything is in one directory.
+        std::replace(filename.begin(), filename.end(), '/', '_');
+        std::replace(filename.begin(), filename.end(), '\\', '_');
+
+        // Prepend the filename with the directory.
+        filename = mDir + filename;
+
+        ASSERT(!mFile.is_open());
+        mFile.open(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+        // Write the initial 8 bytes. This means the fuzzer should never inject an error.
+        const uint64_t injectedErrorIndex = 0xFFFF'FFFF'FFFF'FFFF;
+        mFile.write(reinterpret_cast<const char*>(&injectedErrorIndex),
+                    sizeof(injectedErrorIndex));
+    }
+
+    const volatile char* WireServerTraceLayer::HandleCommands(const volatile char* commands,
+                                                              size_t size) {
+        if (mFile.is_open()) {
+            mFile.write(const_cast<const char*>(commands), size);
+        }
+        return mHandler->HandleCommands(commands, size);
+    }
+
+}  // namespace utils
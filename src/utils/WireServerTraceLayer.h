@@ -0,0 +1,47 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILS_WIRESERVERTRACELAYER_H_
+#define UTILS_WIRESERVERTRACELAYER_H_
+
+#include "dawn_wire/Wire.h"
+
+#include <fstream>
+#include <string>
+
+namespace utils {
+
+    // Forwards the commands sent to a WireServer and writes them to a trace file. A trace starts
+    // with the 8 bytes of the index at which the fuzzers inject an error, set to never inject one,
+    // followed by the commands. Traces are replayed by the fuzzers and by WireTraceReplay with the
+    // client device injected with the ID 1 and the generation 0.
+    class WireServerTraceLayer : public dawn_wire::CommandHandler {
+      public:
+        WireServerTraceLayer(const char* dir, dawn_wire::CommandHandler* handler);
+
+        // Starts writing the commands to the file |name| in the directory of the traces,
+        // replacing the slashes of |name| with underscores.
+        void BeginWireTrace(const char* name);
+
+        const volatile char* HandleCommands(const volatile char* commands, size_t size) override;
+
+      private:
+        std::string mDir;
+        dawn_wire::CommandHandler* mHandler;
+        std::ofstream mFile;
+    };
+
+}  // namespace utils
+
+#endif  // UTILS_WIRESERVERTRACELAYER_H_